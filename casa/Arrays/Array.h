@@ -219,6 +219,19 @@ public:
     // The copy is allocated by <src>DefaultAllocator<T></src>.
     Array(const IPosition &shape, const T *storage);
 
+    // Create an Array of a given shape referencing external storage
+    // (as with policy <src>SHARE</src>) whose lifetime is governed by
+    // <src>owner</src>. A reference to <src>owner</src> is kept by this
+    // array and all arrays sharing its storage, so the storage stays
+    // valid as long as any of them exists. It is, for instance, used to
+    // make an array referencing memory-mapped file data.
+    // <br>Note that the storage might be readonly memory, so the data
+    // should not be changed through such an array. Resizing the array or
+    // making it unique always makes a copy of the data.
+    Array(const IPosition &shape, T *storage,
+          const std::shared_ptr<void>& owner,
+          const Alloc& allocator = Alloc());
+
     // Construct an array from an iterator and a shape.
     template<typename InputIterator>
     Array(const IPosition &shape, InputIterator startIter, const Alloc& allocator = Alloc());
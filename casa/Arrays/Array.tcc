@@ -146,6 +146,31 @@ Array<T, Alloc>::Array(const IPosition &shape, T *storage,
   assert(ok());
 }
 
+template<class T, typename Alloc>
+Array<T, Alloc>::Array(const IPosition &shape, T *storage,
+                       const std::shared_ptr<void>& owner,
+                       const Alloc& allocator)
+: ArrayBase(shape),
+  data_p(),
+  begin_p(nullptr),
+  end_p(nullptr)
+{
+  takeStorage(shape, storage, SHARE, allocator);
+  // Let the storage object also hold the owner of the external data.
+  // The aliasing constructor of shared_ptr is used to share ownership of
+  // both, so the owner is released together with the storage object.
+  struct Holder {
+    std::shared_ptr<arrays_internal::Storage<T, Alloc>> storage;
+    std::shared_ptr<void> owner;
+  };
+  std::shared_ptr<Holder> holder = std::make_shared<Holder>();
+  holder->storage = data_p;
+  holder->owner   = owner;
+  data_p = std::shared_ptr<arrays_internal::Storage<T, Alloc>>
+    (holder, holder->storage.get());
+  assert(ok());
+}
+
 template<class T, typename Alloc>
 Array<T, Alloc>::Array(const IPosition &shape, const T *storage)
 : ArrayBase(shape),
@@ -28,8 +28,12 @@
 
 //# Includes
 #include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -47,12 +51,15 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_WriteCallBack (writeCallBack),
   its_InitCallBack  (initCallBack),
   its_DeleteCallBack(deleteCallBack),
+  its_GetLocalCallBack (0),
+  its_SkipWriteCallBack(0),
   its_StartOffset   (startOffset),
   its_BucketSize    (bucketSize),
   its_CurNrOfBuckets(0),
   its_NewNrOfBuckets(nrOfBuckets),
   its_CacheSize     (cacheSize),
   its_CacheSizeUsed (0),
+  its_ForceGrow     (False),
   its_Cache         (cacheSize, static_cast<char*>(0)),
   its_ActualSlot    (0),
   its_SlotNr        (nrOfBuckets, Int(-1)),
@@ -62,7 +69,16 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_LRUCounter    (0),
   its_Buffer        (0),
   its_NrOfFree      (0),
-  its_FirstFree     (-1)
+  its_FirstFree     (-1),
+  its_PrefetchSize  (0),
+  its_LastRead      (-1),
+  its_SeqCount      (0)
+#if defined(USE_THREADS)
+  ,
+  its_PrefetchActive (-1),
+  its_PrefetchDiscard(False),
+  its_PrefetchStop   (False)
+#endif
 {
     initStatistics();
     // The bucketsize must be set.
@@ -93,6 +109,9 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
 
 BucketCache::~BucketCache()
 {
+    // Wait until a release by the cache manager has finished.
+    setReleaseMutex (0);
+    stopPrefetch();
     // Clear the entire cache.
     // It is not flushed (that should have been done before).
     // In that way no needless flushes are done for a temporary table.
@@ -102,6 +121,11 @@ BucketCache::~BucketCache()
 
 void BucketCache::clear (uInt fromSlot, Bool doFlush)
 {
+    // Prefetched data might be outdated if the file is reread.
+    waitPrefetch();
+    if (fromSlot == 0) {
+        stopPrefetch();
+    }
     if (doFlush) {
         flush (fromSlot);
     }
@@ -115,6 +139,8 @@ void BucketCache::clear (uInt fromSlot, Bool doFlush)
 	initStatistics();
     }
     if (fromSlot < its_CacheSizeUsed) {
+        adjustCacheBytes (-Int64(its_CacheSizeUsed - fromSlot) *
+                          its_BucketSize);
 	its_CacheSizeUsed = fromSlot;
     }
 }
@@ -205,12 +231,25 @@ void BucketCache::setLRU()
     its_LRU[its_ActualSlot] = ++its_LRUCounter;
 }
 
+void BucketCache::setLocalCallBacks (BucketCacheGetLocal getLocalCallBack,
+                                     BucketCacheSkipWrite skipWriteCallBack)
+{
+    its_GetLocalCallBack  = getLocalCallBack;
+    its_SkipWriteCallBack = skipWriteCallBack;
+}
+
 char* BucketCache::getBucket (uInt bucketNr)
 {
     if (bucketNr >= its_NewNrOfBuckets) {
 	throw (indexError<Int> (bucketNr));
     }
     naccess_p++;
+    // Give up memory if asked for by the cache manager (but not while
+    // getting the buckets for getBuckets).
+    if (! its_ForceGrow) {
+        releaseIfRequested();
+    }
+    cacheUsed();
     // Test if it is already in the cache.
     if (its_SlotNr[bucketNr] >= 0) {
 	its_ActualSlot = its_SlotNr[bucketNr];
@@ -223,17 +262,98 @@ char* BucketCache::getBucket (uInt bucketNr)
     if (bucketNr < its_CurNrOfBuckets) {
 	getSlot (bucketNr);
 	readBucket (its_ActualSlot);
+    }else if (its_file->isWritable()) {
+	initializeBuckets (bucketNr);
     }else{
-        if (! its_file->isWritable()) {
+        // A bucket not written to the file can still be kept by the owner.
+        char* local = (its_GetLocalCallBack == 0  ?  0 :
+                       its_GetLocalCallBack (its_Owner, bucketNr));
+        if (local == 0) {
             throw AipsError ("BucketCache::getBucket: bucket " +
                              String::toString(bucketNr) +
                              " exceeds nr of buckets");
         }
-	initializeBuckets (bucketNr);
+        getSlot (bucketNr);
+        its_Cache[its_ActualSlot] = local;
     }
     return its_Cache[its_ActualSlot];
 }
 
+Bool BucketCache::getBuckets (const std::vector<uInt>& bucketNrs,
+                              std::vector<char*>& data,
+                              uInt nthreads, Bool setDirty)
+{
+    if (bucketNrs.size() > its_CacheSize) {
+        return False;
+    }
+    releaseIfRequested();
+    cacheUsed();
+    // All buckets have to fit, so the cache can grow beyond the budget.
+    its_ForceGrow = True;
+    try {
+        getBucketsInCache (bucketNrs, nthreads);
+    } catch (...) {
+        its_ForceGrow = False;
+        throw;
+    }
+    its_ForceGrow = False;
+    data.resize (bucketNrs.size());
+    for (size_t i=0; i<bucketNrs.size(); ++i) {
+        its_ActualSlot = its_SlotNr[bucketNrs[i]];
+        data[i] = its_Cache[its_ActualSlot];
+        if (setDirty) {
+            its_Dirty[its_ActualSlot] = 1;
+        }
+    }
+    return True;
+}
+
+void BucketCache::getBucketsInCache (const std::vector<uInt>& bucketNrs,
+                                     uInt nthreads)
+{
+    // First initialize the buckets not in the file yet.
+    // Thereafter mark the buckets in the cache as most recently used,
+    // so getting a slot for the others cannot remove them from the cache.
+    uInt naccess = 0;
+    for (size_t i=0; i<bucketNrs.size(); ++i) {
+        if (bucketNrs[i] >= its_CurNrOfBuckets) {
+            getBucket (bucketNrs[i]);
+        } else {
+            naccess++;
+        }
+    }
+    for (size_t i=0; i<bucketNrs.size(); ++i) {
+        if (its_SlotNr[bucketNrs[i]] >= 0) {
+            its_ActualSlot = its_SlotNr[bucketNrs[i]];
+            setLRU();
+        }
+    }
+    // Get a slot for the buckets to read. Do the reads in parallel
+    // if possible, otherwise one by one.
+    Bool parallel = ((nthreads > 1  ||  its_file->hasBatchRead())  &&
+                     its_file->canReadAsync());
+    std::vector<uInt> slotNrs;
+    for (size_t i=0; i<bucketNrs.size(); ++i) {
+        uInt bucketNr = bucketNrs[i];
+        if (its_SlotNr[bucketNr] < 0) {
+            getSlot (bucketNr);
+            if (getLocalBucket (its_ActualSlot)) {
+                continue;
+            }
+            if (parallel) {
+                discardPrefetched (bucketNr);
+                slotNrs.push_back (its_ActualSlot);
+            } else {
+                readBucket (its_ActualSlot);
+            }
+        }
+    }
+    if (! slotNrs.empty()) {
+        readBuckets (slotNrs, nthreads);
+    }
+    naccess_p += naccess;
+}
+
 void BucketCache::extend (uInt nrBucket)
 {
     its_NewNrOfBuckets += nrBucket;
@@ -271,6 +391,7 @@ uInt BucketCache::addBucket (char* data)
 	its_CurNrOfBuckets++;
 	bucketNr = its_NewNrOfBuckets - 1;
     }
+    discardPrefetched (bucketNr);
     getSlot (bucketNr);
     its_Cache[its_ActualSlot] = data;
     its_Dirty[its_ActualSlot] = 1;
@@ -283,6 +404,7 @@ void BucketCache::removeBucket()
     // Thus store the bucket nr of the first free in this bucket
     // and make this bucket the first free.
     uInt bucketNr = its_BucketNr[its_ActualSlot];
+    discardPrefetched (bucketNr);
     CanonicalConversion::fromLocal (its_Buffer, its_FirstFree);
     its_file->seek (its_StartOffset + Int64(bucketNr) * its_BucketSize);
     its_file->write (its_Buffer, its_BucketSize);
@@ -301,12 +423,14 @@ void BucketCache::removeBucket()
 
 void BucketCache::get (char* buf, uInt length, Int64 offset)
 {
+    waitPrefetch();
     checkOffset (length, offset);
     its_file->seek (offset);
     its_file->read (buf, length);
 }
 void BucketCache::put (const char* buf, uInt length, Int64 offset)
 {
+    waitPrefetch();
     checkOffset (length, offset);
     its_file->seek (offset);
     its_file->write (buf, length);
@@ -323,7 +447,11 @@ void BucketCache::checkOffset (uInt length, Int64 offset) const
 
 void BucketCache::getSlot (uInt bucketNr)
 {
-    if (its_CacheSizeUsed < its_CacheSize) {
+    // Use a new slot if the cache is not full and the memory budget
+    // allows it. The first slot can always be used.
+    if (its_CacheSizeUsed < its_CacheSize  &&
+        adjustCacheBytes (its_BucketSize,
+                          its_ForceGrow  ||  its_CacheSizeUsed == 0)) {
 	its_ActualSlot = its_CacheSizeUsed++;
     }else{
 	its_ActualSlot = 0;
@@ -341,6 +469,7 @@ void BucketCache::getSlot (uInt bucketNr)
 	    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
 	    its_Cache[its_ActualSlot] = 0;
 	    its_SlotNr[its_BucketNr[its_ActualSlot]] = -1;
+	    nevict_p++;
 	}
     }
     setLRU();
@@ -349,9 +478,68 @@ void BucketCache::getSlot (uInt bucketNr)
 }
 
 
+Int64 BucketCache::releaseCache (Int64 nbytes)
+{
+    uInt nkeep = std::max (nbytes / its_BucketSize, Int64(1));
+    if (its_CacheSizeUsed <= nkeep) {
+        return Int64(its_CacheSizeUsed) * its_BucketSize;
+    }
+    // Remove the least recently used buckets except the current one.
+    std::vector<uInt> slots;
+    slots.reserve (its_CacheSizeUsed);
+    for (uInt i=0; i<its_CacheSizeUsed; ++i) {
+        if (i != its_ActualSlot) {
+            slots.push_back (i);
+        }
+    }
+    std::sort (slots.begin(), slots.end(),
+               [this](uInt s1, uInt s2) { return its_LRU[s1] < its_LRU[s2]; });
+    std::vector<Bool> removed (its_CacheSizeUsed, False);
+    for (uInt i=0; i<its_CacheSizeUsed-nkeep; ++i) {
+        uInt slot = slots[i];
+        if (its_Dirty[slot]) {
+            writeBucket (slot);
+        }
+        its_DeleteCallBack (its_Owner, its_Cache[slot]);
+        its_SlotNr[its_BucketNr[slot]] = -1;
+        removed[slot] = True;
+        nevict_p++;
+    }
+    // Move the remaining buckets to the first slots.
+    uInt nr = 0;
+    for (uInt i=0; i<its_CacheSizeUsed; ++i) {
+        if (! removed[i]) {
+            if (i != nr) {
+                its_Cache[nr]    = its_Cache[i];
+                its_BucketNr[nr] = its_BucketNr[i];
+                its_Dirty[nr]    = its_Dirty[i];
+                its_LRU[nr]      = its_LRU[i];
+                its_SlotNr[its_BucketNr[nr]] = nr;
+                if (its_ActualSlot == i) {
+                    its_ActualSlot = nr;
+                }
+            }
+            nr++;
+        }
+    }
+    for (uInt i=nr; i<its_CacheSizeUsed; ++i) {
+        its_Cache[i] = 0;
+        its_Dirty[i] = 0;
+    }
+    its_CacheSizeUsed = nr;
+    return Int64(its_CacheSizeUsed) * its_BucketSize;
+}
+
 void BucketCache::writeBucket (uInt slotNr)
 {
 ///    cout << "write " << its_BucketNr[slotNr] << " " << slotNr;
+    discardPrefetched (its_BucketNr[slotNr]);
+    if (its_SkipWriteCallBack != 0  &&
+        its_SkipWriteCallBack (its_Owner, its_BucketNr[slotNr],
+                               its_Cache[slotNr])) {
+        its_Dirty[slotNr] = 0;
+        return;
+    }
     its_WriteCallBack (its_Owner, its_Buffer, its_Cache[slotNr]);
     its_file->seek (its_StartOffset +
 		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
@@ -362,22 +550,106 @@ void BucketCache::writeBucket (uInt slotNr)
 void BucketCache::readBucket (uInt slotNr)
 {
 ///    cout << "read " << its_BucketNr[slotNr] << " " << slotNr;
-    its_file->seek (its_StartOffset +
-		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
-    its_file->read (its_Buffer, its_BucketSize);
+    if (getLocalBucket (slotNr)) {
+        return;
+    }
+    uInt bucketNr = its_BucketNr[slotNr];
+    if (! getPrefetched (bucketNr)) {
+        its_file->seek (its_StartOffset + Int64(bucketNr) * its_BucketSize);
+        its_file->read (its_Buffer, its_BucketSize);
+    }
     its_Cache[slotNr] = its_ReadCallBack (its_Owner, its_Buffer);
     nread_p++;
+    prefetch (bucketNr);
+}
+void BucketCache::readBuckets (const std::vector<uInt>& slotNrs,
+                               uInt nthreads)
+{
+    std::exception_ptr excp;
+    if (its_file->hasBatchRead()) {
+        // Submit all reads in one go and convert thereafter.
+        std::vector<char> bufs(size_t(its_BucketSize) * slotNrs.size());
+        std::vector<ByteIO::ReadRequest> requests(slotNrs.size());
+        for (size_t i=0; i<slotNrs.size(); ++i) {
+            requests[i].size   = its_BucketSize;
+            requests[i].offset = its_StartOffset +
+                                 Int64(its_BucketNr[slotNrs[i]]) * its_BucketSize;
+            requests[i].buf    = bufs.data() + i*its_BucketSize;
+        }
+        try {
+            its_file->preadBatch (requests);
+        } catch (...) {
+            excp = std::current_exception();
+        }
+        if (! excp) {
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+            for (Int i=0; i<Int(slotNrs.size()); ++i) {
+                try {
+                    its_Cache[slotNrs[i]] = its_ReadCallBack
+                      (its_Owner, static_cast<char*>(requests[i].buf));
+                } catch (...) {
+#pragma omp critical(BucketCache_readBuckets)
+                    excp = std::current_exception();
+                }
+            }
+        }
+    } else {
+#pragma omp parallel num_threads(nthreads)
+        {
+            std::vector<char> buf(its_BucketSize);
+#pragma omp for schedule(dynamic)
+            for (Int i=0; i<Int(slotNrs.size()); ++i) {
+                try {
+                    uInt slotNr = slotNrs[i];
+                    its_file->pread (buf.data(), its_BucketSize,
+                                     its_StartOffset +
+                                     Int64(its_BucketNr[slotNr]) *
+                                     its_BucketSize);
+                    its_Cache[slotNr] = its_ReadCallBack (its_Owner,
+                                                          buf.data());
+                } catch (...) {
+#pragma omp critical(BucketCache_readBuckets)
+                    excp = std::current_exception();
+                }
+            }
+        }
+    }
+    nread_p += slotNrs.size();
+    if (excp) {
+        // Release the slots of the buckets that could not be read.
+        for (size_t i=0; i<slotNrs.size(); ++i) {
+            if (its_Cache[slotNrs[i]] == 0) {
+                its_SlotNr[its_BucketNr[slotNrs[i]]] = -1;
+                its_LRU[slotNrs[i]] = 0;
+            }
+        }
+        std::rethrow_exception (excp);
+    }
+}
+Bool BucketCache::getLocalBucket (uInt slotNr)
+{
+    if (its_GetLocalCallBack != 0) {
+        char* local = its_GetLocalCallBack (its_Owner, its_BucketNr[slotNr]);
+        if (local != 0) {
+            its_Cache[slotNr] = local;
+            return True;
+        }
+    }
+    return False;
 }
+
 void BucketCache::initializeBuckets (uInt bucketNr)
 {
     // Initialize this bucket and all uninitialized ones before it.
     while (its_CurNrOfBuckets <= bucketNr) {
 	getSlot (its_CurNrOfBuckets);
 ///	cout << "init " << its_CurNrOfBuckets << " " << its_ActualSlot;
-	its_Cache[its_ActualSlot] = its_InitCallBack (its_Owner);
-	its_Dirty[its_ActualSlot] = 1;
+        if (! getLocalBucket (its_ActualSlot)) {
+            its_Cache[its_ActualSlot] = its_InitCallBack (its_Owner);
+            its_Dirty[its_ActualSlot] = 1;
+            ninit_p++;
+        }
 	its_CurNrOfBuckets++;
-	ninit_p++;
     }
 }
 
@@ -403,6 +675,10 @@ void BucketCache::showStatistics (ostream& os) const
     if (nwrite_p > 0) {
 	os << "#writes:   " << nwrite_p << endl;
     }
+    if (nprefetch_p > 0) {
+	os << "#prefetch: " << nprefetch_p << "         used: "
+           << nprefetchUsed_p << endl;
+    }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
 	os << "        hit-rate:  "
@@ -418,7 +694,203 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nevict_p  = 0;
+    nprefetch_p     = 0;
+    nprefetchUsed_p = 0;
+}
+
+
+uInt BucketCache::defaultPrefetch()
+{
+    Int nr;
+    AipsrcValue<Int>::find (nr, "bucketcache.prefetch", 0);
+    return std::max (nr, 0);
+}
+
+void BucketCache::setPrefetch (uInt nrBuckets)
+{
+#if defined(USE_THREADS)
+    if (! its_file->canReadAsync()) {
+        nrBuckets = 0;
+    }
+#else
+    nrBuckets = 0;
+#endif
+    if (nrBuckets == 0) {
+        stopPrefetch();
+    }
+    its_PrefetchSize = nrBuckets;
+}
+
+void BucketCache::waitPrefetch()
+{
+#if defined(USE_THREADS)
+    if (its_PrefetchThread.joinable()) {
+        std::unique_lock<std::mutex> lock(its_PrefetchMutex);
+        its_PrefetchQueue.clear();
+        its_PrefetchCond.wait (lock, [this]{ return its_PrefetchActive < 0; });
+    }
+#endif
+}
+
+void BucketCache::stopPrefetch()
+{
+#if defined(USE_THREADS)
+    if (its_PrefetchThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(its_PrefetchMutex);
+            its_PrefetchStop = True;
+        }
+        its_PrefetchCond.notify_all();
+        its_PrefetchThread.join();
+        its_PrefetchStop = False;
+    }
+    its_PrefetchQueue.clear();
+    its_Prefetched.clear();
+#endif
+    its_LastRead = -1;
+    its_SeqCount = 0;
+}
+
+Bool BucketCache::getPrefetched (uInt bucketNr)
+{
+#if defined(USE_THREADS)
+    if (its_PrefetchThread.joinable()) {
+        std::unique_lock<std::mutex> lock(its_PrefetchMutex);
+        if (its_PrefetchActive == Int(bucketNr)) {
+            // Being read, so wait until done.
+            its_PrefetchCond.wait (lock, [this, bucketNr]
+                                   { return its_PrefetchActive != Int(bucketNr); });
+        } else {
+            // Do not read it anymore if still queued.
+            std::deque<uInt>::iterator iter =
+              std::find (its_PrefetchQueue.begin(), its_PrefetchQueue.end(),
+                         bucketNr);
+            if (iter != its_PrefetchQueue.end()) {
+                its_PrefetchQueue.erase (iter);
+            }
+        }
+        std::map<uInt,std::vector<char>>::iterator iter =
+          its_Prefetched.find (bucketNr);
+        if (iter != its_Prefetched.end()) {
+            memcpy (its_Buffer, iter->second.data(), its_BucketSize);
+            its_Prefetched.erase (iter);
+            nprefetchUsed_p++;
+            return True;
+        }
+    }
+#else
+    (void)bucketNr;
+#endif
+    return False;
+}
+
+void BucketCache::discardPrefetched (uInt bucketNr)
+{
+#if defined(USE_THREADS)
+    if (its_PrefetchThread.joinable()) {
+        std::lock_guard<std::mutex> lock(its_PrefetchMutex);
+        its_Prefetched.erase (bucketNr);
+        if (its_PrefetchActive == Int(bucketNr)) {
+            its_PrefetchDiscard = True;
+        }
+        std::deque<uInt>::iterator iter =
+          std::find (its_PrefetchQueue.begin(), its_PrefetchQueue.end(),
+                     bucketNr);
+        if (iter != its_PrefetchQueue.end()) {
+            its_PrefetchQueue.erase (iter);
+        }
+    }
+#else
+    (void)bucketNr;
+#endif
+}
+
+void BucketCache::prefetch (uInt bucketNr)
+{
+    if (its_PrefetchSize == 0) {
+        return;
+    }
+    // Read ahead if at least two buckets have been read in sequence.
+    if (Int(bucketNr) == its_LastRead + 1) {
+        its_SeqCount++;
+    } else {
+        its_SeqCount = 0;
+    }
+    its_LastRead = bucketNr;
+    if (its_SeqCount == 0) {
+        return;
+    }
+#if defined(USE_THREADS)
+    if (! its_PrefetchThread.joinable()) {
+        its_PrefetchThread = std::thread (&BucketCache::runPrefetch, this);
+    }
+    uInt lastNr = std::min (its_CurNrOfBuckets, bucketNr + 1 + its_PrefetchSize);
+    {
+        std::lock_guard<std::mutex> lock(its_PrefetchMutex);
+        // Remove prefetched buckets which will not be used in this sequence.
+        std::map<uInt,std::vector<char>>::iterator iter = its_Prefetched.begin();
+        while (iter != its_Prefetched.end()) {
+            if (iter->first < bucketNr  ||  iter->first >= lastNr) {
+                iter = its_Prefetched.erase (iter);
+            } else {
+                ++iter;
+            }
+        }
+        uInt nr = its_PrefetchQueue.size() + its_Prefetched.size() +
+                  (its_PrefetchActive < 0 ? 0 : 1);
+        for (uInt bnr=bucketNr+1; bnr<lastNr && nr<its_PrefetchSize; ++bnr) {
+            if (its_SlotNr[bnr] < 0
+            &&  Int(bnr) != its_PrefetchActive
+            &&  its_Prefetched.find(bnr) == its_Prefetched.end()
+            &&  std::find (its_PrefetchQueue.begin(), its_PrefetchQueue.end(),
+                           bnr) == its_PrefetchQueue.end()) {
+                its_PrefetchQueue.push_back (bnr);
+                nprefetch_p++;
+                nr++;
+            }
+        }
+    }
+    its_PrefetchCond.notify_all();
+#endif
+}
+
+#if defined(USE_THREADS)
+void BucketCache::runPrefetch()
+{
+    std::vector<char> buf;
+    std::unique_lock<std::mutex> lock(its_PrefetchMutex);
+    while (True) {
+        its_PrefetchCond.wait (lock, [this]
+                  { return its_PrefetchStop || !its_PrefetchQueue.empty(); });
+        if (its_PrefetchStop) {
+            break;
+        }
+        uInt bucketNr = its_PrefetchQueue.front();
+        its_PrefetchQueue.pop_front();
+        its_PrefetchActive  = bucketNr;
+        its_PrefetchDiscard = False;
+        lock.unlock();
+        // Read without holding the lock.
+        // An error is ignored; the bucket will be read again when needed,
+        // so the error is reported by that read.
+        Bool ok = True;
+        buf.resize (its_BucketSize);
+        try {
+            its_file->pread (buf.data(), its_BucketSize,
+                             its_StartOffset + Int64(bucketNr) * its_BucketSize);
+        } catch (std::exception&) {
+            ok = False;
+        }
+        lock.lock();
+        if (ok  &&  !its_PrefetchDiscard) {
+            its_Prefetched[bucketNr].swap (buf);
+        }
+        its_PrefetchActive = -1;
+        its_PrefetchCond.notify_all();
+    }
 }
+#endif
 
 } //# NAMESPACE CASACORE - END
 
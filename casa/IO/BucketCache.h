@@ -31,8 +31,17 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/IO/CacheManager.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
+#include <map>
+#include <deque>
+#include <vector>
+#if defined(USE_THREADS)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 //# Forward clarations
 #include <casacore/casa/iosfwd.h>
@@ -71,6 +80,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // The DeleteBuffer callback function has to delete the buffer
 // allocated by the ToLocal function.
 // <p>
+// Optionally the GetLocal and SkipWrite callback functions can be set
+// using <src>setLocalCallBacks</src>. They make it possible for the owner
+// to keep buckets that do not need to be stored in the file (e.g. buckets
+// with a constant value). The GetLocal function is called before a bucket
+// is read. If it returns a buffer, that buffer (allocated like in the
+// ToLocal function) is used and the file is not read. The SkipWrite function
+// is called before a bucket is written. If it returns True,
+// the bucket is not written.
+// <p>
 // The functions get a pointer to the owner object, which was provided
 // at construction time. The callback function has to cast this to the
 // correct type and can use it thereafter.
@@ -91,6 +109,9 @@ typedef void (*BucketCacheFromLocal) (void* ownerObject, char* canonical,
 				      const char* local);
 typedef char* (*BucketCacheAddBuffer) (void* ownerObject);
 typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
+typedef char* (*BucketCacheGetLocal) (void* ownerObject, uInt bucketNr);
+typedef Bool (*BucketCacheSkipWrite) (void* ownerObject, uInt bucketNr,
+                                      const char* local);
 // </group>
 
 
@@ -141,6 +162,21 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // for example, be used to have tiled arrays with different tile shapes
 // in the same file.
 // <p>
+// Optionally BucketCache can prefetch buckets (see function
+// <src>setPrefetch</src>). When it detects that buckets are read
+// sequentially, a background thread reads the next buckets ahead, so
+// sequential scans of a column do not stall on every bucket read.
+// The prefetched buckets are kept in external format and converted by
+// the ToLocal callback function (in the calling thread) when they are
+// actually needed. Prefetching is only done for a plain file (which
+// supports concurrent reads) and if casacore is built with threads.
+// <p>
+// The memory of the cache slots in use is accounted for by the
+// <linkto class=CacheManager>CacheManager</linkto>. If the process-wide
+// budget is exceeded, a cache uses its least recently used slot instead
+// of a new one and can be asked to give up its least recently used
+// buckets to make room for another cache.
+// <p>
 // Statistics are kept to know how efficient the cache is working.
 // It is possible to initialize and show the statistics.
 // </synopsis> 
@@ -214,7 +250,7 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // </todo>
 
 
-class BucketCache
+class BucketCache : public CacheClient
 {
 public:
 
@@ -231,7 +267,7 @@ public:
 		 BucketCacheAddBuffer addCallBack,
 		 BucketCacheDeleteBuffer deleteCallBack);
 
-    ~BucketCache();
+    virtual ~BucketCache();
 
     // Flush the cache from the given slot on.
     // By default the entire cache is flushed.
@@ -264,6 +300,32 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Set the maximum number of buckets to read ahead when a sequential
+    // access pattern is detected. 0 means no prefetching (the default).
+    // It is ignored if the file does not support concurrent reads.
+    void setPrefetch (uInt nrBuckets);
+
+    // Get the maximum number of buckets to read ahead.
+    uInt prefetchSize() const;
+
+    // Get the default number of buckets to read ahead as defined by the
+    // aipsrc variable <src>bucketcache.prefetch</src> (default 0).
+    static uInt defaultPrefetch();
+
+    // Wait until the prefetching in progress has finished and discard
+    // the pending requests.
+    // It must be done before the file is accessed in another way than via
+    // this object (e.g. reopened). It is done by the functions of this
+    // class which access the file (except getBucket).
+    void waitPrefetch();
+
+    // Set the optional callback functions to get a bucket without reading
+    // it and to tell if a bucket does not need to be written
+    // (see the synopsis of <linkto group=BucketCache.h#BucketCache_CallBack>
+    // the callback functions</linkto>).
+    void setLocalCallBacks (BucketCacheGetLocal getLocalCallBack,
+                            BucketCacheSkipWrite skipWriteCallBack);
+
     // Set the dirty bit for the current bucket.
     void setDirty();
 
@@ -276,6 +338,22 @@ public:
     // A pointer to the data in converted format is returned.
     char* getBucket (uInt bucketNr);
 
+    // Make the given buckets available in the cache and return pointers
+    // to their data in local format (in the same order as the bucket numbers).
+    // The buckets not in the cache yet are read and converted using at most
+    // <src>nthreads</src> threads in parallel, so the ToLocal callback
+    // function must be thread-safe if <src>nthreads>1</src>. That is only
+    // done for a plain file (which supports concurrent reads).
+    // If the file can read in batches (using io_uring), all buckets are
+    // read in one go before being converted in parallel.
+    // <br>All returned pointers have to remain valid, so it can only be
+    // done if the cache is large enough to hold all buckets. If not,
+    // False is returned and nothing is done.
+    // If <src>setDirty</src> is True, all buckets are marked as dirty.
+    Bool getBuckets (const std::vector<uInt>& bucketNrs,
+                     std::vector<char*>& data,
+                     uInt nthreads, Bool setDirty = False);
+
     // Extend the file with the given number of buckets.
     // The buckets get initialized when they are acquired
     // (using getBucket) for the first time.
@@ -316,9 +394,30 @@ public:
     // (Re)initialize the cache statistics.
     void initStatistics();
 
+    // Is the bucket in the cache?
+    Bool isCached (uInt bucketNr) const;
+
+    // Get the statistics: the number of bucket accesses, reads, writes,
+    // initializations of new buckets, and buckets removed from the cache
+    // to make place for another one.
+    // Note that the number of cache hits is #accesses - #reads - #inits.
+    // <group>
+    uInt nAccess() const;
+    uInt nRead() const;
+    uInt nWrite() const;
+    uInt nInit() const;
+    uInt nEvict() const;
+    // </group>
+
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
+protected:
+    // Remove the least recently used buckets from the cache (after
+    // writing them if dirty) until at most <src>nbytes</src> are used.
+    // The current bucket is kept.
+    virtual Int64 releaseCache (Int64 nbytes);
+
 private:
     // The file used.
     BucketFile* its_file;
@@ -332,6 +431,10 @@ private:
     BucketCacheAddBuffer its_InitCallBack;
     // The delete callback function.
     BucketCacheDeleteBuffer its_DeleteCallBack;
+    // The optional callback functions to get a bucket without reading it
+    // and to skip writing a bucket.
+    BucketCacheGetLocal  its_GetLocalCallBack;
+    BucketCacheSkipWrite its_SkipWriteCallBack;
     // The starting offsets of the buckets in the file.
     Int64    its_StartOffset;
     // The bucket size.
@@ -344,6 +447,8 @@ private:
     uInt     its_CacheSize;
     // The nr of slots used in the cache.
     uInt     its_CacheSizeUsed;
+    // Can slots be added regardless of the memory budget?
+    Bool     its_ForceGrow;
     // The cache itself.
     PtrBlock<char*> its_Cache; 
     // The cache slot actually used.
@@ -369,6 +474,30 @@ private:
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nevict_p;
+    uInt nprefetch_p;
+    uInt nprefetchUsed_p;
+    // The maximum nr of buckets to read ahead.
+    uInt its_PrefetchSize;
+    // The last bucket read and the length of the sequential run ending in it.
+    Int  its_LastRead;
+    uInt its_SeqCount;
+#if defined(USE_THREADS)
+    // The prefetch thread, its queue of buckets to read, and the buckets
+    // read ahead (in external format).
+    // The mutex protects the queue, the prefetched buckets and the flags.
+    std::thread                      its_PrefetchThread;
+    std::mutex                       its_PrefetchMutex;
+    std::condition_variable          its_PrefetchCond;
+    std::deque<uInt>                 its_PrefetchQueue;
+    std::map<uInt,std::vector<char>> its_Prefetched;
+    // The bucket being read by the prefetch thread (-1 = none).
+    Int  its_PrefetchActive;
+    // Must the bucket being read be discarded (because it was written)?
+    Bool its_PrefetchDiscard;
+    // Must the prefetch thread stop?
+    Bool its_PrefetchStop;
+#endif
 
 
     // Copy constructor is not possible.
@@ -387,8 +516,39 @@ private:
     void writeBucket (uInt slotNr);
 
     // Read a bucket.
+    // If it has been read ahead, the prefetched data are used.
     void readBucket (uInt slotNr);
 
+    // Get the buckets into the cache (for getBuckets).
+    void getBucketsInCache (const std::vector<uInt>& bucketNrs,
+                            uInt nthreads);
+
+    // Read the buckets in the given slots in parallel.
+    void readBuckets (const std::vector<uInt>& slotNrs, uInt nthreads);
+
+    // Get the prefetched data of the bucket into its_Buffer.
+    // False is returned if the bucket has not been prefetched.
+    Bool getPrefetched (uInt bucketNr);
+
+    // Discard the prefetched data of a bucket (because it is written).
+    void discardPrefetched (uInt bucketNr);
+
+    // Queue buckets after the given one for prefetching if the access
+    // pattern is sequential.
+    void prefetch (uInt bucketNr);
+
+    // Stop the prefetch thread (if running) and discard all prefetched data.
+    void stopPrefetch();
+
+#if defined(USE_THREADS)
+    // The function run by the prefetch thread.
+    void runPrefetch();
+#endif
+
+    // Get the bucket in the given slot from the owner using the GetLocal
+    // callback function (if defined). It returns False if not possible.
+    Bool getLocalBucket (uInt slotNr);
+
     // Initialize the bucket buffer.
     // The uninitialized buckets before this bucket are also initialized.
     // It returns a pointer to the buffer.
@@ -403,6 +563,21 @@ private:
 inline uInt BucketCache::cacheSize() const
     { return its_CacheSize; }
 
+inline Bool BucketCache::isCached (uInt bucketNr) const
+    { return bucketNr < its_NewNrOfBuckets  &&  its_SlotNr[bucketNr] >= 0; }
+inline uInt BucketCache::nAccess() const
+    { return naccess_p; }
+inline uInt BucketCache::nRead() const
+    { return nread_p; }
+inline uInt BucketCache::nWrite() const
+    { return nwrite_p; }
+inline uInt BucketCache::nInit() const
+    { return ninit_p; }
+inline uInt BucketCache::nEvict() const
+    { return nevict_p; }
+inline uInt BucketCache::prefetchSize() const
+    { return its_PrefetchSize; }
+
 inline Int BucketCache::firstFreeBucket() const
     { return its_FirstFree; }
 
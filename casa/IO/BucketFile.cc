@@ -32,6 +32,8 @@
 #include <casacore/casa/IO/MMapfdIO.h>
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/IO/MFFileIO.h>
+#include <casacore/casa/IO/UringIO.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/Logging/LogIO.h>
@@ -74,7 +76,7 @@ BucketFile::BucketFile (const String& fileName,
       bufSize_p  = 0;
     } else {
       fd_p   = FiledesIO::create (name_p.chars());
-      file_p = new FiledesIO (fd_p, name_p);
+      makeFileIO();
     }
     createMapBuf();
 }
@@ -112,6 +114,24 @@ CountedPtr<ByteIO> BucketFile::makeFilebufIO (uInt bufferSize)
 }
 
 
+void BucketFile::makeFileIO()
+{
+    // Only the unbuffered access can read buckets in a batch.
+    if (!isMapped_p  &&  bufSize_p == 0  &&  useUring()) {
+        file_p = new UringIO (fd_p, name_p);
+    } else {
+        file_p = new FiledesIO (fd_p, name_p);
+    }
+}
+
+Bool BucketFile::useUring()
+{
+    Bool use;
+    AipsrcValue<Bool>::find (use, "bucketfile.iouring", True);
+    return use  &&  UringIO::isAvailable();
+}
+
+
 void BucketFile::close()
 {
     if (file_p) {
@@ -131,7 +151,7 @@ void BucketFile::open()
                                isWritable_p ? ByteIO::Update : ByteIO::Old);
       } else {
         fd_p   = FiledesIO::open (name_p.chars(), isWritable_p);
-        file_p = new FiledesIO (fd_p, name_p);
+        makeFileIO();
       }
       createMapBuf();
     }
@@ -205,6 +225,21 @@ uInt BucketFile::read (void* buffer, uInt length)
   return file_p->read (length, buffer);
 }
 
+uInt BucketFile::pread (void* buffer, uInt length, Int64 offset)
+{
+  return file_p->pread (length, offset, buffer);
+}
+
+void BucketFile::preadBatch (const std::vector<ByteIO::ReadRequest>& requests)
+{
+  file_p->preadBatch (requests);
+}
+
+Bool BucketFile::hasBatchRead() const
+{
+  return file_p  &&  file_p->hasBatchRead();
+}
+
 uInt BucketFile::write (const void* buffer, uInt length)
 {
   file_p->write (length, buffer);
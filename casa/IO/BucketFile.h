@@ -167,6 +167,29 @@ public:
     // Read bytes from the file.
     virtual uInt read (void* buffer, uInt length);
 
+    // Read bytes from the file at the given offset.
+    // The file pointer is not changed. For a plain file (see
+    // <src>canReadAsync</src>) it can be done by another thread while
+    // this thread does other IO on the file.
+    uInt pread (void* buffer, uInt length, Int64 offset);
+
+    // Can <src>pread</src> be used by another thread?
+    // It is the case for a plain file (not part of a MultiFileBase).
+    virtual Bool canReadAsync() const;
+
+    // Read a batch of requests (each at its own offset).
+    // The file pointer is not changed.
+    void preadBatch (const std::vector<ByteIO::ReadRequest>& requests);
+
+    // Does <src>preadBatch</src> submit all requests to the system in one go?
+    // It is the case for an unbuffered plain file if io_uring is available
+    // (see class <linkto class=UringIO>UringIO</linkto>) and not switched
+    // off by the aipsrc variable <src>bucketfile.iouring</src>.
+    virtual Bool hasBatchRead() const;
+
+    // Tell if io_uring is available and not switched off by aipsrc.
+    static Bool useUring();
+
     // Write bytes into the file.
     virtual uInt write (const void* buffer, uInt length);
 
@@ -211,6 +234,9 @@ private:
     // Forbid assignment.
     BucketFile& operator= (const BucketFile&);
 
+    // Create the unbuffered file object for fd_p.
+    void makeFileIO();
+
     // Create the mapped or buffered file object.
     void createMapBuf();
 
@@ -234,6 +260,8 @@ inline Bool BucketFile::isMapped() const
     { return isMapped_p; }
 inline Bool BucketFile::isBuffered() const
     { return bufSize_p>0; }
+inline Bool BucketFile::canReadAsync() const
+    { return mfile_p == 0; }
 
 
 } //# NAMESPACE CASACORE - END
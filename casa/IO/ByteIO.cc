@@ -73,6 +73,18 @@ Int64 ByteIO::pread (Int64 size, Int64 offset, void* buf,
     return r;
 }
 
+void ByteIO::preadBatch (const std::vector<ReadRequest>& requests)
+{
+    for (size_t i=0; i<requests.size(); ++i) {
+        pread (requests[i].size, requests[i].offset, requests[i].buf);
+    }
+}
+
+Bool ByteIO::hasBatchRead() const
+{
+    return False;
+}
+
 void ByteIO::flush()
 {}
 
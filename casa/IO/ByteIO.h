@@ -31,6 +31,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -88,6 +89,14 @@ public:
 	End
     };
 
+    // Define a request to read <src>size</src> bytes at <src>offset</src>
+    // into <src>buf</src> (used by <src>preadBatch</src>).
+    struct ReadRequest {
+        Int64 size;
+        Int64 offset;
+        void* buf;
+    };
+
 
     // The constructor does nothing.
     ByteIO();
@@ -111,6 +120,17 @@ public:
     // The file offset is not changed
     virtual Int64 pread (Int64 size, Int64 offset, void* buf, Bool throwException=True);
 
+    // Do a batch of reads at given offsets. The file offset is not changed.
+    // An exception is thrown if a request could not be read entirely.
+    // The default implementation does a <src>pread</src> per request,
+    // but a derived class can submit all requests to the system in one go
+    // (see <linkto class=UringIO>UringIO</linkto>).
+    virtual void preadBatch (const std::vector<ReadRequest>& requests);
+
+    // Does <src>preadBatch</src> submit the requests in one go?
+    // The default implementation returns False.
+    virtual Bool hasBatchRead() const;
+
     // Reopen the underlying IO stream for read/write access.
     // Nothing will be done if the stream is writable already.
     // Otherwise it will be reopened and an exception will be thrown
@@ -0,0 +1,255 @@
+//# CacheManager.cc: Process-wide memory budget for data caches
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/casa/IO/CacheManager.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+std::atomic<Int64>  CacheManager::theirBudget(-1);
+std::atomic<Int64>  CacheManager::theirTotal(0);
+std::atomic<uInt64> CacheManager::theirUseCounter(1);
+
+// The registered caches and the mutex protecting them.
+// A recursive mutex is used, because releasing memory of a cache can
+// write data, which can cause other caches to allocate memory.
+// They are function statics to be sure they exist when used.
+static std::recursive_mutex& cacheManagerMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+static std::set<CacheClient*>& cacheManagerClients()
+{
+  static std::set<CacheClient*> clients;
+  return clients;
+}
+
+
+CacheClient::CacheClient()
+: itsBytes         (0),
+  itsLastUse       (0),
+  itsReleaseTarget (-1),
+  itsReleasing     (False),
+  itsReleaseMutex  (0)
+{
+  CacheManager::add (this);
+}
+
+CacheClient::CacheClient (const CacheClient&)
+: itsBytes         (0),
+  itsLastUse       (0),
+  itsReleaseTarget (-1),
+  itsReleasing     (False),
+  itsReleaseMutex  (0)
+{
+  CacheManager::add (this);
+}
+
+CacheClient& CacheClient::operator= (const CacheClient&)
+{
+  return *this;
+}
+
+CacheClient::~CacheClient()
+{
+  CacheManager::remove (this);
+}
+
+Bool CacheClient::adjustCacheBytes (Int64 nbytes, Bool force)
+{
+  return CacheManager::adjust (this, nbytes, force);
+}
+
+void CacheClient::setReleaseMutex (std::recursive_mutex* mutex)
+{
+  CacheManager::setReleaseMutex (this, mutex);
+}
+
+void CacheClient::doRelease()
+{
+  Int64 target = itsReleaseTarget.exchange (-1);
+  if (target >= 0) {
+    CacheManager::release (this, target);
+  }
+}
+
+
+Int64 CacheManager::defaultBudget()
+{
+  Int nMiB;
+  AipsrcValue<Int>::find (nMiB, "cachemanager.budget", 0);
+  return (nMiB > 0  ?  Int64(nMiB) * 1024 * 1024 : 0);
+}
+
+Int64 CacheManager::initBudget()
+{
+  Int64 nbytes = defaultBudget();
+  // Do not overwrite a budget set in the meantime.
+  Int64 unset = -1;
+  theirBudget.compare_exchange_strong (unset, nbytes);
+  return theirBudget;
+}
+
+void CacheManager::setBudget (Int64 nbytes)
+{
+  nbytes = std::max (nbytes, Int64(0));
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  theirBudget = nbytes;
+  if (nbytes > 0  &&  theirTotal > nbytes) {
+    makeRoom (0, theirTotal - nbytes);
+  }
+}
+
+Int64 CacheManager::totalBytes()
+{
+  return theirTotal;
+}
+
+uInt CacheManager::nclients()
+{
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  return cacheManagerClients().size();
+}
+
+void CacheManager::add (CacheClient* client)
+{
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  cacheManagerClients().insert (client);
+}
+
+void CacheManager::remove (CacheClient* client)
+{
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  cacheManagerClients().erase (client);
+  theirTotal -= client->itsBytes.exchange (0);
+}
+
+Bool CacheManager::adjust (CacheClient* client, Int64 nbytes, Bool force)
+{
+  if (nbytes > 0) {
+    Int64 maxBytes = budget();
+    if (maxBytes > 0) {
+      std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+      if (theirTotal + nbytes > maxBytes) {
+        makeRoom (client, theirTotal + nbytes - maxBytes);
+        if (theirTotal + nbytes > maxBytes  &&  !force
+            &&  client->itsBytes > 0) {
+          return False;
+        }
+      }
+      client->itsBytes += nbytes;
+      theirTotal += nbytes;
+      return True;
+    }
+  }
+  client->itsBytes += nbytes;
+  theirTotal += nbytes;
+  return True;
+}
+
+void CacheManager::makeRoom (CacheClient* except, Int64 nbytes)
+{
+  // Order the other caches using memory from least to most recently used.
+  std::vector<std::pair<uInt64,CacheClient*>> victims;
+  for (CacheClient* client : cacheManagerClients()) {
+    if (client != except  &&  !client->itsReleasing
+        &&  client->itsBytes > 0) {
+      victims.push_back (std::make_pair(client->itsLastUse.load(), client));
+    }
+  }
+  std::sort (victims.begin(), victims.end());
+  for (const auto& victim : victims) {
+    if (nbytes <= 0) {
+      break;
+    }
+    CacheClient* client = victim.second;
+    Int64 used = client->itsBytes;
+    Int64 target = std::max (used - nbytes, Int64(0));
+    Int64 pending = client->itsReleaseTarget;
+    if (pending >= 0  &&  pending < target) {
+      target = pending;
+    }
+    // A cache can only be released if its owner does not use it, thus if
+    // the mutex its owner holds while using it can be locked. A cache
+    // sharing the mutex of the cache needing memory (e.g., in the same
+    // data manager) is in use by this thread.
+    // Otherwise the release is deferred until the owner uses it again.
+    std::recursive_mutex* mutex = client->itsReleaseMutex;
+    if (mutex != 0  &&  (except == 0  ||  mutex != except->itsReleaseMutex)
+        &&  mutex->try_lock()) {
+      std::lock_guard<std::recursive_mutex> lock(*mutex, std::adopt_lock);
+      client->itsReleaseTarget = -1;
+      release (client, target);
+      nbytes -= used - client->itsBytes;
+    } else {
+      client->itsReleaseTarget = target;
+      nbytes -= used - target;
+    }
+  }
+}
+
+void CacheManager::release (CacheClient* client, Int64 target)
+{
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  // Writing data while releasing can make the same thread make room in
+  // other caches; this cache cannot be used for that.
+  if (client->itsReleasing) {
+    return;
+  }
+  Int64 used = client->itsBytes;
+  client->itsReleasing = True;
+  Int64 remaining;
+  try {
+    remaining = client->releaseCache (target);
+  } catch (...) {
+    client->itsReleasing = False;
+    throw;
+  }
+  client->itsReleasing = False;
+  Int64 freed = used - remaining;
+  if (freed > 0) {
+    client->itsBytes -= freed;
+    theirTotal -= freed;
+  }
+}
+
+void CacheManager::setReleaseMutex (CacheClient* client,
+                                    std::recursive_mutex* mutex)
+{
+  // Locking the manager's mutex waits for a release in progress.
+  std::lock_guard<std::recursive_mutex> lock(cacheManagerMutex());
+  client->itsReleaseMutex = mutex;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,281 @@
+//# CacheManager.h: Process-wide memory budget for data caches
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_CACHEMANAGER_H
+#define CASA_CACHEMANAGER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <atomic>
+#include <mutex>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Base class for a cache whose memory is managed by the CacheManager.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tCacheManager" demos="">
+// </reviewed>
+
+// <prerequisite> 
+//    <li> <linkto class=CacheManager>CacheManager</linkto> class
+// </prerequisite>
+
+// <synopsis> 
+// A cache (like <linkto class=BucketCache>BucketCache</linkto>) derives
+// from this class to take part in the process-wide memory budget kept by
+// the <linkto class=CacheManager>CacheManager</linkto>. The object is
+// registered with the manager on construction and unregistered on
+// destruction.
+// <p>
+// The derived class has to tell the manager how much memory it allocates
+// or frees using <src>adjustCacheBytes</src>. If a cache gets more memory,
+// the manager asks the least recently used other caches to release memory
+// if the budget would be exceeded. For that purpose the derived class has
+// to implement <src>releaseCache</src> and has to call
+// <src>cacheUsed</src> when it is accessed.
+// <br>The manager can only release the memory of another cache if that
+// cache is not in use. For that purpose the owner of the cache (e.g., a
+// data manager) can tell which mutex it holds while using the cache
+// (and the data obtained from it) using <src>setReleaseMutex</src>.
+// If the manager can lock that mutex, the cache is idle and its memory is
+// released immediately. Otherwise (or if no mutex is set) the release is
+// deferred until the owner calls <src>releaseIfRequested</src>, which the
+// derived class should do in its access functions (under the lock its
+// owner holds) before handing out data. In that way a cache never
+// releases memory a thread might be working on. Note that the budget can
+// be exceeded temporarily until such busy caches are used again.
+// </synopsis>
+
+// <motivation> 
+// Keep the memory used by the caches of many open tables and images
+// in a process within a limit.
+// </motivation>
+
+
+class CacheClient
+{
+public:
+    // The cache is registered with the CacheManager.
+    CacheClient();
+
+    // A copy is registered as a new cache without memory.
+    CacheClient (const CacheClient& that);
+
+    // Assignment does not change the registration nor the accounting.
+    CacheClient& operator= (const CacheClient& that);
+
+    // The cache is unregistered. Its memory still accounted for is
+    // subtracted from the total.
+    virtual ~CacheClient();
+
+    // Get the number of bytes accounted for this cache.
+    Int64 cacheBytes() const
+      { return itsBytes; }
+
+    // Set the mutex the owner holds while using the cache or data obtained
+    // from it. It makes it possible to release memory of an idle cache
+    // immediately. A null pointer (the default) means that a release is
+    // always deferred until the cache is used again.
+    // <br>The owner must reset it to a null pointer before destructing
+    // the objects the cache uses when releasing memory.
+    void setReleaseMutex (std::recursive_mutex* mutex);
+
+protected:
+    // Release memory until at most <src>nbytes</src> are used (as far
+    // as possible). The most recently used data must be kept, because a
+    // pointer to it might still be in use.
+    // It returns the number of bytes used thereafter.
+    // <br>The function must not call <src>adjustCacheBytes</src>;
+    // the accounting is done by the manager.
+    virtual Int64 releaseCache (Int64 nbytes) = 0;
+
+    // Tell the manager that the cache uses <src>nbytes</src> more
+    // (or less if negative).
+    // When growing beyond the budget, other caches are asked to release
+    // memory. If that is not sufficient, False is returned and nothing is
+    // accounted, unless <src>force=True</src> or the cache does not use
+    // any memory yet. The cache should then reuse its own memory.
+    Bool adjustCacheBytes (Int64 nbytes, Bool force=False);
+
+    // Mark the cache as used now (for the least recently used ordering).
+    // It is only done if a budget is set.
+    void cacheUsed();
+
+    // Release the memory the manager asked for since the cache was used
+    // last.
+    void releaseIfRequested()
+      { if (itsReleaseTarget.load(std::memory_order_relaxed) >= 0) {
+          doRelease();
+        }
+      }
+
+private:
+    // Release the memory asked for.
+    void doRelease();
+
+    friend class CacheManager;
+
+    std::atomic<Int64>  itsBytes;
+    std::atomic<uInt64> itsLastUse;
+    // The number of bytes to release to (-1 = no release requested).
+    std::atomic<Int64>  itsReleaseTarget;
+    // Is the cache releasing memory? It is protected by the manager's mutex.
+    Bool itsReleasing;
+    // The mutex the owner holds while using the cache.
+    // It is protected by the manager's mutex.
+    std::recursive_mutex* itsReleaseMutex;
+};
+
+
+
+// <summary>
+// Process-wide memory budget for data caches.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tCacheManager" demos="">
+// </reviewed>
+
+// <prerequisite> 
+//    <li> <linkto class=CacheClient>CacheClient</linkto> class
+// </prerequisite>
+
+// <synopsis> 
+// Many caches in casacore (e.g., the bucket caches of the table storage
+// managers, including the tile caches of the tiled storage managers,
+// and the lattice tile caches) size themselves independently.
+// A process opening many tables or images can thereby use far more memory
+// than intended. This class keeps track of the memory used by all caches
+// (derived from <linkto class=CacheClient>CacheClient</linkto>) and can
+// enforce a total budget for them.
+// <p>
+// If a cache needs more memory while the budget would be exceeded, the
+// least recently used other caches release memory (their least recently
+// used items). An idle cache does so immediately, while a cache in use
+// does so when it is used again; meanwhile the cache needing memory has
+// to reuse its own memory. In this way the budget is applied across
+// caches in LRU order.
+// <br>The budget is defined in MiB by the aipsrc variable
+// <src>cachemanager.budget</src>. The default 0 means that no budget is
+// enforced; the memory is only accounted for. It can be changed at any
+// time using <src>setBudget</src>.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    // Use at most 2 GiB for all caches.
+//    CacheManager::setBudget (Int64(2048) * 1024 * 1024);
+//    cout << CacheManager::totalBytes() << " bytes in "
+//         << CacheManager::nclients() << " caches" << endl;
+// </srcblock>
+// </example>
+
+// <motivation> 
+// Long-running services can open hundreds of tables. Without a global
+// budget they either thrash or run out of memory.
+// </motivation>
+
+
+class CacheManager
+{
+public:
+    // Get the budget (in bytes). 0 means no budget.
+    static Int64 budget()
+      { Int64 nbytes = theirBudget.load(std::memory_order_relaxed);
+        return (nbytes >= 0  ?  nbytes : initBudget());
+      }
+
+    // Set the budget (in bytes). 0 means no budget.
+    // If more memory is in use, the caches are asked to release memory.
+    static void setBudget (Int64 nbytes);
+
+    // Get the default budget as defined by the aipsrc variable
+    // <src>cachemanager.budget</src> (in MiB, default 0).
+    static Int64 defaultBudget();
+
+    // Get the total number of bytes used by all caches.
+    static Int64 totalBytes();
+
+    // Get the number of registered caches.
+    static uInt nclients();
+
+private:
+    friend class CacheClient;
+
+    // Read the default budget.
+    static Int64 initBudget();
+
+    // Register or unregister a cache.
+    // <group>
+    static void add (CacheClient* client);
+    static void remove (CacheClient* client);
+    // </group>
+
+    // Adjust the memory of a cache (see CacheClient::adjustCacheBytes).
+    static Bool adjust (CacheClient* client, Int64 nbytes, Bool force);
+
+    // Get the next use counter.
+    static uInt64 nextUse()
+      { return theirUseCounter.fetch_add (1, std::memory_order_relaxed); }
+
+    // Ask the caches, except the given one, to release at least the given
+    // number of bytes in least recently used order. An idle cache (whose
+    // release mutex can be locked) releases immediately, otherwise the
+    // release is done when the cache is used again.
+    // The mutex must have been locked.
+    static void makeRoom (CacheClient* except, Int64 nbytes);
+
+    // Let a cache release memory and do the accounting.
+    static void release (CacheClient* client, Int64 target);
+
+    // Set the release mutex of a cache.
+    static void setReleaseMutex (CacheClient* client,
+                                 std::recursive_mutex* mutex);
+
+    static std::atomic<Int64>  theirBudget;
+    static std::atomic<Int64>  theirTotal;
+    static std::atomic<uInt64> theirUseCounter;
+};
+
+
+inline void CacheClient::cacheUsed()
+{
+    if (CacheManager::budget() > 0) {
+        itsLastUse.store (CacheManager::nextUse(), std::memory_order_relaxed);
+    }
+}
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
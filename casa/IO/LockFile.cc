@@ -254,8 +254,9 @@ void LockFile::getInfo (MemoryIO& info)
     // - thereafter the entire info
     uChar buffer[2048];
     // Read the first part of the file.
-    traceLSEEK (itsLocker.fd(), 0, SEEK_SET);
-    uInt leng = read (itsLocker.fd(), buffer, sizeof(buffer));
+    // Use pread to avoid a seek, because this is done for each lock.
+    Int64 nread = tracePREAD (itsLocker.fd(), buffer, sizeof(buffer), 0);
+    uInt leng = (nread > 0  ?  nread : 0);
     // Extract the request list from it.
     convReqId (buffer, leng);
     // Get the length of the info.
@@ -277,7 +278,8 @@ void LockFile::getInfo (MemoryIO& info)
     if (infoLeng > leng) {
 	infoLeng -= leng;
 	uChar* buf = new uChar[infoLeng];
-	AlwaysAssert (read (itsLocker.fd(), buf, infoLeng) == Int(infoLeng),
+	AlwaysAssert (tracePREAD (itsLocker.fd(), buf, infoLeng,
+                                  SIZEREQID + SIZEINT + leng) == Int(infoLeng),
                       AipsError);
 	info.write (infoLeng, buf);
 	delete [] buf;
@@ -79,26 +79,27 @@ namespace casacore
       prot = PROT_READ | PROT_WRITE;
     }
     // Do mmap of entire file.
-    itsPtr = static_cast<char*>(::mmap (0, itsFileSize, prot, MAP_SHARED,
-                                        fd(), 0));
-    if (itsPtr == MAP_FAILED) {
+    char* ptr = static_cast<char*>(::mmap (0, itsFileSize, prot, MAP_SHARED,
+                                           fd(), 0));
+    if (ptr == MAP_FAILED) {
       throw AipsError ("MMapfdIO::MMapfdIO - mmap of " + fileName() +
                        " failed: " + strerror(errno));
     }
+    // The map is owned by a shared pointer, so it is unmapped when
+    // the last user (e.g., an Array view on the data) releases it.
+    Int64 size = itsFileSize;
+    itsMapping = std::shared_ptr<char> (ptr, [size](char* p)
+                                        { ::munmap (p, size); });
+    itsPtr = ptr;
     // Optimize for sequential access.
     ::madvise (itsPtr, itsFileSize, MADV_SEQUENTIAL);
   }
 
   void MMapfdIO::unmapFile()
   {
-    if (itsPtr != 0) {
-      int res = ::munmap (itsPtr, itsFileSize);
-      if (res != 0) {
-        throw AipsError ("MMapfdIO::unmapFile - munmap of " + fileName() +
-                         " failed: " + strerror(errno));
-      }
-      itsPtr = 0;
-    }
+    // The memory is unmapped when the last reference to it is released.
+    itsMapping.reset();
+    itsPtr = 0;
   }
 
   void MMapfdIO::flush()
@@ -33,6 +33,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/IO/FiledesIO.h>
 #include <casacore/casa/OS/RegularFile.h>
+#include <memory>
 
 namespace casacore
 {
@@ -58,6 +59,12 @@ namespace casacore
 // it will cause a segmentation if the file is readonly. If the file is
 // writable, writing into the mapped data segment means changing the file
 // contents.
+//
+// The mapping itself is reference counted. Function <src>mapping</src>
+// gives a shared pointer to it, which keeps the mapped memory valid
+// after the file has been remapped (because it was extended) or closed.
+// It can be used to make an Array referencing the mapped data without
+// copying it.
 // </synopsis>
 
 class MMapfdIO: public FiledesIO
@@ -119,6 +126,14 @@ public:
   Int64 getFileSize() const
     { return itsFileSize; }
 
+  // Get a shared pointer to the current mapping (an empty one if the
+  // file is not mapped). The mapping is only unmapped when the last
+  // shared pointer to it is released, so a pointer obtained using
+  // <src>getReadPointer</src> stays valid while a copy of the shared
+  // pointer is held, even if the file is remapped or closed.
+  std::shared_ptr<char> mapping() const
+    { return itsMapping; }
+
 protected:
   // Reset the position pointer to the given value. It returns the
   // new position.
@@ -137,6 +152,7 @@ private:
   Int64  itsFileSize;       //# File size
   Int64  itsPosition;       //# Current seek position
   char*  itsPtr;            //# Pointer to memory map
+  std::shared_ptr<char> itsMapping;   //# Owner of the memory map
   Bool   itsIsWritable;
 };
 
@@ -0,0 +1,318 @@
+//# UringIO.cc: Class for unbuffered IO on a file with batched reads
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/UringIO.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <errno.h>                     // needed for errno
+#include <casacore/casa/string.h>               // needed for strerror
+#include <algorithm>
+#include <cstring>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+#ifdef HAVE_IO_URING
+
+// The io_uring submission and completion queue of a UringIO object.
+// It uses the system calls directly (liburing is not needed).
+class UringQueue
+{
+public:
+    // Create the queue with the given number of entries.
+    // An exception is thrown if io_uring cannot be used.
+    explicit UringQueue (uInt nentries);
+
+    ~UringQueue();
+
+    // Get the number of entries in the submission queue.
+    uInt size() const
+      { return itsNEntries; }
+
+    // Submit the reads on the file for the requests in the given range
+    // (at most size() requests) and wait until all have finished.
+    // The result of each read (as from pread) is stored in result.
+    void read (int fd, const std::vector<ByteIO::ReadRequest>& requests,
+               size_t start, size_t end, std::vector<Int64>& result);
+
+private:
+    UringQueue (const UringQueue&);
+    UringQueue& operator= (const UringQueue&);
+
+    // Unmap and close the queue.
+    void cleanup();
+
+    int       itsFd;
+    uInt      itsNEntries;
+    void*     itsSqPtr;
+    size_t    itsSqSize;
+    void*     itsCqPtr;
+    size_t    itsCqSize;
+    io_uring_sqe* itsSqes;
+    size_t    itsSqesSize;
+    unsigned* itsSqTail;
+    unsigned* itsSqMask;
+    unsigned* itsSqArray;
+    unsigned* itsCqHead;
+    unsigned* itsCqTail;
+    unsigned* itsCqMask;
+    io_uring_cqe* itsCqes;
+};
+
+UringQueue::UringQueue (uInt nentries)
+: itsFd     (-1),
+  itsSqPtr  (MAP_FAILED),
+  itsCqPtr  (MAP_FAILED),
+  itsSqes   (0)
+{
+    io_uring_params params;
+    memset (&params, 0, sizeof(params));
+    itsFd = syscall (__NR_io_uring_setup, nentries, &params);
+    if (itsFd < 0) {
+        throw AipsError (String("UringIO: io_uring_setup failed: ") +
+                         strerror(errno));
+    }
+    itsNEntries = params.sq_entries;
+    itsSqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    itsCqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    Bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        itsSqSize = itsCqSize = std::max (itsSqSize, itsCqSize);
+    }
+    itsSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    itsSqPtr = mmap (0, itsSqSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, itsFd, IORING_OFF_SQ_RING);
+    if (itsSqPtr != MAP_FAILED) {
+        itsCqPtr = singleMap  ?  itsSqPtr :
+          mmap (0, itsCqSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, itsFd, IORING_OFF_CQ_RING);
+    }
+    void* sqes = MAP_FAILED;
+    if (itsCqPtr != MAP_FAILED) {
+        sqes = mmap (0, itsSqesSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, itsFd, IORING_OFF_SQES);
+    }
+    if (sqes == MAP_FAILED) {
+        int error = errno;
+        cleanup();
+        throw AipsError (String("UringIO: mmap of io_uring failed: ") +
+                         strerror(error));
+    }
+    itsSqes = static_cast<io_uring_sqe*>(sqes);
+    char* sq = static_cast<char*>(itsSqPtr);
+    char* cq = static_cast<char*>(itsCqPtr);
+    itsSqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    itsSqMask  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    itsSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    itsCqHead  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    itsCqTail  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    itsCqMask  = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    itsCqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+}
+
+UringQueue::~UringQueue()
+{
+    cleanup();
+}
+
+void UringQueue::cleanup()
+{
+    if (itsSqes != 0) {
+        munmap (itsSqes, itsSqesSize);
+        itsSqes = 0;
+    }
+    if (itsCqPtr != MAP_FAILED  &&  itsCqPtr != itsSqPtr) {
+        munmap (itsCqPtr, itsCqSize);
+    }
+    itsCqPtr = MAP_FAILED;
+    if (itsSqPtr != MAP_FAILED) {
+        munmap (itsSqPtr, itsSqSize);
+        itsSqPtr = MAP_FAILED;
+    }
+    if (itsFd >= 0) {
+        close (itsFd);
+        itsFd = -1;
+    }
+}
+
+void UringQueue::read (int fd, const std::vector<ByteIO::ReadRequest>& requests,
+                       size_t start, size_t end, std::vector<Int64>& result)
+{
+    // Fill the submission queue entries.
+    // Only this thread changes the tail, so it can be read directly.
+    unsigned tail = *itsSqTail;
+    unsigned mask = *itsSqMask;
+    for (size_t i=start; i<end; ++i) {
+        unsigned index = tail & mask;
+        io_uring_sqe* sqe = itsSqes + index;
+        memset (sqe, 0, sizeof(io_uring_sqe));
+        sqe->opcode    = IORING_OP_READ;
+        sqe->fd        = fd;
+        sqe->addr      = reinterpret_cast<unsigned long>(requests[i].buf);
+        sqe->len       = requests[i].size;
+        sqe->off       = requests[i].offset;
+        sqe->user_data = i;
+        itsSqArray[index] = index;
+        tail++;
+    }
+    __atomic_store_n (itsSqTail, tail, __ATOMIC_RELEASE);
+    // Submit and wait for all completions.
+    uInt nsubmit = end - start;
+    uInt ndone = 0;
+    while (ndone < end - start) {
+        int nr = syscall (__NR_io_uring_enter, itsFd, nsubmit, 1,
+                          IORING_ENTER_GETEVENTS, 0, 0);
+        if (nr < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw AipsError (String("UringIO: io_uring_enter failed: ") +
+                             strerror(errno));
+        }
+        nsubmit -= std::min (uInt(nr), nsubmit);
+        unsigned head = *itsCqHead;
+        unsigned cqmask = *itsCqMask;
+        while (head != __atomic_load_n (itsCqTail, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe* cqe = itsCqes + (head & cqmask);
+            result[cqe->user_data] = cqe->res;
+            head++;
+            ndone++;
+        }
+        __atomic_store_n (itsCqHead, head, __ATOMIC_RELEASE);
+    }
+}
+
+#else
+
+// Dummy class if io_uring is not available.
+class UringQueue
+{};
+
+#endif
+
+
+UringIO::UringIO (int fd, const String& fileName, uInt queueDepth)
+: FiledesIO     (fd, fileName),
+  itsQueue      (0),
+  itsQueueDepth (std::max (queueDepth, 1u)),
+  itsUseUring   (isAvailable())
+{}
+
+UringIO::~UringIO()
+{
+    delete itsQueue;
+}
+
+Bool UringIO::hasBatchRead() const
+{
+    return itsUseUring;
+}
+
+Bool UringIO::isAvailable()
+{
+#ifdef HAVE_IO_URING
+    static Bool available = []() -> Bool {
+        try {
+            UringQueue queue(1);
+        } catch (const AipsError&) {
+            return False;
+        }
+        return True;
+    }();
+    return available;
+#else
+    return False;
+#endif
+}
+
+void UringIO::preadEach (const std::vector<ReadRequest>& requests,
+                         size_t start, size_t end)
+{
+    for (size_t i=start; i<end; ++i) {
+        pread (requests[i].size, requests[i].offset, requests[i].buf);
+    }
+}
+
+void UringIO::preadBatch (const std::vector<ReadRequest>& requests)
+{
+    if (! isReadable()) {
+        throw AipsError ("UringIO::preadBatch " + fileName()
+                         + " - is not readable");
+    }
+#ifdef HAVE_IO_URING
+    std::lock_guard<std::mutex> lock(itsMutex);
+    if (itsUseUring  &&  itsQueue == 0) {
+        try {
+            itsQueue = new UringQueue (itsQueueDepth);
+        } catch (const AipsError&) {
+            itsUseUring = False;
+        }
+    }
+    // A request must fit in the 32-bit length of a submission entry.
+    Bool fits = True;
+    for (size_t i=0; i<requests.size(); ++i) {
+        if (requests[i].size > 0x7fffffff) {
+            fits = False;
+            break;
+        }
+    }
+    if (itsUseUring  &&  fits  &&  requests.size() > 1) {
+        std::vector<Int64> result(requests.size());
+        for (size_t st=0; st<requests.size(); st+=itsQueue->size()) {
+            size_t end = std::min (requests.size(), st + itsQueue->size());
+            itsQueue->read (fd(), requests, st, end, result);
+        }
+        for (size_t i=0; i<requests.size(); ++i) {
+            const ReadRequest& req = requests[i];
+            if (result[i] == -EINVAL  ||  result[i] == -EOPNOTSUPP) {
+                // The kernel does not support the read operation.
+                itsUseUring = False;
+                preadEach (requests, i, i+1);
+            } else if (result[i] < 0) {
+                throw AipsError ("UringIO::preadBatch " + fileName() +
+                                 " - error returned by system call: " +
+                                 strerror(-result[i]));
+            } else if (result[i] < req.size) {
+                // Read the remainder of a short read.
+                pread (req.size - result[i], req.offset + result[i],
+                       static_cast<char*>(req.buf) + result[i]);
+            }
+        }
+        return;
+    }
+#endif
+    preadEach (requests, 0, requests.size());
+}
+
+
+} //# NAMESPACE CASACORE - END
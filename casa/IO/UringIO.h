@@ -0,0 +1,136 @@
+//# UringIO.h: Class for unbuffered IO on a file with batched reads
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_URINGIO_H
+#define CASA_URINGIO_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/FiledesIO.h>
+#include <mutex>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class UringQueue;
+
+
+// <summary>
+// Class for unbuffered IO on a file with batched reads using io_uring.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tUringIO" demos="">
+// </reviewed>
+
+// <prerequisite> 
+//    <li> <linkto class=FiledesIO>FiledesIO</linkto> class
+// </prerequisite>
+
+// <synopsis> 
+// This class is a specialization of class
+// <linkto class=FiledesIO>FiledesIO</linkto>. It behaves in the same way,
+// but function <src>preadBatch</src> submits all read requests to the
+// kernel in one go using the Linux io_uring interface. In this way a
+// single system call can start many reads, so a fast device (like NVMe)
+// can work on many requests in parallel.
+// <p>
+// The io_uring queue is only created when <src>preadBatch</src> is used
+// for the first time. If io_uring is not available (because casacore is
+// not built on Linux or because the kernel does not support or allow it),
+// <src>preadBatch</src> does a <src>pread</src> per request.
+// Function <src>hasBatchRead</src> tells if io_uring is used.
+// <br>The queue is protected by a mutex, so <src>preadBatch</src> can be
+// used by multiple threads.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    int fd = FiledesIO::open ("file.name");
+//    UringIO fio (fd, "file.name");
+//    // Read two blocks of 1024 bytes in one go.
+//    char buf1[1024], buf2[1024];
+//    std::vector<ByteIO::ReadRequest> requests(2);
+//    requests[0].size = 1024; requests[0].offset = 0; requests[0].buf = buf1;
+//    requests[1].size = 1024; requests[1].offset = 8192; requests[1].buf = buf2;
+//    fio.preadBatch (requests);
+//    FiledesIO::close (fd);
+// </srcblock>
+// </example>
+
+// <motivation> 
+// Reduce the system call overhead when reading many buckets or tiles
+// and let the device reach its queue depth.
+// </motivation>
+
+
+class UringIO: public FiledesIO
+{
+public: 
+    // Construct from the given file descriptor.
+    // The file name is only used in possible error messages.
+    // The queue depth is the maximum number of reads submitted at a time.
+    explicit UringIO (int fd, const String& fileName=String(),
+                      uInt queueDepth=64);
+
+    // The destructor detaches, but does not close the file.
+    virtual ~UringIO();
+
+    // Read the requests using io_uring (if available).
+    // An exception is thrown if a request could not be read entirely.
+    virtual void preadBatch (const std::vector<ReadRequest>& requests);
+
+    // Is io_uring used by <src>preadBatch</src>?
+    virtual Bool hasBatchRead() const;
+
+    // Can io_uring be used on this system?
+    // It is tested once by creating a queue.
+    static Bool isAvailable();
+
+private:
+    // Copy constructor, should not be used.
+    UringIO (const UringIO& that);
+
+    // Assignment, should not be used.
+    UringIO& operator= (const UringIO& that);
+
+    // Read the requests in the given range one by one.
+    void preadEach (const std::vector<ReadRequest>& requests,
+                    size_t start, size_t end);
+
+    //# Data members.
+    UringQueue* itsQueue;
+    uInt        itsQueueDepth;
+    Bool        itsUseUring;
+    std::mutex  itsMutex;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
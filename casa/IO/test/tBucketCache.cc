@@ -40,6 +40,7 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e();
 
 int main (int argc, const char*[])
 {
@@ -54,6 +55,7 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e();
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
 	return 1;
@@ -256,3 +258,57 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+// Check the bucket contents as written by a().
+void checkBucket (BucketCache& cache, Int bucketNr)
+{
+    char* buf = cache.getBucket (bucketNr);
+    Int v1 = (bucketNr<5 ? bucketNr+1 : bucketNr-4);
+    Int v2 = (bucketNr<5 ? bucketNr+1 : bucketNr+5);
+    if (bucketNr >= 105) {
+        v1 = v2 = (bucketNr==110 ? 110 : bucketNr-99);
+    }
+    if (*(Int*)buf != v1  ||  *(Int*)(buf+32760) != v2) {
+	cout << "Error in bucket " << bucketNr << endl;
+    }
+}
+
+void e()
+{
+    // Open the file and read it sequentially using prefetching.
+    BucketFile file("tBucketCache_tmp.data", True);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 4, 0, aToLocal, aFromLocal,
+		       aInitBuffer, aDeleteBuffer);
+    cache.setPrefetch (8);
+    for (Int i=0; i<Int(cache.nBucket()); i++) {
+        checkBucket (cache, i);
+    }
+    // Update a bucket which might have been prefetched and read again.
+    for (Int i=20; i<30; i++) {
+        checkBucket (cache, i);
+    }
+    char* buf = cache.getBucket (33);
+    *(Int*)buf = -1;
+    cache.setDirty();
+    for (Int i=40; i<45; i++) {
+        checkBucket (cache, i);
+    }
+    for (Int i=30; i<40; i++) {
+        buf = cache.getBucket (i);
+        if ((i==33  &&  *(Int*)buf != -1)  ||  (i!=33  &&  *(Int*)buf != i-4)) {
+            cout << "Error in prefetched bucket " << i << endl;
+        }
+    }
+    buf = cache.getBucket (33);
+    *(Int*)buf = 29;
+    cache.setDirty();
+    // Random access still works.
+    for (Int i=0; i<100; i++) {
+        checkBucket (cache, (i*37) % 100);
+    }
+    cache.setPrefetch (0);
+    cout << "checked prefetching of " << cache.nBucket() << " buckets" << endl;
+}
@@ -0,0 +1,334 @@
+//# tCacheManager.cc: Test program for class CacheManager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/CacheManager.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the process-wide cache budget of class CacheManager.
+// </summary>
+
+// A cache containing items of 100 bytes.
+class TestCache : public CacheClient
+{
+public:
+  TestCache() : itsNItem(0) {}
+  // Add items as far as the budget allows. Return the number added.
+  uInt add (uInt nitem)
+  {
+    releaseIfRequested();
+    cacheUsed();
+    uInt nr = 0;
+    while (nr < nitem  &&  adjustCacheBytes (100)) {
+      ++itsNItem;
+      ++nr;
+    }
+    return nr;
+  }
+  void use()
+  {
+    releaseIfRequested();
+    cacheUsed();
+  }
+  void releaseAll()
+  {
+    adjustCacheBytes (-Int64(itsNItem) * 100);
+    itsNItem = 0;
+  }
+  uInt nitem() const
+    { return itsNItem; }
+protected:
+  virtual Int64 releaseCache (Int64 nbytes)
+  {
+    // Keep at least one item (the most recently used).
+    while (itsNItem > 1  &&  Int64(itsNItem) * 100 > nbytes) {
+      --itsNItem;
+    }
+    return Int64(itsNItem) * 100;
+  }
+private:
+  uInt itsNItem;
+};
+
+void testAccounting()
+{
+  // Without budget everything is accounted for.
+  CacheManager::setBudget (0);
+  Int64 total = CacheManager::totalBytes();
+  uInt nclient = CacheManager::nclients();
+  {
+    TestCache c1, c2;
+    AlwaysAssertExit (CacheManager::nclients() == nclient + 2);
+    AlwaysAssertExit (c1.add(10) == 10);
+    AlwaysAssertExit (c2.add(5) == 5);
+    AlwaysAssertExit (c1.cacheBytes() == 1000);
+    AlwaysAssertExit (CacheManager::totalBytes() == total + 1500);
+    c2.releaseAll();
+    AlwaysAssertExit (CacheManager::totalBytes() == total + 1000);
+  }
+  // The destructor removes the memory still accounted.
+  AlwaysAssertExit (CacheManager::nclients() == nclient);
+  AlwaysAssertExit (CacheManager::totalBytes() == total);
+}
+
+void testBudget()
+{
+  Int64 total = CacheManager::totalBytes();
+  CacheManager::setBudget (total + 1000);
+  TestCache c1, c2, c3;
+  AlwaysAssertExit (c1.add(4) == 4);
+  AlwaysAssertExit (c2.add(4) == 4);
+  c1.use();
+  // c2 is least recently used, so it is asked to release memory.
+  // It only does so when it is used again, so c3 cannot grow meanwhile.
+  AlwaysAssertExit (c3.add(4) == 2);
+  AlwaysAssertExit (c1.nitem() == 4);
+  AlwaysAssertExit (c2.nitem() == 4);
+  c2.use();
+  AlwaysAssertExit (c2.nitem() == 3);
+  AlwaysAssertExit (c2.cacheBytes() == 300);
+  AlwaysAssertExit (c3.add(1) == 1);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 1000);
+  // Thereafter c1 is least recently used.
+  AlwaysAssertExit (c3.add(2) == 0);
+  AlwaysAssertExit (c1.nitem() == 4);
+  c1.use();
+  AlwaysAssertExit (c1.nitem() == 3);
+  AlwaysAssertExit (c3.add(10) == 1);
+  AlwaysAssertExit (c3.nitem() == 4);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 1000);
+  // A smaller budget asks the least recently used caches to release
+  // memory. c2 keeps its last item, so c1 is asked as well.
+  CacheManager::setBudget (total + 500);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 1000);
+  c2.use();
+  c1.use();
+  AlwaysAssertExit (c1.nitem() == 1  &&  c2.nitem() == 1);
+  AlwaysAssertExit (c3.nitem() == 4);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 600);
+  CacheManager::setBudget (0);
+}
+
+void testIdle()
+{
+  Int64 total = CacheManager::totalBytes();
+  CacheManager::setBudget (total + 1000);
+  std::recursive_mutex mutex1, mutex2;
+  TestCache c1, c2;
+  c1.setReleaseMutex (&mutex1);
+  c2.setReleaseMutex (&mutex2);
+  AlwaysAssertExit (c1.add(10) == 10);
+  // c1 is idle, so it releases memory immediately.
+  AlwaysAssertExit (c2.add(4) == 4);
+  AlwaysAssertExit (c1.nitem() == 6);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 1000);
+  // c2 is in use (by another thread), so its release is deferred.
+  std::atomic<Bool> locked(False), done(False);
+  std::thread thr([&]() {
+      std::lock_guard<std::recursive_mutex> lock(mutex2);
+      locked = True;
+      while (!done) {
+        std::this_thread::yield();
+      }
+    });
+  while (!locked) {
+    std::this_thread::yield();
+  }
+  AlwaysAssertExit (c1.add(2) == 0);
+  AlwaysAssertExit (c2.nitem() == 4);
+  done = True;
+  thr.join();
+  c2.use();
+  AlwaysAssertExit (c2.nitem() == 3);
+  AlwaysAssertExit (c1.add(2) == 2);
+  AlwaysAssertExit (c1.nitem() == 8  &&  c2.nitem() == 2);
+  // A smaller budget releases memory of idle caches immediately.
+  // c2 keeps its last item, so c1 releases as well.
+  CacheManager::setBudget (total + 500);
+  AlwaysAssertExit (c1.nitem() == 4  &&  c2.nitem() == 1);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 500);
+  // Without a release mutex, the release is deferred again.
+  c1.setReleaseMutex (0);
+  CacheManager::setBudget (total + 1000);
+  AlwaysAssertExit (c2.add(10) == 5);
+  CacheManager::setBudget (total + 500);
+  AlwaysAssertExit (c1.nitem() == 4  &&  c2.nitem() == 5);
+  c1.use();
+  AlwaysAssertExit (c1.nitem() == 1);
+  CacheManager::setBudget (0);
+}
+
+void testThreads()
+{
+  Int64 total = CacheManager::totalBytes();
+  CacheManager::setBudget (total + 1000);
+  TestCache c1, c2;
+  // Fill c1 in another thread, so it can only release memory
+  // when it is used again.
+  std::thread thr([&c1]() { c1.add(10); });
+  thr.join();
+  AlwaysAssertExit (c1.nitem() == 10);
+  AlwaysAssertExit (c2.add(1) == 1);
+  AlwaysAssertExit (c2.add(1) == 0);
+  AlwaysAssertExit (c1.nitem() == 10);
+  c1.use();
+  AlwaysAssertExit (c1.nitem() == 8);
+  AlwaysAssertExit (c2.add(1) == 1);
+  CacheManager::setBudget (0);
+}
+
+// Callbacks for the BucketCache.
+char* toLocal (void*, const char* data)
+{
+  char* ptr = new char[1024];
+  memcpy (ptr, data, 1024);
+  return ptr;
+}
+void fromLocal (void*, char* data, const char* local)
+{
+  memcpy (data, local, 1024);
+}
+char* initBuffer (void*)
+{
+  char* ptr = new char[1024];
+  memset (ptr, 0, 1024);
+  return ptr;
+}
+void deleteBuffer (void*, char* buffer)
+{
+  delete [] buffer;
+}
+
+void testBucketCache()
+{
+  {
+    BucketFile file ("tCacheManager_tmp.data");
+    file.open();
+    BucketCache cache (&file, 0, 1024, 20, 20, 0, toLocal, fromLocal,
+                       initBuffer, deleteBuffer);
+    for (uInt i=0; i<20; ++i) {
+      char* buf = cache.getBucket (i);
+      *(Int*)buf = i;
+      cache.setDirty();
+    }
+    AlwaysAssertExit (cache.cacheBytes() == 20*1024);
+    cache.flush();
+  }
+  Int64 total = CacheManager::totalBytes();
+  CacheManager::setBudget (total + 8*1024);
+  BucketFile file ("tCacheManager_tmp.data", True);
+  file.open();
+  BucketCache cache1 (&file, 0, 1024, 20, 20, 0, toLocal, fromLocal,
+                      initBuffer, deleteBuffer);
+  BucketCache cache2 (&file, 0, 1024, 20, 20, 0, toLocal, fromLocal,
+                      initBuffer, deleteBuffer);
+  std::recursive_mutex mutex1, mutex2;
+  cache1.setReleaseMutex (&mutex1);
+  cache2.setReleaseMutex (&mutex2);
+  // The cache cannot use more slots than the budget allows.
+  for (uInt j=0; j<2; ++j) {
+    for (uInt i=0; i<20; ++i) {
+      AlwaysAssertExit (*(Int*)(cache1.getBucket(i)) == Int(i));
+    }
+  }
+  AlwaysAssertExit (cache1.cacheBytes() == 8*1024);
+  AlwaysAssertExit (cache1.nRead() == 40);
+  // Using the other cache releases buckets of the first one, which is
+  // done immediately because it is idle.
+  for (uInt i=0; i<6; ++i) {
+    AlwaysAssertExit (*(Int*)(cache2.getBucket(i)) == Int(i));
+  }
+  AlwaysAssertExit (cache2.cacheBytes() == 6*1024);
+  AlwaysAssertExit (cache1.cacheBytes() == 2*1024);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 8*1024);
+  // The most recently used buckets have been kept.
+  AlwaysAssertExit (cache1.isCached(19)  &&  cache1.isCached(18));
+  AlwaysAssertExit (*(Int*)(cache1.getBucket(19)) == 19);
+  // If the other cache is in use, it releases when used again.
+  // Meanwhile this cache has to reuse its own memory.
+  std::atomic<Bool> locked(False), done(False);
+  std::thread thr([&]() {
+      std::lock_guard<std::recursive_mutex> lock(mutex2);
+      locked = True;
+      while (!done) {
+        std::this_thread::yield();
+      }
+    });
+  while (!locked) {
+    std::this_thread::yield();
+  }
+  AlwaysAssertExit (*(Int*)(cache1.getBucket(3)) == 3);
+  AlwaysAssertExit (cache1.cacheBytes() == 2*1024);
+  AlwaysAssertExit (cache2.cacheBytes() == 6*1024);
+  done = True;
+  thr.join();
+  // The deferred release is done when cache2 is used again.
+  AlwaysAssertExit (*(Int*)(cache2.getBucket(5)) == 5);
+  AlwaysAssertExit (cache2.cacheBytes() == 5*1024);
+  AlwaysAssertExit (*(Int*)(cache1.getBucket(4)) == 4);
+  AlwaysAssertExit (cache1.cacheBytes() == 3*1024);
+  AlwaysAssertExit (CacheManager::totalBytes() == total + 8*1024);
+  // getBuckets can exceed the budget, because all buckets are needed.
+  std::vector<uInt> bucketNrs;
+  std::vector<char*> data;
+  for (uInt i=0; i<12; ++i) {
+    bucketNrs.push_back (i+5);
+  }
+  AlwaysAssertExit (cache1.getBuckets (bucketNrs, data, 1));
+  for (uInt i=0; i<12; ++i) {
+    AlwaysAssertExit (*(Int*)(data[i]) == Int(i+5));
+  }
+  AlwaysAssertExit (cache1.cacheBytes() >= 12*1024);
+  CacheManager::setBudget (0);
+}
+
+int main()
+{
+  try {
+    testAccounting();
+    testBudget();
+    testIdle();
+    testThreads();
+    testBucketCache();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,112 @@
+//# tUringIO.cc: Test program for class UringIO
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/UringIO.h>
+#include <casacore/casa/IO/FiledesIO.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the batched reads of class UringIO.
+// The output is the same whether io_uring is available or not.
+// </summary>
+
+// Check a batch of reads of the given length at some offsets.
+void checkBatch (UringIO& fio, Int nreq, Int length)
+{
+  std::vector<std::vector<Int>> bufs(nreq, std::vector<Int>(length));
+  std::vector<ByteIO::ReadRequest> requests(nreq);
+  for (Int i=0; i<nreq; ++i) {
+    requests[i].size   = length * sizeof(Int);
+    requests[i].offset = ((i*37) % 1000) * sizeof(Int);
+    requests[i].buf    = bufs[i].data();
+  }
+  fio.preadBatch (requests);
+  for (Int i=0; i<nreq; ++i) {
+    for (Int j=0; j<length; ++j) {
+      AlwaysAssertExit (bufs[i][j] == (i*37)%1000 + j);
+    }
+  }
+}
+
+int main()
+{
+  try {
+    // Write a file with 2000 integers.
+    {
+      int fd = FiledesIO::create ("tUringIO_tmp.dat");
+      FiledesIO fio (fd, "tUringIO_tmp.dat");
+      std::vector<Int> vals(2000);
+      for (Int i=0; i<2000; ++i) {
+        vals[i] = i;
+      }
+      fio.write (vals.size() * sizeof(Int), vals.data());
+      FiledesIO::close (fd);
+    }
+    int fd = FiledesIO::open ("tUringIO_tmp.dat");
+    {
+      // Use a small queue to test that large batches are split.
+      UringIO fio (fd, "tUringIO_tmp.dat", 4);
+      AlwaysAssertExit (fio.hasBatchRead() == UringIO::isAvailable());
+      checkBatch (fio, 0, 10);
+      checkBatch (fio, 1, 10);
+      checkBatch (fio, 3, 1);
+      checkBatch (fio, 50, 100);
+      // Ordinary reads should still work.
+      Int val;
+      fio.seek (8, ByteIO::Begin);
+      fio.read (sizeof(Int), &val);
+      AlwaysAssertExit (val == 2);
+      // Reading past the end of the file must fail.
+      std::vector<Int> buf(20);
+      std::vector<ByteIO::ReadRequest> requests(2);
+      requests[0].size = 10*sizeof(Int);
+      requests[0].offset = 0;
+      requests[0].buf = buf.data();
+      requests[1].size = 10*sizeof(Int);
+      requests[1].offset = 1995*sizeof(Int);
+      requests[1].buf = buf.data() + 10;
+      Bool failed = False;
+      try {
+        fio.preadBatch (requests);
+      } catch (const AipsError& x) {
+        failed = True;
+      }
+      AlwaysAssertExit (failed);
+    }
+    FiledesIO::close (fd);
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
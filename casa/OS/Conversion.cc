@@ -124,14 +124,9 @@ void Conversion::boolToBit (void* to, const void* from,
 	}
     }
     //# Set the bits in all 'full' bytes.
-    for (size_t i=startByte; i<endByte; ++i) {
-	unsigned char& ch = bits[i];
-	ch = 0;
-	for (size_t j=0; j<8; ++j) {
-	    if (*data++) {
-                ch |= (1<<j);
-	    }
-	}
+    if (endByte > startByte) {
+        boolToBit (bits + startByte, data, 8 * (endByte - startByte));
+        data += 8 * (endByte - startByte);
     }
     //# Set the bits in the last byte (if needed).
     if (endBit2 > 0) {
@@ -448,30 +443,47 @@ static m64d_t conv_tab[256] __attribute__ ((aligned (8))) = {
 size_t Conversion::bitToBool (void* to, const void* from,
                               size_t nvalues)
 {
-    if (sizeof(Bool) != sizeof(char)  ||  (7 & (unsigned long long)to)) {
+    if (sizeof(Bool) != sizeof(char)) {
 	return bitToBool_ (to, from, nvalues);
     }
-#ifdef __clang__
-    uint64_t* __attribute__ ((aligned (8))) data = (uint64_t *)to;
-#else
-    uint64_t* __attribute__ ((aligned (8))) data =
- 	(uint64_t __attribute__ ((aligned (8)))*)to;
-#endif
+    Bool* data = (Bool*)to;
     const uint8_t* bits = (const uint8_t*)from;
-    const size_t bits_per_loop = 8;
-    const size_t nwords = nvalues / bits_per_loop;
+    const size_t nbytes = nvalues / 8;
+    size_t done = 0;
+#ifdef __SSE2__
+    // Expand 2 bytes (16 bits) per iteration. Each byte is replicated 8 times
+    // after which each copy is masked with its bit and compared to it.
+    // The resulting 0xFF bytes are converted to True.
+    // Unaligned loads and stores are used, so 'to' can have any alignment.
+    const __m128i mask = _mm_set_epi8 (-128, 64, 32, 16, 8, 4, 2, 1,
+                                       -128, 64, 32, 16, 8, 4, 2, 1);
+    const __m128i one  = _mm_set1_epi8 (1);
+    const Int64 nwords = nbytes / 2;
 #ifdef _OPENMP
     size_t nthr =
         std::max((size_t)1,
-                 std::min((size_t)omp_get_max_threads(), nwords / (16 * 1024)));
+                 std::min((size_t)omp_get_max_threads(),
+                          (size_t)nwords / (16 * 1024)));
 # pragma omp parallel for if (nwords >= 32 * 1024) num_threads(nthr)
 #endif
-    for (size_t i = 0; i < nwords; ++i) {
-        data[i] = conv_tab[bits[i]].d;
+    for (Int64 i = 0; i < nwords; ++i) {
+        uint16_t word;
+        memcpy (&word, &bits[2*i], 2);
+        __m128i v = _mm_cvtsi32_si128 (word);
+        v = _mm_unpacklo_epi8 (v, v);
+        v = _mm_unpacklo_epi16 (v, v);
+        v = _mm_unpacklo_epi32 (v, v);
+        v = _mm_cmpeq_epi8 (_mm_and_si128 (v, mask), mask);
+        _mm_storeu_si128 ((__m128i*)&data[16*i], _mm_and_si128 (v, one));
+    }
+    done = 2 * nwords;
+#endif
+    // Use the lookup table for the remaining full bytes.
+    for (size_t i = done; i < nbytes; ++i) {
+        memcpy (&data[8*i], conv_tab[bits[i]].b, 8);
     }
-    return nwords * (bits_per_loop / 8)
-	+ bitToBool_ (&data[nwords], &bits[nwords],
-                      nvalues - (nwords * bits_per_loop));
+    return nbytes + bitToBool_ (&data[8*nbytes], &bits[nbytes],
+                                nvalues - 8*nbytes);
 }
 
 void Conversion::bitToBool (void* to, const void* from,
@@ -499,12 +511,10 @@ void Conversion::bitToBool (void* to, const void* from,
             *data++ = (ch & (1<<j));
 	}
     }
-    //# Set the bits in all 'full' bytes.
-    for (size_t i=startByte; i<endByte; ++i) {
-	int ch = bits[i];
-	for (size_t j=0; j<8; ++j) {
-            *data++ = (ch & (1<<j));
-	}
+    //# Get the bits in all 'full' bytes.
+    if (endByte > startByte) {
+        bitToBool (data, bits + startByte, 8 * (endByte - startByte));
+        data += 8 * (endByte - startByte);
     }
     //# Get the bits in the last byte (if needed).
     if (endBit2 > 0) {
@@ -31,6 +31,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <cstring>
 
 
 #include <casacore/casa/namespace.h>
@@ -70,6 +71,54 @@ void checkAll()
   }
 }
 
+// Check the conversions for all alignments, start bits and lengths
+// against a straightforward implementation.
+void checkUnaligned()
+{
+  cout << "checkUnaligned ..." << endl;
+  const uInt maxnr = 300;
+  uChar bits[maxnr/8 + 8];
+  uChar out[maxnr/8 + 8];
+  Bool flagArr[maxnr + 16];
+  uInt seed = 1;
+  for (uInt i=0; i<sizeof(bits); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    bits[i] = seed >> 16;
+  }
+  for (uInt align=0; align<8; ++align) {
+    Bool* flags = flagArr + align;
+    for (uInt nr=0; nr<=maxnr; nr+=7) {
+      AlwaysAssertExit (Conversion::bitToBool (flags, bits, nr) ==
+                        (nr+7)/8);
+      for (uInt i=0; i<nr; ++i) {
+        AlwaysAssertExit (flags[i] == ((bits[i/8] & (1<<(i%8))) != 0));
+      }
+      memset (out, 0, sizeof(out));
+      AlwaysAssertExit (Conversion::boolToBit (out, flags, nr) == (nr+7)/8);
+      for (uInt i=0; i<nr/8; ++i) {
+        AlwaysAssertExit (out[i] == bits[i]);
+      }
+      for (uInt st=0; st<10; ++st) {
+        Conversion::bitToBool (flags, bits, st, nr);
+        for (uInt i=0; i<nr; ++i) {
+          uInt b = st+i;
+          AlwaysAssertExit (flags[i] == ((bits[b/8] & (1<<(b%8))) != 0));
+        }
+        memset (out, 0xff, sizeof(out));
+        Conversion::boolToBit (out, flags, st, nr);
+        for (uInt i=0; i<st+nr+8; ++i) {
+          Bool set = (out[i/8] & (1<<(i%8))) != 0;
+          if (i < st  ||  i >= st+nr) {
+            AlwaysAssertExit (set);
+          } else {
+            AlwaysAssertExit (set == ((bits[i/8] & (1<<(i%8))) != 0));
+          }
+        }
+      }
+    }
+  }
+}
+
 int main()
 {
     uInt nbool = 100;
@@ -155,6 +204,7 @@ int main()
     delete [] bits;
 
     checkAll();
+    checkUnaligned();
     cout << "OK" << endl;
     return 0;
 }
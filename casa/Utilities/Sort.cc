@@ -34,6 +34,7 @@
 ///#include <casacore/casa/Containers/BlockIO.h>
 
 #include <casacore/casa/stdlib.h>                 // for rand
+#include <cstring>
 #ifdef _OPENMP
 # include <omp.h>
 #endif
@@ -261,6 +262,127 @@ void Sort::addKey (SortKey* key)
 }
 
 
+// Get the size of a data type that can be used in a radix sort.
+// It returns 0 if the data type cannot be used.
+static uInt radixKeySize (DataType dtype)
+{
+    switch (dtype) {
+    case TpBool:
+    case TpChar:
+    case TpUChar:
+        return 1;
+    case TpShort:
+    case TpUShort:
+        return 2;
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+        return 4;
+    case TpInt64:
+    case TpDouble:
+        return 8;
+    default:
+        break;
+    }
+    return 0;
+}
+
+// Convert a value to an unsigned integer with the same ordering.
+// For signed types the sign bit is flipped. For floating point types
+// all bits are flipped for negative values; -0 is made equal to +0.
+static uInt64 radixKeyValue (const void* data, DataType dtype)
+{
+    switch (dtype) {
+    case TpBool:
+        return *static_cast<const Bool*>(data) ? 1 : 0;
+    case TpChar:
+        return uChar(*static_cast<const Char*>(data)) ^ 0x80u;
+    case TpUChar:
+        return *static_cast<const uChar*>(data);
+    case TpShort:
+        return uShort(*static_cast<const Short*>(data)) ^ 0x8000u;
+    case TpUShort:
+        return *static_cast<const uShort*>(data);
+    case TpInt:
+        return uInt(*static_cast<const Int*>(data)) ^ 0x80000000u;
+    case TpUInt:
+        return *static_cast<const uInt*>(data);
+    case TpInt64:
+        return uInt64(*static_cast<const Int64*>(data)) ^
+               (uInt64(1) << 63);
+    case TpFloat:
+      {
+        Float v = *static_cast<const Float*>(data);
+        if (v == 0) v = 0;
+        uInt bits;
+        memcpy (&bits, &v, sizeof(bits));
+        return (bits & 0x80000000u)  ?  uInt(~bits) : (bits | 0x80000000u);
+      }
+    case TpDouble:
+      {
+        Double v = *static_cast<const Double*>(data);
+        if (v == 0) v = 0;
+        uInt64 bits;
+        memcpy (&bits, &v, sizeof(bits));
+        uInt64 sign = uInt64(1) << 63;
+        return (bits & sign)  ?  ~bits : (bits | sign);
+      }
+    default:
+        break;
+    }
+    return 0;
+}
+
+uInt Sort::radixKeyWords() const
+{
+    // A key is not split over words, so the next word is used if
+    // it does not fit in the current one.
+    uInt nbits = 0;
+    for (size_t i=0; i<nrkey_p; i++) {
+        uInt sz = radixKeySize (keys_p[i]->cmpObj_p->dataType());
+        if (sz == 0) {
+            return 0;
+        }
+        if (nbits%64 + 8*sz > 64) {
+            nbits += 64 - nbits%64;
+        }
+        nbits += 8*sz;
+    }
+    return (nbits + 63) / 64;
+}
+
+void Sort::fillRadixKeys (uInt64* keys, uInt nwords,
+                          uInt64 start, uInt64 nrrec) const
+{
+    for (uInt64 j=0; j<nrrec; j++) {
+        uInt64* key = keys + j*nwords;
+        for (uInt w=0; w<nwords; w++) {
+            key[w] = 0;
+        }
+        uInt nbits = 0;
+        for (size_t i=0; i<nrkey_p; i++) {
+            const SortKey* skp = keys_p[i];
+            DataType dtype = skp->cmpObj_p->dataType();
+            uInt sz = 8 * radixKeySize (dtype);
+            if (nbits%64 + sz > 64) {
+                nbits += 64 - nbits%64;
+            }
+            uInt64 value = radixKeyValue
+              ((const char*)skp->data_p + (start+j)*skp->incr_p, dtype);
+            // Complement descending keys if the order is mixed.
+            if (order_p == 0  &&  skp->order_p == Descending) {
+                value = ~value;
+                if (sz < 64) {
+                    value &= (uInt64(1) << sz) - 1;
+                }
+            }
+            key[nbits/64] |= value << (64 - nbits%64 - sz);
+            nbits += sz;
+        }
+    }
+}
+
+
 uInt Sort::sort (Vector<uInt>& indexVector, uInt nrrec,
                  int options, Bool tryGenSort) const
   { return doSort (indexVector, nrrec, options, tryGenSort); }
@@ -141,9 +141,25 @@ protected:
 //  <DT> <src>Sort::HeapSort</src>
 //  <DD> Heapsort has O(n*log(n)) behaviour. Its speed is lower than
 //       that of QuickSort, so QuickSort is the default algorithm.
+//  <DT> <src>Sort::RadixSort</src>
+//  <DD> A (parallel) LSD radix sort has O(n) behaviour. It can only be
+//       used if all keys are standard numeric data types (Bool, integer,
+//       float or double) compared with the default comparison objects
+//       (i.e., ObjCompare created from the data type). The keys of a record
+//       are packed into a composite integer key, on which the radix sort
+//       is done. Byte positions having the same value for all records
+//       (e.g., the high bytes of an antenna number) are skipped.
+//       It needs extra memory for the packed keys and a second index array
+//       (about 2*8 bytes per key word plus the size of an index per record).
+//       Therefore it is only used if explicitly asked for.
+//       If the keys cannot be used, the default algorithm is used instead.
+//       <br>Note that NaN values have a defined order in the radix sort:
+//       a NaN sorts after +infinity (or before -infinity if its sign bit
+//       is set). The other algorithms compare a NaN as equal to any value,
+//       so its position is undefined. Furthermore -0 and 0 are equal.
 // </DL>
 // The default is to use QuickSort for small arrays or if only a single
-// thread can be used. Otherwise ParSort is the default.
+// thread can be used, and ParSort for the others.
 // 
 // All sort algorithms are <em>stable</em>, which means that the original
 // order is kept when keys are equal.
@@ -253,7 +269,8 @@ public:
                  InsSort=2,         // use insertion sort algorithm
                  QuickSort=4,       // use Quicksort algorithm
                  ParSort=8,         // use parallel merge sort algorithm
-                 NoDuplicates=16};  // skip data with equal sort keys
+                 NoDuplicates=16,   // skip data with equal sort keys
+                 RadixSort=32};     // use (parallel) radix sort if possible
 
     // Enumerate the sort order:
     enum Order {Ascending=-1,
@@ -401,6 +418,23 @@ private:
     void merge (T* inx, T* tmp, T size, T* index,
                 T nparts) const;
 
+    // Do a radix sort on the packed keys, if possible in parallel.
+    // The index array must be filled with 0..nrrec-1.
+    template<typename T>
+    T radixSort (int nthr, T nrrec, T* inx) const;
+
+    // Get the number of 64-bit words needed for the packed radix keys
+    // of a record. It returns 0 if a radix sort cannot be done on the keys.
+    uInt radixKeyWords() const;
+
+    // Fill the packed radix keys of <src>nrrec</src> records starting
+    // at record <src>start</src>. The most significant word comes first.
+    // Each packed key sorts ascending as unsigned integer words.
+    // Descending keys are complemented unless all keys are descending,
+    // in which case the result of the ascending sort is reversed.
+    void fillRadixKeys (uInt64* keys, uInt nwords,
+                        uInt64 start, uInt64 nrrec) const;
+
     // Do a quicksort, optionally skipping duplicates
     // (qkSort is the actual quicksort function).
     // <group>
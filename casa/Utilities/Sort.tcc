@@ -33,6 +33,8 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/SortError.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <algorithm>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -70,6 +72,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Do not use more threads than there are values.
     if (uInt(nthr) > nrrec) nthr = nrrec;
 #endif
+    if (type == RadixSort  &&  radixKeyWords() == 0) {
+      type = DefaultSort;
+    }
     if (type == DefaultSort) {
       type = (nrrec<1000 || nthr==1  ?  QuickSort : ParSort);
     }
@@ -102,6 +107,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         n = insSortNoDup (nrrec, inx);
       }
       break;
+    case RadixSort:
+      n = radixSort (nthr, nrrec, inx);
+      if (nodup) {
+        n = insSortNoDup (nrrec, inx);
+      }
+      break;
     default:
       throw SortInvOpt();
     }
@@ -280,6 +291,93 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  template<typename T>
+  T Sort::radixSort (int nthr, T nrrec, T* inx) const
+  {
+    uInt nw = radixKeyWords();
+    // Both the packed keys and the indices are moved in each pass,
+    // so the keys are read sequentially.
+    std::vector<uInt64> keyBuf1(nrrec*nw);
+    std::vector<uInt64> keyBuf2(nrrec*nw);
+    Block<T> inxtmp(nrrec);
+    // Divide the records in a part per thread.
+    T step = (nrrec + nthr - 1) / nthr;
+    Block<T> tinx(nthr+1);
+    for (int i=0; i<nthr; ++i) tinx[i] = std::min(T(i*step), nrrec);
+    tinx[nthr] = nrrec;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nthr; ++i) {
+      fillRadixKeys (keyBuf1.data() + tinx[i]*nw, nw,
+                     tinx[i], tinx[i+1]-tinx[i]);
+    }
+    uInt64* keys = keyBuf1.data();
+    uInt64* keysTo = keyBuf2.data();
+    T* inxFrom = inx;
+    T* inxTo = inxtmp.storage();
+    // Each thread counts the digits in its part. Thereafter the offsets
+    // are determined such that the parts are stored in order, thus the
+    // sort is stable.
+    Block<T> counts(nthr*256);
+    for (Int w=nw-1; w>=0; --w) {
+      for (uInt shift=0; shift<64; shift+=8) {
+        counts = 0;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<nthr; ++i) {
+          T* cnt = counts.storage() + i*256;
+          for (T j=tinx[i]; j<tinx[i+1]; ++j) {
+            cnt[(keys[j*nw+w] >> shift) & 255]++;
+          }
+        }
+        // Skip the pass if all records have the same digit.
+        Bool skip = False;
+        for (uInt d=0; d<256  &&  !skip; ++d) {
+          T nd = 0;
+          for (int i=0; i<nthr; ++i) nd += counts[i*256+d];
+          skip = (nd == nrrec);
+        }
+        if (skip) {
+          continue;
+        }
+        T offset = 0;
+        for (uInt d=0; d<256; ++d) {
+          for (int i=0; i<nthr; ++i) {
+            T nd = counts[i*256+d];
+            counts[i*256+d] = offset;
+            offset += nd;
+          }
+        }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<nthr; ++i) {
+          T* offs = counts.storage() + i*256;
+          for (T j=tinx[i]; j<tinx[i+1]; ++j) {
+            const uInt64* key = keys + j*nw;
+            T k = offs[(key[w] >> shift) & 255]++;
+            for (uInt p=0; p<nw; ++p) keysTo[k*nw+p] = key[p];
+            inxTo[k] = inxFrom[j];
+          }
+        }
+        std::swap (keys, keysTo);
+        std::swap (inxFrom, inxTo);
+      }
+    }
+    // If final result happens to be in incorrect array, copy it over.
+    if (inxFrom != inx) {
+      objcopy (inx, inxFrom, nrrec);
+    }
+    // If all keys are descending, equal keys have to be in descending
+    // index order as well (as done by compare), so reverse the result.
+    if (order_p == Descending) {
+      std::reverse (inx, inx+nrrec);
+    }
+    return nrrec;
+  }
+
   template<typename T>
   T Sort::insSort (T nrrec, T* inx) const
   {
@@ -29,6 +29,7 @@
 
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/stdlib.h>
 #include <casacore/casa/iostream.h>
@@ -284,12 +285,58 @@ void sort_test_unique()
     cout << endl;
 }
 
+// Test that the radix sort on keys of various types gives the same result
+// as the quicksort. When skipping duplicates, it is compared with the
+// parallel merge sort, because both keep the first record of equal keys.
+// Values are chosen such that many keys are equal.
+void sort_test_radix (Sort::Order order1, Sort::Order order2)
+{
+    const uInt nrdata = 5000;
+    Vector<Double> dData(nrdata);
+    Vector<Float> fData(nrdata);
+    Vector<Short> sData(nrdata);
+    Vector<Bool> bData(nrdata);
+    Vector<Int64> lData(nrdata);
+    for (uInt i=0; i<nrdata; i++) {
+      dData[i] = (rand()%7 - 3) * 1e10;
+      fData[i] = (rand()%5 - 2) * 0.5;
+      sData[i] = rand()%9 - 4;
+      bData[i] = rand()%2 == 0;
+      lData[i] = (Int64(rand()%3) - 1) << 40;
+    }
+    // Mix -0 and +0.
+    fData[3] = -0.;
+    fData[4] = 0.;
+    Sort sort;
+    sort.sortKey (dData.data(), TpDouble, 0, order1);
+    sort.sortKey (fData.data(), TpFloat, 0, order2);
+    sort.sortKey (sData.data(), TpShort, 0, order1);
+    sort.sortKey (bData.data(), TpBool, 0, order2);
+    sort.sortKey (lData.data(), TpInt64, 0, order1);
+    Vector<uInt> inx1, inx2;
+    uInt nr1 = sort.sort (inx1, nrdata, Sort::QuickSort);
+    uInt nr2 = sort.sort (inx2, nrdata, Sort::RadixSort);
+    AlwaysAssertExit (nr1 == nrdata  &&  nr2 == nrdata);
+    AlwaysAssertExit (allEQ (inx1, inx2));
+    // The default sort (not using the radix sort) gives the same result.
+    Vector<uInt64> inx3;
+    AlwaysAssertExit (sort.sort (inx3, uInt64(nrdata)) == nrdata);
+    for (uInt i=0; i<nrdata; i++) {
+      AlwaysAssertExit (inx3[i] == inx1[i]);
+    }
+    nr1 = sort.sort (inx1, nrdata, Sort::ParSort | Sort::NoDuplicates);
+    nr2 = sort.sort (inx2, nrdata, Sort::RadixSort | Sort::NoDuplicates);
+    AlwaysAssertExit (nr1 == nr2  &&  nr1 < nrdata);
+    AlwaysAssertExit (allEQ (inx1, inx2));
+}
+
 int main()
 {
     sortit (Sort::InsSort);
     sortit (Sort::ParSort);
     sortit (Sort::QuickSort);
     sortit (Sort::HeapSort);
+    sortit (Sort::RadixSort);
 
     // Sort a longer array and check its result.
     sortall (Sort::InsSort, Sort::Ascending);
@@ -308,6 +355,14 @@ int main()
     sortall (Sort::ParSort | Sort::NoDuplicates, Sort::Descending);
     sortall (Sort::QuickSort | Sort::NoDuplicates, Sort::Descending);
     sortall (Sort::HeapSort | Sort::NoDuplicates, Sort::Descending);
+    sortall (Sort::RadixSort, Sort::Ascending);
+    sortall (Sort::RadixSort | Sort::NoDuplicates, Sort::Ascending);
+    sortall (Sort::RadixSort, Sort::Descending);
+    sortall (Sort::RadixSort | Sort::NoDuplicates, Sort::Descending);
+
+    sort_test_radix (Sort::Ascending, Sort::Ascending);
+    sort_test_radix (Sort::Descending, Sort::Descending);
+    sort_test_radix (Sort::Ascending, Sort::Descending);
 
     sort_test_unique();
 
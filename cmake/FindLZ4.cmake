@@ -0,0 +1,27 @@
+# - Try to find LZ4: the LZ4 compression library
+# Variables used by this module:
+#  LZ4_ROOT_DIR     - LZ4 root directory
+# Variables defined by this module:
+#  LZ4_FOUND        - system has LZ4
+#  LZ4_INCLUDE_DIR  - the LZ4 include directory (cached)
+#  LZ4_INCLUDE_DIRS - the LZ4 include directories
+#                        (identical to LZ4_INCLUDE_DIR)
+#  LZ4_LIBRARY      - the LZ4 library (cached)
+#  LZ4_LIBRARIES    - the LZ4 libraries
+#                        (identical to LZ4_LIBRARY)
+
+if(NOT LZ4_FOUND)
+
+  find_path(LZ4_INCLUDE_DIR lz4.h
+    HINTS ${LZ4_ROOT_DIR} PATH_SUFFIXES include)
+  find_library(LZ4_LIBRARY lz4
+    HINTS ${LZ4_ROOT_DIR} PATH_SUFFIXES lib)
+  mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(LZ4 DEFAULT_MSG LZ4_LIBRARY LZ4_INCLUDE_DIR)
+
+  set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+  set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+
+endif(NOT LZ4_FOUND)
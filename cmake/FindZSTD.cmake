@@ -0,0 +1,27 @@
+# - Try to find ZSTD: the Zstandard compression library
+# Variables used by this module:
+#  ZSTD_ROOT_DIR     - ZSTD root directory
+# Variables defined by this module:
+#  ZSTD_FOUND        - system has ZSTD
+#  ZSTD_INCLUDE_DIR  - the ZSTD include directory (cached)
+#  ZSTD_INCLUDE_DIRS - the ZSTD include directories
+#                        (identical to ZSTD_INCLUDE_DIR)
+#  ZSTD_LIBRARY      - the ZSTD library (cached)
+#  ZSTD_LIBRARIES    - the ZSTD libraries
+#                        (identical to ZSTD_LIBRARY)
+
+if(NOT ZSTD_FOUND)
+
+  find_path(ZSTD_INCLUDE_DIR zstd.h
+    HINTS ${ZSTD_ROOT_DIR} PATH_SUFFIXES include)
+  find_library(ZSTD_LIBRARY zstd
+    HINTS ${ZSTD_ROOT_DIR} PATH_SUFFIXES lib)
+  mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(ZSTD DEFAULT_MSG ZSTD_LIBRARY ZSTD_INCLUDE_DIR)
+
+  set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+  set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+
+endif(NOT ZSTD_FOUND)
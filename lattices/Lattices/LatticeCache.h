@@ -34,6 +34,7 @@
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/IO/CacheManager.h>
 
 //# Forward Declarations
 #include <casacore/casa/iosfwd.h>
@@ -77,6 +78,12 @@ template <class T> class Lattice;
 // one will only want overlapping windows for additive operations
 // in which case the additive flag to the constructor should be 
 // used.
+//
+// The memory of the tiles in the cache is accounted for by the
+// <linkto class=CacheManager>CacheManager</linkto>. If its budget is
+// exceeded, the least recently used tile is reused instead of an
+// unused one, and the least recently used tiles can be flushed and
+// removed to make room for another cache.
 // </synopsis>
 //
 // <example>
@@ -92,7 +99,7 @@ template <class T> class Lattice;
 // <todo asof="1997/02/27">
 // </todo>
 
-template <class T> class LatticeCache 
+template <class T> class LatticeCache : public CacheClient
 {
 public:
 
@@ -132,6 +139,14 @@ protected:
 
   LatticeCache() {};
 
+  // Remove the least recently used tiles (after writing them if
+  // obtained for writing) until at most nbytes are used.
+  // The most recently used tile is kept.
+  virtual Int64 releaseCache(Int64 nbytes);
+
+  // Get the number of bytes accounted for a tile.
+  Int64 tileBytes() const;
+
   Int numberTiles;
   IPosition tileShape;
   Vector<Int> tileShapeVec, tileOffsetVec;
@@ -150,6 +165,7 @@ protected:
   Block<IPosition> tileLocs;
   Block<Int> tileSequence;
   Block<Array<T> > tileContents;
+  Block<Bool> tileWritable;
 
   void writeTile(Int tile);
   void readTile(Int tile, Bool readonly);
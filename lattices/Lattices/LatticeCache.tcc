@@ -49,6 +49,8 @@
 
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
+#include <algorithm>
+#include <vector>
 
 #include <casacore/lattices/Lattices/LatticeCache.h>
 
@@ -67,6 +69,7 @@ LatticeCache<T> &LatticeCache<T>::operator=(const LatticeCache<T> & other)
   tileLocs=other.tileLocs;
   tileSequence=other.tileSequence;
   tileContents=other.tileContents;
+  tileWritable=other.tileWritable;
   numberTiles=other.numberTiles;
   tileShape=other.tileShape;
   tileShapeVec=other.tileShapeVec;
@@ -80,6 +83,12 @@ LatticeCache<T> &LatticeCache<T>::operator=(const LatticeCache<T> & other)
   cacheWrites=other.cacheWrites;
   image_p=other.image_p;
   additive=other.additive;
+  // Account for the memory of the copied tiles.
+  Int64 nbytes=0;
+  for(Int tile=0;tile<numberTiles;tile++) {
+    if(tileSequence[tile]>-1) nbytes+=tileBytes();
+  }
+  adjustCacheBytes(nbytes-cacheBytes(), True);
   return *this;
 }
 
@@ -118,12 +127,14 @@ LatticeCache<T>::LatticeCache(Lattice<T> &image,
   tileLocs.resize(numberTiles);
   tileSequence.resize(numberTiles);
   tileContents.resize(numberTiles);
+  tileWritable.resize(numberTiles);
 
   // Initialize. We use the sequence number to determine if
   // a tile has any contents, and for least-recently-used 
   // caching.
   for (Int tile=0;tile<numberTiles;tile++) {
     tileSequence[tile]=-1;    
+    tileWritable[tile]=False;
   }
 }
 
@@ -150,6 +161,9 @@ template <class T>
 Array<T>& LatticeCache<T>::tile(IPosition& cacheLoc, const IPosition& tileLoc,
 				Bool readonly) {
   cacheLoc=cacheLocation(cacheLoc, tileLoc);
+  // Give up memory if asked for by the cache manager.
+  releaseIfRequested();
+  cacheUsed();
   cacheAccesses++;
   Int foundTile=-1;
   for(Int tile=0;tile<numberTiles;tile++) {
@@ -174,6 +188,7 @@ Array<T>& LatticeCache<T>::tile(IPosition& cacheLoc, const IPosition& tileLoc,
 
   // Return the contents of this tile
   tileSequence[foundTile]=cacheAccesses;
+  if(!readonly) tileWritable[foundTile]=True;
   return tileContents[foundTile];
 }
  
@@ -304,6 +319,11 @@ Int LatticeCache<T>::getFreeTile(Bool readonly) {
       break;
     }
   }
+  // Only use it if the memory budget allows it.
+  if(foundTile>-1 && tileContents[foundTile].empty() &&
+     !adjustCacheBytes(tileBytes())) {
+    foundTile=-1;
+  }
 
   if(foundTile<0) {
     // We didn't find an unallocated tile so we look for the
@@ -323,9 +343,40 @@ Int LatticeCache<T>::getFreeTile(Bool readonly) {
     tileSequence[foundTile]=-1;
   }
   AlwaysAssert(foundTile>-1, AipsError);
+  tileWritable[foundTile]=False;
   return foundTile;
 }
 
+template <class T>
+Int64 LatticeCache<T>::tileBytes() const {
+  return Int64(tileShape.product())*sizeof(T);
+}
+
+template <class T>
+Int64 LatticeCache<T>::releaseCache(Int64 nbytes) {
+  // Find the tiles in use, ordered from least to most recently used.
+  std::vector<std::pair<Int,Int> > used;
+  for(Int tile=0;tile<numberTiles;tile++) {
+    if(tileSequence[tile]>-1) {
+      used.push_back(std::make_pair(tileSequence[tile], tile));
+    }
+  }
+  std::sort(used.begin(), used.end());
+  // Remove tiles, but keep the most recently used one.
+  Int64 nr=used.size();
+  for(uInt i=0;i+1<used.size() && nr*tileBytes()>nbytes;i++) {
+    Int tile=used[i].second;
+    if(tileWritable[tile]) {
+      writeTile(tile);
+    }
+    tileContents[tile].resize();
+    tileSequence[tile]=-1;
+    tileWritable[tile]=False;
+    nr--;
+  }
+  return nr*tileBytes();
+}
+
 
 
 } //# NAMESPACE CASACORE - END
@@ -92,6 +92,8 @@ private:
 // examples below.  MSIter implements iteration by time interval for the use of
 // e.g., calibration tasks that want to calculate solutions over some interval
 // of time.  You can iterate over multiple MeasurementSets with this class.
+// <br>Class <linkto class=MSIterChunkList>MSIterChunkList</linkto> can be
+// used to get the list of all chunks, so they can be processed in parallel.
 // </synopsis>
 //
 // <example>
@@ -0,0 +1,97 @@
+//# MSIterChunkList.cc: List of the chunks of an MSIter for parallel processing
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/ms/MeasurementSets/MSIterChunkList.h>
+#include <casacore/ms/MeasurementSets/MSIter.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+MSIterChunkList::MSIterChunkList (MSIter& msIter)
+  : itsMSs       (msIter.numMS()),
+    itsNextChunk (0)
+{
+  for (size_t i=0; i<itsMSs.nelements(); ++i) {
+    itsMSs[i] = msIter.ms(i);
+  }
+  for (msIter.origin(); msIter.more(); msIter++) {
+    MSIterChunk chunk;
+    Table tab = msIter.table();
+    chunk.msId             = msIter.msId();
+    chunk.arrayId          = msIter.arrayId();
+    chunk.fieldId          = msIter.fieldId();
+    chunk.dataDescId       = msIter.dataDescriptionId();
+    chunk.spectralWindowId = msIter.spectralWindowId();
+    chunk.rowNumbers.reference (tab.rowNumbers (msIter.ms()));
+    chunk.startTime = 0;
+    chunk.endTime   = 0;
+    if (tab.nrow() > 0) {
+      Vector<Double> times =
+        ScalarColumn<Double>(tab, MS::columnName(MS::TIME)).getColumn();
+      minMax (chunk.startTime, chunk.endTime, times);
+    }
+    itsChunks.push_back (chunk);
+  }
+  msIter.origin();
+}
+
+Table MSIterChunkList::table (size_t index) const
+{
+  if (index >= itsChunks.size()) {
+    throw TableError ("MSIterChunkList::table: chunk index " +
+                      String::toString(index) + " out of range");
+  }
+  const MSIterChunk& chunk = itsChunks[index];
+  // Creating a reference table is not thread-safe.
+  std::lock_guard<std::mutex> lock(itsMutex);
+  return itsMSs[chunk.msId](chunk.rowNumbers);
+}
+
+Bool MSIterChunkList::claim (size_t& index)
+{
+  index = itsNextChunk++;
+  return index < itsChunks.size();
+}
+
+std::vector<size_t> MSIterChunkList::chunksForProcess (uInt rank,
+                                                       uInt nproc) const
+{
+  if (nproc == 0  ||  rank >= nproc) {
+    throw TableError ("MSIterChunkList::chunksForProcess: invalid rank " +
+                      String::toString(rank) + " for " +
+                      String::toString(nproc) + " processes");
+  }
+  std::vector<size_t> indices;
+  for (size_t i=rank; i<itsChunks.size(); i+=nproc) {
+    indices.push_back (i);
+  }
+  return indices;
+}
+
+} //# NAMESPACE CASACORE - END
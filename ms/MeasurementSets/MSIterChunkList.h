@@ -0,0 +1,175 @@
+//# MSIterChunkList.h: List of the chunks of an MSIter for parallel processing
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef MS_MSITERCHUNKLIST_H
+#define MS_MSITERCHUNKLIST_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Block.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MSIter;
+
+// <summary>
+// Description of a single chunk of an MSIter
+// </summary>
+
+// <use visibility=export>
+
+// <synopsis>
+// An MSIterChunk holds the main table row numbers and the iteration state
+// of a chunk as found by an MSIter. It is filled by class MSIterChunkList.
+// The start and end time are the minimum and maximum TIME value in
+// the chunk.
+// </synopsis>
+
+struct MSIterChunk
+{
+  size_t msId;
+  Int arrayId;
+  Int fieldId;
+  Int dataDescId;
+  Int spectralWindowId;
+  Double startTime;
+  Double endTime;
+  Vector<rownr_t> rowNumbers;
+};
+
+
+// <summary>
+// List of the chunks of an MSIter for parallel processing
+// </summary>
+
+// <use visibility=export>
+
+// <prerequisite>
+//   <li> <linkto class="MSIter:description">MSIter</linkto>
+// </prerequisite>
+
+// <synopsis>
+// MSIter walks sequentially through the chunks of one or more
+// MeasurementSets, so it cannot be used directly to process the chunks
+// in parallel. An MSIterChunkList iterates once through a given MSIter
+// and keeps the row numbers and iteration state (MS, array, field,
+// data description, spectral window, time range) of each chunk.
+// Thereafter threads or processes can handle the chunks independently.
+// <p>
+// Threads can use the function <src>claim</src> to get the index of the
+// next unprocessed chunk. The function <src>table</src> gives the
+// rows of the chunk as a reference table, for which each thread has to
+// create its own ScalarColumn and ArrayColumn objects.
+// Note that the MeasurementSet must be opened with PermanentLocking or
+// UserLocking and <src>Table::setConcurrentRead</src> has to be
+// used to make it possible that multiple threads read it at the same time.
+// <br>Processes can use the function <src>chunksForProcess</src> to get a
+// fixed set of chunks to process. Each process has to create the
+// MSIter and MSIterChunkList in the same way, so they find the same chunks.
+// </synopsis>
+
+// <example>
+// <srcblock>
+// MeasurementSet ms("my.ms", TableLock(TableLock::PermanentLocking));
+// ms.setConcurrentRead();
+// MSIter msIter(ms, Block<Int>(), 60.);
+// MSIterChunkList chunks(msIter);
+// #pragma omp parallel
+// {
+//   size_t index;
+//   while (chunks.claim (index)) {
+//     Table tab = chunks.table (index);
+//     ArrayColumn<Complex> data(tab, "DATA");
+//     process (chunks.chunk(index), data);
+//   }
+// }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Gridding and calibration tools need to be able to distribute the chunks
+// of an MSIter over multiple cores.
+// </motivation>
+
+class MSIterChunkList
+{
+public:
+  // Iterate through all chunks of the MSIter to form the list.
+  // Thereafter the MSIter is reset to its origin.
+  explicit MSIterChunkList (MSIter& msIter);
+
+  // Get the number of chunks.
+  size_t size() const
+    { return itsChunks.size(); }
+
+  // Get the description of the given chunk.
+  const MSIterChunk& chunk (size_t index) const
+    { return itsChunks[index]; }
+
+  // Get the MeasurementSet of the given chunk.
+  const MeasurementSet& ms (size_t index) const
+    { return itsMSs[itsChunks[index].msId]; }
+
+  // Get the rows of the given chunk as a reference table.
+  // It can be called by multiple threads at the same time.
+  Table table (size_t index) const;
+
+  // Claim the next chunk not claimed before. Its index is returned in
+  // <src>index</src>. False is returned if all chunks have been claimed.
+  // It can be called by multiple threads at the same time.
+  Bool claim (size_t& index);
+
+  // Make all chunks unclaimed again.
+  void resetClaims()
+    { itsNextChunk = 0; }
+
+  // Get the indices of the chunks to be processed by the given process
+  // when <src>nproc</src> processes are used. The chunks are distributed
+  // in a round-robin way.
+  std::vector<size_t> chunksForProcess (uInt rank, uInt nproc) const;
+
+private:
+  // Copying is not possible.
+  MSIterChunkList (const MSIterChunkList&);
+  MSIterChunkList& operator= (const MSIterChunkList&);
+
+  //# Data members
+  Block<MeasurementSet>    itsMSs;
+  std::vector<MSIterChunk> itsChunks;
+  std::atomic<size_t>      itsNextChunk;
+  mutable std::mutex       itsMutex;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
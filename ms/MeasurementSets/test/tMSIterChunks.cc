@@ -0,0 +1,251 @@
+//# tMSIterChunks.cc: Test program for class MSIterChunkList
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSIter.h>
+#include <casacore/ms/MeasurementSets/MSIterChunkList.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/ms/MeasurementSets/MSFieldColumns.h>
+#include <casacore/ms/MeasurementSets/MSDataDescColumns.h>
+#include <casacore/ms/MeasurementSets/MSSpWindowColumns.h>
+#include <casacore/ms/MeasurementSets/MSPolColumns.h>
+#include <casacore/ms/MeasurementSets/MSAntennaColumns.h>
+#include <casacore/ms/MeasurementSets/MSFeedColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace casacore;
+
+// <summary>
+// Test program for class MSIterChunkList.
+// The chunks are compared with the chunks found by MSIter and are
+// processed by multiple threads and (simulated) processes.
+// </summary>
+
+// Create an MS with a few fields and data descriptions.
+void createMS (Int nAnt, Int nTime, Int nDD, Int nField, Double interval)
+{
+  TableDesc td (MS::requiredTableDesc());
+  MS::addColumnToDesc (td, MS::DATA, 2);
+  SetupNewTable newtab("tMSIterChunks_tmp.ms", td, Table::New);
+  MeasurementSet ms(newtab);
+  ms.createDefaultSubtables (Table::New);
+  Array<Complex> data(IPosition(2,4,8));
+  MSColumns mscols(ms);
+  rownr_t rownr = 0;
+  for (Int iField=0; iField<nField; ++iField) {
+    for (Int it=0; it<nTime; ++it) {
+      for (Int ddid=0; ddid<nDD; ++ddid) {
+        for (Int i1=0; i1<nAnt; ++i1) {
+          for (Int i2=i1; i2<nAnt; ++i2) {
+            ms.addRow();
+            mscols.time().put (rownr, 1e9 + interval*(it+0.5));
+            mscols.interval().put (rownr, interval);
+            mscols.antenna1().put (rownr, i1);
+            mscols.antenna2().put (rownr, i2);
+            mscols.arrayId().put (rownr, 0);
+            mscols.dataDescId().put (rownr, ddid);
+            mscols.fieldId().put (rownr, iField);
+            data = Complex(rownr, 0);
+            mscols.data().put (rownr, data);
+            ++rownr;
+          }
+        }
+      }
+    }
+  }
+  ms.field().addRow (nField);
+  MSFieldColumns fieldcols(ms.field());
+  Array<Double> dir(IPosition(2,2,1));
+  dir.data()[0] = 1.1; dir.data()[1] = 1.5;
+  for (Int iField=0; iField<nField; ++iField) {
+    fieldcols.delayDir().put (iField, dir);
+    fieldcols.phaseDir().put (iField, dir);
+    fieldcols.name().put (iField, "FIELD" + String::toString(iField));
+  }
+  ms.dataDescription().addRow (nDD);
+  MSDataDescColumns ddcols(ms.dataDescription());
+  ms.spectralWindow().addRow (nDD);
+  MSSpWindowColumns spwcols(ms.spectralWindow());
+  Vector<Double> freqs(8);
+  for (Int ddid=0; ddid<nDD; ++ddid) {
+    ddcols.spectralWindowId().put (ddid, nDD-1-ddid);
+    ddcols.polarizationId().put (ddid, 0);
+    indgen (freqs, 1e9 + ddid*1e7, 1e6);
+    spwcols.chanFreq().put (ddid, freqs);
+  }
+  ms.polarization().addRow (1);
+  MSPolarizationColumns polcols(ms.polarization());
+  Vector<Int> corrTypes(2, 0);
+  corrTypes[1] = 1;
+  polcols.numCorr().put (0, 4);
+  polcols.corrType().put (0, corrTypes);
+  ms.antenna().addRow (nAnt);
+  MSAntennaColumns antcols(ms.antenna());
+  Vector<Double> pos(3);
+  indgen (pos, 6.4e6, 1e3);
+  ms.feed().addRow (nAnt);
+  MSFeedColumns feedcols(ms.feed());
+  for (Int i=0; i<nAnt; ++i) {
+    antcols.mount().put (i, "equatorial");
+    antcols.position().put (i, pos);
+    pos += 10.;
+    feedcols.antennaId().put (i, i);
+    feedcols.spectralWindowId().put (i, -1);
+    feedcols.numReceptors().put (i, 2);
+    feedcols.beamOffset().put (i, Array<Double>(IPosition(2,2,2), 0.));
+    feedcols.receptorAngle().put (i, Vector<Double>(2, 0.));
+    feedcols.polResponse().put (i, Array<Complex>(IPosition(2,2,2)));
+  }
+}
+
+// Check that the chunk list matches the sequential iteration.
+void checkChunks (MSIter& msIter, const MSIterChunkList& chunks)
+{
+  size_t index = 0;
+  for (msIter.origin(); msIter.more(); msIter++, ++index) {
+    AlwaysAssertExit (index < chunks.size());
+    const MSIterChunk& chunk = chunks.chunk(index);
+    AlwaysAssertExit (chunk.msId == msIter.msId());
+    AlwaysAssertExit (chunk.arrayId == msIter.arrayId());
+    AlwaysAssertExit (chunk.fieldId == msIter.fieldId());
+    AlwaysAssertExit (chunk.dataDescId == msIter.dataDescriptionId());
+    AlwaysAssertExit (chunk.spectralWindowId == msIter.spectralWindowId());
+    Vector<Double> times =
+      ScalarColumn<Double>(msIter.table(), "TIME").getColumn();
+    AlwaysAssertExit (chunk.startTime == min(times));
+    AlwaysAssertExit (chunk.endTime == max(times));
+    Table tab = chunks.table (index);
+    AlwaysAssertExit (tab.nrow() == msIter.table().nrow());
+    AlwaysAssertExit (allEQ (tab.rowNumbers(chunks.ms(index)),
+                             msIter.table().rowNumbers(msIter.ms())));
+  }
+  AlwaysAssertExit (index == chunks.size());
+}
+
+// Process a chunk by checking its DATA values. It returns the number
+// of rows processed and increments nerr for each wrong row.
+rownr_t processChunk (const MSIterChunkList& chunks, size_t index,
+                      std::atomic<uInt>& nerr)
+{
+  Table tab = chunks.table (index);
+  const Vector<rownr_t>& rows = chunks.chunk(index).rowNumbers;
+  ScalarColumn<Int> ddid(tab, "DATA_DESC_ID");
+  ArrayColumn<Complex> data(tab, "DATA");
+  Array<Complex> buf;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    data.get (i, buf, True);
+    if (! allEQ (buf, Complex(rows[i], 0))  ||
+        ddid(i) != chunks.chunk(index).dataDescId) {
+      nerr++;
+    }
+  }
+  return tab.nrow();
+}
+
+int main()
+{
+  try {
+    Int nAnt = 4;
+    Int nTime = 6;
+    Int nDD = 3;
+    Int nField = 2;
+    createMS (nAnt, nTime, nDD, nField, 60.);
+    MeasurementSet ms("tMSIterChunks_tmp.ms",
+                      TableLock(TableLock::PermanentLocking));
+    ms.setConcurrentRead();
+    MSIter msIter(ms, Block<Int>(), 120.);
+    MSIterChunkList chunks(msIter);
+    // Each chunk contains 2 time slots.
+    AlwaysAssertExit (chunks.size() == size_t(nField*nDD*nTime/2));
+    checkChunks (msIter, chunks);
+    // Also with multiple MSs.
+    {
+      Block<MeasurementSet> mss(2, ms);
+      MSIter msIter2(mss, Block<Int>(), 0.);
+      MSIterChunkList chunks2(msIter2);
+      AlwaysAssertExit (chunks2.size() == size_t(2*nField*nDD));
+      AlwaysAssertExit (chunks2.chunk(chunks2.size()-1).msId == 1);
+      checkChunks (msIter2, chunks2);
+    }
+    // Claim the chunks in a few threads.
+    for (uInt pass=0; pass<2; ++pass) {
+      std::vector<std::atomic<uInt>> nclaimed(chunks.size());
+      for (auto& n : nclaimed) {
+        n = 0;
+      }
+      std::atomic<uInt> nerr(0);
+      std::atomic<rownr_t> nrow(0);
+      std::vector<std::thread> threads;
+      for (uInt thr=0; thr<4; ++thr) {
+        threads.push_back (std::thread ([&]() {
+          size_t index;
+          while (chunks.claim (index)) {
+            nclaimed[index]++;
+            nrow += processChunk (chunks, index, nerr);
+          }
+        }));
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+      AlwaysAssertExit (nerr == 0);
+      AlwaysAssertExit (nrow == ms.nrow());
+      for (auto& n : nclaimed) {
+        AlwaysAssertExit (n == 1);
+      }
+      chunks.resetClaims();
+    }
+    // Divide the chunks over a few processes.
+    uInt nproc = 5;
+    std::vector<uInt> nprocessed(chunks.size(), 0);
+    for (uInt rank=0; rank<nproc; ++rank) {
+      std::vector<size_t> indices = chunks.chunksForProcess (rank, nproc);
+      AlwaysAssertExit (indices.size() >= chunks.size() / nproc);
+      for (size_t index : indices) {
+        nprocessed[index]++;
+      }
+    }
+    for (uInt n : nprocessed) {
+      AlwaysAssertExit (n == 1);
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
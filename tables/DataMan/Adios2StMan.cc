@@ -143,6 +143,28 @@ rownr_t Adios2StMan::getNrRows()
     return pimpl->getNrRows();
 }
 
+rownr_t Adios2StMan::rankRowOffset(MPI_Comm mpiComm, rownr_t nLocalRows,
+                                   rownr_t &nTotalRows)
+{
+    static_assert(sizeof(rownr_t) == sizeof(uint64_t),
+                  "rownr_t is sent as MPI_UINT64_T");
+    uint64_t nLocal = nLocalRows;
+    uint64_t offset = 0;
+    uint64_t total = 0;
+    if (MPI_Exscan(&nLocal, &offset, 1, MPI_UINT64_T, MPI_SUM, mpiComm)
+        != MPI_SUCCESS ||
+        MPI_Allreduce(&nLocal, &total, 1, MPI_UINT64_T, MPI_SUM, mpiComm)
+        != MPI_SUCCESS)
+    {
+        throw DataManError("Adios2StMan::rankRowOffset: MPI reduction failed");
+    }
+    // The result of MPI_Exscan is undefined on rank 0.
+    int rank;
+    MPI_Comm_rank(mpiComm, &rank);
+    nTotalRows = total;
+    return rank == 0 ? 0 : offset;
+}
+
 
 
 //
@@ -84,6 +84,14 @@ public:
     Record dataManagerSpec() const;
     rownr_t getNrRows();
 
+    // Collectively determine the rows to be written by this MPI rank when
+    // each rank in mpiComm writes nLocalRows consecutive rows of a table.
+    // The first row of this rank is returned and nTotalRows is set to the
+    // number of rows all ranks have to create the table with.
+    // Table-level metadata (table.dat, keywords) is only written by rank 0.
+    static rownr_t rankRowOffset(MPI_Comm mpiComm, rownr_t nLocalRows,
+                                 rownr_t &nTotalRows);
+
 private:
     class impl;
     std::unique_ptr<impl> pimpl;
@@ -151,6 +151,38 @@ void Adios2StManColumn::arrayColumnVToSelection()
     }
 }
 
+Bool Adios2StManColumn::arrayColumnCellsVToSelection(const RefRows &rownrs)
+{
+    // A contiguous range of rows of a fixed shape column can be selected
+    // as a whole, so it is transferred in a single ADIOS2 call. This is
+    // how an MPI rank writes its own row range of a table.
+    if (!isShapeFixed || dtype() == TpString || dtype() == TpArrayString)
+    {
+        return false;
+    }
+    RefRowsSliceIter iter(rownrs);
+    if (iter.pastEnd())
+    {
+        return false;
+    }
+    auto row_start = iter.sliceStart();
+    auto row_end = iter.sliceEnd();
+    auto row_incr = iter.sliceIncr();
+    iter.next();
+    if (!iter.pastEnd() || (row_incr != 1 && row_end != row_start))
+    {
+        return false;
+    }
+    itsAdiosStart[0] = row_start;
+    itsAdiosCount[0] = row_end - row_start + 1;
+    for (size_t i = 1; i < itsAdiosShape.size(); ++i)
+    {
+        itsAdiosStart[i] = 0;
+        itsAdiosCount[i] = itsAdiosShape[i];
+    }
+    return true;
+}
+
 void Adios2StManColumn::scalarColumnCellsVToSelection(const RefRows &rows)
 {
     RefRowsSliceIter iter(rows);
@@ -252,6 +284,11 @@ void Adios2StManColumn::putScalarColumnCellsV(const RefRows &rownrs, const Array
 
 void Adios2StManColumn::putArrayColumnCellsV (const RefRows& rownrs, const ArrayBase& data)
 {
+    if(arrayColumnCellsVToSelection(rownrs))
+    {
+        toAdios(&data);
+        return;
+    }
     if(rownrs.isSliced())
     {
         rownrs.convert();
@@ -274,6 +311,11 @@ void Adios2StManColumn::putArrayColumnCellsV (const RefRows& rownrs, const Array
 
 void Adios2StManColumn::getArrayColumnCellsV (const RefRows& rownrs, ArrayBase &data)
 {
+    if(arrayColumnCellsVToSelection(rownrs))
+    {
+        fromAdios(&data);
+        return;
+    }
     if(rownrs.isSliced())
     {
         rownrs.convert();
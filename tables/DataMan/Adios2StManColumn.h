@@ -126,6 +126,7 @@ protected:
     void scalarColumnCellsVToSelection(const RefRows &rownrs);
     void arrayVToSelection(rownr_t rownr);
     void arrayColumnVToSelection();
+    Bool arrayColumnCellsVToSelection(const RefRows &rownrs);
     void sliceVToSelection(rownr_t rownr, const Slicer &ns);
     void columnSliceVToSelection(const Slicer &ns);
     void columnSliceCellsVToSelection(const RefRows &rows, const Slicer &ns);
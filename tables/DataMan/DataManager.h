@@ -294,7 +294,7 @@ public:
       { return tsmOption_p; }
 
     // Get the MultiFile pointer (can be 0).
-    MultiFileBase* multiFile()
+    MultiFileBase* multiFile() const
       { return multiFile_p; }
 
     // Compose a keyword name from the given keyword appended with the
@@ -410,6 +410,7 @@ private:
     MultiFileBase* multiFile_p;      //# MultiFile to use; 0=no MultiFile
     Table*       table_p;            //# Table this data manager belongs to
     mutable DataManager* clone_p;    //# Pointer to clone (used by SetupNewTab)
+    mutable std::recursive_mutex accessMutex_p; //# for concurrent reading
 
 
     // The copy constructor cannot be used for this base class.
@@ -532,6 +533,20 @@ public:
     void setClone (DataManager* clone) const
         { clone_p = clone; }
 
+    // Get the mutex serializing the access to the data manager.
+    // The columns lock it for each access, so it is not locked while the
+    // data manager is idle. It is recursive, because a virtual column
+    // engine can read other columns in the same data manager.
+    std::recursive_mutex& accessMutex() const
+        { return accessMutex_p; }
+
+    // Get the mutex to be used by the caches of a storage manager to let
+    // the CacheManager release memory if the data manager is idle (see
+    // CacheClient::setReleaseMutex). A null pointer is returned if a
+    // MultiFile is used, because the data managers using it share a mutex.
+    std::recursive_mutex* cacheReleaseMutex() const
+        { return (multiFile_p == 0  ?  &accessMutex_p : 0); }
+
     // Register a mapping of a data manager type to its static construction
     // function. It is fully thread-safe.
     static void registerCtor (const String& type, DataManagerCtor func);
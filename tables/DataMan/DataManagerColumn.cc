@@ -43,6 +43,22 @@ DataManagerColumn::~DataManagerColumn()
 void DataManagerColumn::setMaxLength (uInt)
 {}
 
+Bool DataManagerColumn::getZoneMap (Vector<rownr_t>&, Vector<Double>&,
+                                    Vector<Double>&)
+{
+    return False;
+}
+
+Bool DataManagerColumn::getArrayViewV (rownr_t, const Slicer*, ArrayBase&)
+{
+    return False;
+}
+
+Bool DataManagerColumn::getColumnRangeViewV (rownr_t, rownr_t, ArrayBase&)
+{
+    return False;
+}
+
 void DataManagerColumn::setShapeColumn (const IPosition&)
 {
     throw DataManInvOper ("setShapeColumn only allowed for FixedShape arrays"
@@ -35,6 +35,7 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Utilities/CountedPtr.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -409,6 +410,38 @@ public:
 				       const Slicer& slicer,
 				       const ArrayBase& data);
 
+    // Get the zone map of a scalar numeric column, i.e., the minimum and
+    // maximum value for consecutive ranges of rows (e.g., buckets).
+    // <src>endRows</src> gets the last row of each zone.
+    // The min/max values are a hull of the actual values; a zone with
+    // minimum > maximum does not contain any value (e.g., all NaN).
+    // It is used to skip rows that cannot match a selection.
+    // The default implementation returns False, meaning that no zone map
+    // is available.
+    virtual Bool getZoneMap (Vector<rownr_t>& endRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues);
+
+    // Make <src>data</src> reference the array (or a section of it) in
+    // the given row without copying the data. <src>slicer</src> is a null
+    // pointer if the full array has to be referenced.
+    // It is only possible if the
+    // storage manager holds the data contiguously in memory in local
+    // format (e.g., memory-mapped), so the array can reference it
+    // directly. The array must not be changed.
+    // <br>The default implementation returns False, meaning that it is
+    // not possible and the data have to be copied using getArrayV or
+    // getSliceV.
+    virtual Bool getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                ArrayBase& data);
+
+    // Make <src>data</src> reference the arrays in <src>nrow</src> rows
+    // starting at <src>startRow</src> without copying them.
+    // The rows are the last axis of the array.
+    // Similar to getArrayViewV, the default implementation returns False.
+    virtual Bool getColumnRangeViewV (rownr_t startRow, rownr_t nrow,
+                                      ArrayBase& data);
+
     // Throw an "invalid operation" exception for the default
     // implementation of get.
     void throwGet() const;
@@ -142,6 +142,10 @@ ISMBase::ISMBase (const ISMBase& that)
 
 ISMBase::~ISMBase()
 {
+    // The cache must not be released while the columns are deleted.
+    if (cache_p != 0) {
+	cache_p->setReleaseMutex (0);
+    }
     for (uInt i=0; i<ncolumn(); i++) {
 	delete colSet_p[i];
     }
@@ -292,6 +296,8 @@ void ISMBase::makeCache()
 				   ISMBucket::deleteCallBack);
 	cache_p->resync (nbucketInit_p, nFreeBucket_p, firstFree_p);
 	AlwaysAssert (cache_p != 0, AipsError);
+	cache_p->setPrefetch (BucketCache::defaultPrefetch());
+	cache_p->setReleaseMutex (cacheReleaseMutex());
 	// Allocate a buffer for temporary storage by all ISM classes.
 	if (tempBuffer_p == 0) {
 	    tempBuffer_p = new char [bucketSize_p];
@@ -537,6 +543,9 @@ void ISMBase::removeColumn (DataManagerColumn* colp)
 
 void ISMBase::recreate()
 {
+    if (cache_p != 0) {
+	cache_p->setReleaseMutex (0);
+    }
     delete index_p;
     index_p = 0;
     delete cache_p;
@@ -656,6 +665,9 @@ StManArrayFile* ISMBase::openArrayFile (ByteIO::OpenOption opt)
 
 void ISMBase::reopenRW()
 {
+    if (cache_p != 0) {
+        cache_p->waitPrefetch();
+    }
     file_p->setRW();
     uInt nrcol = ncolumn();
     for (uInt i=0; i<nrcol; i++) {
@@ -70,6 +70,7 @@ ROIncrementalStManAccessor& ROIncrementalStManAccessor::operator=
 void ROIncrementalStManAccessor::setCacheSize (uInt size,
                                                Bool canExceedNrBuckets)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->setCacheSize (size, canExceedNrBuckets);
 }
 uInt ROIncrementalStManAccessor::cacheSize() const
@@ -79,6 +80,7 @@ uInt ROIncrementalStManAccessor::cacheSize() const
 
 void ROIncrementalStManAccessor::clearCache()
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->clearCache();
 }
 
@@ -89,6 +91,7 @@ void ROIncrementalStManAccessor::showIndexStatistics (ostream& os) const
 
 void ROIncrementalStManAccessor::showBucketLayout (ostream& os) const
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->showBucketLayout (os);
 }
 
@@ -101,6 +104,7 @@ Bool ROIncrementalStManAccessor::checkBucketLayout (uInt& offendingCursor,
                                                     rownr_t& offendingRow,
                                                     rownr_t& offendingPrevRow) const
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
   Bool ok;
   ok = dataManPtr_p->checkBucketLayout (offendingCursor,
                                         offendingBucketStartRow,
@@ -74,7 +74,8 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsUseZoneMaps       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -106,7 +107,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsUseZoneMaps       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -138,7 +140,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsUseZoneMaps       (False)
 { 
   // Get nr of rows per bucket if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -157,6 +160,9 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("ZONEMAPS")) {
+    itsUseZoneMaps = spec.asBool ("ZONEMAPS");
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -179,11 +185,16 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsUseZoneMaps       (that.itsUseZoneMaps)
 {}
 
 SSMBase::~SSMBase()
 {
+  // The cache must not be released while the columns are deleted.
+  if (itsCache != 0) {
+    itsCache->setReleaseMutex (0);
+  }
   for (uInt i=0; i<ncolumn(); i++) {
     delete itsPtrColumn[i];
   }
@@ -217,6 +228,9 @@ Record SSMBase::dataManagerSpec() const
   rec.define ("BUCKETSIZE", Int(itsBucketSize));
   rec.define ("PERSCACHESIZE", Int(itsPersCacheSize));
   rec.define ("IndexLength", Int(itsIndexLength));
+  if (itsUseZoneMaps) {
+    rec.define ("ZONEMAPS", True);
+  }
   return rec;
 }
 
@@ -295,6 +309,7 @@ DataManagerColumn* SSMBase::makeScalarColumn (const String&,
     itsPtrColumn.resize (itsPtrColumn.nelements() + 32);
   }
   SSMColumn* aColumn = new SSMColumn (this, aDataType, ncolumn());
+  aColumn->setIsScalar();
   itsPtrColumn[ncolumn()] = aColumn;
   return aColumn;
 }
@@ -373,6 +388,8 @@ void SSMBase::makeCache()
 				SSMBase::deleteCallBack);
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
+    itsCache->setPrefetch (BucketCache::defaultPrefetch());
+    itsCache->setReleaseMutex (cacheReleaseMutex());
 
     if (forceFill) {
       readIndexBuckets();
@@ -503,6 +520,9 @@ void SSMBase::readIndexBuckets()
   for (uInt i=0; i < aNrIdx; i++) {
     itsPtrIndex[i] = new SSMIndex(this);
     itsPtrIndex[i]->get(anMOs);
+    if (itsPtrIndex[i]->hasZoneMaps()) {
+      itsUseZoneMaps = True;
+    }
   }
   
   anMOs.close();
@@ -805,6 +825,10 @@ void SSMBase::addColumn (DataManagerColumn* aColumn)
   }
 
   aSSMC->addRow(itsNrRows,0,aBestFit != -1);
+  // All values of the new column are zero (a new index has new buckets).
+  if (itsUseZoneMaps  &&  aSSMC->canHaveZoneMap()) {
+    itsPtrIndex[itsColIndexMap[nCol]]->addZoneMap (itsColumnOffset[nCol]);
+  }
   isDataChanged = True;
 }
 
@@ -921,6 +945,9 @@ char* SSMBase::find(rownr_t aRowNr,     uInt aColNr,
 
 void SSMBase::recreate()
 {
+  if (itsCache != 0) {
+    itsCache->setReleaseMutex (0);
+  }
   delete itsCache;
   itsCache = 0;
   delete itsFile;
@@ -1056,6 +1083,9 @@ StManArrayFile* SSMBase::openArrayFile (ByteIO::OpenOption anOpt)
 
 void SSMBase::reopenRW()
 {
+  if (itsCache != 0) {
+    itsCache->waitPrefetch();
+  }
   if (itsFile != 0) {
     itsFile->setRW();
   }
@@ -1108,6 +1138,39 @@ void SSMBase::init()
   itsPtrIndex.resize (1, True);
   itsPtrIndex[0] = new SSMIndex(this, rowsPerBucket);
   itsPtrIndex[0]->setNrColumns (nrCol, aTotalSize);
+  if (itsUseZoneMaps) {
+    for (uInt i=0; i<nrCol; i++) {
+      if (itsPtrColumn[i]->canHaveZoneMap()) {
+        itsPtrIndex[0]->addZoneMap (itsColumnOffset[i]);
+      }
+    }
+  }
+}
+
+void SSMBase::setZoneMaps (Bool useZoneMaps)
+{
+  itsUseZoneMaps = useZoneMaps;
+}
+
+Bool SSMBase::getZoneMap (uInt aColNr, Vector<rownr_t>& endRows,
+                          Vector<Double>& minValues, Vector<Double>& maxValues)
+{
+  // Make sure the index has been read.
+  getCache();
+  if (!itsUseZoneMaps) {
+    return False;
+  }
+  return itsPtrIndex[itsColIndexMap[aColNr]]->getZoneMap
+    (itsColumnOffset[aColNr], endRows, minValues, maxValues);
+}
+
+void SSMBase::updateZone (uInt aColNr, rownr_t aRowNr,
+                          Double aMin, Double aMax)
+{
+  if (itsUseZoneMaps) {
+    itsPtrIndex[itsColIndexMap[aColNr]]->updateZone
+      (itsColumnOffset[aColNr], aRowNr, aMin, aMax);
+  }
 }
 
 
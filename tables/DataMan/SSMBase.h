@@ -33,6 +33,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -211,6 +212,22 @@ public:
 
   // Get the current cache size (in buckets).
   uInt getCacheSize() const;
+
+  // Tell if a zone map (the minimum and maximum value per bucket) has
+  // to be kept for the scalar columns with a numeric data type.
+  // It can only be set before the table is created; for an existing table
+  // the zone maps are used if they were created.
+  // It can also be set by the ZONEMAPS field in the specification record.
+  void setZoneMaps (Bool useZoneMaps);
+
+  // Get the zone map of the given column.
+  // False is returned if the column has no zone map.
+  Bool getZoneMap (uInt aColNr, Vector<rownr_t>& endRows,
+                   Vector<Double>& minValues, Vector<Double>& maxValues);
+
+  // Widen the zone of the bucket containing the given row and column.
+  // Nothing is done if the column has no zone map.
+  void updateZone (uInt aColNr, rownr_t aRowNr, Double aMin, Double aMax);
   
   // Clear the cache used by this storage manager.
   // It will flush the cache as needed and remove all buckets from it.
@@ -460,6 +477,9 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // Are zone maps kept for the scalar numeric columns?
+  Bool itsUseZoneMaps;
 };
 
 
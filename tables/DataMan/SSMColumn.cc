@@ -37,6 +37,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -50,7 +51,8 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsIsScalar    (False)
 {
   init();
 }
@@ -343,6 +345,7 @@ void SSMColumn::putBool (rownr_t aRowNr, const Bool* aValue)
 void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uChar*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -351,6 +354,7 @@ void SSMColumn::putuChar (rownr_t aRowNr, const uChar* aValue)
 void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Short*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -359,6 +363,7 @@ void SSMColumn::putShort (rownr_t aRowNr, const Short* aValue)
 void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uShort*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -367,6 +372,7 @@ void SSMColumn::putuShort (rownr_t aRowNr, const uShort* aValue)
 void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -375,6 +381,7 @@ void SSMColumn::putInt (rownr_t aRowNr, const Int* aValue)
 void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<uInt*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -383,6 +390,7 @@ void SSMColumn::putuInt (rownr_t aRowNr, const uInt* aValue)
 void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<Int64*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -391,6 +399,7 @@ void SSMColumn::putInt64 (rownr_t aRowNr, const Int64* aValue)
 void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<float*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -399,6 +408,7 @@ void SSMColumn::putfloat (rownr_t aRowNr, const float* aValue)
 void SSMColumn::putdouble (rownr_t aRowNr, const double* aValue)
 {
   putValue(aRowNr,aValue);
+  updateZone (aRowNr, Double(*aValue));
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     static_cast<double*>(itsData)[aRowNr-columnCache().start()] = 
       *aValue;
@@ -557,14 +567,103 @@ void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
     rownr_t aNr = anEndRow-aStartRow+1;
     rowsToDo -= aNr;
     itsWriteFunc (aValPtr, aDataPtr, aNr * itsNrCopy);
-    aDataPtr += aNr * itsLocalSize;
     itsSSMPtr->setBucketDirty();
+    updateZone (aStartRow, aDataPtr, aNr);
+    aDataPtr += aNr * itsLocalSize;
   }
 
   // Be sure cache will be emptied
   columnCache().invalidate();
 }
 
+template<typename T>
+void ssmColumnMinMax (const void* aValues, rownr_t aNr,
+                      Double& aMin, Double& aMax)
+{
+  const T* values = static_cast<const T*>(aValues);
+  for (rownr_t i=0; i<aNr; ++i) {
+    Double v = values[i];
+    if (!isNaN(v)) {
+      if (v < aMin) aMin = v;
+      if (v > aMax) aMax = v;
+    }
+  }
+}
+
+void SSMColumn::updateZone (rownr_t aStartRow, const void* aValues,
+                            rownr_t aNr)
+{
+  if (!itsIsScalar  ||  aNr == 0) {
+    return;
+  }
+  Double aMin = std::numeric_limits<Double>::max();
+  Double aMax = -aMin;
+  switch (dataType()) {
+  case TpUChar:
+    ssmColumnMinMax<uChar> (aValues, aNr, aMin, aMax);
+    break;
+  case TpShort:
+    ssmColumnMinMax<Short> (aValues, aNr, aMin, aMax);
+    break;
+  case TpUShort:
+    ssmColumnMinMax<uShort> (aValues, aNr, aMin, aMax);
+    break;
+  case TpInt:
+    ssmColumnMinMax<Int> (aValues, aNr, aMin, aMax);
+    break;
+  case TpUInt:
+    ssmColumnMinMax<uInt> (aValues, aNr, aMin, aMax);
+    break;
+  case TpInt64:
+    ssmColumnMinMax<Int64> (aValues, aNr, aMin, aMax);
+    break;
+  case TpFloat:
+    ssmColumnMinMax<Float> (aValues, aNr, aMin, aMax);
+    break;
+  case TpDouble:
+    ssmColumnMinMax<Double> (aValues, aNr, aMin, aMax);
+    break;
+  default:
+    return;
+  }
+  if (aMin <= aMax) {
+    itsSSMPtr->updateZone (itsColNr, aStartRow, aMin, aMax);
+  }
+}
+
+void SSMColumn::setIsScalar()
+{
+  itsIsScalar = True;
+}
+
+Bool SSMColumn::canHaveZoneMap() const
+{
+  if (itsIsScalar) {
+    switch (dataType()) {
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+      return True;
+    default:
+      break;
+    }
+  }
+  return False;
+}
+
+Bool SSMColumn::getZoneMap (Vector<rownr_t>& endRows,
+                            Vector<Double>& minValues,
+                            Vector<Double>& maxValues)
+{
+  return itsIsScalar  &&
+    itsSSMPtr->getZoneMap (itsColNr, endRows, minValues, maxValues);
+}
+
 void SSMColumn::removeColumn()
 {
   if (dataType() == TpString  &&  itsMaxLen == 0) {
@@ -197,6 +197,19 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Tell that the column is a scalar column (used by SSMBase).
+  void setIsScalar();
+
+  // Can a zone map be kept for this column?
+  // That is the case for a scalar column with a numeric data type.
+  Bool canHaveZoneMap() const;
+
+  // Get the zone map of the column (i.e. the minimum and maximum per bucket).
+  // False is returned if no zone map is kept for it.
+  virtual Bool getZoneMap (Vector<rownr_t>& endRows,
+                           Vector<Double>& minValues,
+                           Vector<Double>& maxValues);
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, rownr_t rowNr, rownr_t startRow, rownr_t endRow);
@@ -227,6 +240,13 @@ protected:
   // Each data bucket is filled with the the appropriate part of the array.
   void putColumnValue (const void* anArray, rownr_t aNrRows);
 
+  // Update the zone map of a scalar column with the value put in a row.
+  void updateZone (rownr_t aRowNr, Double aValue);
+
+  // Update the zone map of a scalar column with the values put in
+  // the rows <src>aStartRow</src> till <src>aStartRow+aNr</src>.
+  void updateZone (rownr_t aStartRow, const void* aValues, rownr_t aNr);
+
 
   // Pointer to the parent storage manager.
   SSMBase*          itsSSMPtr;
@@ -253,6 +273,8 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is it a scalar column?
+  Bool              itsIsScalar;
   
 private:
   // Forbid copy constructor.
@@ -289,6 +311,13 @@ inline char* SSMColumn::getDataPtr()
   return static_cast<char*>(itsData);
 }
 
+inline void SSMColumn::updateZone (rownr_t aRowNr, Double aValue)
+{
+  if (itsIsScalar) {
+    itsSSMPtr->updateZone (itsColNr, aRowNr, aValue, aValue);
+  }
+}
+
 inline uInt SSMColumn::getColNr()
 {
   return itsColNr;
@@ -70,14 +70,30 @@ void SSMIndex::get (AipsIO& anOs)
     getBlock (anOs, itsLastRow);
   }
   getBlock (anOs, itsBucketNumber);
+  itsZoneMin.clear();
+  itsZoneMax.clear();
+  if (version > 2) {
+    uInt nzone;
+    anOs >> nzone;
+    for (uInt i=0; i<nzone; ++i) {
+      Int anOffset;
+      anOs >> anOffset;
+      getBlock (anOs, itsZoneMin[anOffset]);
+      getBlock (anOs, itsZoneMax[anOffset]);
+    }
+  }
   anOs.getend();
 }
 
 void SSMIndex::put (AipsIO& anOs) const
 {
   // Try to be forward compatible by trying to write the row numbers as uInt.
+  // Zone maps need version 3.
   uInt version = 1;
-  if (itsNUsed > 0  &&  itsLastRow[itsNUsed-1] > DataManager::MAXROWNR32) {
+  if (hasZoneMaps()) {
+    version = 3;
+  } else if (itsNUsed > 0  &&
+             itsLastRow[itsNUsed-1] > DataManager::MAXROWNR32) {
     version = 2;
   }
   anOs.putstart("SSMIndex", version);
@@ -95,6 +111,14 @@ void SSMIndex::put (AipsIO& anOs) const
     putBlock (anOs, itsLastRow, itsNUsed);
   }
   putBlock (anOs, itsBucketNumber, itsNUsed);
+  if (version > 2) {
+    anOs << uInt(itsZoneMin.size());
+    for (const auto& x : itsZoneMin) {
+      anOs << x.first;
+      putBlock (anOs, x.second, itsNUsed);
+      putBlock (anOs, itsZoneMax.at(x.first), itsNUsed);
+    }
+  }
   anOs.putend();
 }
 
@@ -149,6 +173,12 @@ void SSMIndex::addRow (rownr_t aNrRows)
     itsLastRow[itsNUsed-1] += toAdd;
     aNrRows -= toAdd;
     lastRow += toAdd;
+    // The new rows in the last bucket contain zeroes.
+    if (toAdd > 0) {
+      for (const auto& x : itsZoneMin) {
+        updateZone (x.first, lastRow-1, 0, 0);
+      }
+    }
   }
  
   if (aNrRows == 0) {
@@ -170,6 +200,10 @@ void SSMIndex::addRow (rownr_t aNrRows)
     }
     itsLastRow.resize (aNewNr);
     itsBucketNumber.resize(aNewNr);
+    for (auto& x : itsZoneMin) {
+      x.second.resize (aNewNr);
+      itsZoneMax.at(x.first).resize (aNewNr);
+    }
   }
   
   // first time bucket is made and filled, last bucket was filled, so if
@@ -181,6 +215,11 @@ void SSMIndex::addRow (rownr_t aNrRows)
     lastRow += toAdd;
     aNrRows -= toAdd;
     itsLastRow[itsNUsed] = lastRow-1;
+    // A new bucket is filled with zeroes.
+    for (auto& x : itsZoneMin) {
+      x.second[itsNUsed] = 0;
+      itsZoneMax.at(x.first)[itsNUsed] = 0;
+    }
     itsNUsed += 1;
   }
 }
@@ -217,6 +256,12 @@ Int SSMIndex::deleteRow (rownr_t aRowNr)
       objmove (&itsBucketNumber[anIndex],
 	       &itsBucketNumber[anIndex+1],
 	       itsNUsed-anIndex-1);
+      for (auto& x : itsZoneMin) {
+        Block<Double>& zmax = itsZoneMax.at(x.first);
+        objmove (&x.second[anIndex], &x.second[anIndex+1],
+                 itsNUsed-anIndex-1);
+        objmove (&zmax[anIndex], &zmax[anIndex+1], itsNUsed-anIndex-1);
+      }
     }
     itsNUsed--;
     itsLastRow[itsNUsed]=0;
@@ -251,6 +296,8 @@ Int SSMIndex::removeColumn (Int anOffset, uInt nbits)
   // set freespace (total in bytes).
   uInt aLength = (itsRowsPerBucket * nbits + 7) / 8;
   itsFreeSpace.insert (std::make_pair(anOffset,aLength));
+  itsZoneMin.erase (anOffset);
+  itsZoneMax.erase (anOffset);
  
   itsNrColumns--;
   AlwaysAssert (itsNrColumns > -1, AipsError);
@@ -345,5 +392,59 @@ void SSMIndex::find (rownr_t aRowNumber, uInt& aBucketNr,
   }
 }
 
+void SSMIndex::addZoneMap (Int anOffset)
+{
+  Block<Double>& zmin = itsZoneMin[anOffset];
+  Block<Double>& zmax = itsZoneMax[anOffset];
+  zmin.resize (itsLastRow.nelements(), True, False);
+  zmax.resize (itsLastRow.nelements(), True, False);
+  zmin = Double(0);
+  zmax = Double(0);
+}
+
+Bool SSMIndex::hasZoneMap (Int anOffset) const
+{
+  return itsZoneMin.find(anOffset) != itsZoneMin.end();
+}
+
+Bool SSMIndex::hasZoneMaps() const
+{
+  return !itsZoneMin.empty();
+}
+
+void SSMIndex::updateZone (Int anOffset, rownr_t aRowNr,
+                           Double aMin, Double aMax)
+{
+  std::map<Int,Block<Double>>::iterator iter = itsZoneMin.find(anOffset);
+  if (iter == itsZoneMin.end()  ||  isNaN(aMin)  ||  isNaN(aMax)) {
+    return;
+  }
+  uInt anIndex = getIndex (aRowNr, String());
+  Double& zmin = iter->second[anIndex];
+  Double& zmax = itsZoneMax.at(anOffset)[anIndex];
+  if (aMin < zmin) zmin = aMin;
+  if (aMax > zmax) zmax = aMax;
+}
+
+Bool SSMIndex::getZoneMap (Int anOffset, Vector<rownr_t>& endRows,
+                           Vector<Double>& minValues,
+                           Vector<Double>& maxValues) const
+{
+  std::map<Int,Block<Double>>::const_iterator iter = itsZoneMin.find(anOffset);
+  if (iter == itsZoneMin.end()) {
+    return False;
+  }
+  const Block<Double>& zmax = itsZoneMax.at(anOffset);
+  endRows.resize (itsNUsed);
+  minValues.resize (itsNUsed);
+  maxValues.resize (itsNUsed);
+  for (uInt i=0; i<itsNUsed; ++i) {
+    endRows[i]   = itsLastRow[i];
+    minValues[i] = iter->second[i];
+    maxValues[i] = zmax[i];
+  }
+  return True;
+}
+
 } //# NAMESPACE CASACORE - END
 
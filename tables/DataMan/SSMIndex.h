@@ -74,6 +74,11 @@ class SSMBase;
 //       When a new column is added <linkto class=SSMBase>SSMBase</linkto>
 //       will scan the SSMIndex objects to find the hole fitting best.
 // </ol>
+// Optionally it keeps a zone map for some of its columns (identified by
+// their offset in the bucket). A zone map holds the minimum and maximum
+// value in each bucket, so a selection can skip the buckets that cannot
+// contain matching values. A zone can be wider than the actual values
+// (e.g. after rows are removed), but never narrower.
 // </synopsis>
   
 // <todo asof="$DATE:$">
@@ -119,6 +124,7 @@ public:
 
   // A column is removed.
   // Set the free space at offset for a field with the given nr of bits.
+  // Its zone map (if any) is removed.
   // It returns the nr of columns still used in this index.
   Int removeColumn (Int anOffset, uInt nbits);
 
@@ -144,6 +150,26 @@ public:
   void find (rownr_t aRowNumber, uInt& aBucketNr, rownr_t& aStartRow,
 	     rownr_t& anEndRow, const String& colName) const;
 
+  // Start a zone map for the column at the given offset.
+  // All existing buckets are initialized with an empty zone [0,0], because
+  // the bucket data of a new column are zeroes.
+  void addZoneMap (Int anOffset);
+
+  // Does the column at the given offset have a zone map?
+  Bool hasZoneMap (Int anOffset) const;
+
+  // Does any column in this index have a zone map?
+  Bool hasZoneMaps() const;
+
+  // Widen the zone of the bucket containing the given row with the given
+  // values. Nothing is done if the column has no zone map or if a value is NaN.
+  void updateZone (Int anOffset, rownr_t aRowNr, Double aMin, Double aMax);
+
+  // Get the last row number, minimum and maximum of each bucket.
+  // False is returned if the column at the given offset has no zone map.
+  Bool getZoneMap (Int anOffset, Vector<rownr_t>& endRows,
+                   Vector<Double>& minValues, Vector<Double>& maxValues) const;
+
 private:
   // Get the index of the bucket containing the given row.
   uInt getIndex (rownr_t aRowNr, const String& colName) const;
@@ -171,6 +197,11 @@ private:
 
   //# Nr of columns using this index.
   Int itsNrColumns;
+
+  //# Per column offset the minimum and maximum value in each bucket.
+  //# They are indexed together with itsLastRow.
+  std::map<Int,Block<Double>> itsZoneMin;
+  std::map<Int,Block<Double>> itsZoneMax;
 };
 
 
@@ -106,6 +106,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <p>
 // As said above all string arrays and variable length scalar strings
 // are stored in separate string buckets. 
+// <p>
+// Optionally StandardStMan keeps a zone map for the scalar columns with a
+// numeric data type (see function <src>setZoneMaps</src> in class
+// <linkto class=SSMBase>SSMBase</linkto> or field ZONEMAPS in the
+// specification record). It holds the minimum and maximum value of each
+// column in each bucket and is stored in the index. A table selection with
+// a range predicate on such a column (e.g. <src>TIME > t1 && TIME < t2</src>)
+// uses it to skip the buckets that cannot match, so these buckets are not
+// read. It is most effective for columns with (nearly) sorted values.
 // </synopsis>
 
 // <motivation>
@@ -70,6 +70,7 @@ ROStandardStManAccessor& ROStandardStManAccessor::operator=
 void ROStandardStManAccessor::setCacheSize (uInt aSize,
                                             Bool canExceedNrBuckets)
 {
+    std::lock_guard<std::recursive_mutex> lock(itsSSMPtr->accessMutex());
     itsSSMPtr->setCacheSize (aSize, canExceedNrBuckets);
 }
 
@@ -80,11 +81,13 @@ uInt ROStandardStManAccessor::getCacheSize() const
 
 void ROStandardStManAccessor::clearCache()
 {
+    std::lock_guard<std::recursive_mutex> lock(itsSSMPtr->accessMutex());
     itsSSMPtr->clearCache();
 }
 
 void ROStandardStManAccessor::showBaseStatistics (ostream& anOs) const
 {
+    std::lock_guard<std::recursive_mutex> lock(itsSSMPtr->accessMutex());
     itsSSMPtr->showBaseStatistics (anOs);
 }
 
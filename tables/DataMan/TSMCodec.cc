@@ -0,0 +1,323 @@
+//# TSMCodec.cc: Lossless codecs for the tiles of the Tiled Storage Manager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <cstring>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TSMCodec::Type TSMCodec::fromString (const String& name)
+{
+    String str(name);
+    str.upcase();
+    if (str.empty()  ||  str == "NONE") {
+        return None;
+    } else if (str == "RLE") {
+        return RLE;
+    } else if (str == "ZLIB") {
+        return Zlib;
+    } else if (str == "ZSTD") {
+        return Zstd;
+    } else if (str == "LZ4") {
+        return LZ4;
+    }
+    throw TSMError ("Unknown TSM tile codec " + name);
+}
+
+String TSMCodec::toString (Type codec)
+{
+    switch (codec) {
+    case None:
+        return "NONE";
+    case RLE:
+        return "RLE";
+    case Zlib:
+        return "ZLIB";
+    case Zstd:
+        return "ZSTD";
+    case LZ4:
+        return "LZ4";
+    }
+    return "UNKNOWN";
+}
+
+Bool TSMCodec::isAvailable (Type codec)
+{
+    switch (codec) {
+    case None:
+    case RLE:
+        return True;
+    case Zlib:
+#ifdef HAVE_ZLIB
+        return True;
+#else
+        return False;
+#endif
+    case Zstd:
+#ifdef HAVE_ZSTD
+        return True;
+#else
+        return False;
+#endif
+    case LZ4:
+#ifdef HAVE_LZ4
+        return True;
+#else
+        return False;
+#endif
+    }
+    return False;
+}
+
+void TSMCodec::checkAvailable (Type codec)
+{
+    if (! isAvailable (codec)) {
+        throw TSMError ("TSM tile codec " + toString(codec) +
+                        " is not available in this build of casacore");
+    }
+}
+
+void TSMCodec::shuffle (uInt elementSize, const char* in, uInt length,
+                        char* out)
+{
+    uInt nelem = length / elementSize;
+    for (uInt b=0; b<elementSize; ++b) {
+        const char* inp = in + b;
+        for (uInt i=0; i<nelem; ++i) {
+            *out++ = *inp;
+            inp += elementSize;
+        }
+    }
+    uInt ndone = nelem * elementSize;
+    memcpy (out, in + ndone, length - ndone);
+}
+
+void TSMCodec::unshuffle (uInt elementSize, const char* in, uInt length,
+                          char* out)
+{
+    uInt nelem = length / elementSize;
+    for (uInt b=0; b<elementSize; ++b) {
+        char* outp = out + b;
+        for (uInt i=0; i<nelem; ++i) {
+            *outp = *in++;
+            outp += elementSize;
+        }
+    }
+    uInt ndone = nelem * elementSize;
+    memcpy (out + ndone, in, length - ndone);
+}
+
+// The encoding is a sequence of runs, each starting with a control byte c.
+// If c < 128, it is followed by c+1 literal bytes. Otherwise the next byte
+// has to be repeated c-125 times (thus 3 to 130 times).
+uInt TSMCodec::rleEncode (const char* in, uInt length, char* out,
+                          uInt maxLength)
+{
+    uInt nout = 0;
+    uInt i = 0;
+    while (i < length) {
+        // Determine the length of the run starting at i.
+        uInt nrun = 1;
+        while (i+nrun < length  &&  nrun < 130  &&  in[i+nrun] == in[i]) {
+            nrun++;
+        }
+        if (nrun >= 3) {
+            if (nout + 2 > maxLength) {
+                return 0;
+            }
+            out[nout++] = char(nrun + 125);
+            out[nout++] = in[i];
+            i += nrun;
+        } else {
+            // Collect literals until a run of at least 3 equal bytes starts.
+            uInt st = i;
+            while (i < length  &&  i-st < 128) {
+                if (i+2 < length  &&  in[i] == in[i+1]  &&  in[i] == in[i+2]) {
+                    break;
+                }
+                i++;
+            }
+            uInt nlit = i - st;
+            if (nout + 1 + nlit > maxLength) {
+                return 0;
+            }
+            out[nout++] = char(nlit - 1);
+            memcpy (out + nout, in + st, nlit);
+            nout += nlit;
+        }
+    }
+    return nout;
+}
+
+Bool TSMCodec::rleDecode (const char* in, uInt length, char* out,
+                          uInt rawLength)
+{
+    uInt nout = 0;
+    uInt i = 0;
+    while (i < length) {
+        uInt c = static_cast<unsigned char>(in[i++]);
+        if (c < 128) {
+            uInt nlit = c + 1;
+            if (i + nlit > length  ||  nout + nlit > rawLength) {
+                return False;
+            }
+            memcpy (out + nout, in + i, nlit);
+            i += nlit;
+            nout += nlit;
+        } else {
+            uInt nrun = c - 125;
+            if (i >= length  ||  nout + nrun > rawLength) {
+                return False;
+            }
+            memset (out + nout, in[i++], nrun);
+            nout += nrun;
+        }
+    }
+    return nout == rawLength;
+}
+
+uInt TSMCodec::compress (Type codec, uInt elementSize,
+                         const char* in, uInt length,
+                         std::vector<char>& out)
+{
+    checkAvailable (codec);
+    if (codec == None  ||  length == 0) {
+        return 0;
+    }
+    // Shuffle the bytes if needed.
+    std::vector<char> shuffled;
+    const char* data = in;
+    if (elementSize > 1) {
+        shuffled.resize (length);
+        shuffle (elementSize, in, length, shuffled.data());
+        data = shuffled.data();
+    }
+    uInt nout = 0;
+    switch (codec) {
+    case RLE:
+        out.resize (length);
+        nout = rleEncode (data, length, out.data(), length-1);
+        break;
+    case Zlib:
+#ifdef HAVE_ZLIB
+        {
+            uLongf dlen = compressBound (length);
+            out.resize (dlen);
+            if (compress2 (reinterpret_cast<Bytef*>(out.data()), &dlen,
+                           reinterpret_cast<const Bytef*>(data), length,
+                           1) == Z_OK) {
+                nout = dlen;
+            }
+        }
+#endif
+        break;
+    case Zstd:
+#ifdef HAVE_ZSTD
+        {
+            out.resize (ZSTD_compressBound (length));
+            size_t n = ZSTD_compress (out.data(), out.size(), data, length, 1);
+            if (! ZSTD_isError(n)) {
+                nout = n;
+            }
+        }
+#endif
+        break;
+    case LZ4:
+#ifdef HAVE_LZ4
+        out.resize (LZ4_compressBound (length));
+        nout = LZ4_compress_default (data, out.data(), length, out.size());
+#endif
+        break;
+    default:
+        break;
+    }
+    return (nout < length  ?  nout : 0);
+}
+
+void TSMCodec::decompress (Type codec, uInt elementSize,
+                           const char* in, uInt length,
+                           char* out, uInt rawLength)
+{
+    checkAvailable (codec);
+    // Decompress into a temporary buffer if the bytes have to be unshuffled.
+    std::vector<char> shuffled;
+    char* data = out;
+    if (elementSize > 1) {
+        shuffled.resize (rawLength);
+        data = shuffled.data();
+    }
+    Bool ok = False;
+    switch (codec) {
+    case RLE:
+        ok = rleDecode (in, length, data, rawLength);
+        break;
+    case Zlib:
+#ifdef HAVE_ZLIB
+        {
+            uLongf dlen = rawLength;
+            ok = uncompress (reinterpret_cast<Bytef*>(data), &dlen,
+                             reinterpret_cast<const Bytef*>(in),
+                             length) == Z_OK  &&  dlen == rawLength;
+        }
+#endif
+        break;
+    case Zstd:
+#ifdef HAVE_ZSTD
+        ok = ZSTD_decompress (data, rawLength, in, length) == rawLength;
+#endif
+        break;
+    case LZ4:
+#ifdef HAVE_LZ4
+        ok = LZ4_decompress_safe (in, data, length, rawLength) == Int(rawLength);
+#endif
+        break;
+    default:
+        break;
+    }
+    if (!ok) {
+        throw TSMError ("TSMCodec: corrupt " + toString(codec) +
+                        " compressed tile");
+    }
+    if (elementSize > 1) {
+        unshuffle (elementSize, data, rawLength, out);
+    }
+}
+
+} //# NAMESPACE CASACORE - END
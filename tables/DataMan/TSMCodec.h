@@ -0,0 +1,161 @@
+//# TSMCodec.h: Lossless codecs for the tiles of the Tiled Storage Manager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCODEC_H
+#define TABLES_TSMCODEC_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Lossless codecs for the tiles of the Tiled Storage Manager
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledCompressed.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TSMCompressedFile>TSMCompressedFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCodec compresses and decompresses the tiles of a Tiled Storage Manager
+// whose files are compressed (see class
+// <linkto class=TSMCompressedFile>TSMCompressedFile</linkto>).
+// Each tile is compressed independently, so a tile can be read without
+// reading any other tile.
+// <p>
+// Before compressing, the bytes of the tile are shuffled, i.e., the first
+// bytes of all elements are stored first, thereafter all second bytes, etc.
+// The element size is the size of the basic data type of the columns
+// (thus 4 for Float and Complex). Shuffling makes that the mostly equal
+// high order bytes of numbers form long runs, which compress well.
+// <br>The following codecs are supported:
+// <ul>
+//  <li> <src>RLE</src> is a simple run-length encoding of the shuffled bytes.
+//       It is always available and very fast, but only effective for data
+//       with long runs of equal bytes like flags and constant weights.
+//  <li> <src>ZLIB</src> uses zlib with its fastest compression level.
+//  <li> <src>ZSTD</src> uses Zstandard with its fastest compression level.
+//  <li> <src>LZ4</src> uses LZ4, which decompresses fastest.
+// </ul>
+// ZLIB, ZSTD and LZ4 are only available if casacore was built with
+// the corresponding library (see function <src>isAvailable</src>).
+// A tile that does not get smaller when compressed, is stored as is.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   std::vector<char> compressed;
+//   uInt n = TSMCodec::compress (TSMCodec::RLE, 4, tile, tileSize,
+//                                compressed);
+//   if (n > 0) {
+//     TSMCodec::decompress (TSMCodec::RLE, 4, compressed.data(), n,
+//                           tile, tileSize);
+//   }
+// </srcblock>
+// </example>
+
+class TSMCodec
+{
+public:
+    // Define the possible codecs.
+    // The values are stored in the files, so they should not be changed.
+    enum Type {
+      // Tiles are not compressed.
+      None = 0,
+      // Byte shuffle and run-length encoding.
+      RLE  = 1,
+      // Byte shuffle and zlib.
+      Zlib = 2,
+      // Byte shuffle and Zstandard.
+      Zstd = 3,
+      // Byte shuffle and LZ4.
+      LZ4  = 4
+    };
+
+    // Get the codec from its (case-insensitive) name.
+    // An empty name means None.
+    // An exception is thrown if the name is unknown.
+    static Type fromString (const String& name);
+
+    // Get the name of the codec.
+    static String toString (Type codec);
+
+    // Is the codec available in this build?
+    static Bool isAvailable (Type codec);
+
+    // Throw an exception if the codec is not available.
+    static void checkAvailable (Type codec);
+
+    // Compress the data in <src>in</src> into <src>out</src> (which is
+    // resized as needed). The elementSize is used to shuffle the bytes.
+    // It returns the length of the compressed data, or 0 if compressing
+    // does not make the data smaller.
+    static uInt compress (Type codec, uInt elementSize,
+                          const char* in, uInt length,
+                          std::vector<char>& out);
+
+    // Decompress the data in <src>in</src> into <src>out</src> which must
+    // have the length <src>rawLength</src> of the uncompressed data.
+    // An exception is thrown if the data are corrupt.
+    static void decompress (Type codec, uInt elementSize,
+                            const char* in, uInt length,
+                            char* out, uInt rawLength);
+
+    // Shuffle or unshuffle the bytes of the elements.
+    // The remaining bytes (if length is not a multiple of elementSize)
+    // are copied as is.
+    // <group>
+    static void shuffle (uInt elementSize, const char* in, uInt length,
+                         char* out);
+    static void unshuffle (uInt elementSize, const char* in, uInt length,
+                           char* out);
+    // </group>
+
+private:
+    // Run-length encode and decode.
+    // <group>
+    static uInt rleEncode (const char* in, uInt length, char* out,
+                           uInt maxLength);
+    static Bool rleDecode (const char* in, uInt length, char* out,
+                           uInt rawLength);
+    // </group>
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
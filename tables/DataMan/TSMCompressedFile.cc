@@ -0,0 +1,312 @@
+//# TSMCompressedFile.cc: File with independently compressed tiles for the TSM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/TSMCompressedFile.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <cstring>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TSMCompressedFile::TSMCompressedFile (const String& fileName,
+                                      TSMCodec::Type codec,
+                                      uInt elementSize,
+                                      MultiFileBase* mfile)
+: BucketFile     (fileName, 0, False, mfile),
+  codec_p        (codec),
+  elementSize_p  (elementSize),
+  position_p     (0),
+  logicalSize_p  (0),
+  physicalSize_p (0)
+{
+  TSMCodec::checkAvailable (codec);
+}
+
+TSMCompressedFile::TSMCompressedFile (const String& fileName, Bool writable,
+                                      TSMCodec::Type codec,
+                                      uInt elementSize,
+                                      MultiFileBase* mfile)
+: BucketFile     (fileName, writable, 0, False, mfile),
+  codec_p        (codec),
+  elementSize_p  (elementSize),
+  position_p     (0),
+  logicalSize_p  (0),
+  physicalSize_p (0)
+{
+  TSMCodec::checkAvailable (codec);
+}
+
+TSMCompressedFile::~TSMCompressedFile()
+{}
+
+CountedPtr<ByteIO> TSMCompressedFile::makeFilebufIO (uInt)
+{
+  throw TSMError ("TSMCompressedFile: buffered IO cannot be used for "
+                  "compressed file " + name());
+}
+
+Bool TSMCompressedFile::canReadAsync() const
+{
+  return False;
+}
+
+Bool TSMCompressedFile::hasBatchRead() const
+{
+  return False;
+}
+
+void TSMCompressedFile::seek (Int64 offset)
+{
+  position_p = offset;
+}
+
+Int64 TSMCompressedFile::fileSize() const
+{
+  return logicalSize_p;
+}
+
+Int64 TSMCompressedFile::uncompressedSize() const
+{
+  Int64 size = 0;
+  for (const auto& tile : index_p) {
+    size += tile.second.rawLength;
+  }
+  return size;
+}
+
+Int64 TSMCompressedFile::freeSize() const
+{
+  Int64 size = 0;
+  for (const auto& extent : freeOffsets_p) {
+    size += extent.second;
+  }
+  return size;
+}
+
+Int64 TSMCompressedFile::allocate (uInt length)
+{
+  std::set<std::pair<Int64,Int64>>::iterator iter =
+    freeLengths_p.lower_bound (std::make_pair (Int64(length), Int64(0)));
+  if (iter == freeLengths_p.end()) {
+    Int64 offset = physicalSize_p;
+    physicalSize_p += length;
+    return offset;
+  }
+  Int64 extLength = iter->first;
+  Int64 offset    = iter->second;
+  freeLengths_p.erase (iter);
+  freeOffsets_p.erase (offset);
+  // Keep the remainder as a free extent.
+  if (extLength > length) {
+    freeOffsets_p[offset + length] = extLength - length;
+    freeLengths_p.insert (std::make_pair (extLength - length,
+                                          offset + length));
+  }
+  return offset;
+}
+
+void TSMCompressedFile::release (Int64 offset, Int64 length)
+{
+  if (length <= 0) {
+    return;
+  }
+  // Merge with the next free extent.
+  std::map<Int64,Int64>::iterator iter = freeOffsets_p.find (offset + length);
+  if (iter != freeOffsets_p.end()) {
+    length += iter->second;
+    freeLengths_p.erase (std::make_pair (iter->second, iter->first));
+    freeOffsets_p.erase (iter);
+  }
+  // Merge with the previous free extent.
+  iter = freeOffsets_p.lower_bound (offset);
+  if (iter != freeOffsets_p.begin()) {
+    --iter;
+    if (iter->first + iter->second == offset) {
+      offset  = iter->first;
+      length += iter->second;
+      freeLengths_p.erase (std::make_pair (iter->second, iter->first));
+      freeOffsets_p.erase (iter);
+    }
+  }
+  // Space at the end of the file is not needed anymore.
+  if (offset + length == physicalSize_p) {
+    physicalSize_p = offset;
+  } else {
+    freeOffsets_p[offset] = length;
+    freeLengths_p.insert (std::make_pair (length, offset));
+  }
+}
+
+void TSMCompressedFile::makeFreeList()
+{
+  freeOffsets_p.clear();
+  freeLengths_p.clear();
+  std::vector<std::pair<Int64,Int64>> extents;
+  extents.reserve (index_p.size());
+  for (const auto& tile : index_p) {
+    extents.push_back (std::make_pair (tile.second.offset,
+                                       Int64(tile.second.capacity)));
+  }
+  std::sort (extents.begin(), extents.end());
+  Int64 end = 0;
+  for (const auto& extent : extents) {
+    if (extent.first > end) {
+      release (end, extent.first - end);
+    }
+    end = std::max (end, extent.first + extent.second);
+  }
+  release (end, physicalSize_p - end);
+}
+
+uInt TSMCompressedFile::read (void* buffer, uInt length)
+{
+  char* out = static_cast<char*>(buffer);
+  std::unordered_map<Int64,TileLocation>::const_iterator iter =
+    index_p.find (position_p);
+  if (iter == index_p.end()) {
+    // The tile has not been written yet, so it is empty.
+    memset (out, 0, length);
+  } else {
+    const TileLocation& tile = iter->second;
+    // Read the tile as stored.
+    buffer_p.resize (tile.length);
+    BucketFile::seek (tile.offset);
+    BucketFile::read (buffer_p.data(), tile.length);
+    if (tile.length == tile.rawLength) {
+      memcpy (out, buffer_p.data(), std::min(length, tile.rawLength));
+    } else if (length == tile.rawLength) {
+      TSMCodec::decompress (codec_p, elementSize_p, buffer_p.data(),
+                            tile.length, out, tile.rawLength);
+    } else {
+      // Only part of the tile is asked for (e.g. a free list pointer).
+      std::vector<char> raw(tile.rawLength);
+      TSMCodec::decompress (codec_p, elementSize_p, buffer_p.data(),
+                            tile.length, raw.data(), tile.rawLength);
+      memcpy (out, raw.data(), std::min(length, tile.rawLength));
+    }
+    if (length > tile.rawLength) {
+      memset (out + tile.rawLength, 0, length - tile.rawLength);
+    }
+  }
+  position_p += length;
+  return length;
+}
+
+uInt TSMCompressedFile::write (const void* buffer, uInt length)
+{
+  const char* in = static_cast<const char*>(buffer);
+  uInt clen = TSMCodec::compress (codec_p, elementSize_p, in, length,
+                                  buffer_p);
+  // Store the tile uncompressed if it does not shrink.
+  const char* data = in;
+  if (clen == 0) {
+    clen = length;
+  } else {
+    data = buffer_p.data();
+  }
+  std::unordered_map<Int64,TileLocation>::iterator iter =
+    index_p.find (position_p);
+  if (iter == index_p.end()) {
+    TileLocation tile;
+    tile.offset   = allocate (clen);
+    tile.capacity = clen;
+    iter = index_p.insert (std::make_pair(position_p, tile)).first;
+  } else if (clen > iter->second.capacity) {
+    // The tile does not fit in its old space, so move it.
+    // Its old space can be reused.
+    release (iter->second.offset, iter->second.capacity);
+    iter->second.offset   = allocate (clen);
+    iter->second.capacity = clen;
+  }
+  iter->second.length    = clen;
+  iter->second.rawLength = length;
+  BucketFile::seek (iter->second.offset);
+  BucketFile::write (data, clen);
+  position_p += length;
+  logicalSize_p = std::max (logicalSize_p, position_p);
+  return length;
+}
+
+void TSMCompressedFile::putIndex (AipsIO& ios) const
+{
+  uInt64 nr = index_p.size();
+  std::vector<Int64> logical, offsets;
+  std::vector<uInt> lengths, rawLengths, capacities;
+  logical.reserve (nr);
+  offsets.reserve (nr);
+  lengths.reserve (nr);
+  rawLengths.reserve (nr);
+  capacities.reserve (nr);
+  for (const auto& tile : index_p) {
+    logical.push_back (tile.first);
+    offsets.push_back (tile.second.offset);
+    lengths.push_back (tile.second.length);
+    rawLengths.push_back (tile.second.rawLength);
+    capacities.push_back (tile.second.capacity);
+  }
+  ios << nr << logicalSize_p << physicalSize_p;
+  if (nr > 0) {
+    ios.put (nr, logical.data(), False);
+    ios.put (nr, offsets.data(), False);
+    ios.put (nr, lengths.data(), False);
+    ios.put (nr, rawLengths.data(), False);
+    ios.put (nr, capacities.data(), False);
+  }
+}
+
+void TSMCompressedFile::getIndex (AipsIO& ios)
+{
+  uInt64 nr;
+  ios >> nr >> logicalSize_p >> physicalSize_p;
+  std::vector<Int64> logical(nr), offsets(nr);
+  std::vector<uInt> lengths(nr), rawLengths(nr), capacities(nr);
+  if (nr > 0) {
+    ios.get (nr, logical.data());
+    ios.get (nr, offsets.data());
+    ios.get (nr, lengths.data());
+    ios.get (nr, rawLengths.data());
+    ios.get (nr, capacities.data());
+  }
+  index_p.clear();
+  index_p.reserve (nr);
+  for (uInt64 i=0; i<nr; ++i) {
+    TileLocation tile;
+    tile.offset    = offsets[i];
+    tile.length    = lengths[i];
+    tile.rawLength = rawLengths[i];
+    tile.capacity  = capacities[i];
+    index_p.insert (std::make_pair(logical[i], tile));
+  }
+  makeFreeList();
+}
+
+} //# NAMESPACE CASACORE - END
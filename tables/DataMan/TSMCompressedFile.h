@@ -0,0 +1,208 @@
+//# TSMCompressedFile.h: File with independently compressed tiles for the TSM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TSMCOMPRESSEDFILE_H
+#define TABLES_TSMCOMPRESSEDFILE_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class AipsIO;
+
+
+// <summary>
+// File with independently compressed tiles for the Tiled Storage Manager
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledCompressed.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TSMFile>TSMFile</linkto>
+//   <li> <linkto class=BucketFile>BucketFile</linkto>
+//   <li> <linkto class=TSMCodec>TSMCodec</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TSMCompressedFile is a BucketFile storing each bucket (i.e., tile)
+// compressed with the given <linkto class=TSMCodec>TSMCodec</linkto>.
+// It is used by <linkto class=TSMFile>TSMFile</linkto> if a tile codec
+// is set in the <linkto class=TiledStMan>TiledStMan</linkto>.
+// <p>
+// The BucketCache reading and writing the tiles sees the logical
+// (uncompressed) file. Each write of a tile at a logical offset is
+// compressed and stored at a physical offset in the file. An index
+// maps the logical offset of a tile to its physical location, so a tile
+// is found in constant time. If a rewritten tile fits in the space of
+// the old one, it is stored in place, otherwise it is moved and the space
+// of the old tile is freed.
+// <br>The free extents are reused for tiles written thereafter. A tile
+// is stored in the smallest free extent it fits in (and the remainder is
+// kept as a free extent). If there is none, the tile is appended to the
+// file. Adjacent free extents are merged, and a free extent at the end
+// of the file is removed. Note that the file is not truncated.
+// <br>The index is kept in memory and is stored by the TSMFile
+// in the header of the TiledStMan. The free extents are not stored,
+// but are derived from the gaps between the tiles when the index is read.
+// <p>
+// Because reading a tile involves decompression, the file cannot be
+// read asynchronously, memory-mapped or buffered.
+// </synopsis>
+
+class TSMCompressedFile : public BucketFile
+{
+public:
+    // Create a new file with the given codec.
+    // The element size is the size of the basic data type of the data
+    // (see <linkto class=TSMCodec>TSMCodec</linkto>).
+    TSMCompressedFile (const String& fileName, TSMCodec::Type codec,
+                       uInt elementSize, MultiFileBase* mfile=0);
+
+    // Create the object for an existing file.
+    // Its index has to be read using <src>getIndex</src>.
+    TSMCompressedFile (const String& fileName, Bool writable,
+                       TSMCodec::Type codec, uInt elementSize,
+                       MultiFileBase* mfile=0);
+
+    virtual ~TSMCompressedFile();
+
+    // Buffered IO cannot be used.
+    virtual CountedPtr<ByteIO> makeFilebufIO (uInt bufferSize);
+
+    // Read a tile starting at the current logical offset and decompress it.
+    // A tile that has never been written is returned as zeroes.
+    virtual uInt read (void* buffer, uInt length);
+
+    // Compress a tile and write it at the current logical offset.
+    virtual uInt write (const void* buffer, uInt length);
+
+    // Seek to a logical offset.
+    virtual void seek (Int64 offset);
+
+    // Get the logical size of the file.
+    virtual Int64 fileSize() const;
+
+    // The file cannot be read asynchronously.
+    // <group>
+    virtual Bool canReadAsync() const;
+    virtual Bool hasBatchRead() const;
+    // </group>
+
+    // Get the codec and element size used.
+    // <group>
+    TSMCodec::Type codec() const
+      { return codec_p; }
+    uInt elementSize() const
+      { return elementSize_p; }
+    // </group>
+
+    // Get the number of tiles stored.
+    uInt64 nrTiles() const
+      { return index_p.size(); }
+
+    // Get the physical size of the file (the compressed tiles).
+    Int64 compressedSize() const
+      { return physicalSize_p; }
+
+    // Get the total logical size of the tiles stored.
+    Int64 uncompressedSize() const;
+
+    // Get the total size of the free extents.
+    Int64 freeSize() const;
+
+    // Write or read the index.
+    // <group>
+    void putIndex (AipsIO& ios) const;
+    void getIndex (AipsIO& ios);
+    // </group>
+
+private:
+    // The location of a tile in the file.
+    struct TileLocation {
+      // Physical offset.
+      Int64 offset;
+      // Length of the compressed tile (equals rawLength if not compressed).
+      uInt  length;
+      // Length of the uncompressed tile.
+      uInt  rawLength;
+      // Space available at the offset.
+      uInt  capacity;
+    };
+
+    // Forbid copy constructor and assignment.
+    // <group>
+    TSMCompressedFile (const TSMCompressedFile&);
+    TSMCompressedFile& operator= (const TSMCompressedFile&);
+    // </group>
+
+    // Get the physical offset of the space for a tile with the given length.
+    // It uses the smallest free extent that is large enough, otherwise the
+    // tile is appended to the file.
+    Int64 allocate (uInt length);
+
+    // Add the space at the given physical offset to the free extents.
+    // It is merged with adjacent free extents.
+    void release (Int64 offset, Int64 length);
+
+    // Derive the free extents from the gaps between the tiles.
+    void makeFreeList();
+
+    TSMCodec::Type codec_p;
+    uInt           elementSize_p;
+    // The current logical offset.
+    Int64          position_p;
+    // The logical and physical size of the file.
+    Int64          logicalSize_p;
+    Int64          physicalSize_p;
+    // Map of logical offset of a tile to its location.
+    std::unordered_map<Int64,TileLocation> index_p;
+    // The free extents mapping physical offset to length.
+    std::map<Int64,Int64> freeOffsets_p;
+    // The free extents ordered by length (and offset).
+    std::set<std::pair<Int64,Int64>> freeLengths_p;
+    // Buffer for compressed data.
+    std::vector<char> buffer_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -45,6 +45,7 @@
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/string.h>                           // for memcpy
 #include <casacore/casa/iostream.h>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -94,7 +95,14 @@ TSMCube::TSMCube (TiledStMan* stman, TSMFile* file,
   fileOffset_p   (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  tileUseSeq_p   (0),
+  tileUseFirst_p (0),
+  maxTileHistory_p (0),
+  nadaptive_p    (0),
+  pixelExternalLength_p (0),
+  pixelLocalLength_p (0),
+  nconstGet_p    (0)
 {
     if (fileOffset < 0) {
         // TiledCellStMan uses an empty shape; setShape is called later. 
@@ -121,7 +129,14 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
   filePtr_p      (0),
   cache_p        (0),
   userSetCache_p (False),
-  lastColAccess_p(NoAccess)
+  lastColAccess_p(NoAccess),
+  tileUseSeq_p   (0),
+  tileUseFirst_p (0),
+  maxTileHistory_p (0),
+  nadaptive_p    (0),
+  pixelExternalLength_p (0),
+  pixelLocalLength_p (0),
+  nconstGet_p    (0)
 {
     Int fileSeqnr = getObject (ios);
     if (fileSeqnr >= 0) {
@@ -134,7 +149,7 @@ TSMCube::TSMCube (TiledStMan* stman, AipsIO& ios,
 TSMCube::~TSMCube()
 {
     delete cache_p;
-    delete [] cachedTile_p;
+    delete [] cachedTile_p.load();
 }
 
 
@@ -152,6 +167,7 @@ void TSMCube::emptyCache()
     if (cache_p != 0) {
         cache_p->resize (0);
     }
+    resetTileHistory();
     userSetCache_p = False;
     lastColAccess_p = NoAccess;
 }
@@ -168,6 +184,35 @@ void TSMCube::showCacheStatistics (ostream& os) const
     }
 }
 
+Record TSMCube::cacheStatistics() const
+{
+    uInt naccess = 0, nread = 0, ninit = 0, nwrite = 0, nevict = 0;
+    uInt cacheSize = 0;
+    if (cache_p != 0) {
+        cacheSize = cache_p->cacheSize();
+        naccess   = cache_p->nAccess();
+        nread     = cache_p->nRead();
+        ninit     = cache_p->nInit();
+        nwrite    = cache_p->nWrite();
+        nevict    = cache_p->nEvict();
+    }
+    Record rec;
+    rec.define ("CacheSize", Int(cacheSize));
+    rec.define ("BucketSize", Int(bucketSize_p));
+    rec.define ("Accesses", Int64(naccess));
+    rec.define ("Hits", Int64(naccess) - nread - ninit);
+    rec.define ("Misses", Int64(nread) + ninit);
+    rec.define ("Evictions", Int64(nevict));
+    rec.define ("Reads", Int64(nread));
+    rec.define ("Writes", Int64(nwrite));
+    rec.define ("BytesRead", Int64(nread) * bucketSize_p);
+    rec.define ("BytesWritten", Int64(nwrite) * bucketSize_p);
+    rec.define ("AdaptiveResizes", Int64(nadaptive_p));
+    rec.define ("ConstantTiles", Int64(constTiles_p.size()));
+    rec.define ("ConstantGets", Int64(nconstGet_p));
+    return rec;
+}
+
 uInt TSMCube::coordinateSize (const String& coordinateName) const
 {
     if (! values_p.isDefined (coordinateName)) {
@@ -286,8 +331,13 @@ void TSMCube::putObject (AipsIO& ios)
     flushCache();
     // If the offset is small enough, write it as an old style file,
     // so older software can still read it.
+    // Version 3 is only used if constant tiles are kept.
     Bool vers1 = (fileOffset_p < 2u*1024u*1024u*1024u);
-    if (vers1) {
+    Bool vers3 = stmanPtr_p->constantTiles();
+    if (vers3) {
+        vers1 = False;
+        ios << 3;                          // version 3
+    } else if (vers1) {
         ios << 1;                          // version 1
     } else {
         ios << 2;                          // version 2
@@ -307,6 +357,9 @@ void TSMCube::putObject (AipsIO& ios)
     } else {
 	ios << fileOffset_p;
     }
+    if (vers3) {
+        putConstantTiles (ios);
+    }
 }
 Int TSMCube::getObject (AipsIO& ios)
 {
@@ -326,6 +379,13 @@ Int TSMCube::getObject (AipsIO& ios)
     } else {
         ios >> fileOffset_p;
     }
+    if (version >= 3) {
+        getConstantTiles (ios);
+    } else {
+        constTiles_p.clear();
+        constValues_p.clear();
+        constLocalValues_p.clear();
+    }
     return fileSeqnr;
 }
 
@@ -351,6 +411,10 @@ void TSMCube::setup()
     bucketSize_p = stmanPtr_p->getLengthOffset (tileSize_p, externalOffset_p,
 						localOffset_p,
 						localTileLength_p);
+    // Also for a single pixel (used for constant tiles).
+    pixelExternalLength_p = stmanPtr_p->getLengthOffset
+                               (1, pixelExternalOffset_p, pixelLocalOffset_p,
+                                pixelLocalLength_p);
 
     // Resize IPosition member variables used in accessSection()
     resizeTileSections();
@@ -379,6 +443,10 @@ void TSMCube::makeCache()
                                    bucketSize_p, nrTiles_p, 1, this,
                                    readCallBack, writeCallBack,
                                    initCallBack, deleteCallBack);
+        if (stmanPtr_p->constantTiles()) {
+            cache_p->setLocalCallBacks (getLocalCallBack, skipWriteCallBack);
+        }
+        cache_p->setReleaseMutex (stmanPtr_p->cacheReleaseMutex());
     }
 }
 
@@ -668,12 +736,8 @@ char* TSMCube::readCallBack (void* owner, const char* external)
 }
 char* TSMCube::readTile (const char* external)
 {
-    char* local = 0;
-
-    if (cachedTile_p != 0){
-        local = cachedTile_p;
-        cachedTile_p = 0;
-    } else {
+    char* local = cachedTile_p.exchange (0);
+    if (local == 0) {
         local = new char[localTileLength_p];
     }
 
@@ -693,9 +757,8 @@ void TSMCube::writeTile (char* external, const char* local)
 void TSMCube::deleteCallBack (void* owner, char* buffer)
 {
     TSMCube * tsmCube = ((TSMCube*)owner);
-    if (tsmCube->cachedTile_p == 0){
-        tsmCube->cachedTile_p = buffer;
-    } else {
+    char* empty = 0;
+    if (! tsmCube->cachedTile_p.compare_exchange_strong (empty, buffer)) {
         delete [] buffer;
     }
 }
@@ -707,6 +770,148 @@ char* TSMCube::initCallBack (void* owner)
     return buffer;
 }
 
+char* TSMCube::getLocalCallBack (void* owner, uInt tileNr)
+{
+    return ((TSMCube*)owner)->makeConstantTile (tileNr);
+}
+Bool TSMCube::skipWriteCallBack (void* owner, uInt tileNr, const char* local)
+{
+    return ((TSMCube*)owner)->recordConstantTile (tileNr, local);
+}
+
+char* TSMCube::makeConstantTile (uInt tileNr)
+{
+    std::unordered_map<uInt,uInt>::const_iterator iter =
+      constTiles_p.find (tileNr);
+    if (iter == constTiles_p.end()) {
+        return 0;
+    }
+    const std::vector<char>& value = constLocalValue (iter->second);
+    char* local = cachedTile_p.exchange (0);
+    if (local == 0) {
+        local = new char[localTileLength_p];
+    }
+    // Replicate the value of each column by doubling the part filled.
+    for (uInt i=0; i<localOffset_p.nelements(); ++i) {
+        uInt pixelSize = pixelLocalSize (i);
+        char* data = local + localOffset_p[i];
+        size_t length = size_t(tileSize_p) * pixelSize;
+        size_t done = pixelSize;
+        memcpy (data, &value[pixelLocalOffset_p[i]], pixelSize);
+        while (done < length) {
+            size_t n = std::min (done, length - done);
+            memcpy (data + done, data, n);
+            done += n;
+        }
+    }
+    nconstGet_p++;
+    return local;
+}
+
+Bool TSMCube::recordConstantTile (uInt tileNr, const char* local)
+{
+    // The pixels of a column are equal if the data equal themselves
+    // shifted by one pixel.
+    for (uInt i=0; i<localOffset_p.nelements(); ++i) {
+        uInt pixelSize = pixelLocalSize (i);
+        const char* data = local + localOffset_p[i];
+        size_t length = size_t(tileSize_p) * pixelSize;
+        if (memcmp (data, data + pixelSize, length - pixelSize) != 0) {
+            constTiles_p.erase (tileNr);
+            return False;
+        }
+    }
+    // Gather the first pixel of each column and look if that value is known.
+    std::vector<char> value(pixelLocalLength_p);
+    for (uInt i=0; i<localOffset_p.nelements(); ++i) {
+        uInt pixelSize = pixelLocalSize (i);
+        memcpy (&value[pixelLocalOffset_p[i]], local + localOffset_p[i],
+                pixelSize);
+    }
+    uInt index = 0;
+    while (index < constLocalValues_p.size()  &&
+           constLocalValue(index) != value) {
+        index++;
+    }
+    if (index == constLocalValues_p.size()) {
+        std::vector<char> external(pixelExternalLength_p, 0);
+        stmanPtr_p->writeTile (external.data(), pixelExternalOffset_p,
+                               value.data(), pixelLocalOffset_p, 1);
+        constValues_p.push_back (external);
+        constLocalValues_p.push_back (value);
+    }
+    constTiles_p[tileNr] = index;
+    return True;
+}
+
+uInt TSMCube::pixelLocalSize (uInt column) const
+{
+    uInt end = (column+1 < pixelLocalOffset_p.nelements()  ?
+                pixelLocalOffset_p[column+1] : pixelLocalLength_p);
+    return end - pixelLocalOffset_p[column];
+}
+
+const std::vector<char>& TSMCube::constLocalValue (uInt index)
+{
+    // Convert the value to local format when used for the first time.
+    std::vector<char>& value = constLocalValues_p[index];
+    if (value.empty()) {
+        value.resize (pixelLocalLength_p);
+        stmanPtr_p->readTile (value.data(), pixelLocalOffset_p,
+                              constValues_p[index].data(),
+                              pixelExternalOffset_p, 1);
+    }
+    return value;
+}
+
+void TSMCube::putConstantTiles (AipsIO& ios) const
+{
+    ios << uInt(constValues_p.size());
+    for (size_t i=0; i<constValues_p.size(); ++i) {
+        ios.put (constValues_p[i].size(),
+                 (const uChar*)(constValues_p[i].data()));
+    }
+    std::vector<uInt> tileNrs, indices;
+    tileNrs.reserve (constTiles_p.size());
+    indices.reserve (constTiles_p.size());
+    for (const auto& tile : constTiles_p) {
+        tileNrs.push_back (tile.first);
+        indices.push_back (tile.second);
+    }
+    ios << uInt(tileNrs.size());
+    if (! tileNrs.empty()) {
+        ios.put (tileNrs.size(), tileNrs.data(), False);
+        ios.put (indices.size(), indices.data(), False);
+    }
+}
+
+void TSMCube::getConstantTiles (AipsIO& ios)
+{
+    uInt nvalues;
+    ios >> nvalues;
+    constValues_p.resize (nvalues);
+    constLocalValues_p.clear();
+    constLocalValues_p.resize (nvalues);
+    for (uInt i=0; i<nvalues; ++i) {
+        uInt n;
+        ios >> n;
+        constValues_p[i].resize (n);
+        ios.get (n, (uChar*)(constValues_p[i].data()));
+    }
+    uInt ntiles;
+    ios >> ntiles;
+    std::vector<uInt> tileNrs(ntiles), indices(ntiles);
+    if (ntiles > 0) {
+        ios.get (ntiles, tileNrs.data());
+        ios.get (ntiles, indices.data());
+    }
+    constTiles_p.clear();
+    constTiles_p.reserve (ntiles);
+    for (uInt i=0; i<ntiles; ++i) {
+        constTiles_p[tileNrs[i]] = indices[i];
+    }
+}
+
 uInt TSMCube::cacheSize() const
 {
     if (cache_p == 0) {
@@ -715,6 +920,129 @@ uInt TSMCube::cacheSize() const
     return cache_p->cacheSize();
 }
 
+char* TSMCube::getTile (BucketCache* cachePtr, uInt tileNr)
+{
+    if (!userSetCache_p  &&  stmanPtr_p->adaptiveCache()) {
+        noteTileAccess (tileNr);
+    }
+    return cachePtr->getBucket (tileNr);
+}
+
+void TSMCube::noteTileAccess (uInt tileNr)
+{
+    if (maxTileHistory_p == 0) {
+        maxTileHistory_p = adaptiveMaxSize();
+    }
+    std::unordered_map<uInt,uInt64>::iterator iter = tileLastUse_p.find (tileNr);
+    if (iter != tileLastUse_p.end()) {
+        uInt64 slot = iter->second;
+        // The tile has been used before. If no longer in the cache, the
+        // cache is too small for the access pattern. Grow it to the number
+        // of tiles used since then, which is the cache size that would
+        // have kept the tile (LRU stack distance).
+        if (! cache_p->isCached (tileNr)) {
+            uInt dist = tileLastUse_p.size() - countTileUses (slot);
+            if (dist > cache_p->cacheSize()) {
+                dist = std::min (dist, adaptiveMaxSize());
+                if (dist > cache_p->cacheSize()) {
+                    cache_p->resize (dist);
+                    nadaptive_p++;
+                }
+            }
+        }
+        tileUseOrder_p[slot] = 0;
+        addTileUse (slot, -1);
+        tileLastUse_p.erase (iter);
+    }
+    if (tileUseSeq_p == tileUseOrder_p.size()) {
+        compactTileHistory();
+    }
+    tileUseOrder_p[tileUseSeq_p] = tileNr + 1;
+    addTileUse (tileUseSeq_p, 1);
+    tileLastUse_p[tileNr] = tileUseSeq_p;
+    tileUseSeq_p++;
+    // A longer history is useless, because the cache cannot get larger.
+    while (tileLastUse_p.size() > maxTileHistory_p) {
+        while (tileUseOrder_p[tileUseFirst_p] == 0) {
+            tileUseFirst_p++;
+        }
+        tileLastUse_p.erase (tileUseOrder_p[tileUseFirst_p] - 1);
+        tileUseOrder_p[tileUseFirst_p] = 0;
+        addTileUse (tileUseFirst_p, -1);
+    }
+}
+
+void TSMCube::addTileUse (uInt64 slot, Int value)
+{
+    for (uInt64 i=slot+1; i<=tileUseTree_p.size(); i += i & (~i + 1)) {
+        tileUseTree_p[i-1] += value;
+    }
+}
+
+uInt64 TSMCube::countTileUses (uInt64 slot) const
+{
+    uInt64 n = 0;
+    for (uInt64 i=slot; i>0; i -= i & (~i + 1)) {
+        n += tileUseTree_p[i-1];
+    }
+    return n;
+}
+
+void TSMCube::compactTileHistory()
+{
+    // Renumber the used slots and leave room for at least as many new ones.
+    uInt64 nused = tileLastUse_p.size();
+    uInt64 nslot = std::max (2*nused, uInt64(64));
+    std::vector<uInt> order;
+    order.reserve (nslot);
+    for (uInt64 i=tileUseFirst_p; i<tileUseSeq_p; ++i) {
+        if (tileUseOrder_p[i] != 0) {
+            tileLastUse_p[tileUseOrder_p[i] - 1] = order.size();
+            order.push_back (tileUseOrder_p[i]);
+        }
+    }
+    order.resize (nslot, 0);
+    tileUseOrder_p.swap (order);
+    tileUseSeq_p = nused;
+    tileUseFirst_p = 0;
+    // Build the Fenwick tree in linear time.
+    tileUseTree_p.assign (nslot, 0);
+    for (uInt64 i=1; i<=nslot; ++i) {
+        if (i <= nused) {
+            tileUseTree_p[i-1]++;
+        }
+        uInt64 parent = i + (i & (~i + 1));
+        if (parent <= nslot) {
+            tileUseTree_p[parent-1] += tileUseTree_p[i-1];
+        }
+    }
+}
+
+uInt TSMCube::adaptiveMaxSize() const
+{
+    // The budget is shared by all caches, so only the part not used by
+    // the others can be used.
+    Int64 used = CacheManager::totalBytes();
+    if (cache_p != 0) {
+        used -= cache_p->cacheBytes();
+    }
+    Int64 avail = Int64(TiledStMan::cacheBudget()) - used;
+    uInt64 maxSize = std::max (avail, Int64(0)) / bucketSize_p;
+    maxSize = std::min (maxSize, uInt64(nrTiles_p));
+    maxSize = validateCacheSize (std::min (maxSize, uInt64(0xffffffff)));
+    return std::max (uInt(maxSize), 1u);
+}
+
+void TSMCube::resetTileHistory()
+{
+    tileUseOrder_p.clear();
+    tileUseTree_p.clear();
+    tileLastUse_p.clear();
+    tileUseSeq_p = 0;
+    tileUseFirst_p = 0;
+    maxTileHistory_p = 0;
+}
+
 uInt TSMCube::validateCacheSize (uInt cacheSize) const
 {
   return validateCacheSize (cacheSize, stmanPtr_p->maximumCacheSize(),
@@ -747,6 +1075,8 @@ void TSMCube::setCacheSize (uInt cacheSize, Bool forceSmaller, Bool userSet)
     }
 ////    cout << "cachesize=" << cacheSize << endl;
     userSetCache_p = userSet;
+    // A new access pattern starts, so forget the tiles accessed before.
+    resetTileHistory();
 }
 
 // Set the cache size for the given slice and access path.
@@ -759,11 +1089,16 @@ void TSMCube::setCacheSize (const IPosition& sliceShape,
     uInt cacheSize = calcCacheSize (sliceShape, windowStart,
 				    windowLength, axisPath);
     // If not userset, do not cache if more than 25% of the memory is needed.
+    // In adaptive mode the cache is limited to what fits in the budget.
     if (!userSet) {
-      uInt maxSize = uInt(HostInfo::memoryTotal(True) * 1024.*0.25 /
-                          bucketSize_p);
-      if (cacheSize > maxSize) {
-	cacheSize = 1;
+      if (stmanPtr_p->adaptiveCache()) {
+        cacheSize = std::min (cacheSize, adaptiveMaxSize());
+      } else {
+        uInt maxSize = uInt(HostInfo::memoryTotal(True) * 1024.*0.25 /
+                            bucketSize_p);
+        if (cacheSize > maxSize) {
+          cacheSize = 1;
+        }
       }
     }
     setCacheSize (cacheSize, forceSmaller, userSet);
@@ -913,7 +1248,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
 	stmanPtr_p->setDataChanged();
     }
     // Prepare for the iteration through the necessary tiles.
-    uInt i, j;
+    uInt i;
 
     // Initialize the various variables and determine the number of
     // tiles needed (which will determine the cache size).
@@ -965,7 +1300,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     if (oneEntireTile) {
         // Get the tile from the cache.
         uInt tileNr = expandedTilesPerDim_p.offset (startTile_p);
-        char* dataArray = cachePtr->getBucket (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr);
         // If writing, set cache slot to dirty.
         if (writeFlag) {
             memcpy (dataArray+pixelOffset, section,
@@ -990,111 +1325,155 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
 
     // At this point we start looping through all tiles.
-    // startPixel and endPixel will contain the first and last pixels
-    // needed in the current tile.
     // tilePos contains the position of the current tile.
     IPosition startSection (start);            // start of section in cube
-    IPosition sectionShape (end - start + 1);  // section shape
-    TSMShape expandedSectionShape (sectionShape);
-    IPosition startPixel (startPixelInFirstTile_p);
-    IPosition endPixel   (endPixelInFirstTile_p);
+    TSMShape expandedSectionShape (end - start + 1);
     IPosition tilePos    (startTile_p);
     IPosition tileIncr = 
       expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
-    IPosition dataLength(nrdim_p);
-    IPosition dataPos   (nrdim_p);
-    IPosition sectionPos(nrdim_p);
-    uInt dataOffset;
-    size_t sectionOffset;
     uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
 
+    // If possible, read the tiles and copy their data in parallel.
+    // That can only be done if the cache can hold all tiles needed.
+    // The data of each tile go to a separate part of the section,
+    // so the copies do not interfere.
+    uInt nthreads = stmanPtr_p->nthreads();
+    size_t nrTiles = nrTileSection_p.product();
+    if (nthreads > 1  &&  nrTiles > 1  &&  nrTiles <= cachePtr->cacheSize()) {
+        std::vector<uInt> tileNrs;
+        std::vector<IPosition> tilePositions;
+        tileNrs.reserve (nrTiles);
+        tilePositions.reserve (nrTiles);
+        while (True) {
+            tileNrs.push_back (tileNr);
+            tilePositions.push_back (tilePos);
+            for (i=0; i<nrdim_p; i++) {
+                tileNr += tileIncr(i);
+                if (++tilePos(i) <= endTile_p(i)) {
+                    break;
+                }
+                tilePos(i) = startTile_p(i);
+            }
+            if (i == nrdim_p) {
+                break;
+            }
+        }
+        if (!userSetCache_p  &&  stmanPtr_p->adaptiveCache()) {
+            for (size_t t=0; t<nrTiles; ++t) {
+                noteTileAccess (tileNrs[t]);
+            }
+        }
+        std::vector<char*> dataArrays;
+        if (cachePtr->getBuckets (tileNrs, dataArrays, nthreads, writeFlag)) {
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+            for (Int64 t=0; t<Int64(nrTiles); ++t) {
+                copyTile (dataArrays[t], tilePositions[t],
+                          section, startSection, expandedSectionShape,
+                          pixelOffset, localPixelSize, writeFlag);
+            }
+            return;
+        }
+        tilePos = startTile_p;
+        tileNr  = expandedTilesPerDim_p.offset (tilePos);
+    }
+
     while (True) {
 //      cout << "tilePos=" << tilePos << endl;
 //      cout << "tileNr=" << tileNr << endl;
-//      cout << "start=" << startPixel << endl;
-//      cout << "end=" << endPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr);
         if (writeFlag) {
             cachePtr->setDirty();
         }
+        copyTile (dataArray, tilePos, section, startSection,
+                  expandedSectionShape, pixelOffset, localPixelSize,
+                  writeFlag);
 
-        // At this point we start looping through all pixels in the tile.
-        // We do a vector at a time.
-        // Calculate the start and end pixel in the tile.
-        // Initialize the pixel position in the data and section.
+        // Determine the next tile to access.
+        // We increase the tile position in a dimension.
         for (i=0; i<nrdim_p; i++) {
-            dataLength(i) = 1 + endPixel(i) - startPixel(i);
-            dataPos(i)    = startPixel(i);
-            sectionPos(i) = tilePos(i) * tileShape_p(i)
-                            + startPixel(i) - startSection(i);
+            tileNr += tileIncr(i);
+            if (++tilePos(i) <= endTile_p(i)) {
+                break;                                 // not past last tile
+            }
+            // Past last tile in this dimension.
+            // Reset start.
+            tilePos(i) = startTile_p(i);
         }
-        dataOffset = pixelOffset + localPixelSize *
-                            expandedTileShape_p.offset (startPixel);
-        sectionOffset = localPixelSize *
-                            expandedSectionShape.offset (sectionPos);
-        IPosition dataIncr    = localPixelSize *
-                            expandedTileShape_p.offsetIncrement (dataLength);
-        IPosition sectionIncr = localPixelSize *
-                            expandedSectionShape.offsetIncrement (dataLength);
+        if (i == nrdim_p) {
+            break;                                     // ready
+        }
+    }
+}
 
-        while (True) {
-            uInt localSize = dataLength(0) * localPixelSize;
-            /* merge zero increments into one copy */
-            for (j = 1; j < nrdim_p; j++) {
-                if (dataIncr(j) == 0 && sectionIncr(j) == 0) {
-                    localSize *= dataLength(j);
-                    dataPos(j) = endPixel(j);
-                }
-                else {
-                    break;
-                }
-            }
+void TSMCube::copyTile (char* dataArray, const IPosition& tilePos,
+                        char* section, const IPosition& startSection,
+                        const TSMShape& expandedSectionShape,
+                        uInt pixelOffset, uInt localPixelSize,
+                        Bool writeFlag) const
+{
+    // At this point we start looping through all pixels in the tile.
+    // We do a vector at a time.
+    // Calculate the start and end pixel in the tile.
+    // Initialize the pixel position in the data and section.
+    IPosition startPixel(nrdim_p);
+    IPosition endPixel  (nrdim_p);
+    IPosition dataLength(nrdim_p);
+    IPosition dataPos   (nrdim_p);
+    IPosition sectionPos(nrdim_p);
+    uInt i, j;
+    for (i=0; i<nrdim_p; i++) {
+        startPixel(i) = (tilePos(i) == startTile_p(i)  ?
+                         startPixelInFirstTile_p(i) : 0);
+        endPixel(i)   = (tilePos(i) == endTile_p(i)  ?
+                         endPixelInLastTile_p(i) : tileShape_p(i) - 1);
+        dataLength(i) = 1 + endPixel(i) - startPixel(i);
+        dataPos(i)    = startPixel(i);
+        sectionPos(i) = tilePos(i) * tileShape_p(i)
+                        + startPixel(i) - startSection(i);
+    }
+    uInt dataOffset = pixelOffset + localPixelSize *
+                        expandedTileShape_p.offset (startPixel);
+    size_t sectionOffset = localPixelSize *
+                        expandedSectionShape.offset (sectionPos);
+    IPosition dataIncr    = localPixelSize *
+                        expandedTileShape_p.offsetIncrement (dataLength);
+    IPosition sectionIncr = localPixelSize *
+                        expandedSectionShape.offsetIncrement (dataLength);
 
-            if (writeFlag) {
-                TSMCube_MoveData(dataArray + dataOffset,
-                                 section + sectionOffset, localSize);
-            } else {
-                TSMCube_MoveData(section + sectionOffset,
-                                 dataArray + dataOffset, localSize);
-            }
-            dataOffset += localSize;
-            sectionOffset += localSize;
-            for (j = 1; j < nrdim_p; j++) {
-                dataOffset += dataIncr(j);
-                sectionOffset += sectionIncr(j);
-                if (++dataPos(j) <= endPixel(j)) {
-                    break;
-                }
-                dataPos(j) = startPixel(j);
+    while (True) {
+        uInt localSize = dataLength(0) * localPixelSize;
+        /* merge zero increments into one copy */
+        for (j = 1; j < nrdim_p; j++) {
+            if (dataIncr(j) == 0 && sectionIncr(j) == 0) {
+                localSize *= dataLength(j);
+                dataPos(j) = endPixel(j);
             }
-            if (j == nrdim_p) {
+            else {
                 break;
             }
         }
 
-        // Determine the next tile to access and the starting and
-        // ending pixels in it.
-        // We increase the tile position in a dimension.
-        for (i=0; i<nrdim_p; i++) {
-            tileNr += tileIncr(i);
-            startPixel(i) = 0;
-            if (++tilePos(i) < endTile_p(i)) {
-                break;                                 // not at last tile
-            }
-            if (tilePos(i) == endTile_p(i)) {
-                endPixel(i) = endPixelInLastTile_p(i);   // last tile
+        if (writeFlag) {
+            TSMCube_MoveData(dataArray + dataOffset,
+                             section + sectionOffset, localSize);
+        } else {
+            TSMCube_MoveData(section + sectionOffset,
+                             dataArray + dataOffset, localSize);
+        }
+        dataOffset += localSize;
+        sectionOffset += localSize;
+        for (j = 1; j < nrdim_p; j++) {
+            dataOffset += dataIncr(j);
+            sectionOffset += sectionIncr(j);
+            if (++dataPos(j) <= endPixel(j)) {
                 break;
             }
-            // Past last tile in this dimension.
-            // Reset start and end.
-            tilePos(i) = startTile_p(i);
-            startPixel(i) = startPixelInFirstTile_p(i);
-            endPixel(i)   = endPixelInFirstTile_p(i);
+            dataPos(j) = startPixel(j);
         }
-        if (i == nrdim_p) {
-            break;                                     // ready
+        if (j == nrdim_p) {
+            break;
         }
     }
 }
@@ -1134,7 +1513,7 @@ void TSMCube::accessLine (char* section, uInt pixelOffset,
 //      cout << "nrpixel=" << nrPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr) + offset;
+        char* dataArray = getTile (cachePtr, tileNr) + offset;
         if (writeFlag) {
             cachePtr->setDirty();
         }
@@ -1297,6 +1676,13 @@ void TSMCube::accessLine (char* section, uInt pixelOffset,
 }
 
 
+const char* TSMCube::getSectionPointer (const IPosition&, const IPosition&,
+                                        uInt, uInt, std::shared_ptr<void>&)
+{
+    return 0;
+}
+
+
 void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
                              const IPosition& stride,
                              char* section, uInt colnr,
@@ -1382,7 +1768,7 @@ void TSMCube::accessStrided (const IPosition& start, const IPosition& end,
 //      cout << "start=" << startPixel << endl;
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
+        char* dataArray = getTile (cachePtr, tileNr);
         if (writeFlag) {
             cachePtr->setDirty();
         }
@@ -36,6 +36,10 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/iosfwd.h>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -150,6 +154,16 @@ public:
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Get the cache statistics as a record containing the fields
+    // CacheSize (in buckets), BucketSize (in bytes), Accesses, Hits, Misses,
+    // Evictions, Reads, Writes, BytesRead, BytesWritten,
+    // AdaptiveResizes (the number of times the adaptive mode grew the cache),
+    // ConstantTiles (the number of tiles kept as a constant value), and
+    // ConstantGets (the number of times a constant tile was made without
+    // reading it).
+    // All values are 0 if no cache is used (yet).
+    virtual Record cacheStatistics() const;
+
     // Put the data of the object into the AipsIO stream.
     void putObject (AipsIO& ios);
 
@@ -228,6 +242,20 @@ public:
                                 uInt localPixelSize, uInt externalPixelSize,
                                 Bool writeFlag);
 
+    // Get a pointer to the data of a section in the cube without copying
+    // it, which is only possible if the cube's tiles are memory-mapped.
+    // The section must be contained in a single tile and be contiguous
+    // in it; i.e., the leading axes cover the full tile, followed by at
+    // most one partial axis, while the remaining axes have length 1.
+    // <br><src>owner</src> is set to an object keeping the data valid
+    // (thus also after the cube or file is closed).
+    // A null pointer is returned if not possible, which is always the
+    // case for the cached (i.e., not mapped) cubes.
+    virtual const char* getSectionPointer (const IPosition& start,
+                                           const IPosition& end, uInt colnr,
+                                           uInt externalPixelSize,
+                                           std::shared_ptr<void>& owner);
+
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
@@ -333,6 +361,45 @@ private:
 		     uInt endPixelInLastTile,
 		     uInt lineIndex);
 
+    // Copy the data between a tile and the section for the tile at the
+    // given position. The section's start and shape are given, while the
+    // tile and section limits are taken from the accessSection variables.
+    void copyTile (char* dataArray, const IPosition& tilePos,
+                   char* section, const IPosition& startSection,
+                   const TSMShape& expandedSectionShape,
+                   uInt pixelOffset, uInt localPixelSize,
+                   Bool writeFlag) const;
+
+    // Get a tile from the cache.
+    // If the cache size is adaptive, the access is recorded first.
+    char* getTile (BucketCache* cachePtr, uInt tileNr);
+
+    // Record the access of a tile for the adaptive cache size.
+    // If the tile is accessed again, but not in the cache anymore, the
+    // cache is grown to the number of different tiles accessed since its
+    // previous access (i.e. its LRU stack distance).
+    void noteTileAccess (uInt tileNr);
+
+    // Add a value to the count of a slot in the tile access history
+    // (the Fenwick tree).
+    void addTileUse (uInt64 slot, Int value);
+
+    // Count the used slots before the given slot in the tile access history.
+    uInt64 countTileUses (uInt64 slot) const;
+
+    // Renumber the used slots of the tile access history, so there is room
+    // for new accesses.
+    void compactTileHistory();
+
+    // Get the maximum cache size (in buckets) the adaptive mode can use.
+    // It is limited by the number of tiles, the maximum cache size of
+    // the storage manager, and the part of the cache budget not used by
+    // other caches (as accounted by the CacheManager).
+    uInt adaptiveMaxSize() const;
+
+    // Clear the recorded tile accesses (done if the access pattern changes).
+    void resetTileHistory();
+
     // Define the callback functions for the BucketCache.
     // <group>
     static char* readCallBack (void* owner, const char* external);
@@ -342,6 +409,36 @@ private:
     static void deleteCallBack (void* owner, char* buffer);
     // </group>
 
+    // Define the callback functions for the BucketCache to handle
+    // constant tiles. They are only used if the storage manager keeps
+    // constant tiles (see <src>TiledStMan::setConstantTiles</src>).
+    // <group>
+    static char* getLocalCallBack (void* owner, uInt tileNr);
+    static Bool skipWriteCallBack (void* owner, uInt tileNr,
+                                   const char* local);
+    // </group>
+
+    // Make a tile in local format if it is a constant tile.
+    // It returns 0 if not a constant tile.
+    char* makeConstantTile (uInt tileNr);
+
+    // Record if the tile in local format is constant, i.e., if for each
+    // data column all pixels in the tile have the same value.
+    // It returns True if constant, thus if it does not need to be written.
+    Bool recordConstantTile (uInt tileNr, const char* local);
+
+    // Get the size in local format of a pixel of the given data column.
+    uInt pixelLocalSize (uInt column) const;
+
+    // Get the value of a constant tile in local format.
+    const std::vector<char>& constLocalValue (uInt index);
+
+    // Write or read the constant tiles.
+    // <group>
+    void putConstantTiles (AipsIO& ios) const;
+    void getConstantTiles (AipsIO& ios);
+    // </group>
+
     // Define the functions doing the actual read and write of the 
     // data in the tile and converting it to/from local format.
     // <group>
@@ -352,7 +449,9 @@ private:
 protected:
     //# Declare member variables.
 
-    char * cachedTile_p; // optimization to hold one tile chunk
+    // Optimization to hold one tile chunk.
+    // It is atomic, because tiles can be read by multiple threads.
+    std::atomic<char*> cachedTile_p;
 
     // Pointer to the parent storage manager.
     TiledStMan*     stmanPtr_p;
@@ -401,6 +500,34 @@ protected:
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
 
+    // The tiles in order of access (slot -> tile+1, 0 if the slot is not
+    // used anymore), a Fenwick tree counting the used slots, and the slot
+    // of the last access of each tile; used for the adaptive cache size.
+    // The Fenwick tree gives the LRU stack distance in O(log n) time.
+    std::vector<uInt>               tileUseOrder_p;
+    std::vector<uInt>               tileUseTree_p;
+    std::unordered_map<uInt,uInt64> tileLastUse_p;
+    // The next slot to use and the first slot possibly used.
+    uInt64                          tileUseSeq_p;
+    uInt64                          tileUseFirst_p;
+    // Maximum number of tiles to keep in the access history.
+    uInt            maxTileHistory_p;
+    // Number of times the adaptive mode resized the cache.
+    uInt            nadaptive_p;
+    // The constant tiles (tile number -> index in constValues_p).
+    std::unordered_map<uInt,uInt> constTiles_p;
+    // The distinct values of constant tiles: a single pixel of each data
+    // column in external and local format.
+    std::vector<std::vector<char> > constValues_p;
+    std::vector<std::vector<char> > constLocalValues_p;
+    // Offsets of a single pixel of each data column (external and local).
+    Block<uInt>     pixelExternalOffset_p;
+    Block<uInt>     pixelLocalOffset_p;
+    uInt            pixelExternalLength_p;
+    uInt            pixelLocalLength_p;
+    // Number of times a constant tile was made without reading it.
+    uInt64          nconstGet_p;
+
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
     // desctruction overhead if they are local to accessSection()
@@ -39,6 +39,7 @@
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/BucketMapped.h>
+#include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/OS/HostInfo.h>
@@ -156,6 +157,45 @@ void TSMCubeMMap::setCacheSize (const IPosition&,
                                 Bool, Bool)
 {}
 
+const char* TSMCubeMMap::getSectionPointer (const IPosition& start,
+                                            const IPosition& end, uInt colnr,
+                                            uInt externalPixelSize,
+                                            std::shared_ptr<void>& owner)
+{
+  // Bools are stored as bits, so cannot be referenced.
+  if (externalPixelSize == 0  ||  nrdim_p == 0) {
+    return 0;
+  }
+  // The section must be in a single tile.
+  IPosition tilePos(nrdim_p);
+  IPosition pixelPos(nrdim_p);
+  for (uInt i=0; i<nrdim_p; i++) {
+    tilePos(i) = start(i) / tileShape_p(i);
+    if (end(i) / tileShape_p(i) != tilePos(i)) {
+      return 0;
+    }
+    pixelPos(i) = start(i) - tilePos(i) * tileShape_p(i);
+  }
+  // It must be contiguous in the tile; i.e., all axes before the last
+  // axis with length > 1 must be entire.
+  Int lastAxis = nrdim_p - 1;
+  while (lastAxis > 0  &&  end(lastAxis) == start(lastAxis)) {
+    lastAxis--;
+  }
+  for (Int i=0; i<lastAxis; i++) {
+    if (end(i) - start(i) + 1 != tileShape_p(i)) {
+      return 0;
+    }
+  }
+  uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
+  const char* dataArray = getCache()->getBucket (tileNr);
+  // Get the mapping after getBucket, because it opens the file if needed
+  // and might remap it.
+  owner = filePtr_p->bucketFile()->mappedFile()->mapping();
+  return dataArray + externalOffset_p[colnr] +
+    externalPixelSize * expandedTileShape_p.offset (pixelPos);
+}
+
 void TSMCubeMMap::accessSection (const IPosition& start, const IPosition& end,
                                  char* section, uInt colnr,
                                  uInt localPixelSize, uInt externalPixelSize,
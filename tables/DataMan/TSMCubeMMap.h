@@ -146,6 +146,14 @@ public:
                                 uInt localPixelSize, uInt externalPixelSize,
                                 Bool writeFlag);
 
+    // Get a pointer to the mapped data of a section in the cube.
+    // It returns a null pointer if the section is not contiguous
+    // within a single tile.
+    virtual const char* getSectionPointer (const IPosition& start,
+                                           const IPosition& end, uInt colnr,
+                                           uInt externalPixelSize,
+                                           std::shared_ptr<void>& owner);
+
     // Set the cache size for the given slice and access path.
     virtual void setCacheSize (const IPosition& sliceShape,
                                const IPosition& windowStart,
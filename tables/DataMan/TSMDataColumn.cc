@@ -34,14 +34,30 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/string.h>
 #include <casacore/casa/iostream.h>
+#include <cstdint>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Let the array reference the data if properly aligned.
+template<typename T>
+Bool tsmMakeArrayView (ArrayBase& data, const IPosition& shape,
+                       const char* ptr, const std::shared_ptr<void>& owner)
+{
+    if (reinterpret_cast<std::uintptr_t>(ptr) % alignof(T) != 0) {
+        return False;
+    }
+    Array<T> view (shape, reinterpret_cast<T*>(const_cast<char*>(ptr)),
+                   owner);
+    static_cast<Array<T>&>(data).reference (view);
+    return True;
+}
+
 TSMDataColumn::TSMDataColumn (const TSMColumn& column)
 : TSMColumn (column)
 {
@@ -554,6 +570,97 @@ void TSMDataColumn::putSliceV (rownr_t rownr, const Slicer& ns,
     dataPtr.freeVStorage (data, deleteIt);
 }
 
+Bool TSMDataColumn::makeView (TSMCube* hypercube, const IPosition& start,
+                              const IPosition& end, const IPosition& shape,
+                              ArrayBase& data)
+{
+    // A view is only possible if the data are held in local format.
+    if (mustConvert_p  ||  tilePixelSize_p != localPixelSize_p) {
+        return False;
+    }
+    std::shared_ptr<void> owner;
+    const char* ptr = hypercube->getSectionPointer (start, end, colnr_p,
+                                                    tilePixelSize_p, owner);
+    if (ptr == 0) {
+        return False;
+    }
+    switch (dataType()) {
+    case TpUChar:
+        return tsmMakeArrayView<uChar> (data, shape, ptr, owner);
+    case TpShort:
+        return tsmMakeArrayView<Short> (data, shape, ptr, owner);
+    case TpUShort:
+        return tsmMakeArrayView<uShort> (data, shape, ptr, owner);
+    case TpInt:
+        return tsmMakeArrayView<Int> (data, shape, ptr, owner);
+    case TpUInt:
+        return tsmMakeArrayView<uInt> (data, shape, ptr, owner);
+    case TpInt64:
+        return tsmMakeArrayView<Int64> (data, shape, ptr, owner);
+    case TpFloat:
+        return tsmMakeArrayView<Float> (data, shape, ptr, owner);
+    case TpDouble:
+        return tsmMakeArrayView<Double> (data, shape, ptr, owner);
+    case TpComplex:
+        return tsmMakeArrayView<Complex> (data, shape, ptr, owner);
+    case TpDComplex:
+        return tsmMakeArrayView<DComplex> (data, shape, ptr, owner);
+    default:
+        break;
+    }
+    return False;
+}
+
+Bool TSMDataColumn::getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                   ArrayBase& data)
+{
+    IPosition end;
+    TSMCube* hypercube = stmanPtr_p->getHypercube (rownr, end);
+    IPosition start (end);
+    IPosition cellShape = shape(rownr);
+    IPosition viewShape (cellShape);
+    if (slicer == 0) {
+        for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
+            start(i) = 0;
+            end(i)--;
+        }
+    } else {
+        IPosition blc, trc, inc;
+        viewShape = slicer->inferShapeFromSource (cellShape, blc, trc, inc);
+        if (! inc.allOne()) {
+            return False;
+        }
+        for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
+            start(i) = blc(i);
+            end(i)   = trc(i);
+        }
+    }
+    return makeView (hypercube, start, end, viewShape, data);
+}
+
+Bool TSMDataColumn::getColumnRangeViewV (rownr_t startRow, rownr_t nrow,
+                                         ArrayBase& data)
+{
+    if (nrow == 0) {
+        return False;
+    }
+    // The rows must be consecutive on the last axis of the same hypercube.
+    IPosition start, end;
+    TSMCube* hypercube = stmanPtr_p->getHypercube (startRow, start);
+    if (stmanPtr_p->getHypercube (startRow+nrow-1, end) != hypercube
+    ||  start.size() != stmanPtr_p->nrCoordVector() + 1
+    ||  rownr_t(end(start.size()-1) - start(start.size()-1)) != nrow-1) {
+        return False;
+    }
+    IPosition viewShape (end);
+    for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
+        start(i) = 0;
+        end(i)--;
+    }
+    viewShape(start.size()-1) = nrow;
+    return makeView (hypercube, start, end, viewShape, data);
+}
+
 void TSMDataColumn::getArrayColumnV (ArrayBase& dataPtr)
 {
   if (! stmanPtr_p->canAccessColumn()) {
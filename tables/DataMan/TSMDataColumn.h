@@ -244,6 +244,20 @@ public:
                                        const Slicer& ns,
                                        const ArrayBase& data);
 
+    // Make <src>data</src> reference the array (section) in the given
+    // row in the memory-mapped tile without copying it.
+    // It returns False if that is not possible, thus if the hypercube is
+    // not memory-mapped, the data have to be converted (e.g., Bool or
+    // other byte order), or the section is not contiguous in a tile.
+    virtual Bool getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                ArrayBase& data);
+
+    // Make <src>data</src> reference the arrays in a range of rows
+    // without copying them. It has the same restrictions as getArrayViewV;
+    // furthermore, the rows must be in the same hypercube and tile.
+    virtual Bool getColumnRangeViewV (rownr_t startRow, rownr_t nrow,
+                                      ArrayBase& data);
+
     // Read the data of the column from a tile.
     // (I.e. convert from external to local format).
     void readTile (void* to, const void* from, uInt nrPixels);
@@ -319,6 +333,12 @@ private:
 				 const IPosition& shape,
 				 const void* dataPtr, Bool writeFlag);
 
+    // Make <src>data</src> reference the given section in the hypercube
+    // if it is contiguous in memory. The array gets the given shape.
+    Bool makeView (TSMCube* hypercube, const IPosition& start,
+                   const IPosition& end, const IPosition& shape,
+                   ArrayBase& data);
+
     // Read or write the full cells given by start,end,incr.
     void accessFullCells (TSMCube* hypercube,
 			  char* dataPtr, Bool writeFlag,
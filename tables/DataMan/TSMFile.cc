@@ -28,20 +28,24 @@
 
 //# Includes
 #include <casacore/tables/DataMan/TSMFile.h>
+#include <casacore/tables/DataMan/TSMCompressedFile.h>
 #include <casacore/tables/DataMan/TSMOption.h>
 #include <casacore/tables/DataMan/TiledStMan.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/stdio.h>		// for sprintf
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
-: fileSeqnr_p (fileSequenceNr),
-  file_p      (0),
-  length_p    (0)
+: fileSeqnr_p   (fileSequenceNr),
+  file_p        (0),
+  length_p      (0),
+  codec_p       (stman->tileCodec()),
+  elementSize_p (stman->tileCodecElementSize())
 {
     // Create the file.
     char strc[8];
@@ -52,14 +56,20 @@ TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, bufSize, mapOpt, mfile);
+    if (codec_p != TSMCodec::None) {
+      file_p = new TSMCompressedFile (fileName, codec_p, elementSize_p, mfile);
+    } else {
+      file_p = new BucketFile (fileName, bufSize, mapOpt, mfile);
+    }
 }
 
 TSMFile::TSMFile (const String& fileName, Bool writable,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
-: fileSeqnr_p (0),
-  file_p      (0),
-  length_p    (0)
+: fileSeqnr_p   (0),
+  file_p        (0),
+  length_p      (0),
+  codec_p       (TSMCodec::None),
+  elementSize_p (1)
 {
     // Create the file.
     Bool mapOpt = tsmOpt.option() == TSMOption::MMap;
@@ -74,7 +84,7 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
                   const TSMOption& tsmOpt, MultiFileBase* mfile)
 : file_p (0)
 {
-    getObject (ios);
+    getHeader (ios);
     if (seqnr != fileSeqnr_p) {
       throw DataManInternalError ("TSMFile::TSMFile " + 
                                   stman->dataManagerName());
@@ -87,8 +97,15 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, stman->table().isWritable(),
-                             bufSize, mapOpt, mfile);
+    if (codec_p != TSMCodec::None) {
+      TSMCompressedFile* cfile = new TSMCompressedFile
+        (fileName, stman->table().isWritable(), codec_p, elementSize_p, mfile);
+      file_p = cfile;
+      cfile->getIndex (ios);
+    } else {
+      file_p = new BucketFile (fileName, stman->table().isWritable(),
+                               bufSize, mapOpt, mfile);
+    }
 }
 
 TSMFile::~TSMFile()
@@ -96,10 +113,22 @@ TSMFile::~TSMFile()
     delete file_p;
 }
 
+TSMCompressedFile* TSMFile::compressedFile()
+{
+    if (codec_p == TSMCodec::None) {
+        return 0;
+    }
+    return static_cast<TSMCompressedFile*>(file_p);
+}
+
 void TSMFile::putObject (AipsIO& ios) const
 {
     // Take care of forward compatibility (for small enough files).
+    // Version 3 is used for a file with compressed tiles.
     uInt version = (length_p < 2u*1024u*1024u*1024u  ?  1 : 2);
+    if (codec_p != TSMCodec::None) {
+        version = 3;
+    }
     ios << version;
     ios << fileSeqnr_p;
     if (version == 1) {
@@ -108,9 +137,22 @@ void TSMFile::putObject (AipsIO& ios) const
     } else {
         ios << length_p;
     }
+    if (version >= 3) {
+        ios << uInt(codec_p) << elementSize_p;
+        static_cast<const TSMCompressedFile*>(file_p)->putIndex (ios);
+    }
 }
 
 void TSMFile::getObject (AipsIO& ios)
+{
+    uInt version = getHeader (ios);
+    if (version >= 3) {
+        AlwaysAssert (codec_p != TSMCodec::None  &&  file_p != 0, AipsError);
+        compressedFile()->getIndex (ios);
+    }
+}
+
+uInt TSMFile::getHeader (AipsIO& ios)
 {
     uInt version;
     ios >> version;
@@ -122,6 +164,14 @@ void TSMFile::getObject (AipsIO& ios)
     } else {
         ios >> length_p;
     }
+    codec_p = TSMCodec::None;
+    elementSize_p = 1;
+    if (version >= 3) {
+        uInt codec;
+        ios >> codec >> elementSize_p;
+        codec_p = TSMCodec::Type(codec);
+    }
+    return version;
 }
 
 } //# NAMESPACE CASACORE - END
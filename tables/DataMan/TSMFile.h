@@ -31,6 +31,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/IO/BucketFile.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -39,6 +40,7 @@ class TSMOption;
 class TiledStMan;
 class MultiFileBase;
 class AipsIO;
+class TSMCompressedFile;
 
 // <summary>
 // File object for Tiled Storage Manager.
@@ -68,6 +70,10 @@ class AipsIO;
 // <p>
 // Underneath it uses a BucketFile to access the file.
 // In this way the IO details are well encapsulated.
+// <br>If a tile codec is set in the TiledStMan, a
+// <linkto class=TSMCompressedFile>TSMCompressedFile</linkto> is used
+// which stores each tile compressed. The codec and the tile index of
+// such a file are kept in the TSMFile object.
 // </synopsis> 
 
 // <motivation>
@@ -121,6 +127,15 @@ public:
     // Increment the logical file length.
     void extend (Int64 increment);
 
+    // Return the codec used to compress the tiles.
+    TSMCodec::Type codec() const;
+
+    // Are the tiles stored compressed?
+    Bool isCompressed() const;
+
+    // Return the compressed file object (0 if not compressed).
+    TSMCompressedFile* compressedFile();
+
 
 private:
     // The file sequence number.
@@ -129,6 +144,9 @@ private:
     BucketFile* file_p;
     // The (logical) length of the file.
     Int64 length_p;
+    // The codec used to compress the tiles and the element size of the data.
+    TSMCodec::Type codec_p;
+    uInt           elementSize_p;
 	    
 
     // Forbid copy constructor.
@@ -136,6 +154,9 @@ private:
 
     // Forbid assignment.
     TSMFile& operator= (const TSMFile&);
+
+    // Read the header of the object and return its version.
+    uInt getHeader (AipsIO& ios);
 };
 
 
@@ -148,6 +169,12 @@ inline uInt TSMFile::sequenceNumber() const
 inline void TSMFile::extend (Int64 increment)
     { length_p += increment; }
 
+inline TSMCodec::Type TSMFile::codec() const
+    { return codec_p; }
+
+inline Bool TSMFile::isCompressed() const
+    { return codec_p != TSMCodec::None; }
+
 inline BucketFile* TSMFile::bucketFile()
     { return file_p; }
 
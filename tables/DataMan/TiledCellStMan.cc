@@ -64,6 +64,12 @@ TiledCellStMan::TiledCellStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt64 ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (spec.asString ("TILECODEC"));
+    }
+    if (spec.isDefined ("CONSTANTTILES")) {
+        setConstantTiles (spec.asBool ("CONSTANTTILES"));
+    }
 }
 
 TiledCellStMan::~TiledCellStMan()
@@ -74,6 +80,8 @@ DataManager* TiledCellStMan::clone() const
     TiledCellStMan* smp = new TiledCellStMan (hypercolumnName_p,
 					      defaultTileShape_p,
 					      maximumCacheSize());
+    smp->tileCodec_p = tileCodec_p;
+    smp->constantTiles_p = constantTiles_p;
     return smp;
 }
 
@@ -70,6 +70,12 @@ TiledColumnStMan::TiledColumnStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt64 ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (spec.asString ("TILECODEC"));
+    }
+    if (spec.isDefined ("CONSTANTTILES")) {
+        setConstantTiles (spec.asBool ("CONSTANTTILES"));
+    }
 }
 
 TiledColumnStMan::~TiledColumnStMan()
@@ -80,6 +86,8 @@ DataManager* TiledColumnStMan::clone() const
     TiledColumnStMan* smp = new TiledColumnStMan (hypercolumnName_p,
 						  tileShape_p,
 						  maximumCacheSize());
+    smp->tileCodec_p = tileCodec_p;
+    smp->constantTiles_p = constantTiles_p;
     return smp;
 }
 
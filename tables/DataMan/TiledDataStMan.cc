@@ -59,6 +59,12 @@ TiledDataStMan::TiledDataStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt64 ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (spec.asString ("TILECODEC"));
+    }
+    if (spec.isDefined ("CONSTANTTILES")) {
+        setConstantTiles (spec.asBool ("CONSTANTTILES"));
+    }
 }
 
 TiledDataStMan::~TiledDataStMan()
@@ -68,6 +74,8 @@ DataManager* TiledDataStMan::clone() const
 {
     TiledDataStMan* smp = new TiledDataStMan (hypercolumnName_p,
 					      maximumCacheSize());
+    smp->tileCodec_p = tileCodec_p;
+    smp->constantTiles_p = constantTiles_p;
     return smp;
 }
 
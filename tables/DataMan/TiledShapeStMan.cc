@@ -75,6 +75,12 @@ TiledShapeStMan::TiledShapeStMan (const String& hypercolumnName,
     if (spec.isDefined ("MAXIMUMCACHESIZE")) {
         setPersMaxCacheSize (spec.asInt64 ("MAXIMUMCACHESIZE"));
     }
+    if (spec.isDefined ("TILECODEC")) {
+        setTileCodec (spec.asString ("TILECODEC"));
+    }
+    if (spec.isDefined ("CONSTANTTILES")) {
+        setConstantTiles (spec.asBool ("CONSTANTTILES"));
+    }
 }
 
 TiledShapeStMan::~TiledShapeStMan()
@@ -85,6 +91,8 @@ DataManager* TiledShapeStMan::clone() const
     TiledShapeStMan* smp = new TiledShapeStMan (hypercolumnName_p,
 						defaultTileShape_p,
 						maximumCacheSize());
+    smp->tileCodec_p = tileCodec_p;
+    smp->constantTiles_p = constantTiles_p;
     return smp;
 }
 
@@ -40,11 +40,16 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/BinarySearch.h>
 #include <casacore/casa/Utilities/GenSort.h>
+#include <casacore/casa/IO/CacheManager.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/OS/DOos.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/DataMan/DataManError.h>
 
@@ -58,6 +63,10 @@ TiledStMan::TiledStMan ()
   fileSet_p         (1, static_cast<TSMFile*>(0)),
   persMaxCacheSize_p(0),
   maxCacheSize_p    (0),
+  nthreads_p        (defaultNThreads()),
+  adaptiveCache_p   (defaultAdaptiveCache()),
+  tileCodec_p       (TSMCodec::None),
+  constantTiles_p   (False),
   nrdim_p           (0),
   nrCoordVector_p   (0),
   dataChanged_p     (False)
@@ -70,6 +79,10 @@ TiledStMan::TiledStMan (const String& hypercolumnName, uInt maximumCacheSize)
   fileSet_p         (1, static_cast<TSMFile*>(0)),
   persMaxCacheSize_p(maximumCacheSize),
   maxCacheSize_p    (maximumCacheSize),
+  nthreads_p        (defaultNThreads()),
+  adaptiveCache_p   (defaultAdaptiveCache()),
+  tileCodec_p       (TSMCodec::None),
+  constantTiles_p   (False),
   nrdim_p           (0),
   nrCoordVector_p   (0),
   dataChanged_p     (False)
@@ -78,12 +91,14 @@ TiledStMan::TiledStMan (const String& hypercolumnName, uInt maximumCacheSize)
 TiledStMan::~TiledStMan()
 {
     uInt i;
-    for (i=0; i<ncolumn(); i++) {
-	delete colSet_p[i];
-    }
+    // Delete the hypercubes first, so their caches are not released
+    // while the columns are deleted.
     for (i=0; i<cubeSet_p.nelements(); i++) {
 	delete cubeSet_p[i];
     }
+    for (i=0; i<ncolumn(); i++) {
+	delete colSet_p[i];
+    }
     for (i=0; i<fileSet_p.nelements(); i++) {
 	delete fileSet_p[i];
     }
@@ -289,6 +304,12 @@ Record TiledStMan::dataManagerSpec() const
     Record rec = getProperties();
     rec.define ("DEFAULTTILESHAPE", defaultTileShape().asVector());
     rec.define ("MAXIMUMCACHESIZE", Int64(persMaxCacheSize_p));
+    if (tileCodec_p != TSMCodec::None) {
+        rec.define ("TILECODEC", TSMCodec::toString (tileCodec_p));
+    }
+    if (constantTiles_p) {
+        rec.define ("CONSTANTTILES", constantTiles_p);
+    }
     Record subrec;
     Int nrrec=0;
     for (uInt64 i=0; i<cubeSet_p.nelements(); i++) {
@@ -356,6 +377,111 @@ void TiledStMan::deleteManager()
 void TiledStMan::setMaximumCacheSize (uInt nMiB)
     { maxCacheSize_p = nMiB; }
 
+void TiledStMan::setNThreads (uInt nthreads)
+{
+    nthreads_p = (nthreads == 0  ?  OMP::maxThreads() : nthreads);
+}
+
+void TiledStMan::setTileCodec (const String& codec)
+{
+    TSMCodec::Type type = TSMCodec::fromString (codec);
+    if (type != tileCodec_p) {
+        for (uInt i=0; i<fileSet_p.nelements(); i++) {
+            if (fileSet_p[i] != 0) {
+                throw TSMError ("TiledStMan: tile codec cannot be changed "
+                                "after data have been written in " +
+                                hypercolumnName_p);
+            }
+        }
+        TSMCodec::checkAvailable (type);
+        tileCodec_p = type;
+    }
+}
+
+void TiledStMan::setConstantTiles (Bool constantTiles)
+{
+    if (constantTiles != constantTiles_p) {
+        for (uInt i=0; i<cubeSet_p.nelements(); i++) {
+            if (cubeSet_p[i] != 0) {
+                throw TSMError ("TiledStMan: keeping constant tiles cannot "
+                                "be changed after hypercubes have been "
+                                "created in " + hypercolumnName_p);
+            }
+        }
+        constantTiles_p = constantTiles;
+    }
+}
+
+uInt TiledStMan::tileCodecElementSize() const
+{
+    uInt size = 0;
+    for (uInt i=0; i<dataCols_p.nelements(); i++) {
+        uInt sz;
+        switch (dataCols_p[i]->dataType()) {
+        case TpBool:
+            sz = 1;
+            break;
+        case TpComplex:
+            sz = sizeof(Float);
+            break;
+        case TpDComplex:
+            sz = sizeof(Double);
+            break;
+        default:
+            sz = ValType::getTypeSize (DataType(dataCols_p[i]->dataType()));
+        }
+        if (size != 0  &&  sz != size) {
+            return 1;
+        }
+        size = sz;
+    }
+    return (size == 0  ?  1 : size);
+}
+
+void TiledStMan::setAdaptiveCache (Bool adaptive)
+{
+    adaptiveCache_p = adaptive;
+}
+
+Bool TiledStMan::defaultAdaptiveCache()
+{
+    Bool adaptive;
+    AipsrcValue<Bool>::find (adaptive, "tiledstman.adaptivecache", False);
+    return adaptive;
+}
+
+uInt64 TiledStMan::cacheBudget()
+{
+    static uInt64 budget = []() -> uInt64 {
+        Int nMiB;
+        AipsrcValue<Int>::find (nMiB, "tiledstman.cachebudget", 0);
+        return uInt64(std::max (nMiB, 0)) * 1024 * 1024;
+    }();
+    if (budget > 0) {
+        return budget;
+    }
+    // Use the budget of all caches if defined.
+    if (CacheManager::budget() > 0) {
+        return CacheManager::budget();
+    }
+    return uInt64(HostInfo::memoryTotal(True) * 1024. * 0.25);
+}
+
+Record TiledStMan::cacheStatistics (uInt hypercube) const
+{
+    return getTSMCube(hypercube)->cacheStatistics();
+}
+
+uInt TiledStMan::defaultNThreads()
+{
+    Int nr;
+    AipsrcValue<Int>::find (nr, "tiledstman.nthreads", 1);
+    if (nr <= 0) {
+        return OMP::maxThreads();
+    }
+    return nr;
+}
+
 
 Bool TiledStMan::canChangeShape() const
 {
@@ -384,7 +510,11 @@ TSMCube* TiledStMan::makeTSMCube (TSMFile* file, const IPosition& cubeShape,
                                   Int64 fileOffset)
 {
     TSMCube* hypercube;
-    if (tsmOption().option() == TSMOption::MMap) {
+    if (tileCodec_p != TSMCodec::None  ||  constantTiles_p) {
+        // Compressed or constant tiles can only be accessed via the cache.
+        hypercube = new TSMCube (this, file, cubeShape, tileShape,
+                                 values, fileOffset);
+    } else if (tsmOption().option() == TSMOption::MMap) {
         //cout << "mmapping TSM1" << endl;
         AlwaysAssert (file->bucketFile()->isMapped(), AipsError);
         hypercube = new TSMCubeMMap (this, file, cubeShape, tileShape,
@@ -1051,9 +1181,11 @@ void TiledStMan::headerFilePut (AipsIO& headerFile, uInt64 nrCube)
     // is used. In that way older software can read newer tables.
     // Similarly, use older version if number of rows less than maxUint.
     Bool useNewVersion = False;
+    // Version 4 is only used if constant tiles are kept.
     if (nrrow_p > MAXROWNR32  ||
-        persMaxCacheSize_p != uInt(persMaxCacheSize_p)) {
-      headerFile.putstart ("TiledStMan", 3);
+        persMaxCacheSize_p != uInt(persMaxCacheSize_p)  ||
+        constantTiles_p) {
+      headerFile.putstart ("TiledStMan", constantTiles_p ? 4 : 3);
       headerFile << asBigEndian();
       useNewVersion = True;
     } else if (asBigEndian()) {
@@ -1081,6 +1213,9 @@ void TiledStMan::headerFilePut (AipsIO& headerFile, uInt64 nrCube)
     } else {
       headerFile << uInt(persMaxCacheSize_p);
     }
+    if (constantTiles_p) {
+      headerFile << constantTiles_p;
+    }
     headerFile << nrdim_p;
     // nrfile and nrcube can never exceed nrrow,
     // so it's safe to use uInt for old version.
@@ -1167,6 +1302,10 @@ uInt TiledStMan::headerFileGet (AipsIO& headerFile, rownr_t tabNrrow,
       headerFile >> tmp;
       persMaxCacheSize_p = tmp;
     }
+    constantTiles_p = False;
+    if (version >= 4) {
+      headerFile >> constantTiles_p;
+    }
     maxCacheSize_p = persMaxCacheSize_p;
     if (firstTime) {
 	// Setup the various things (i.e. initialize other variables).
@@ -1206,6 +1345,13 @@ uInt TiledStMan::headerFileGet (AipsIO& headerFile, rownr_t tabNrrow,
 	    fileSet_p[i] = 0;
 	}
     }
+    // The tile codec is kept in the files.
+    for (uInt64 i=0; i<nrFile; i++) {
+        if (fileSet_p[i] != 0) {
+            tileCodec_p = fileSet_p[i]->codec();
+            break;
+        }
+    }
     uInt64 nrCube;
     if (version >= 3) {
       headerFile >> nrCube;
@@ -1221,7 +1367,9 @@ uInt TiledStMan::headerFileGet (AipsIO& headerFile, rownr_t tabNrrow,
     }
     for (uInt64 i=0; i<nrCube; i++) {
 	if (cubeSet_p[i] == 0) {
-            if (tsmOption().option() == TSMOption::MMap) {
+            if (tileCodec_p != TSMCodec::None  ||  constantTiles_p) {
+	        cubeSet_p[i] = new TSMCube (this, headerFile);
+            } else if (tsmOption().option() == TSMOption::MMap) {
                 //cout << "mmapping TSM" << endl;
                 cubeSet_p[i] = new TSMCubeMMap (this, headerFile);
             } else if (tsmOption().option() == TSMOption::Buffer) {
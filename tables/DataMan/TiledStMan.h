@@ -37,6 +37,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -172,6 +173,82 @@ public:
     // Get the current maximum cache size (in MiB (MibiByte)).
     uInt maximumCacheSize() const;
 
+    // Set the number of threads to use to read and copy the tiles of
+    // a section spanning multiple tiles. 0 means all cores.
+    // The initial value is given by the aipsrc variable
+    // <src>tiledstman.nthreads</src> (default 1).
+    void setNThreads (uInt nthreads);
+
+    // Get the number of threads to use to access the tiles of a section.
+    uInt nthreads() const;
+
+    // Get the default number of threads as defined in aipsrc.
+    static uInt defaultNThreads();
+
+    // Set if the cache size of the hypercubes is adapted to the access
+    // pattern. If set, a hypercube keeps track of the tiles accessed and
+    // grows its cache when a tile has to be reread that would have been
+    // kept in a larger cache. The caches of all hypercubes in the process
+    // share the memory budget given by <src>cacheBudget</src>.
+    // The cache size of a hypercube set explicitly by the user is not
+    // adapted. The initial value is given by the aipsrc variable
+    // <src>tiledstman.adaptivecache</src> (default False).
+    void setAdaptiveCache (Bool adaptive);
+
+    // Is the cache size adapted to the access pattern?
+    Bool adaptiveCache() const;
+
+    // Get the default adaptive mode as defined in aipsrc.
+    static Bool defaultAdaptiveCache();
+
+    // Get the memory budget (in bytes) for the caches of all hypercubes
+    // in adaptive mode. It is defined in MiB by the aipsrc variable
+    // <src>tiledstman.cachebudget</src>. The default 0 means the budget
+    // of the <linkto class=CacheManager>CacheManager</linkto> if set,
+    // otherwise 25% of the total memory.
+    static uInt64 cacheBudget();
+
+    // Set the codec used to compress the tiles (see
+    // <linkto class=TSMCodec>TSMCodec</linkto> for the possible names).
+    // Each tile is compressed independently, so a tile can be read
+    // without reading other tiles. The codec is persistent, but can only
+    // be set as long as no hypercubes have been created; an exception is
+    // thrown otherwise or if the codec is not available in this build.
+    // It can also be given as TILECODEC in the data manager specification.
+    // <br>Compressed tiles cannot be memory-mapped or buffered, so the
+    // <linkto class=TSMOption>TSMOption</linkto> is ignored and the
+    // tiles are always accessed through the cache.
+    void setTileCodec (const String& codec);
+
+    // Get the codec used to compress the tiles.
+    TSMCodec::Type tileCodec() const;
+
+    // Set if tiles with a constant value are kept in the hypercube header
+    // instead of being written. Such a tile is not read nor converted when
+    // it is used; its data are filled with the constant value.
+    // Each data column in a tile can have its own value. It is useful
+    // for, for instance, FLAG columns where most tiles are entirely False
+    // or entirely True.
+    // The setting is persistent, but can only be changed as long as no
+    // hypercubes have been created. It can also be given as CONSTANTTILES
+    // in the data manager specification.
+    // <br>Like compressed tiles, constant tiles can only be accessed
+    // through the cache, so the <linkto class=TSMOption>TSMOption</linkto>
+    // is ignored.
+    void setConstantTiles (Bool constantTiles);
+
+    // Are tiles with a constant value kept in the hypercube header?
+    Bool constantTiles() const;
+
+    // Get the size of the basic data type used when compressing the tiles.
+    // It is the size of the data type of the data columns (the real size
+    // for complex types and 1 for Bool), or 1 if they have different sizes.
+    uInt tileCodecElementSize() const;
+
+    // Get the cache statistics of the given hypercube.
+    // See <src>TSMCube::cacheStatistics</src> for its fields.
+    Record cacheStatistics (uInt hypercube) const;
+
     // Get the current cache size (in buckets) for the hypercube in
     // the given row.
     uInt cacheSize (rownr_t rownr) const;
@@ -300,7 +377,8 @@ public:
     // It also returns the position of the row in that hypercube.
     virtual TSMCube* getHypercube (rownr_t rownr, IPosition& position) = 0;
 
-    // Make the correct TSMCube type (depending on tsmOption()).
+    // Make the correct TSMCube type (depending on tsmOption() and
+    // the tile codec).
     TSMCube* makeTSMCube (TSMFile* file, const IPosition& cubeShape,
                           const IPosition& tileShape,
                           const Record& values, Int64 fileOffset=-1);
@@ -511,6 +589,14 @@ protected:
     uInt      persMaxCacheSize_p;
     // The actual maximum cache size for a hypercube (in MiB).
     uInt      maxCacheSize_p;
+    // The number of threads to use to access the tiles of a section.
+    uInt      nthreads_p;
+    // Adapt the cache size to the access pattern?
+    Bool      adaptiveCache_p;
+    // The codec used to compress the tiles.
+    TSMCodec::Type tileCodec_p;
+    // Are constant tiles kept in the hypercube header?
+    Bool      constantTiles_p;
     // The dimensionality of the hypercolumn.
     uInt      nrdim_p;
     // The number of vector coordinates.
@@ -532,6 +618,18 @@ private:
 inline uInt TiledStMan::maximumCacheSize() const
     { return maxCacheSize_p; }
 
+inline uInt TiledStMan::nthreads() const
+    { return nthreads_p; }
+
+inline Bool TiledStMan::adaptiveCache() const
+    { return adaptiveCache_p; }
+
+inline TSMCodec::Type TiledStMan::tileCodec() const
+    { return tileCodec_p; }
+
+inline Bool TiledStMan::constantTiles() const
+    { return constantTiles_p; }
+
 inline uInt TiledStMan::nrCoordVector() const
     { return nrCoordVector_p; }
 
@@ -81,6 +81,7 @@ DataManager* ROTiledStManAccessor::getDataManager() const
 
 void ROTiledStManAccessor::setMaximumCacheSize (uInt size)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->setMaximumCacheSize (size);
 }
 uInt ROTiledStManAccessor::maximumCacheSize() const
@@ -88,6 +89,29 @@ uInt ROTiledStManAccessor::maximumCacheSize() const
     return dataManPtr_p->maximumCacheSize();
 }
 
+void ROTiledStManAccessor::setNThreads (uInt nthreads)
+{
+    dataManPtr_p->setNThreads (nthreads);
+}
+uInt ROTiledStManAccessor::nthreads() const
+{
+    return dataManPtr_p->nthreads();
+}
+void ROTiledStManAccessor::setAdaptiveCache (Bool adaptive)
+{
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
+    dataManPtr_p->setAdaptiveCache (adaptive);
+}
+Bool ROTiledStManAccessor::adaptiveCache() const
+{
+    return dataManPtr_p->adaptiveCache();
+}
+Record ROTiledStManAccessor::cacheStatistics (uInt hypercube) const
+{
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
+    return dataManPtr_p->cacheStatistics (hypercube);
+}
+
 uInt ROTiledStManAccessor::cacheSize (rownr_t rownr) const
 {
     return dataManPtr_p->cacheSize (rownr);
@@ -165,6 +189,7 @@ void ROTiledStManAccessor::setCacheSize (rownr_t rownr,
 					 const IPosition& axisPath,
 					 Bool forceSmaller)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->setCacheSize (rownr, sliceShape, IPosition(),
 				IPosition(), axisPath,
 				forceSmaller);
@@ -176,6 +201,7 @@ void ROTiledStManAccessor::setCacheSize (rownr_t rownr,
 					 const IPosition& axisPath,
 					 Bool forceSmaller)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->setCacheSize (rownr, sliceShape, windowStart,
 				windowLength, axisPath,
 				forceSmaller);
@@ -184,12 +210,14 @@ void ROTiledStManAccessor::setCacheSize (rownr_t rownr,
 void ROTiledStManAccessor::setCacheSize (rownr_t rownr, uInt nbuckets,
 					 Bool forceSmaller)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->setCacheSize (rownr, nbuckets, forceSmaller);
 }
 
 void ROTiledStManAccessor::setHypercubeCacheSize (uInt hypercube, uInt nbuckets,
                                                   Bool forceSmaller)
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     // Allow the cache to be sized only if the hypercube is not empty.
 
     if (getBucketSize(hypercube) > 0){
@@ -199,6 +227,7 @@ void ROTiledStManAccessor::setHypercubeCacheSize (uInt hypercube, uInt nbuckets,
 
 void ROTiledStManAccessor::clearCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock(dataManPtr_p->accessMutex());
     dataManPtr_p->emptyCaches();
 }
 
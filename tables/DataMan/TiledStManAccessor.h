@@ -188,6 +188,35 @@ public:
     // Get the maximum cache size (in MiB).
     uInt maximumCacheSize() const;
 
+    // Set the number of threads to use to read and copy the tiles of
+    // a data section spanning multiple tiles (0 means all cores).
+    // It is only used if the cache can hold all tiles of the section.
+    // The initial value is defined by the aipsrc variable
+    // <src>tiledstman.nthreads</src> (default 1).
+    // The value is not persistent.
+    void setNThreads (uInt nthreads);
+
+    // Get the number of threads to use.
+    uInt nthreads() const;
+
+    // Switch the adaptive cache mode on or off. In adaptive mode the
+    // cache of a hypercube grows to the working set of the tiles
+    // accessed, as long as it fits in the memory budget shared by all
+    // hypercubes (see <src>TiledStMan::cacheBudget</src>).
+    // It is not used for a hypercube whose cache size is set explicitly.
+    // The initial mode is defined by the aipsrc variable
+    // <src>tiledstman.adaptivecache</src> (default False).
+    // The mode is not persistent.
+    void setAdaptiveCache (Bool adaptive);
+
+    // Is the adaptive cache mode used?
+    Bool adaptiveCache() const;
+
+    // Get the cache statistics of the given hypercube as a record with
+    // the fields CacheSize, BucketSize, Accesses, Hits, Misses, Evictions,
+    // Reads, Writes, BytesRead, BytesWritten, and AdaptiveResizes.
+    Record cacheStatistics (uInt hypercube) const;
+
     // Get the current cache size (in buckets) for the hypercube in
     // the given row.
     uInt cacheSize (rownr_t rownr) const;
@@ -0,0 +1,147 @@
+//# tAdios2StManMPI.cc: Test program for parallel writes with the ADIOS2 storage manager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/DataMan/Adios2StMan.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/namespace.h>
+
+// This test has to be run with multiple MPI processes (see the .run file).
+// Each rank writes its own row range of the DATA, FLAG and TIME columns,
+// after which all ranks check the entire table.
+
+const std::string tableName = "tAdios2StManMPI_tmp.tab";
+const IPosition cellShape(2, 4, 8);
+
+Complex dataValue(rownr_t row, size_t i)
+{
+    return Complex(row, i);
+}
+
+Bool flagValue(rownr_t row, size_t i)
+{
+    return (row + i) % 3 == 0;
+}
+
+void doWrite(int rank, int nrank)
+{
+    // Let the ranks write a different number of rows.
+    rownr_t nLocalRows = 10 + rank;
+    rownr_t nTotalRows;
+    rownr_t startRow = Adios2StMan::rankRowOffset(MPI_COMM_WORLD, nLocalRows,
+                                                  nTotalRows);
+    AlwaysAssertExit(startRow == rownr_t(10 * rank + rank * (rank - 1) / 2));
+    AlwaysAssertExit(nTotalRows == rownr_t(10 * nrank + nrank * (nrank - 1) / 2));
+
+    // Aggregate the data of all ranks into a single subfile.
+    std::map<std::string, std::string> engineParams;
+    engineParams["NumAggregators"] = "1";
+    Adios2StMan stman(MPI_COMM_WORLD, "", engineParams);
+
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn(ScalarColumnDesc<Double>("TIME"));
+    td.addColumn(ArrayColumnDesc<Complex>("DATA", cellShape, ColumnDesc::FixedShape));
+    td.addColumn(ArrayColumnDesc<Bool>("FLAG", cellShape, ColumnDesc::FixedShape));
+    SetupNewTable newtab(tableName, td, Table::New);
+    newtab.bindAll(stman);
+    Table tab(MPI_COMM_WORLD, newtab, nTotalRows);
+    // Table keywords are committed by rank 0.
+    if (rank == 0)
+    {
+        tab.rwKeywordSet().define("NRANK", nrank);
+    }
+
+    Cube<Complex> data(cellShape[0], cellShape[1], nLocalRows);
+    Cube<Bool> flag(cellShape[0], cellShape[1], nLocalRows);
+    Vector<Double> time(nLocalRows);
+    for (rownr_t r = 0; r < nLocalRows; ++r)
+    {
+        Matrix<Complex> dataCell(data.xyPlane(r));
+        Matrix<Bool> flagCell(flag.xyPlane(r));
+        for (size_t i = 0; i < dataCell.size(); ++i)
+        {
+            dataCell.data()[i] = dataValue(startRow + r, i);
+            flagCell.data()[i] = flagValue(startRow + r, i);
+        }
+        time[r] = startRow + r;
+    }
+    Slicer rows(IPosition(1, startRow), IPosition(1, nLocalRows));
+    ScalarColumn<Double>(tab, "TIME").putColumnRange(rows, time);
+    ArrayColumn<Complex>(tab, "DATA").putColumnRange(rows, data);
+    ArrayColumn<Bool>(tab, "FLAG").putColumnRange(rows, flag);
+}
+
+void doRead(int nrank)
+{
+    Table tab(tableName);
+    AlwaysAssertExit(tab.keywordSet().asInt("NRANK") == nrank);
+    rownr_t nrow = tab.nrow();
+    AlwaysAssertExit(nrow == rownr_t(10 * nrank + nrank * (nrank - 1) / 2));
+    Vector<Double> time = ScalarColumn<Double>(tab, "TIME").getColumn();
+    Array<Complex> data = ArrayColumn<Complex>(tab, "DATA").getColumn();
+    Array<Bool> flag = ArrayColumn<Bool>(tab, "FLAG").getColumn();
+    AlwaysAssertExit(data.shape() == IPosition(3, cellShape[0], cellShape[1], nrow));
+    AlwaysAssertExit(flag.shape() == data.shape());
+    size_t cellSize = cellShape.product();
+    for (rownr_t row = 0; row < nrow; ++row)
+    {
+        AlwaysAssertExit(time[row] == Double(row));
+        for (size_t i = 0; i < cellSize; ++i)
+        {
+            AlwaysAssertExit(data.data()[row * cellSize + i] == dataValue(row, i));
+            AlwaysAssertExit(flag.data()[row * cellSize + i] == flagValue(row, i));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int rank, nrank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nrank);
+    try
+    {
+        doWrite(rank, nrank);
+        MPI_Barrier(MPI_COMM_WORLD);
+        doRead(nrank);
+    }
+    catch (std::exception &x)
+    {
+        cout << "Unexpected exception: " << x.what() << endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,199 @@
+//# tSSMZoneMap.cc: Test program for the zone maps of the StandardStMan
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <limits>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the zone maps kept by the StandardStMan.
+// It checks that the zone maps cover the values and that selections
+// using them give the same result as a selection without them.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab("tSSMZoneMap_tmp.tab", td, Table::New);
+  StandardStMan ssm("SSM", -100);
+  ssm.setZoneMaps (True);
+  newtab.bindAll (ssm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ScalarColumn<String> name(tab, "NAME");
+  for (rownr_t i=0; i<nrow; ++i) {
+    time.put (i, 1000. + i/10);
+    ant.put (i, i%7);
+    name.put (i, "n");
+  }
+  AlwaysAssertExit (tab.dataManagerInfo().subRecord(0).subRecord("SPEC").
+                    asBool("ZONEMAPS"));
+}
+
+// Check that the zone map of the column covers all values.
+void checkZoneMap (const Table& tab, const String& colName)
+{
+  TableColumn col(tab, colName);
+  Vector<rownr_t> endRows;
+  Vector<Double> minValues, maxValues;
+  AlwaysAssertExit (col.getZoneMap (endRows, minValues, maxValues));
+  AlwaysAssertExit (endRows.size() > 1);
+  AlwaysAssertExit (endRows[endRows.size()-1] == tab.nrow()-1);
+  rownr_t st = 0;
+  for (uInt i=0; i<endRows.size(); ++i) {
+    for (rownr_t row=st; row<=endRows[i]; ++row) {
+      Double v = col.asdouble(row);
+      AlwaysAssertExit (v >= minValues[i]  &&  v <= maxValues[i]);
+    }
+    st = endRows[i] + 1;
+  }
+}
+
+// Check a selection against the row by row evaluation.
+void checkSelect (const Table& tab, const TableExprNode& expr)
+{
+  Vector<rownr_t> rows = tab(expr).rowNumbers();
+  Vector<rownr_t> expRows(tab.nrow());
+  uInt nr = 0;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (expr.getBool(i)) {
+      expRows[nr++] = i;
+    }
+  }
+  expRows.resize (nr, True);
+  AlwaysAssertExit (rows.size() == nr  &&  allEQ (rows, expRows));
+  AlwaysAssertExit (allEQ (tab(expr, 0, 0, 2).rowNumbers(), expRows));
+}
+
+void checkSelects (const Table& tab)
+{
+  TableExprNode time = tab.col("TIME");
+  TableExprNode ant = tab.col("ANTENNA1");
+  checkSelect (tab, time > 1500.);
+  checkSelect (tab, time >= 1200.  &&  time < 1203.);
+  checkSelect (tab, time == 1250.  ||  time == 3000.);
+  checkSelect (tab, time > 1600.  &&  ant == 3);
+  checkSelect (tab, (time < 1010.  ||  time > 1990.)  &&  ant != 3);
+  checkSelect (tab, time > 5000.);
+  checkSelect (tab, ant >= 5);
+  checkSelect (tab, ant*2 > 5  ||  time < 1100.);
+  // Open ranges must not exclude infinite values.
+  checkSelect (tab, time > 1e300);
+  checkSelect (tab, time < -1e300);
+}
+
+// Check selections using the same column name in two tables.
+// Their ranges must not be combined.
+void checkTwoTables (const Table& tab)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  SetupNewTable newtab("tSSMZoneMap_tmp.tab2", td, Table::New);
+  StandardStMan ssm("SSM", -100);
+  ssm.setZoneMaps (True);
+  newtab.bindAll (ssm);
+  Table tab2(newtab, tab.nrow());
+  ScalarColumn<Double> time2(tab2, "TIME");
+  for (rownr_t i=0; i<tab2.nrow(); ++i) {
+    time2.put (i, 2000. - i/10);
+  }
+  TableExprNode t1 = tab.col("TIME");
+  TableExprNode t2 = tab2.col("TIME");
+  checkSelect (tab, t1 > 1500.  &&  t2 < 1500.);
+  checkSelect (tab, t1 > 1900.  ||  t2 > 1950.);
+  checkSelect (tab2, t2 > 1950.  ||  t1 > 1900.);
+  AlwaysAssertExit (tab(t1 > 1500.  &&  t2 < 1500.).nrow() > 0);
+}
+
+int main()
+{
+  try {
+    createTable (10000);
+    checkTwoTables (Table("tSSMZoneMap_tmp.tab"));
+    {
+      Table tab("tSSMZoneMap_tmp.tab", Table::Update);
+      checkZoneMap (tab, "TIME");
+      checkZoneMap (tab, "ANTENNA1");
+      Vector<rownr_t> endRows;
+      Vector<Double> minValues, maxValues;
+      AlwaysAssertExit (! TableColumn(tab, "NAME").getZoneMap
+                        (endRows, minValues, maxValues));
+      checkSelects (tab);
+      // Change some values and add and remove some rows.
+      ScalarColumn<Double> time(tab, "TIME");
+      time.put (5555, 5555.);
+      // Fill some entire buckets with infinite values.
+      for (rownr_t i=7600; i<7900; ++i) {
+        time.put (i, std::numeric_limits<Double>::infinity());
+        time.put (i+1000, -std::numeric_limits<Double>::infinity());
+      }
+      tab.addRow (250);
+      for (rownr_t i=10000; i<tab.nrow(); ++i) {
+        time.put (i, 2000. + i/10);
+      }
+      tab.removeRow (17);
+      tab.removeRow (4321);
+      checkZoneMap (tab, "TIME");
+      checkZoneMap (tab, "ANTENNA1");
+      checkSelects (tab);
+      // Put the entire column.
+      ScalarColumn<Int> ant(tab, "ANTENNA1");
+      Vector<Int> ants(tab.nrow());
+      indgen (ants);
+      ant.putColumn (ants);
+      checkZoneMap (tab, "ANTENNA1");
+      checkSelects (tab);
+    }
+    // Check that the zone maps have been persisted.
+    Table tab("tSSMZoneMap_tmp.tab");
+    checkZoneMap (tab, "TIME");
+    checkZoneMap (tab, "ANTENNA1");
+    checkSelects (tab);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
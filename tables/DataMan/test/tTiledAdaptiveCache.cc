@@ -0,0 +1,119 @@
+//# tTiledAdaptiveCache.cc: Test program for the adaptive tile cache of the TSM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the adaptive tile cache of the tiled storage managers.
+// It reads a column in an order not matching the tiles, so the cache
+// has to hold all tiles of a row of tiles to avoid rereading them.
+// </summary>
+
+void createTable (const IPosition& shape, rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", shape,
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTiledAdaptiveCache_tmp.data", td, Table::New);
+  TiledColumnStMan sm ("TSM", IPosition(3, 8, 8, 8));
+  newtab.bindAll (sm);
+  Table tab(newtab, nrow);
+  ArrayColumn<Float> data(tab, "DATA");
+  Cube<Float> arr(shape[0], shape[1], nrow);
+  indgen (arr);
+  data.putColumn (arr);
+}
+
+// Read the column line by line along the rows.
+// Return the cache statistics.
+Record readTable (const IPosition& shape, rownr_t nrow, Bool adaptive)
+{
+  Table tab("tTiledAdaptiveCache_tmp.data", Table::Old,
+            TSMOption(TSMOption::Cache));
+  ROTiledStManAccessor acc(tab, "TSM");
+  acc.setAdaptiveCache (adaptive);
+  AlwaysAssertExit (acc.adaptiveCache() == adaptive);
+  ArrayColumn<Float> data(tab, "DATA");
+  Cube<Float> arr(shape[0], shape[1], nrow);
+  indgen (arr);
+  for (Int j=0; j<shape[1]; ++j) {
+    Slicer slicer (IPosition(2,0,j), IPosition(2,shape[0],1));
+    for (rownr_t i=0; i<nrow; ++i) {
+      AlwaysAssertExit (allEQ (data.getSlice(i, slicer),
+                               arr(IPosition(3,0,j,i),
+                                   IPosition(3,shape[0]-1,j,i)).
+                               reform(slicer.length())));
+    }
+  }
+  Record stat = acc.cacheStatistics (0);
+  // Check the consistency of the statistics.
+  AlwaysAssertExit (stat.asInt("BucketSize") == 8*8*8*4);
+  AlwaysAssertExit (stat.asInt64("Hits") + stat.asInt64("Misses") ==
+                    stat.asInt64("Accesses"));
+  AlwaysAssertExit (stat.asInt64("BytesRead") ==
+                    stat.asInt64("Reads") * stat.asInt("BucketSize"));
+  AlwaysAssertExit (stat.asInt64("Writes") == 0);
+  return stat;
+}
+
+int main()
+{
+  try {
+    IPosition shape(2, 8, 32);
+    createTable (shape, 64);
+    Record stat1 = readTable (shape, 64, False);
+    Record stat2 = readTable (shape, 64, True);
+    // Without adaptive cache each tile is read for each line in it.
+    // The adaptive cache has to hold the 8 tiles along the rows.
+    AlwaysAssertExit (stat1.asInt64("AdaptiveResizes") == 0);
+    AlwaysAssertExit (stat2.asInt64("AdaptiveResizes") > 0);
+    AlwaysAssertExit (stat2.asInt("CacheSize") >= 8);
+    AlwaysAssertExit (stat2.asInt64("Reads") < stat1.asInt64("Reads"));
+    AlwaysAssertExit (stat2.asInt64("Reads") < 2*4*8);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,381 @@
+//# tTiledCompressed.cc: Test program for compressed tiles in the tiled storage managers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/DataMan/TSMCodec.h>
+#include <casacore/tables/DataMan/TSMCompressedFile.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the tile codecs of the tiled storage managers.
+// It checks the codecs themselves and that tables with compressed tiles
+// can be written, rewritten and read back.
+// </summary>
+
+// Compress and decompress a buffer and check the result.
+void checkCodec (TSMCodec::Type codec, uInt elementSize,
+                 const std::vector<char>& data, Bool mustShrink)
+{
+  std::vector<char> comp;
+  uInt clen = TSMCodec::compress (codec, elementSize, data.data(),
+                                  data.size(), comp);
+  if (mustShrink) {
+    AlwaysAssertExit (clen > 0  &&  clen < data.size());
+  }
+  if (clen > 0) {
+    std::vector<char> raw(data.size());
+    TSMCodec::decompress (codec, elementSize, comp.data(), clen,
+                          raw.data(), raw.size());
+    AlwaysAssertExit (raw == data);
+  }
+}
+
+void testCodecs()
+{
+  AlwaysAssertExit (TSMCodec::fromString("") == TSMCodec::None);
+  AlwaysAssertExit (TSMCodec::fromString("rle") == TSMCodec::RLE);
+  AlwaysAssertExit (TSMCodec::fromString("Zlib") == TSMCodec::Zlib);
+  AlwaysAssertExit (TSMCodec::toString(TSMCodec::LZ4) == "LZ4");
+  AlwaysAssertExit (TSMCodec::isAvailable(TSMCodec::RLE));
+  Bool caught = False;
+  try {
+    TSMCodec::fromString ("unknown");
+  } catch (const TSMError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+  // Constant, smooth and noisy float data.
+  std::vector<char> constant(4000, 0);
+  std::vector<char> smooth(4000);
+  std::vector<char> noisy(4001);
+  Float* fptr = reinterpret_cast<Float*>(smooth.data());
+  for (uInt i=0; i<1000; ++i) {
+    fptr[i] = i/100;
+  }
+  uInt seed = 1;
+  for (uInt i=0; i<noisy.size(); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    noisy[i] = seed >> 16;
+  }
+  TSMCodec::Type codecs[] = {TSMCodec::RLE, TSMCodec::Zlib,
+                             TSMCodec::Zstd, TSMCodec::LZ4};
+  for (uInt i=0; i<4; ++i) {
+    if (TSMCodec::isAvailable (codecs[i])) {
+      checkCodec (codecs[i], 4, constant, True);
+      checkCodec (codecs[i], 4, smooth, True);
+      checkCodec (codecs[i], 1, smooth, False);
+      checkCodec (codecs[i], 4, noisy, False);
+      checkCodec (codecs[i], 8, noisy, False);
+    }
+  }
+}
+
+// Get the value expected in the data column.
+// Rows added after the rewrite have their original value.
+Float dataValue (Int i, Int j, rownr_t row, Bool rewritten)
+{
+  if (rewritten  &&  row%4 == 1  &&  row < 100) {
+    return (i*31 + j*17 + row*7) % 101 + 0.5;
+  }
+  return row/10;
+}
+
+void createTable (const String& name, const IPosition& shape, rownr_t nrow,
+                  const String& codec)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", shape,
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool> ("FLAG", shape,
+                                       ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Double> ("WEIGHT", shape,
+                                         ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  TiledColumnStMan sm1 ("TSMData", IPosition(3, shape[0], shape[1], 8));
+  sm1.setTileCodec (codec);
+  newtab.bindColumn ("DATA", sm1);
+  // Data of different types in a tile are not byte-shuffled.
+  TiledColumnStMan sm3 ("TSMFlag", IPosition(3, shape[0], shape[1], 8));
+  sm3.setTileCodec (codec);
+  newtab.bindColumn ("FLAG", sm3);
+  // Use the specification record for the other one.
+  Record spec;
+  spec.define ("DEFAULTTILESHAPE", IPosition(3, shape[0], shape[1], 16).
+               asVector());
+  spec.define ("TILECODEC", codec);
+  TiledShapeStMan sm2 ("TSMWeight", spec);
+  newtab.bindColumn ("WEIGHT", sm2);
+  Table tab(newtab, nrow);
+  ArrayColumn<Float> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<Double> weight(tab, "WEIGHT");
+  Matrix<Float> arr(shape);
+  Matrix<Bool> farr(shape);
+  for (rownr_t row=0; row<nrow; ++row) {
+    arr = dataValue (0, 0, row, False);
+    farr = (row%3 == 0);
+    data.put (row, arr);
+    flag.put (row, farr);
+    weight.put (row, Matrix<Double>(shape, 1.));
+  }
+}
+
+// Rewrite every 4th row with data that compress badly.
+void rewriteTable (const String& name)
+{
+  Table tab(name, Table::Update);
+  ArrayColumn<Float> data(tab, "DATA");
+  IPosition shape = data.shape(0);
+  Matrix<Float> arr(shape);
+  for (rownr_t row=1; row<100; row+=4) {
+    for (Int j=0; j<shape[1]; ++j) {
+      for (Int i=0; i<shape[0]; ++i) {
+        arr(i,j) = dataValue (i, j, row, True);
+      }
+    }
+    data.put (row, arr);
+  }
+  // Add some rows.
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<Double> weight(tab, "WEIGHT");
+  rownr_t nrow = tab.nrow();
+  tab.addRow (10);
+  for (rownr_t row=nrow; row<tab.nrow(); ++row) {
+    arr = dataValue (0, 0, row, False);
+    data.put (row, arr);
+    flag.put (row, Matrix<Bool>(shape, row%3 == 0));
+    weight.put (row, Matrix<Double>(shape, 1.));
+  }
+}
+
+void checkTable (const String& name, const String& codec, Bool rewritten,
+                 const TSMOption& tsmOpt)
+{
+  Table tab(name, Table::Old, tsmOpt);
+  Record dminfo = tab.dataManagerInfo();
+  for (uInt i=0; i<dminfo.nfields(); ++i) {
+    const Record& spec = dminfo.subRecord(i).subRecord("SPEC");
+    if (codec.empty()) {
+      AlwaysAssertExit (! spec.isDefined ("TILECODEC"));
+    } else {
+      AlwaysAssertExit (spec.asString("TILECODEC") ==
+                        TSMCodec::toString (TSMCodec::fromString (codec)));
+    }
+  }
+  ArrayColumn<Float> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<Double> weight(tab, "WEIGHT");
+  IPosition shape = data.shape(0);
+  Matrix<Float> arr(shape);
+  for (rownr_t row=0; row<tab.nrow(); ++row) {
+    for (Int j=0; j<shape[1]; ++j) {
+      for (Int i=0; i<shape[0]; ++i) {
+        arr(i,j) = dataValue (i, j, row, rewritten);
+      }
+    }
+    AlwaysAssertExit (allEQ (data(row), arr));
+    AlwaysAssertExit (allEQ (flag(row), row%3 == 0));
+    AlwaysAssertExit (allEQ (weight(row), 1.));
+  }
+  // Read a slice spanning multiple tiles.
+  Array<Float> col = data.getColumn (Slicer(IPosition(2,1,2),
+                                            IPosition(2,2,3)));
+  AlwaysAssertExit (col.shape() == IPosition(3, 2, 3, tab.nrow()));
+}
+
+void doIt (const String& codec)
+{
+  String name = "tTiledCompressed_tmp.data";
+  IPosition shape(2, 16, 20);
+  rownr_t nrow = 100;
+  createTable (name, shape, nrow, codec);
+  checkTable (name, codec, False, TSMOption(TSMOption::Cache));
+  Int64 size = RegularFile(name + "/table.f0_TSM0").size();
+  if (codec.empty()) {
+    AlwaysAssertExit (size >= Int64(nrow*shape.product()*sizeof(Float)));
+  } else {
+    AlwaysAssertExit (size < Int64(nrow*shape.product()*sizeof(Float)/4));
+  }
+  rewriteTable (name);
+  // The TSMOption does not matter for compressed tiles.
+  checkTable (name, codec, True, TSMOption(TSMOption::Cache));
+  checkTable (name, codec, True, TSMOption(TSMOption::MMap));
+  checkTable (name, codec, True, TSMOption(TSMOption::Buffer));
+  // A deep copy keeps the codec.
+  {
+    Table tab(name);
+    tab.deepCopy (name + "_copy", Table::New);
+  }
+  checkTable (name + "_copy", codec, True, TSMOption(TSMOption::Cache));
+}
+
+// Check that the space of moved tiles is reused.
+void testFreeSpace()
+{
+  String name = "tTiledCompressed_tmp.file";
+  std::vector<char> constant(4000, 1);
+  std::vector<char> noisy(4000);
+  uInt seed = 1;
+  for (uInt i=0; i<noisy.size(); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    noisy[i] = seed >> 16;
+  }
+  Int64 tileSize, fileSize;
+  {
+    TSMCompressedFile file(name, TSMCodec::RLE, 4);
+    for (Int64 i=0; i<4; ++i) {
+      file.seek (i*4000);
+      file.write (constant.data(), 4000);
+    }
+    tileSize = file.compressedSize() / 4;
+    AlwaysAssertExit (tileSize < 4000  &&  file.freeSize() == 0);
+    // A tile not fitting in its space is moved; its old space is free.
+    file.seek (4000);
+    file.write (noisy.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 4000);
+    AlwaysAssertExit (file.freeSize() == tileSize);
+    // A new tile reuses the free space.
+    file.seek (4*4000);
+    file.write (constant.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 4000);
+    AlwaysAssertExit (file.freeSize() == 0);
+    // The space of two adjacent moved tiles is merged.
+    file.seek (2*4000);
+    file.write (noisy.data(), 4000);
+    file.seek (3*4000);
+    file.write (noisy.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 3*4000);
+    AlwaysAssertExit (file.freeSize() == 2*tileSize);
+    file.seek (5*4000);
+    file.write (constant.data(), 4000);
+    file.seek (6*4000);
+    file.write (constant.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 3*4000);
+    AlwaysAssertExit (file.freeSize() == 0);
+    // Freed space at the end of the file is not kept, so a moved last
+    // tile is written at the same offset.
+    file.seek (7*4000);
+    file.write (constant.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 5*tileSize + 3*4000);
+    file.seek (7*4000);
+    file.write (noisy.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 4*4000);
+    AlwaysAssertExit (file.freeSize() == 0);
+    // Leave some free space in the file.
+    file.seek (4*4000);
+    file.write (noisy.data(), 4000);
+    AlwaysAssertExit (file.compressedSize() == 4*tileSize + 5*4000);
+    AlwaysAssertExit (file.freeSize() == tileSize);
+    fileSize = file.compressedSize();
+    AipsIO ios(name + "_index", ByteIO::New);
+    ios.putstart ("tTiledCompressed", 1);
+    file.putIndex (ios);
+    ios.putend();
+  }
+  // The free space is derived again when reading the index.
+  TSMCompressedFile file(name, False, TSMCodec::RLE, 4);
+  AipsIO ios(name + "_index");
+  ios.getstart ("tTiledCompressed");
+  file.getIndex (ios);
+  ios.getend();
+  file.open();
+  AlwaysAssertExit (file.compressedSize() == fileSize);
+  AlwaysAssertExit (file.freeSize() == tileSize);
+  std::vector<char> buf(4000);
+  for (Int64 i=0; i<8; ++i) {
+    file.seek (i*4000);
+    file.read (buf.data(), 4000);
+    AlwaysAssertExit (buf == (i==0 || i==5 || i==6 ? constant : noisy));
+  }
+}
+
+void testErrors()
+{
+  // The codec cannot be changed once the data are written.
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,4,4),
+                                        ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTiledCompressed_tmp.data", td, Table::New);
+  TiledColumnStMan sm ("TSM", IPosition(3,4,4,8));
+  sm.setTileCodec ("RLE");
+  newtab.bindAll (sm);
+  Table tab(newtab, 10);
+  TiledColumnStMan* smp = dynamic_cast<TiledColumnStMan*>
+    (tab.findDataManager ("TSM"));
+  AlwaysAssertExit (smp != 0);
+  smp->setTileCodec ("RLE");
+  Bool caught = False;
+  try {
+    smp->setTileCodec ("none");
+  } catch (const TSMError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+}
+
+int main()
+{
+  try {
+    testCodecs();
+    doIt ("");
+    doIt ("rle");
+    if (TSMCodec::isAvailable (TSMCodec::Zlib)) {
+      doIt ("ZLIB");
+    }
+    if (TSMCodec::isAvailable (TSMCodec::Zstd)) {
+      doIt ("ZSTD");
+    }
+    if (TSMCodec::isAvailable (TSMCodec::LZ4)) {
+      doIt ("LZ4");
+    }
+    testFreeSpace();
+    testErrors();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
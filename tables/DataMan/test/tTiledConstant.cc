@@ -0,0 +1,189 @@
+//# tTiledConstant.cc: Test program for the constant tiles of the tiled storage managers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for keeping constant tiles in the hypercube header
+// of the tiled storage managers.
+// </summary>
+
+// Get the expected flag and data value of a row.
+// Rows 40-59 and 200-219 are not constant, rows 100-199 are all True.
+// Rows from 300 on are added later, thus initialized to zero.
+Bool expFlag (uInt row, uInt chan)
+{
+  if ((row >= 40  &&  row < 60)  ||  (row >= 200  &&  row < 220)) {
+    return chan%3 == 0;
+  }
+  return row >= 100  &&  row < 200;
+}
+
+Float expData (uInt row, uInt chan)
+{
+  if (row >= 200  &&  row < 220) {
+    return row + chan*0.5;
+  }
+  return (row < 100  ||  row >= 300) ? 0 : 2.5;
+}
+
+void createTable (const String& name, Bool constantTiles, uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Bool>  ("FLAG", IPosition(2,4,64),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,4,64),
+                                        ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMFlag", 3, stringToVector("FLAG"));
+  td.defineHypercolumn ("TSMData", 3, stringToVector("DATA"));
+  SetupNewTable newtab(name, td, Table::New);
+  TiledColumnStMan tsmFlag("TSMFlag", IPosition(3,4,64,20));
+  TiledColumnStMan tsmData("TSMData", IPosition(3,4,64,20));
+  tsmFlag.setConstantTiles (constantTiles);
+  tsmData.setConstantTiles (constantTiles);
+  newtab.bindColumn ("FLAG", tsmFlag);
+  newtab.bindColumn ("DATA", tsmData);
+  Table tab(newtab, nrow);
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<Float> data(tab, "DATA");
+  Matrix<Bool> fl(4,64);
+  Matrix<Float> dt(4,64);
+  for (uInt i=0; i<nrow; ++i) {
+    for (uInt j=0; j<64; ++j) {
+      for (uInt k=0; k<4; ++k) {
+        fl(k,j) = expFlag(i,j);
+        dt(k,j) = expData(i,j);
+      }
+    }
+    flag.put (i, fl);
+    data.put (i, dt);
+  }
+}
+
+void checkTable (const Table& tab)
+{
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  ArrayColumn<Float> data(tab, "DATA");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    Matrix<Bool> fl = flag(i);
+    Matrix<Float> dt = data(i);
+    for (uInt j=0; j<64; ++j) {
+      for (uInt k=0; k<4; ++k) {
+        AlwaysAssertExit (fl(k,j) == expFlag(i,j));
+        AlwaysAssertExit (dt(k,j) == expData(i,j));
+      }
+    }
+  }
+  // Also get the columns as a whole.
+  Array<Bool> fls = flag.getColumn();
+  AlwaysAssertExit (ntrue(fls) == 100*4*64 + 40*4*22);
+}
+
+Int64 nrConstant (const Table& tab, const String& dmName)
+{
+  ROTiledStManAccessor acc(tab, dmName);
+  return acc.cacheStatistics(0).asInt64 ("ConstantTiles");
+}
+
+int main()
+{
+  try {
+    createTable ("tTiledConstant_tmp.tab", True, 300);
+    createTable ("tTiledConstant_tmp.ref", False, 300);
+    {
+      Table tab("tTiledConstant_tmp.tab");
+      AlwaysAssertExit (tab.dataManagerInfo().subRecord(0).subRecord("SPEC").
+                        asBool("CONSTANTTILES"));
+      checkTable (tab);
+      checkTable (Table("tTiledConstant_tmp.ref"));
+      // 13 of the 15 flag tiles and 14 of the data tiles are constant.
+      AlwaysAssertExit (nrConstant (tab, "TSMFlag") == 13);
+      AlwaysAssertExit (nrConstant (tab, "TSMData") == 14);
+      AlwaysAssertExit (RegularFile("tTiledConstant_tmp.tab/table.f0_TSM0").
+                        size() <
+                        RegularFile("tTiledConstant_tmp.ref/table.f0_TSM0").
+                        size());
+    }
+    {
+      // Make a constant tile non-constant and a non-constant one constant.
+      Table tab("tTiledConstant_tmp.tab", Table::Update);
+      ArrayColumn<Bool> flag(tab, "FLAG");
+      Matrix<Bool> fl(4,64, False);
+      fl(1,1) = True;
+      flag.put (5, fl);
+      fl = False;
+      for (uInt i=40; i<60; ++i) {
+        flag.put (i, fl);
+      }
+      tab.flush();
+      AlwaysAssertExit (nrConstant (tab, "TSMFlag") == 13);
+      AlwaysAssertExit (flag(5)(IPosition(2,1,1)) == True);
+      fl(1,1) = False;
+      flag.put (5, fl);
+      for (uInt i=40; i<60; ++i) {
+        Matrix<Bool> f(4,64);
+        for (uInt j=0; j<64; ++j) {
+          for (uInt k=0; k<4; ++k) {
+            f(k,j) = expFlag(i,j);
+          }
+        }
+        flag.put (i, f);
+      }
+      // Add rows; the new tiles are initialized as constant.
+      tab.addRow (40);
+    }
+    {
+      Table tab("tTiledConstant_tmp.tab");
+      AlwaysAssertExit (tab.nrow() == 340);
+      checkTable (tab);
+      AlwaysAssertExit (nrConstant (tab, "TSMFlag") == 15);
+      AlwaysAssertExit (nrConstant (tab, "TSMData") == 16);
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,220 @@
+//# tTiledMMapView.cc: Test program for zero-copy views on mapped TSM tiles
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the zero-copy views on memory-mapped tiles
+// (ArrayColumn::getView, getSliceView and getColumnRangeView).
+// </summary>
+
+void createTable (const String& name, Table::EndianFormat endian)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float>   ("DATA", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex> ("CDATA", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool>    ("FLAG", IPosition(2,4,8),
+                                          ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMData", 3,
+                        stringToVector("DATA,CDATA,FLAG"));
+  SetupNewTable newtab(name, td, Table::New);
+  TiledColumnStMan sm ("TSM", IPosition(3,4,8,16));
+  newtab.bindAll (sm);
+  Table tab(newtab, 100, False, endian, TSMOption::MMap);
+  ArrayColumn<Float> data(tab, "DATA");
+  ArrayColumn<Complex> cdata(tab, "CDATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Matrix<Float> arr(4,8);
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    indgen (arr, Float(i*100));
+    data.put (i, arr);
+    cdata.put (i, makeComplex (arr, -arr));
+    flag.put (i, arr > Float(i*100+10));
+  }
+}
+
+void checkViews (const Table& tab)
+{
+  ArrayColumn<Float> data(tab, "DATA");
+  ArrayColumn<Complex> cdata(tab, "CDATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    Array<Float> view;
+    AlwaysAssertExit (data.getView (i, view));
+    AlwaysAssertExit (view.shape() == IPosition(2,4,8));
+    AlwaysAssertExit (allEQ (view, data(i)));
+    Array<Complex> cview;
+    AlwaysAssertExit (cdata.getView (i, cview));
+    AlwaysAssertExit (allEQ (cview, cdata(i)));
+    // Bools are stored as bits, so cannot be referenced.
+    Array<Bool> fview;
+    AlwaysAssertExit (! flag.getView (i, fview));
+    AlwaysAssertExit (fview.empty());
+  }
+  // Slices consisting of full vectors or a part of a single vector.
+  Slicer sl1 (IPosition(2,0,2), IPosition(2,4,3));
+  Slicer sl2 (IPosition(2,1,5), IPosition(2,2,1));
+  Array<Float> view;
+  AlwaysAssertExit (data.getSliceView (7, sl1, view));
+  AlwaysAssertExit (allEQ (view, data.getSlice (7, sl1)));
+  AlwaysAssertExit (data.getSliceView (7, sl2, view));
+  AlwaysAssertExit (allEQ (view, data.getSlice (7, sl2)));
+  // Non-contiguous and strided slices are not possible.
+  Slicer sl3 (IPosition(2,1,2), IPosition(2,2,2));
+  Slicer sl4 (IPosition(2,0,0), IPosition(2,2,8), IPosition(2,2,1));
+  AlwaysAssertExit (! data.getSliceView (7, sl3, view));
+  AlwaysAssertExit (! data.getSliceView (7, sl4, view));
+  // A range of rows in a single tile.
+  Array<Float> rview;
+  AlwaysAssertExit (data.getColumnRangeView (Slicer(IPosition(1,16),
+                                                    IPosition(1,16)),
+                                             rview));
+  AlwaysAssertExit (rview.shape() == IPosition(3,4,8,16));
+  AlwaysAssertExit (allEQ (rview, data.getColumnRange
+                           (Slicer(IPosition(1,16), IPosition(1,16)))));
+  AlwaysAssertExit (data.getColumnRangeView (Slicer(IPosition(1,97),
+                                                    IPosition(1,3)),
+                                             rview));
+  AlwaysAssertExit (allEQ (rview, data.getColumnRange
+                           (Slicer(IPosition(1,97), IPosition(1,3)))));
+  // Rows spanning multiple tiles or with a stride are not possible.
+  AlwaysAssertExit (! data.getColumnRangeView (Slicer(IPosition(1,10),
+                                                      IPosition(1,10)),
+                                               rview));
+  AlwaysAssertExit (! data.getColumnRangeView (Slicer(IPosition(1,0),
+                                                      IPosition(1,8),
+                                                      IPosition(1,2)),
+                                               rview));
+  // A view can also be made through a reference table.
+  Vector<rownr_t> rows(3);
+  rows[0] = 33; rows[1] = 34; rows[2] = 35;
+  Table sel = tab(rows);
+  ArrayColumn<Float> seldata(sel, "DATA");
+  AlwaysAssertExit (seldata.getView (1, view));
+  AlwaysAssertExit (allEQ (view, data(34)));
+  AlwaysAssertExit (seldata.getColumnRangeView (Slicer(IPosition(1,0),
+                                                       IPosition(1,3)),
+                                                rview));
+  AlwaysAssertExit (allEQ (rview, data.getColumnRange
+                           (Slicer(IPosition(1,33), IPosition(1,3)))));
+  rows[1] = 40;
+  Table sel2 = tab(rows);
+  AlwaysAssertExit (! ArrayColumn<Float>(sel2, "DATA").getColumnRangeView
+                    (Slicer(IPosition(1,0), IPosition(1,3)), rview));
+  // Changing the view's copy does not change the table.
+  Array<Float> copy = view.copy();
+  copy = -1.f;
+  AlwaysAssertExit (allEQ (view, data(34)));
+}
+
+int main()
+{
+  try {
+    Table::EndianFormat localEndian = HostInfo::bigEndian() ?
+      Table::BigEndian : Table::LittleEndian;
+    Table::EndianFormat otherEndian = HostInfo::bigEndian() ?
+      Table::LittleEndian : Table::BigEndian;
+    createTable ("tTiledMMapView_tmp.data", localEndian);
+    createTable ("tTiledMMapView_tmp.data2", otherEndian);
+    Array<Float> keep;
+    {
+      Table tab("tTiledMMapView_tmp.data", Table::Old, TSMOption::MMap);
+      checkViews (tab);
+      AlwaysAssertExit (ArrayColumn<Float>(tab, "DATA").getView (5, keep));
+      // A failing view detaches the array from an earlier view, so a get
+      // thereafter does not write into the readonly mapped data.
+      ArrayColumn<Float> rodata(tab, "DATA");
+      Array<Float> view;
+      AlwaysAssertExit (rodata.getView (6, view));
+      AlwaysAssertExit (! rodata.getSliceView
+                        (6, Slicer(IPosition(2,1,2), IPosition(2,2,2)), view));
+      AlwaysAssertExit (view.empty());
+      rodata.get (6, view);
+      AlwaysAssertExit (allEQ (view, rodata(6)));
+      AlwaysAssertExit (rodata.getView (6, view));
+      AlwaysAssertExit (! rodata.getColumnRangeView
+                        (Slicer(IPosition(1,10), IPosition(1,10)), view));
+      AlwaysAssertExit (view.empty());
+      AlwaysAssertExit (rodata.getView (6, view));
+      // Values written in the tile later are visible in the view.
+      // Opening the table for update makes it writable for tab as well.
+      Table rwtab("tTiledMMapView_tmp.data", Table::Update, TSMOption::MMap);
+      // No views on a writable table.
+      AlwaysAssertExit (! ArrayColumn<Float>(rwtab, "DATA").getView (6, view));
+      AlwaysAssertExit (view.empty());
+      ArrayColumn<Float>(rwtab, "DATA").get (6, view);
+      AlwaysAssertExit (allEQ (view, rodata(6)));
+      AlwaysAssertExit (! ArrayColumn<Float>(rwtab, "DATA").getColumnRangeView
+                        (Slicer(IPosition(1,16), IPosition(1,16)), view));
+      AlwaysAssertExit (view.empty());
+      Matrix<Float> arr(4,8);
+      arr = 3.f;
+      ArrayColumn<Float>(rwtab, "DATA").put (5, arr);
+      AlwaysAssertExit (allEQ (keep, 3.f));
+      arr = 5.f;
+      ArrayColumn<Float>(rwtab, "DATA").put (5, arr);
+    }
+    // The view keeps the mapping alive after the table is closed.
+    AlwaysAssertExit (allEQ (keep, 5.f));
+    {
+      // No views on cached tiles.
+      Table tab("tTiledMMapView_tmp.data", Table::Old, TSMOption::Cache);
+      Array<Float> view;
+      AlwaysAssertExit (! ArrayColumn<Float>(tab, "DATA").getView (5, view));
+    }
+    {
+      // No views if the data have to be converted.
+      Table tab("tTiledMMapView_tmp.data2", Table::Old, TSMOption::MMap);
+      Array<Float> view;
+      AlwaysAssertExit (! ArrayColumn<Float>(tab, "DATA").getView (5, view));
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
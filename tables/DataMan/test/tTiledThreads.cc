@@ -0,0 +1,130 @@
+//# tTiledThreads.cc: Test program for the parallel tile access of the TSM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for reading and writing the tiles of a data section
+// spanning multiple tiles with multiple threads.
+// The results are compared with the single-threaded access.
+// </summary>
+
+void createTable (const IPosition& shape, rownr_t nrow, uInt nthreads)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Complex> ("DATA", shape,
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool> ("FLAG", shape,
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTiledThreads_tmp.data", td, Table::New);
+  TiledColumnStMan sm ("TSM", IPosition(3, 4, 5, 7));
+  newtab.bindAll (sm);
+  Table tab(newtab, nrow, False, Table::LittleEndian,
+            TSMOption(TSMOption::Cache));
+  ROTiledStManAccessor acc(tab, "TSM");
+  acc.setNThreads (nthreads);
+  AlwaysAssertExit (acc.nthreads() == nthreads);
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Cube<Complex> arr(shape[0], shape[1], nrow);
+  Cube<Bool> flg(shape[0], shape[1], nrow);
+  for (size_t i=0; i<arr.size(); ++i) {
+    arr.data()[i] = Complex(i, -Float(i));
+    flg.data()[i] = (i%3 == 0);
+  }
+  data.putColumn (arr);
+  flag.putColumn (flg);
+  // Overwrite a part not aligned with the tiles.
+  Slicer slicer (IPosition(2,1,2), IPosition(2,2,shape[1]-3));
+  Cube<Complex> part(2, shape[1]-3, nrow-5);
+  part = Complex(-1, 1);
+  data.putColumnRange (Slicer(IPosition(1,2), IPosition(1,nrow-5)),
+                       slicer, part);
+}
+
+void checkTable (const IPosition& shape, rownr_t nrow, uInt nthreads)
+{
+  Table tab("tTiledThreads_tmp.data");
+  ROTiledStManAccessor acc(tab, "TSM");
+  acc.setNThreads (nthreads);
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Cube<Complex> arr(shape[0], shape[1], nrow);
+  Cube<Bool> flg(shape[0], shape[1], nrow);
+  for (size_t i=0; i<arr.size(); ++i) {
+    arr.data()[i] = Complex(i, -Float(i));
+    flg.data()[i] = (i%3 == 0);
+  }
+  arr(IPosition(3,1,2,2), IPosition(3,2,shape[1]-2,nrow-4)) = Complex(-1,1);
+  AlwaysAssertExit (allEQ (data.getColumn(), arr));
+  AlwaysAssertExit (allEQ (flag.getColumn(), flg));
+  // Read some slices and cells.
+  Slicer slicer (IPosition(2,1,3), IPosition(2,3,shape[1]-4));
+  Array<Complex> part = data.getColumnRange
+    (Slicer(IPosition(1,3), IPosition(1,nrow-6)), slicer);
+  AlwaysAssertExit (allEQ (part, arr(IPosition(3,1,3,3),
+                                     IPosition(3,3,shape[1]-2,nrow-4))));
+  for (rownr_t i=0; i<nrow; i+=7) {
+    AlwaysAssertExit (allEQ (data.getSlice(i, slicer),
+                             arr(IPosition(3,1,3,i),
+                                 IPosition(3,3,shape[1]-2,i)).
+                             reform(slicer.length())));
+  }
+}
+
+int main()
+{
+  try {
+    IPosition shape(2, 4, 64);
+    // Write and read with a different number of threads.
+    for (uInt nthr=1; nthr<=4; nthr+=3) {
+      createTable (shape, 123, nthr);
+      checkTable (shape, 123, 1);
+      checkTable (shape, 123, 4);
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
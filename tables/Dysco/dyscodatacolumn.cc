@@ -13,19 +13,8 @@ void DyscoDataColumn::Prepare(DyscoDistribution distribution,
   _normalization = normalization;
   ThreadedDyscoColumn::Prepare(distribution, normalization, studentsTNu,
                                distributionTruncation);
-  const size_t nPolarizations = shape()[0], nChannels = shape()[1];
 
-  switch (normalization) {
-    case Normalization::kAF:
-      _decoder.reset(new AFTimeBlockEncoder(nPolarizations, nChannels, true));
-      break;
-    case Normalization::kRF:
-      _decoder.reset(new RFTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-    case Normalization::kRow:
-      _decoder.reset(new RowTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-  }
+  _decoder.reset(makeTimeBlockEncoder());
 
   switch (distribution) {
     case GaussianDistribution:
@@ -49,33 +38,46 @@ void DyscoDataColumn::Prepare(DyscoDistribution distribution,
   }
 }
 
-void DyscoDataColumn::initializeDecode(TimeBlockBuffer<data_t> * /*buffer*/,
+TimeBlockEncoder *DyscoDataColumn::makeTimeBlockEncoder() const {
+  const size_t nPolarizations = shape()[0], nChannels = shape()[1];
+  switch (_normalization) {
+    case Normalization::kAF:
+      return new AFTimeBlockEncoder(nPolarizations, nChannels, true);
+    case Normalization::kRF:
+      return new RFTimeBlockEncoder(nPolarizations, nChannels);
+    case Normalization::kRow:
+      return new RowTimeBlockEncoder(nPolarizations, nChannels);
+  }
+  return nullptr;
+}
+
+std::unique_ptr<ThreadedDyscoColumn<std::complex<float>>::ThreadDataBase>
+DyscoDataColumn::initializeDecodeThread() {
+  std::unique_ptr<TimeBlockEncoder> decoder(makeTimeBlockEncoder());
+  return std::unique_ptr<ThreadDataBase>(new ThreadData(std::move(decoder)));
+}
+
+void DyscoDataColumn::initializeDecode(ThreadDataBase *threadData,
+                                       TimeBlockBuffer<data_t> * /*buffer*/,
                                        const float *metaBuffer, size_t nRow,
                                        size_t nAntennae) {
-  _decoder->InitializeDecode(metaBuffer, nRow, nAntennae);
+  TimeBlockEncoder &decoder =
+      threadData ? *static_cast<ThreadData &>(*threadData).encoder : *_decoder;
+  decoder.InitializeDecode(metaBuffer, nRow, nAntennae);
 }
 
-void DyscoDataColumn::decode(TimeBlockBuffer<data_t> *buffer,
+void DyscoDataColumn::decode(ThreadDataBase *threadData,
+                             TimeBlockBuffer<data_t> *buffer,
                              const unsigned int *data, size_t blockRow,
                              size_t a1, size_t a2) {
-  _decoder->Decode(*_gausEncoder, *buffer, data, blockRow, a1, a2);
+  TimeBlockEncoder &decoder =
+      threadData ? *static_cast<ThreadData &>(*threadData).encoder : *_decoder;
+  decoder.Decode(*_gausEncoder, *buffer, data, blockRow, a1, a2);
 }
 
 std::unique_ptr<ThreadedDyscoColumn<std::complex<float>>::ThreadDataBase>
 DyscoDataColumn::initializeEncodeThread() {
-  const size_t nPolarizations = shape()[0], nChannels = shape()[1];
-  std::unique_ptr<TimeBlockEncoder> encoder;
-  switch (_normalization) {
-    case Normalization::kAF:
-      encoder.reset(new AFTimeBlockEncoder(nPolarizations, nChannels, true));
-      break;
-    case Normalization::kRF:
-      encoder.reset(new RFTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-    case Normalization::kRow:
-      encoder.reset(new RowTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-  }
+  std::unique_ptr<TimeBlockEncoder> encoder(makeTimeBlockEncoder());
   std::unique_ptr<ThreadData> newThreadData(new ThreadData(std::move(encoder)));
   // Seed every thread from a random number
   if (_randomize)
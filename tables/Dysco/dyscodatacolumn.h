@@ -48,11 +48,15 @@ class DyscoDataColumn final : public ThreadedDyscoColumn<std::complex<float>> {
   }
 
  protected:
-  virtual void initializeDecode(TimeBlockBuffer<data_t> *buffer,
+  virtual std::unique_ptr<ThreadDataBase> initializeDecodeThread() override;
+
+  virtual void initializeDecode(ThreadDataBase *threadData,
+                                TimeBlockBuffer<data_t> *buffer,
                                 const float *metaBuffer, size_t nRow,
                                 size_t nAntennae) override;
 
-  virtual void decode(TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
+  virtual void decode(ThreadDataBase *threadData,
+                      TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
                       size_t blockRow, size_t a1, size_t a2) override;
 
   virtual std::unique_ptr<ThreadDataBase> initializeEncodeThread() override;
@@ -78,6 +82,8 @@ class DyscoDataColumn final : public ThreadedDyscoColumn<std::complex<float>> {
     std::mt19937 rnd;
   };
 
+  TimeBlockEncoder *makeTimeBlockEncoder() const;
+
   std::mt19937 _rnd;
   std::unique_ptr<StochasticEncoder<float>> _gausEncoder;
   std::unique_ptr<TimeBlockEncoder> _decoder;
@@ -29,7 +29,9 @@ DyscoStMan::DyscoStMan(unsigned dataBitCount, unsigned weightBitCount,
       _normalization(Normalization::kAF),
       _studentTNu(0.0),
       _distributionTruncation(2.5),
-      _staticSeed(false) {}
+      _staticSeed(false),
+      _threadCount(0),
+      _pipelineDepth(0) {}
 
 DyscoStMan::DyscoStMan(const casacore::String &name,
                        const casacore::Record &spec)
@@ -47,7 +49,9 @@ DyscoStMan::DyscoStMan(const casacore::String &name,
       _normalization(Normalization::kAF),
       _studentTNu(0.0),
       _distributionTruncation(0.0),
-      _staticSeed(false) {
+      _staticSeed(false),
+      _threadCount(0),
+      _pipelineDepth(0) {
   setFromSpec(spec);
 }
 
@@ -66,7 +70,9 @@ DyscoStMan::DyscoStMan(const DyscoStMan &source)
       _normalization(source._normalization),
       _studentTNu(source._studentTNu),
       _distributionTruncation(source._distributionTruncation),
-      _staticSeed(source._staticSeed) {}
+      _staticSeed(source._staticSeed),
+      _threadCount(source._threadCount),
+      _pipelineDepth(source._pipelineDepth) {}
 
 void DyscoStMan::setFromSpec(const casacore::Record &spec) {
   // Here we need to load from _spec
@@ -106,6 +112,23 @@ void DyscoStMan::setFromSpec(const casacore::Record &spec) {
       _studentTNu = 0.0;
     _distributionTruncation = spec.asDouble("distributionTruncation");
   }
+  // The run time settings are optional
+  setRunTimeSettings(spec);
+}
+
+void DyscoStMan::setRunTimeSettings(const casacore::Record &spec) {
+  if (spec.description().fieldNumber("threadCount") >= 0) {
+    int threadCount = spec.asInt("threadCount");
+    if (threadCount < 0)
+      throw DyscoStManError("Invalid thread count specified");
+    _threadCount = threadCount;
+  }
+  if (spec.description().fieldNumber("pipelineDepth") >= 0) {
+    int pipelineDepth = spec.asInt("pipelineDepth");
+    if (pipelineDepth < 0)
+      throw DyscoStManError("Invalid pipeline depth specified");
+    _pipelineDepth = pipelineDepth;
+  }
 }
 
 void DyscoStMan::makeEmpty() {
@@ -152,9 +175,28 @@ casacore::Record DyscoStMan::dataManagerSpec() const {
   spec.define("normalization", normStr);
   spec.define("studentTNu", _studentTNu);
   spec.define("distributionTruncation", _distributionTruncation);
+  spec.define("threadCount", int(_threadCount));
+  spec.define("pipelineDepth", int(_pipelineDepth));
   return spec;
 }
 
+casacore::Record DyscoStMan::getProperties() const {
+  casacore::Record properties;
+  properties.define("threadCount", int(_threadCount));
+  properties.define("pipelineDepth", int(_pipelineDepth));
+  return properties;
+}
+
+void DyscoStMan::setProperties(const casacore::Record &spec) {
+  const size_t oldThreadCount = _threadCount;
+  setRunTimeSettings(spec);
+  // The columns (re)start their threads when the block size is known
+  if (_threadCount != oldThreadCount && areOffsetsInitialized()) {
+    for (std::unique_ptr<DyscoStManColumn> &col : _columns)
+      col->InitializeAfterNRowsPerBlockIsKnown();
+  }
+}
+
 void DyscoStMan::registerClass() {
   DataManager::registerCtor("DyscoStMan", makeObject);
 }
@@ -124,6 +124,38 @@ class DyscoStMan : public casacore::DataManager {
 
   void SetStaticSeed(bool staticSeed) { _staticSeed = staticSeed; }
 
+  /**
+   * Set the number of threads that each column uses for encoding and
+   * decoding. The default value of zero uses one thread per processor, up to a
+   * maximum of 8. Note that using more than one thread makes the results
+   * non-deterministic, even when a static seed is used.
+   * This method should be called before adding columns; otherwise use
+   * setProperties().
+   */
+  void SetThreadCount(size_t threadCount) { _threadCount = threadCount; }
+
+  /**
+   * Get the number of threads per column, or zero if the default is used.
+   */
+  size_t ThreadCount() const { return _threadCount; }
+
+  /**
+   * Set the number of time blocks per column that can be in flight. When
+   * writing, this is the number of blocks that are waiting to be encoded and
+   * written. When reading consecutive blocks, it is the number of blocks that
+   * are read and decoded in advance. Higher values increase the memory usage.
+   * The default value of zero uses a depth of 1.2 times the thread count plus
+   * one.
+   */
+  void SetPipelineDepth(size_t pipelineDepth) {
+    _pipelineDepth = pipelineDepth;
+  }
+
+  /**
+   * Get the pipeline depth, or zero if the default is used.
+   */
+  size_t PipelineDepth() const { return _pipelineDepth; }
+
   /**
    * This constructor is called by Casa when it needs to create a DyscoStMan.
    * Casa will call makeObject() that will call this constructor.
@@ -176,6 +208,21 @@ class DyscoStMan : public casacore::DataManager {
    */
   virtual casacore::Record dataManagerSpec() const final override;
 
+  /**
+   * Get the settings that can be changed at run time, which are the
+   * "threadCount" and "pipelineDepth".
+   * @returns Record containing the properties.
+   */
+  virtual casacore::Record getProperties() const final override;
+
+  /**
+   * Change the run time settings. It can be used to change the thread count
+   * and pipeline depth of an existing measurement set, for which the spec is
+   * not used.
+   * @param spec Record containing the properties to change.
+   */
+  virtual void setProperties(const casacore::Record &spec) final override;
+
   /**
    * Get the number of rows in the measurement set.
    * @returns Number of rows in the measurement set.
@@ -323,6 +370,8 @@ class DyscoStMan : public casacore::DataManager {
 
   void setFromSpec(const casacore::Record &spec);
 
+  void setRunTimeSettings(const casacore::Record &spec);
+
   size_t getFileOffset(size_t blockIndex) const {
     return _blockSize * blockIndex + _headerSize;
   }
@@ -400,6 +449,7 @@ class DyscoStMan : public casacore::DataManager {
   Normalization _normalization;
   double _studentTNu, _distributionTruncation;
   bool _staticSeed;
+  size_t _threadCount, _pipelineDepth;
 
   std::vector<std::unique_ptr<DyscoStManColumn>> _columns;
 };
@@ -12,17 +12,30 @@ void DyscoWeightColumn::Prepare(DyscoDistribution distribution,
                                         1 << getBitsPerSymbol()));
 }
 
-void DyscoWeightColumn::initializeDecode(TimeBlockBuffer<data_t> * /*buffer*/,
+std::unique_ptr<ThreadedDyscoColumn<float>::ThreadDataBase>
+DyscoWeightColumn::initializeDecodeThread() {
+  const size_t nPolarizations = shape()[0], nChannels = shape()[1];
+  return std::unique_ptr<ThreadDataBase>(new ThreadData(new WeightBlockEncoder(
+      nPolarizations, nChannels, 1 << getBitsPerSymbol())));
+}
+
+void DyscoWeightColumn::initializeDecode(ThreadDataBase *threadData,
+                                         TimeBlockBuffer<data_t> * /*buffer*/,
                                          const float *metaBuffer,
                                          size_t /*nRow*/,
                                          size_t /*nAntennae*/) {
-  _encoder->InitializeDecode(metaBuffer);
+  WeightBlockEncoder &decoder =
+      threadData ? *static_cast<ThreadData &>(*threadData).decoder : *_encoder;
+  decoder.InitializeDecode(metaBuffer);
 }
 
-void DyscoWeightColumn::decode(TimeBlockBuffer<data_t> *buffer,
+void DyscoWeightColumn::decode(ThreadDataBase *threadData,
+                               TimeBlockBuffer<data_t> *buffer,
                                const unsigned int *data, size_t blockRow,
                                size_t /*a1*/, size_t /*a2*/) {
-  _encoder->Decode(*buffer, data, blockRow);
+  WeightBlockEncoder &decoder =
+      threadData ? *static_cast<ThreadData &>(*threadData).decoder : *_encoder;
+  decoder.Decode(*buffer, data, blockRow);
 }
 
 void DyscoWeightColumn::encode(ThreadDataBase * /*threadData*/,
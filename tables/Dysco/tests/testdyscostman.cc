@@ -26,7 +26,8 @@ casacore::Record GetDyscoSpec() {
 }
 
 struct TestTableFixture {
-  explicit TestTableFixture(size_t nAnt) {
+  explicit TestTableFixture(size_t nAnt, size_t nTime = 2,
+                            const casacore::Record &spec = GetDyscoSpec()) {
     casacore::TableDesc tableDesc;
     IPosition shape(2, 1, 1);
     casacore::ArrayColumnDesc<casacore::Complex> columnDesc(
@@ -48,13 +49,13 @@ struct TestTableFixture {
     register_dyscostman();
     DataManagerCtor dyscoConstructor = DataManager::getCtor("DyscoStMan");
     std::unique_ptr<DataManager> dysco(
-        dyscoConstructor("DATA_dm", GetDyscoSpec()));
+        dyscoConstructor("DATA_dm", spec));
     setupNewTable.bindColumn("DATA", *dysco);
     casacore::Table newTable(setupNewTable);
 
     size_t a1 = 0, a2 = 1;
     double time = 10.0;
-    const size_t nRow = 2 * nAnt * (nAnt - 1) / 2;
+    const size_t nRow = nTime * nAnt * (nAnt - 1) / 2;
     newTable.addRow(nRow);
     casacore::ScalarColumn<int> a1Col(newTable, "ANTENNA1"),
         a2Col(newTable, "ANTENNA2"), fieldCol(newTable, "FIELD_ID"),
@@ -93,6 +94,26 @@ BOOST_AUTO_TEST_CASE(spec) {
   Record spec = dysco.dataManagerSpec();
   BOOST_CHECK_EQUAL(spec.asInt("dataBitCount"), 8);
   BOOST_CHECK_EQUAL(spec.asInt("weightBitCount"), 12);
+  BOOST_CHECK_EQUAL(spec.asInt("threadCount"), 0);
+  BOOST_CHECK_EQUAL(spec.asInt("pipelineDepth"), 0);
+
+  Record pipelineSpec = GetDyscoSpec();
+  pipelineSpec.define("threadCount", 3);
+  pipelineSpec.define("pipelineDepth", 5);
+  DyscoStMan dysco2("pipelined", pipelineSpec);
+  BOOST_CHECK_EQUAL(dysco2.ThreadCount(), 3u);
+  BOOST_CHECK_EQUAL(dysco2.PipelineDepth(), 5u);
+  std::unique_ptr<DataManager> dysco3(dysco2.clone());
+  spec = dysco3->dataManagerSpec();
+  BOOST_CHECK_EQUAL(spec.asInt("threadCount"), 3);
+  BOOST_CHECK_EQUAL(spec.asInt("pipelineDepth"), 5);
+
+  Record properties;
+  properties.define("pipelineDepth", 2);
+  dysco3->setProperties(properties);
+  properties = dysco3->getProperties();
+  BOOST_CHECK_EQUAL(properties.asInt("threadCount"), 3);
+  BOOST_CHECK_EQUAL(properties.asInt("pipelineDepth"), 2);
 }
 
 BOOST_AUTO_TEST_CASE(name) {
@@ -141,6 +162,66 @@ BOOST_AUTO_TEST_CASE(maketable) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(pipelined) {
+  // Write and read many time blocks with a small pipeline, such that the
+  // blocks are read ahead while reading.
+  const size_t nAnt = 4, nTime = 25;
+  Record spec = GetDyscoSpec();
+  spec.define("threadCount", 3);
+  spec.define("pipelineDepth", 2);
+  TestTableFixture fixture(nAnt, nTime, spec);
+
+  casacore::Table table("TestTable");
+  casacore::ArrayColumn<casacore::Complex> dataCol(table, "DATA");
+  BOOST_CHECK_EQUAL(table.nrow(), nTime * nAnt * (nAnt - 1) / 2);
+  std::vector<casacore::Complex> values;
+  for (size_t i = 0; i != table.nrow(); ++i) {
+    values.push_back(*dataCol(i).cbegin());
+    BOOST_CHECK_SMALL(values.back().real() - float(i), 0.01f * (i + 1));
+  }
+  // Reading backwards and skipping blocks does not read ahead, and should
+  // give the same values.
+  Record properties;
+  properties.define("threadCount", 2);
+  properties.define("pipelineDepth", 4);
+  table.findDataManager("DATA", true)->setProperties(properties);
+  for (size_t i = table.nrow(); i != 0; --i) {
+    BOOST_CHECK_EQUAL(*dataCol(i - 1).cbegin(), values[i - 1]);
+  }
+  for (size_t i = 0; i < table.nrow(); i += 13) {
+    BOOST_CHECK_EQUAL(*dataCol(i).cbegin(), values[i]);
+  }
+  for (size_t i = 0; i != table.nrow(); ++i) {
+    BOOST_CHECK_EQUAL(*dataCol(i).cbegin(), values[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_update) {
+  // Overwrite blocks while reading consecutively, such that blocks that
+  // were read ahead become stale.
+  const size_t nAnt = 3, nTime = 12;
+  TestTableFixture fixture(nAnt, nTime);
+  {
+    casacore::Table table("TestTable", casacore::Table::Update);
+    casacore::ArrayColumn<casacore::Complex> dataCol(table, "DATA");
+    for (size_t i = 0; i != table.nrow(); ++i) {
+      casacore::Array<casacore::Complex> arr = dataCol(i);
+      BOOST_CHECK_SMALL((*arr.cbegin()).real() - float(i), 0.01f * (i + 1));
+      if (i % 3 == 0) {
+        *arr.begin() = i * 2;
+        dataCol.put(i, arr);
+      }
+    }
+  }
+  casacore::Table table("TestTable");
+  casacore::ArrayColumn<casacore::Complex> dataCol(table, "DATA");
+  for (size_t i = 0; i != table.nrow(); ++i) {
+    const float expected = (i % 3 == 0) ? i * 2 : i;
+    BOOST_CHECK_SMALL((*dataCol(i).cbegin()).real() - expected,
+                      0.02f * (expected + 1));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(read_past_end) {
   /**
    * While reading past the end of a file might seem wrong in any case, it can
@@ -6,6 +6,7 @@
 #include "bytepacker.h"
 #include "threadgroup.h"
 
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/ms/MeasurementSets/MeasurementSet.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 
@@ -50,6 +51,8 @@ template <typename DataType>
 void ThreadedDyscoColumn<DataType>::stopThreads() {
   std::unique_lock<std::mutex> lock(_mutex);
 
+  discardReadAhead();
+
   if (_threadGroup.empty()) {
     if (!_cache.empty())
       throw DyscoStManError(
@@ -75,32 +78,134 @@ void ThreadedDyscoColumn<DataType>::setShapeColumn(
   _shape = shape;
 }
 
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::readAntennas(
+    size_t blockIndex, casacore::Vector<int> &antenna1,
+    casacore::Vector<int> &antenna2) {
+  const casacore::Slicer rowRange(casacore::IPosition(1, getRowIndex(blockIndex)),
+                                  casacore::IPosition(1, nRowsInBlock()));
+  _ant1Col->getColumnRange(rowRange, antenna1, true);
+  _ant2Col->getColumnRange(rowRange, antenna2, true);
+}
+
+// Decode a block into the given buffer. This function does not access
+// members that are changed by the main thread, so it can be called from the
+// worker threads.
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::decodeBlock(
+    size_t blockIndex, TimeBlockBuffer<data_t> *buffer,
+    const casacore::Vector<int> &antenna1,
+    const casacore::Vector<int> &antenna2, unsigned char *packedSymbolBuffer,
+    unsigned int *unpackedSymbolBuffer, ThreadDataBase *threadUserData) {
+  readCompressedData(blockIndex, packedSymbolBuffer, _blockSize);
+  const size_t nPolarizations = _shape[0], nChannels = _shape[1],
+               nRows = nRowsInBlock(),
+               nMetaFloats = metaDataFloatCount(nRows, nPolarizations,
+                                                nChannels, _antennaCount);
+  unsigned char *symbolStart = packedSymbolBuffer + nMetaFloats * sizeof(float);
+  BytePacker::unpack(_bitsPerSymbol, unpackedSymbolBuffer, symbolStart,
+                     symbolCount(nRows, nPolarizations, nChannels));
+  float *metaData = reinterpret_cast<float *>(packedSymbolBuffer);
+  initializeDecode(threadUserData, buffer, metaData, nRows, _antennaCount);
+  buffer->resize(nRows);
+  for (size_t blockRow = 0; blockRow != nRows; ++blockRow) {
+    decode(threadUserData, buffer, unpackedSymbolBuffer, blockRow,
+           antenna1[blockRow], antenna2[blockRow]);
+  }
+}
+
 template <typename DataType>
 void ThreadedDyscoColumn<DataType>::loadBlock(size_t blockIndex) {
   if (blockIndex < nBlocksInFile()) {
-    readCompressedData(blockIndex, _packedBlockReadBuffer.data(), _blockSize);
-    const size_t nPolarizations = _shape[0], nChannels = _shape[1],
-                 nRows = nRowsInBlock(),
-                 nMetaFloats = metaDataFloatCount(nRows, nPolarizations,
-                                                  nChannels, _antennaCount);
-    unsigned char *symbolStart =
-        _packedBlockReadBuffer.data() + nMetaFloats * sizeof(float);
-    BytePacker::unpack(_bitsPerSymbol, _unpackedSymbolReadBuffer.data(),
-                       symbolStart,
-                       symbolCount(nRows, nPolarizations, nChannels));
-    float *metaData = reinterpret_cast<float *>(_packedBlockReadBuffer.data());
-    initializeDecode(_timeBlockBuffer.get(), metaData, nRows, _antennaCount);
-    uint64_t startRow = getRowIndex(blockIndex);
-    _timeBlockBuffer->resize(nRows);
-    for (size_t blockRow = 0; blockRow != nRows; ++blockRow) {
-      int a1 = (*_ant1Col)(startRow + blockRow),
-          a2 = (*_ant2Col)(startRow + blockRow);
-      decode(_timeBlockBuffer.get(), _unpackedSymbolReadBuffer.data(), blockRow,
-             a1, a2);
-    }
+    casacore::Vector<int> antenna1, antenna2;
+    readAntennas(blockIndex, antenna1, antenna2);
+    decodeBlock(blockIndex, _timeBlockBuffer.get(), antenna1, antenna2,
+                _packedBlockReadBuffer.data(), _unpackedSymbolReadBuffer.data(),
+                nullptr);
+  }
+  _currentBlock = blockIndex;
+  _isCurrentBlockChanged = false;
+}
+
+// Use the block from the read-ahead cache if it is being or has been decoded.
+// Returns false if the block has to be loaded by the caller.
+template <typename DataType>
+bool ThreadedDyscoColumn<DataType>::takeReadAheadBlock(size_t blockIndex) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  typename read_cache_t::iterator i = _readCache.find(blockIndex);
+  if (i == _readCache.end()) return false;
+  ReadItem *item = i->second;
+  if (!item->isBeingDecoded && !item->isDecoded) {
+    // Not picked up yet by a worker; decoding it directly is faster
+    delete item;
+    _readCache.erase(i);
+    return false;
   }
+  while (!item->isDecoded) _cacheChangedCondition.wait(lock);
+  _timeBlockBuffer = std::move(item->buffer);
+  delete item;
+  _readCache.erase(blockIndex);
+  _cacheChangedCondition.notify_all();
+  lock.unlock();
+
   _currentBlock = blockIndex;
   _isCurrentBlockChanged = false;
+  return true;
+}
+
+// Let the workers decode the blocks following the given block, and remove
+// blocks from the read-ahead cache that are no longer needed.
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::scheduleReadAhead(size_t blockIndex) {
+  const size_t depth = maxCacheSize(),
+               endBlock = std::min<size_t>(blockIndex + 1 + depth,
+                                           nBlocksInFile());
+  std::vector<size_t> newBlocks;
+  std::unique_lock<std::mutex> lock(_mutex);
+  typename read_cache_t::iterator i = _readCache.begin();
+  while (i != _readCache.end()) {
+    if (i->first <= blockIndex || i->first >= endBlock) {
+      if (i->second->isBeingDecoded && !i->second->isDecoded)
+        i->second->isDiscarded = true;
+      else
+        delete i->second;
+      i = _readCache.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  for (size_t block = blockIndex + 1; block < endBlock; ++block) {
+    if (_readCache.count(block) == 0 && _cache.count(block) == 0)
+      newBlocks.push_back(block);
+  }
+  lock.unlock();
+  if (newBlocks.empty()) return;
+
+  // Read the antennas without holding the lock to not block the workers.
+  const size_t nPolarizations = _shape[0], nChannels = _shape[1];
+  std::vector<ReadItem *> newItems;
+  for (size_t block : newBlocks) {
+    std::unique_ptr<ReadItem> item(new ReadItem(nPolarizations, nChannels));
+    readAntennas(block, item->antenna1, item->antenna2);
+    newItems.push_back(item.release());
+  }
+  lock.lock();
+  for (size_t j = 0; j != newBlocks.size(); ++j)
+    _readCache.insert(typename read_cache_t::value_type(newBlocks[j], newItems[j]));
+  _cacheChangedCondition.notify_all();
+}
+
+// Items that are being decoded are marked discarded, and are deleted by
+// the worker that decodes them.
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::discardReadAhead() {
+  for (typename read_cache_t::value_type &item : _readCache) {
+    if (item.second->isBeingDecoded && !item.second->isDecoded)
+      item.second->isDiscarded = true;
+    else
+      delete item.second;
+  }
+  _readCache.clear();
 }
 
 template <typename DataType>
@@ -131,7 +236,11 @@ void ThreadedDyscoColumn<DataType>::getValues(
 
       if (_currentBlock != blockIndex) {
         if (_isCurrentBlockChanged) storeBlock();
-        loadBlock(blockIndex);
+        // Only read ahead when the blocks are accessed consecutively;
+        // note that the initial value of _currentBlock is max size_t.
+        const bool isSequential = (blockIndex == _currentBlock + 1);
+        if (!takeReadAheadBlock(blockIndex)) loadBlock(blockIndex);
+        if (isSequential) scheduleReadAhead(blockIndex);
       }
 
       // The time block encoder is now initialized and contains the unpacked
@@ -147,6 +256,8 @@ void ThreadedDyscoColumn<DataType>::storeBlock() {
   // Put the data of the current block into the cache so that the parallell
   // threads can write them
   std::unique_lock<std::mutex> lock(_mutex);
+  // Blocks that were read ahead might be changed by this write
+  discardReadAhead();
   CacheItem *item = new CacheItem(std::move(_timeBlockBuffer));
   // Wait until there is space available AND the row to be written is not in the
   // cache
@@ -245,6 +356,21 @@ size_t ThreadedDyscoColumn<DataType>::defaultThreadCount() const {
   return std::min(8l, sysconf(_SC_NPROCESSORS_ONLN));
 }
 
+template <typename DataType>
+size_t ThreadedDyscoColumn<DataType>::threadCount() const {
+  const size_t n = storageManager().ThreadCount();
+  return n == 0 ? defaultThreadCount() : n;
+}
+
+template <typename DataType>
+size_t ThreadedDyscoColumn<DataType>::maxCacheSize() const {
+  const size_t depth = storageManager().PipelineDepth();
+  if (depth != 0) return depth;
+  const size_t n = storageManager().ThreadCount();
+  return (n == 0 ? ThreadedDyscoColumn::defaultThreadCount() : n) * 12 / 10 +
+         1;
+}
+
 template <typename DataType>
 void ThreadedDyscoColumn<DataType>::InitializeAfterNRowsPerBlockIsKnown() {
   stopThreads();
@@ -261,11 +387,11 @@ void ThreadedDyscoColumn<DataType>::InitializeAfterNRowsPerBlockIsKnown() {
   // TODO _timeBlockEncoder->SetNAntennae(_antennaCount);
 
   // start the threads
-  size_t threadCount = defaultThreadCount();
-  EncodingThreadFunctor functor;
+  const size_t nThreads = threadCount();
+  WorkerThreadFunctor functor;
   functor.parent = this;
   _stopThreads = false;
-  for (size_t i = 0; i != threadCount; ++i) _threadGroup.create_thread(functor);
+  for (size_t i = 0; i != nThreads; ++i) _threadGroup.create_thread(functor);
 }
 
 template <typename DataType>
@@ -294,9 +420,10 @@ void ThreadedDyscoColumn<DataType>::encodeAndWrite(
 }
 
 // Continuously write items from the cache into the measurement
-// set untill asked to quit.
+// set and decode blocks that are read ahead, untill asked to quit.
+// Writing has priority, because the writer waits when the cache is full.
 template <typename DataType>
-void ThreadedDyscoColumn<DataType>::EncodingThreadFunctor::operator()() {
+void ThreadedDyscoColumn<DataType>::WorkerThreadFunctor::operator()() {
   const size_t nPolarizations = parent->_shape[0],
                nChannels = parent->_shape[1];
   const size_t nSymbols =
@@ -309,16 +436,41 @@ void ThreadedDyscoColumn<DataType>::EncodingThreadFunctor::operator()() {
 
   std::unique_ptr<ThreadDataBase> threadUserData =
       parent->initializeEncodeThread();
+  // Only made when the thread has to decode
+  std::unique_ptr<ThreadDataBase> decodeUserData;
 
   while (!parent->_stopThreads) {
     typename cache_t::iterator i;
+    typename read_cache_t::iterator r;
     bool isItemAvailable = parent->isWriteItemAvailable(i);
-    while (!isItemAvailable && !parent->_stopThreads) {
+    bool isReadItemAvailable =
+        !isItemAvailable && parent->isReadItemAvailable(r);
+    while (!isItemAvailable && !isReadItemAvailable &&
+           !parent->_stopThreads) {
       parent->_cacheChangedCondition.wait(lock);
       isItemAvailable = parent->isWriteItemAvailable(i);
+      isReadItemAvailable = !isItemAvailable && parent->isReadItemAvailable(r);
     }
 
-    if (isItemAvailable) {
+    if (isReadItemAvailable) {
+      size_t blockIndex = r->first;
+      ReadItem &item = *r->second;
+      item.isBeingDecoded = true;
+
+      lock.unlock();
+      if (!decodeUserData) decodeUserData = parent->initializeDecodeThread();
+      parent->decodeBlock(blockIndex, item.buffer.get(), item.antenna1,
+                          item.antenna2, &packedSymbolBuffer[0],
+                          &unpackedSymbolBuffer[0], decodeUserData.get());
+
+      lock.lock();
+      // The item might have been removed from the cache in the meantime
+      if (item.isDiscarded)
+        delete &item;
+      else
+        item.isDecoded = true;
+      parent->_cacheChangedCondition.notify_all();
+    } else if (isItemAvailable) {
       size_t blockIndex = i->first;
       CacheItem &item = *i->second;
       item.isBeingWritten = true;
@@ -344,6 +496,17 @@ bool ThreadedDyscoColumn<DataType>::isWriteItemAvailable(
   return (i != _cache.end());
 }
 
+// This function should only be called with a locked mutex
+template <typename DataType>
+bool ThreadedDyscoColumn<DataType>::isReadItemAvailable(
+    typename read_cache_t::iterator &i) {
+  i = _readCache.begin();
+  while (i != _readCache.end() &&
+         (i->second->isBeingDecoded || i->second->isDecoded))
+    ++i;
+  return (i != _readCache.end());
+}
+
 template <typename DataType>
 size_t ThreadedDyscoColumn<DataType>::CalculateBlockSize(
     size_t nRowsInBlock, size_t nAntennae) const {
@@ -4,6 +4,7 @@
 #include <casacore/tables/DataMan/DataManError.h>
 
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 
 #include <condition_variable>
@@ -26,6 +27,15 @@ class DyscoStMan;
 /**
  * A column for storing compressed values in a threaded way, tailored for the
  * data and weight columns that use a threaded approach for encoding.
+ *
+ * The column runs a pool of worker threads that form a pipeline in both
+ * directions. When writing, completed time blocks are put in a cache from
+ * which the workers encode and write them, while the caller continues to
+ * fill the next block. When reading consecutive time blocks, the workers read
+ * and decode the next blocks in the background, such that the caller finds
+ * them decoded when it moves on. The number of workers and the number of
+ * blocks in flight can be set with DyscoStMan::SetThreadCount() and
+ * DyscoStMan::SetPipelineDepth().
  * @author André Offringa
  */
 template <typename DataType>
@@ -113,11 +123,24 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
 
   typedef typename TimeBlockBuffer<data_t>::symbol_t symbol_t;
 
-  virtual void initializeDecode(TimeBlockBuffer<data_t> *buffer,
+  /**
+   * Create the decoding state of a worker thread. It makes it possible to
+   * decode several blocks concurrently.
+   */
+  virtual std::unique_ptr<ThreadDataBase> initializeDecodeThread() = 0;
+
+  /**
+   * Initialize decoding of a block. The @p threadData is the state
+   * returned by initializeDecodeThread(), or nullptr when decoding in the
+   * calling thread, in which case the column's own decoder is used.
+   */
+  virtual void initializeDecode(ThreadDataBase *threadData,
+                                TimeBlockBuffer<data_t> *buffer,
                                 const float *metaBuffer, size_t nRow,
                                 size_t nAntennae) = 0;
 
-  virtual void decode(TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
+  virtual void decode(ThreadDataBase *threadData,
+                      TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
                       size_t blockRow, size_t a1, size_t a2) = 0;
 
   virtual std::unique_ptr<ThreadDataBase> initializeEncodeThread() = 0;
@@ -137,6 +160,12 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
 
   virtual size_t defaultThreadCount() const;
 
+  /**
+   * Number of worker threads: the thread count set in the storage manager,
+   * or defaultThreadCount() when it was not set.
+   */
+  size_t threadCount() const;
+
   size_t getBitsPerSymbol() const { return _bitsPerSymbol; }
 
   const casacore::IPosition &shape() const { return _shape; }
@@ -150,7 +179,23 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
     bool isBeingWritten;
   };
 
-  struct EncodingThreadFunctor {
+  /**
+   * A block that is read ahead. The antenna numbers are obtained by the
+   * main thread, because the table columns can not be accessed concurrently.
+   */
+  struct ReadItem {
+    ReadItem(size_t nPolarizations, size_t nChannels)
+        : buffer(new TimeBlockBuffer<data_t>(nPolarizations, nChannels)),
+          isBeingDecoded(false),
+          isDecoded(false),
+          isDiscarded(false) {}
+
+    std::unique_ptr<TimeBlockBuffer<data_t>> buffer;
+    casacore::Vector<int> antenna1, antenna2;
+    bool isBeingDecoded, isDecoded, isDiscarded;
+  };
+
+  struct WorkerThreadFunctor {
     void operator()();
     ThreadedDyscoColumn *parent;
   };
@@ -172,6 +217,7 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
   };
 
   typedef std::map<size_t, CacheItem *> cache_t;
+  typedef std::map<size_t, ReadItem *> read_cache_t;
 
   void getValues(casacore::rownr_t rowNr, casacore::Array<data_t> *dataPtr);
   void putValues(casacore::rownr_t rowNr, const casacore::Array<data_t> *dataPtr);
@@ -182,11 +228,26 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
                       unsigned int *unpackedSymbolBuffer,
                       ThreadDataBase *threadUserData);
   bool isWriteItemAvailable(typename cache_t::iterator &i);
+  bool isReadItemAvailable(typename read_cache_t::iterator &i);
+  void readAntennas(size_t blockIndex, casacore::Vector<int> &antenna1,
+                    casacore::Vector<int> &antenna2);
+  void decodeBlock(size_t blockIndex, TimeBlockBuffer<data_t> *buffer,
+                   const casacore::Vector<int> &antenna1,
+                   const casacore::Vector<int> &antenna2,
+                   unsigned char *packedSymbolBuffer,
+                   unsigned int *unpackedSymbolBuffer,
+                   ThreadDataBase *threadUserData);
   void loadBlock(size_t blockIndex);
+  bool takeReadAheadBlock(size_t blockIndex);
+  void scheduleReadAhead(size_t blockIndex);
+  // Should only be called with a locked mutex
+  void discardReadAhead();
   void storeBlock();
-  size_t maxCacheSize() const {
-    return ThreadedDyscoColumn::defaultThreadCount() * 12 / 10 + 1;
-  }
+  /**
+   * Maximum number of blocks in flight, both for the write cache and for
+   * reading ahead.
+   */
+  size_t maxCacheSize() const;
 
   unsigned _bitsPerSymbol;
   casacore::IPosition _shape;
@@ -198,6 +259,7 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
   ao::uvector<unsigned char> _packedBlockReadBuffer;
   ao::uvector<unsigned int> _unpackedSymbolReadBuffer;
   cache_t _cache;
+  read_cache_t _readCache;
   bool _stopThreads;
   std::mutex _mutex;
   threadgroup _threadGroup;
@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Quanta/MVTime.h>
@@ -54,6 +55,12 @@ TableExprNodeConstBool::~TableExprNodeConstBool()
 {}
 Bool TableExprNodeConstBool::getBool (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstBool::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                           Vector<Bool>& values)
+{
+    values.resize (rownrs.size());
+    values = value_p;
+}
 
 TableExprNodeConstInt::TableExprNodeConstInt (const Int64& val)
 : TableExprNodeBinary (NTInt, VTScalar, OtLiteral, Table()),
@@ -67,6 +74,18 @@ Double TableExprNodeConstInt::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstInt::getDComplex (const TableExprId&)
     { return double(value_p); }
+void TableExprNodeConstInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Int64>& values)
+{
+    values.resize (rownrs.size());
+    values = value_p;
+}
+void TableExprNodeConstInt::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                            Vector<Double>& values)
+{
+    values.resize (rownrs.size());
+    values = Double(value_p);
+}
 
 TableExprNodeConstDouble::TableExprNodeConstDouble (const Double& val)
 : TableExprNodeBinary (NTDouble, VTScalar, OtLiteral, Table()),
@@ -78,6 +97,12 @@ Double TableExprNodeConstDouble::getDouble (const TableExprId&)
     { return value_p; }
 DComplex TableExprNodeConstDouble::getDComplex (const TableExprId&)
     { return value_p; }
+void TableExprNodeConstDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                               Vector<Double>& values)
+{
+    values.resize (rownrs.size());
+    values = value_p;
+}
 
 TableExprNodeConstDComplex::TableExprNodeConstDComplex (const DComplex& val)
 : TableExprNodeBinary (NTComplex, VTScalar, OtLiteral, Table()),
@@ -235,6 +260,95 @@ String TableExprNodeColumn::getString (const TableExprId& id)
     return val;
 }
 
+// Read the cells of a column with type T and convert them to type U.
+// The row numbers are collapsed to slices where possible, so contiguous
+// rows are read with a single getColumnRange by the data manager.
+template<typename T, typename U>
+static void getConvertedCells (const TableColumn& tabCol,
+                        const Vector<rownr_t>& rownrs, Vector<U>& values)
+{
+    ScalarColumn<T> col (tabCol);
+    Vector<T> data (col.getColumnCells (RefRows(rownrs, False, True)));
+    values.resize (data.size());
+    convertArray (values, data);
+}
+template<typename T>
+static void getCells (const TableColumn& tabCol,
+                      const Vector<rownr_t>& rownrs, Vector<T>& values)
+{
+    values.resize (rownrs.size());
+    ScalarColumn<T> col (tabCol);
+    col.getColumnCells (RefRows(rownrs, False, True), values);
+}
+
+void TableExprNodeColumn::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Bool>& values)
+{
+    if (tabCol_p.columnDesc().dataType() == TpBool) {
+        getCells (tabCol_p, rownrs, values);
+    } else {
+        TableExprNodeRep::getBoolBatch (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getIntBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Int64>& values)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getConvertedCells<uChar> (tabCol_p, rownrs, values);
+        break;
+    case TpShort:
+        getConvertedCells<Short> (tabCol_p, rownrs, values);
+        break;
+    case TpUShort:
+        getConvertedCells<uShort> (tabCol_p, rownrs, values);
+        break;
+    case TpInt:
+        getConvertedCells<Int> (tabCol_p, rownrs, values);
+        break;
+    case TpUInt:
+        getConvertedCells<uInt> (tabCol_p, rownrs, values);
+        break;
+    case TpInt64:
+        getCells (tabCol_p, rownrs, values);
+        break;
+    default:
+        TableExprNodeRep::getIntBatch (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Double>& values)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getConvertedCells<uChar> (tabCol_p, rownrs, values);
+        break;
+    case TpShort:
+        getConvertedCells<Short> (tabCol_p, rownrs, values);
+        break;
+    case TpUShort:
+        getConvertedCells<uShort> (tabCol_p, rownrs, values);
+        break;
+    case TpInt:
+        getConvertedCells<Int> (tabCol_p, rownrs, values);
+        break;
+    case TpUInt:
+        getConvertedCells<uInt> (tabCol_p, rownrs, values);
+        break;
+    case TpInt64:
+        getConvertedCells<Int64> (tabCol_p, rownrs, values);
+        break;
+    case TpFloat:
+        getConvertedCells<Float> (tabCol_p, rownrs, values);
+        break;
+    case TpDouble:
+        getCells (tabCol_p, rownrs, values);
+        break;
+    default:
+        TableExprNodeRep::getDoubleBatch (rownrs, values);
+    }
+}
+
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
 {
     dt = tabCol_p.columnDesc().dataType();
@@ -304,6 +418,41 @@ Array<String>   TableExprNodeColumn::getColumnString (const Vector<rownr_t>& row
 
 
 
+TableExprConcurrentRead::~TableExprConcurrentRead()
+{
+    for (Table& table : tables_p) {
+        table.setConcurrentRead (False);
+    }
+}
+
+Bool TableExprConcurrentRead::add (const TENShPtr& node)
+{
+    std::vector<TableExprNodeRep*> cols;
+    node->getColumnNodes (cols);
+    for (TableExprNodeRep* col : cols) {
+        TableExprNodeColumn* colNode = dynamic_cast<TableExprNodeColumn*>(col);
+        if (colNode == 0  ||  !add (colNode->getColumn().table())) {
+            return False;
+        }
+    }
+    return True;
+}
+
+Bool TableExprConcurrentRead::add (const Table& table)
+{
+    if (! table.isConcurrentRead()) {
+        Table tab(table);
+        try {
+            tab.setConcurrentRead (True);
+        } catch (const TableInvOper&) {
+            return False;
+        }
+        tables_p.push_back (tab);
+    }
+    return True;
+}
+
+
 TableExprNodeRownr::TableExprNodeRownr (const Table& table, uInt origin)
 : TableExprNodeBinary (NTInt, VTScalar, OtRownr, table),
   origin_p            (origin)
@@ -34,6 +34,7 @@
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicMath/Random.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -78,6 +79,7 @@ public:
     TableExprNodeConstBool (const Bool& value);
     ~TableExprNodeConstBool();
     Bool getBool (const TableExprId& id);
+    void getBoolBatch (const Vector<rownr_t>& rownrs, Vector<Bool>& values);
 private:
     Bool value_p;
 };
@@ -111,6 +113,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getIntBatch    (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 private:
     Int64 value_p;
 };
@@ -143,6 +147,7 @@ public:
     ~TableExprNodeConstDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 private:
     Double value_p;
 };
@@ -322,6 +327,14 @@ public:
     String   getString   (const TableExprId& id);
     const TableColumn& getColumn() const;
 
+    // Get the data for a block of rows.
+    // The column is read with getColumnCells and converted if needed.
+    // <group>
+    void getBoolBatch   (const Vector<rownr_t>& rownrs, Vector<Bool>& values);
+    void getIntBatch    (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
+    // </group>
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<rownr_t>& rownrs);
     Array<uChar>    getColumnuChar (const Vector<rownr_t>& rownrs);
@@ -347,6 +360,59 @@ protected:
 
 
 
+// <summary>
+// Let the tables used in expressions be read by multiple threads
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tExprNodeBatch">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> Table::setConcurrentRead
+// </prerequisite>
+
+// <synopsis> 
+// The data managers are not thread-safe. When an expression is evaluated
+// by multiple threads, the tables it uses are read concurrently (see
+// Table::setConcurrentRead) as long as an object of this class exists.
+// In that way each access to a data manager locks its own mutex, so
+// threads only wait for each other when using the same data manager.
+// <br>Tables already read concurrently are left untouched. Otherwise
+// concurrent reading is switched off again by the destructor.
+// </synopsis> 
+
+class TableExprConcurrentRead
+{
+public:
+    TableExprConcurrentRead()
+      {}
+
+    // Switch off concurrent reading for the tables it was set for.
+    ~TableExprConcurrentRead();
+
+    // Let the tables of the columns used in the expression be read
+    // concurrently. False is returned if not possible for a table (e.g.,
+    // if it uses AutoLocking), so the expression cannot be evaluated by
+    // multiple threads.
+    Bool add (const TENShPtr& node);
+
+    // Let the given table be read (and written) concurrently.
+    Bool add (const Table& table);
+
+private:
+    // Copying is not possible.
+    TableExprConcurrentRead (const TableExprConcurrentRead&);
+    TableExprConcurrentRead& operator= (const TableExprConcurrentRead&);
+
+    std::vector<Table> tables_p;
+};
+
+
+
 // <summary>
 // Rownumber in table select expression tree
 // </summary>
@@ -625,6 +625,142 @@ Int64 TableExprFuncNode::getInt (const TableExprId& id)
     return 0;
 }
 
+// Evaluate an operand for a block of rows and apply a function to it.
+template<typename Func>
+static void unaryDoubleBatch (TableExprNodeRep& operand,
+                              const Vector<rownr_t>& rownrs,
+                              Vector<Double>& values, Func func)
+{
+    operand.getDoubleBatch (rownrs, values);
+    Double* vec = values.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; ++i) {
+        vec[i] = func (vec[i]);
+    }
+}
+
+// Evaluate two operands for a block of rows and apply a function to them.
+template<typename Func>
+static void binaryDoubleBatch (TableExprNodeRep& left,
+                               TableExprNodeRep& right,
+                               const Vector<rownr_t>& rownrs,
+                               Vector<Double>& values, Func func)
+{
+    Vector<Double> rvalues;
+    left.getDoubleBatch  (rownrs, values);
+    right.getDoubleBatch (rownrs, rvalues);
+    Double* vec = values.data();
+    const Double* rvec = rvalues.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; ++i) {
+        vec[i] = func (vec[i], rvec[i]);
+    }
+}
+
+void TableExprFuncNode::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Double>& values)
+{
+    if (dataType() == NTDouble) {
+        Double scale = scale_p;
+        switch (funcType_p) {
+        case sinFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return sin(v); });
+            return;
+        case sinhFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return sinh(v); });
+            return;
+        case cosFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return cos(v); });
+            return;
+        case coshFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return cosh(v); });
+            return;
+        case expFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return exp(v); });
+            return;
+        case logFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return log(v); });
+            return;
+        case log10FUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return log10(v); });
+            return;
+        case squareFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return v*v; });
+            return;
+        case cubeFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [](Double v) { return v*v*v; });
+            return;
+        case sqrtFUNC:
+            unaryDoubleBatch (*operands_p[0], rownrs, values,
+                              [scale](Double v) { return sqrt(v) * scale; });
+            return;
+        case absFUNC:
+            if (argDataType_p == NTDouble) {
+                unaryDoubleBatch (*operands_p[0], rownrs, values,
+                                  [](Double v) { return abs(v); });
+                return;
+            }
+            break;
+        case powFUNC:
+            binaryDoubleBatch (*operands_p[0], *operands_p[1], rownrs, values,
+                               [](Double v1, Double v2) { return pow(v1,v2); });
+            return;
+        case minFUNC:
+            binaryDoubleBatch (*operands_p[0], *operands_p[1], rownrs, values,
+                               [](Double v1, Double v2) { return min(v1,v2); });
+            return;
+        case maxFUNC:
+            binaryDoubleBatch (*operands_p[0], *operands_p[1], rownrs, values,
+                               [](Double v1, Double v2) { return max(v1,v2); });
+            return;
+        default:
+            break;
+        }
+    }
+    TableExprNodeRep::getDoubleBatch (rownrs, values);
+}
+
+Bool TableExprFuncNode::isParallelSafe() const
+{
+    if (vtype_p != VTScalar) {
+        return False;
+    }
+    switch (funcType_p) {
+    case sinFUNC:
+    case sinhFUNC:
+    case cosFUNC:
+    case coshFUNC:
+    case expFUNC:
+    case logFUNC:
+    case log10FUNC:
+    case squareFUNC:
+    case cubeFUNC:
+    case sqrtFUNC:
+    case absFUNC:
+    case powFUNC:
+    case minFUNC:
+    case maxFUNC:
+        break;
+    default:
+        return False;
+    }
+    for (uInt i=0; i<operands_p.size(); i++) {
+        if (!operands_p[i]  ||  !operands_p[i]->isParallelSafe()) {
+            return False;
+        }
+    }
+    return True;
+}
+
 Double TableExprFuncNode::getDouble (const TableExprId& id)
 {
     if (dataType() == NTInt) {
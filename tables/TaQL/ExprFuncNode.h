@@ -367,6 +367,16 @@ public:
     MVTime    getDate     (const TableExprId& id);
     // </group>
 
+    // Get the values for a block of rows.
+    // The elementwise mathematical functions are evaluated on the entire
+    // block; other functions use the default row by row evaluation.
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
+
+    // The elementwise mathematical functions can be evaluated in parallel
+    // if their operands can.
+    Bool isParallelSafe() const;
+
     // Check the data and value types of the operands.
     // It sets the exptected data and value types of the operands.
     // Set the value type of the function result and returns
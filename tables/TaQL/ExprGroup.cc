@@ -34,6 +34,10 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 
@@ -124,6 +128,212 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  TableExprGroupHashMap::TableExprGroupHashMap
+  (const vector<TableExprNode>& nodes)
+    : itsKeyOffsets (1, 0)
+  {
+    itsTypes.reserve (nodes.size());
+    for (const TableExprNode& node : nodes) {
+      TableExprNodeRep::NodeDataType dtype = node.getRep()->dataType();
+      if (dtype != TableExprNodeRep::NTBool  &&
+          dtype != TableExprNodeRep::NTInt  &&
+          dtype != TableExprNodeRep::NTDouble  &&
+          dtype != TableExprNodeRep::NTString  &&
+          dtype != TableExprNodeRep::NTDate) {
+        throw TableInvExpr ("A GROUPBY key cannot have data type dcomplex");
+      }
+      itsTypes.push_back (dtype);
+    }
+    rehash (16);
+  }
+
+  void TableExprGroupHashMap::packKeys (const vector<TableExprNode>& nodes,
+                                        const Vector<rownr_t>& rownrs)
+  {
+    AlwaysAssert (nodes.size() == itsTypes.size(), AipsError);
+    size_t nrow = rownrs.size();
+    // First get the values of all keys to know the size of the packed keys.
+    vector<Vector<Bool>>   bvalues(nodes.size());
+    vector<Vector<Int64>>  ivalues(nodes.size());
+    vector<Vector<Double>> dvalues(nodes.size());
+    vector<vector<String>> svalues(nodes.size());
+    itsBlockOffsets.assign (nrow+1, 0);
+    for (size_t k=0; k<nodes.size(); ++k) {
+      switch (itsTypes[k]) {
+      case TableExprNodeRep::NTBool:
+        nodes[k].getBoolBatch (rownrs, bvalues[k]);
+        for (size_t i=0; i<nrow; ++i) {
+          itsBlockOffsets[i+1] += 1;
+        }
+        break;
+      case TableExprNodeRep::NTInt:
+        nodes[k].getIntBatch (rownrs, ivalues[k]);
+        for (size_t i=0; i<nrow; ++i) {
+          itsBlockOffsets[i+1] += sizeof(Int64);
+        }
+        break;
+      case TableExprNodeRep::NTString:
+        svalues[k].resize (nrow);
+        for (size_t i=0; i<nrow; ++i) {
+          svalues[k][i] = nodes[k].getString (rownrs[i]);
+          itsBlockOffsets[i+1] += sizeof(uInt64) + svalues[k][i].size();
+        }
+        break;
+      default:
+        // A date/time is handled as a double.
+        nodes[k].getDoubleBatch (rownrs, dvalues[k]);
+        for (size_t i=0; i<nrow; ++i) {
+          itsBlockOffsets[i+1] += sizeof(Double);
+        }
+        break;
+      }
+    }
+    for (size_t i=0; i<nrow; ++i) {
+      itsBlockOffsets[i+1] += itsBlockOffsets[i];
+    }
+    // Now pack the values of the keys per row.
+    itsBlock.resize (itsBlockOffsets[nrow]);
+    vector<size_t> pos(itsBlockOffsets.begin(), itsBlockOffsets.end()-1);
+    for (size_t k=0; k<nodes.size(); ++k) {
+      for (size_t i=0; i<nrow; ++i) {
+        char* ptr = &(itsBlock[pos[i]]);
+        switch (itsTypes[k]) {
+        case TableExprNodeRep::NTBool:
+          *ptr = (bvalues[k][i] ? 1 : 0);
+          pos[i] += 1;
+          break;
+        case TableExprNodeRep::NTInt:
+          memcpy (ptr, &(ivalues[k][i]), sizeof(Int64));
+          pos[i] += sizeof(Int64);
+          break;
+        case TableExprNodeRep::NTString:
+          {
+            const String& str = svalues[k][i];
+            uInt64 size = str.size();
+            memcpy (ptr, &size, sizeof(uInt64));
+            memcpy (ptr + sizeof(uInt64), str.data(), size);
+            pos[i] += sizeof(uInt64) + size;
+          }
+          break;
+        default:
+          {
+            Double value = dvalues[k][i];
+            if (isNaN(value)) {
+              value = std::numeric_limits<Double>::quiet_NaN();
+            } else if (value == 0) {
+              value = 0;           // turn -0 into 0
+            }
+            memcpy (ptr, &value, sizeof(Double));
+            pos[i] += sizeof(Double);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  uInt64 TableExprGroupHashMap::hash (const char* key, size_t size)
+  {
+    uInt64 h = 14695981039346656037ULL;
+    for (size_t i=0; i<size; ++i) {
+      h ^= uChar(key[i]);
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  Int64 TableExprGroupHashMap::find (const char* key, size_t size,
+                                     uInt64 hash) const
+  {
+    size_t mask = itsSlots.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot+1) & mask) {
+      Int64 group = itsSlots[slot];
+      if (group < 0) {
+        return -1;
+      }
+      if (itsHashes[group] == hash  &&
+          itsKeyOffsets[group+1] - itsKeyOffsets[group] == size  &&
+          memcmp (itsKeys.data() + itsKeyOffsets[group], key, size) == 0) {
+        return group;
+      }
+    }
+  }
+
+  Int64 TableExprGroupHashMap::add (const char* key, size_t size,
+                                    uInt64 hash)
+  {
+    // Keep the load factor below 0.5.
+    if (2 * (itsHashes.size() + 1) > itsSlots.size()) {
+      rehash (2 * itsSlots.size());
+    }
+    Int64 group = itsHashes.size();
+    itsKeys.append (key, size);
+    itsKeyOffsets.push_back (itsKeys.size());
+    itsHashes.push_back (hash);
+    size_t mask = itsSlots.size() - 1;
+    size_t slot = hash & mask;
+    while (itsSlots[slot] >= 0) {
+      slot = (slot+1) & mask;
+    }
+    itsSlots[slot] = group;
+    return group;
+  }
+
+  void TableExprGroupHashMap::rehash (size_t nslot)
+  {
+    itsSlots.assign (nslot, -1);
+    size_t mask = nslot - 1;
+    for (size_t group=0; group<itsHashes.size(); ++group) {
+      size_t slot = itsHashes[group] & mask;
+      while (itsSlots[slot] >= 0) {
+        slot = (slot+1) & mask;
+      }
+      itsSlots[slot] = group;
+    }
+  }
+
+  size_t TableExprGroupHashMap::nbytes() const
+  {
+    return (itsKeys.capacity() +
+            itsKeyOffsets.capacity() * sizeof(size_t) +
+            itsHashes.capacity() * sizeof(uInt64) +
+            itsSlots.capacity() * sizeof(Int64));
+  }
+
+  // Get the capacity of a container after adding elements to it, assuming
+  // it doubles its capacity when it has to grow.
+  static size_t grownCapacity (size_t capacity, size_t size)
+  {
+    return (size <= capacity  ?  capacity : std::max (2*capacity, size));
+  }
+
+  size_t TableExprGroupHashMap::nbytesAfterAdd (size_t keySize) const
+  {
+    size_t ngroup = itsHashes.size() + 1;
+    size_t nslot  = itsSlots.capacity();
+    if (2 * ngroup > itsSlots.size()) {
+      nslot = std::max (nslot, 2 * itsSlots.size());
+    }
+    return (grownCapacity (itsKeys.capacity(), itsKeys.size() + keySize) +
+            grownCapacity (itsKeyOffsets.capacity(), ngroup + 1) *
+              sizeof(size_t) +
+            grownCapacity (itsHashes.capacity(), ngroup) * sizeof(uInt64) +
+            nslot * sizeof(Int64));
+  }
+
+  void TableExprGroupHashMap::clear()
+  {
+    // Swap with empty objects to release the memory.
+    std::string().swap (itsKeys);
+    std::string().swap (itsBlock);
+    vector<size_t>(1, 0).swap (itsKeyOffsets);
+    vector<size_t>().swap (itsBlockOffsets);
+    vector<uInt64>().swap (itsHashes);
+    vector<Int64>().swap (itsSlots);
+    rehash (16);
+  }
+
+
   TableExprGroupResult::TableExprGroupResult
   (const vector<CountedPtr<TableExprGroupFuncSet> >& funcSets)
   {
@@ -163,6 +373,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   Bool TableExprGroupFuncBase::isLazy() const
     { return False; }
+  Bool TableExprGroupFuncBase::isMergeable() const
+    { return False; }
+  void TableExprGroupFuncBase::merge (const TableExprGroupFuncBase&)
+  { throw TableInvExpr ("TableExprGroupFuncBase::merge not implemented"); }
   void TableExprGroupFuncBase::finish()
   {}
   CountedPtr<vector<TableExprId> > TableExprGroupFuncBase::getIds() const
@@ -218,6 +432,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsId = id;
     }
   }
+  Bool TableExprGroupFirst::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupFirst::merge (const TableExprGroupFuncBase& other)
+  {
+    if (itsId.rownr() < 0) {
+      itsId = dynamic_cast<const TableExprGroupFirst&>(other).itsId;
+    }
+  }
   Bool TableExprGroupFirst::getBool (const vector<TableExprId>&)
     { return itsOperand->getBool (itsId); }
   Int64 TableExprGroupFirst::getInt (const vector<TableExprId>&)
@@ -252,6 +476,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsId = id;
   }
+  void TableExprGroupLast::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprId& id = dynamic_cast<const TableExprGroupLast&>(other).itsId;
+    if (id.rownr() >= 0) {
+      itsId = id;
+    }
+  }
 
   TableExprGroupExprId::TableExprGroupExprId (TableExprNodeRep* node)
     : TableExprGroupFuncBase (node)
@@ -268,6 +499,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsIds->push_back (id);
   }
+  Bool TableExprGroupExprId::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupExprId::merge (const TableExprGroupFuncBase& other)
+  {
+    const vector<TableExprId>& ids = *other.getIds();
+    itsIds->insert (itsIds->end(), ids.begin(), ids.end());
+  }
   CountedPtr<vector<TableExprId> > TableExprGroupExprId::getIds() const
   {
     return itsIds;
@@ -393,16 +633,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return MArray<Double>(itsValue); }
   Bool TableExprGroupFuncArrayDouble::checkShape (const MArrayBase& arr,
                                                   const String& func)
+  {
+    return checkShape (arr.shape(), arr.hasMask(), func);
+  }
+  Bool TableExprGroupFuncArrayDouble::checkShape (const IPosition& shape,
+                                                  Bool hasMask,
+                                                  const String& func)
   {
     if (itsValue.empty()) {
-      itsValue.resize (arr.shape(), arr.hasMask());
+      itsValue.resize (shape, hasMask);
       return True;    // first time itsValue is used
     }
-    if (! itsValue.shape().isEqual (arr.shape())) {
+    if (! itsValue.shape().isEqual (shape)) {
       throw TableInvExpr ("Mismatching array shapes in aggregate function " +
                           func);
     }
-    AlwaysAssert (arr.hasMask() == itsValue.hasMask(), AipsError);
+    AlwaysAssert (hasMask == itsValue.hasMask(), AipsError);
     return False;
   }
 
@@ -412,16 +658,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return MArray<DComplex>(itsValue); }
   Bool TableExprGroupFuncArrayDComplex::checkShape (const MArrayBase& arr,
                                                     const String& func)
+  {
+    return checkShape (arr.shape(), arr.hasMask(), func);
+  }
+  Bool TableExprGroupFuncArrayDComplex::checkShape (const IPosition& shape,
+                                                    Bool hasMask,
+                                                    const String& func)
   {
     if (itsValue.empty()) {
-      itsValue.resize (arr.shape(), arr.hasMask());
+      itsValue.resize (shape, hasMask);
       return True;    // first time itsValue is used
     }
-    if (! itsValue.shape().isEqual (arr.shape())) {
+    if (! itsValue.shape().isEqual (shape)) {
       throw TableInvExpr ("Mismatching array shapes in aggregate function " +
                           func);
     }
-    AlwaysAssert (arr.hasMask() == itsValue.hasMask(), AipsError);
+    AlwaysAssert (hasMask == itsValue.hasMask(), AipsError);
     return False;
   }
 
@@ -491,5 +743,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableExprGroupFuncSet::isMergeable() const
+  {
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      if (! itsFuncs[i]->isMergeable()) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  void TableExprGroupFuncSet::merge (const TableExprGroupFuncSet& other)
+  {
+    AlwaysAssert (other.itsFuncs.size() == itsFuncs.size(), AipsError);
+    itsId = other.itsId;
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      itsFuncs[i]->merge (*other.itsFuncs[i]);
+    }
+  }
+
 
 } //# NAMESPACE CASACORE - END
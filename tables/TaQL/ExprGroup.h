@@ -32,6 +32,8 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/tables/TaQL/ExprAggrNode.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <string>
 #include <vector>
 
 
@@ -48,6 +50,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // TaQL expression with an arbitrary data type.
   // This class contains the value of a key for a particular table row.
   // It is part of a TableExprGroupKeySet object.
+  // <note role=warning>
+  // This class is deprecated. TaQL does not use it anymore, because
+  // TableExprGroupHashMap is much faster and uses much less memory.
+  // </note>
   // </synopsis> 
   class TableExprGroupKey
   {
@@ -101,6 +107,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // the value of a key for a particular table row.
   // <br>It contains comparison functions to make it possible to use them
   // in a std::map object to map the groupby keyset to a group.
+  // <note role=warning>
+  // This class is deprecated. TaQL does not use it anymore, because
+  // TableExprGroupHashMap is much faster and uses much less memory.
+  // </note>
   // </synopsis> 
   class TableExprGroupKeySet
   {
@@ -126,6 +136,92 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   };
 
 
+  // <summary>
+  // Class mapping the packed keys in the groupby clause to a group.
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tTableParseGroupby">
+  // </reviewed>
+  // <synopsis>
+  // This class maps the values of the GROUPBY keys of a row to a group number.
+  // The keys are evaluated for a block of rows using the batch get functions
+  // and the values of a row are packed into a byte string. A Bool takes
+  // 1 byte, an integer, double or date 8 bytes, and a string is preceded
+  // by its length. Each double NaN is packed the same way, so all NaNs are
+  // in the same group; similarly -0 is packed as 0.
+  // <br>The packed keys of all groups are kept in a single buffer.
+  // The map uses open addressing with linear probing in a table of
+  // group numbers with a size being a power of 2. The bytes of a key are
+  // only compared if the hash value of the group matches.
+  // </synopsis>
+  class TableExprGroupHashMap
+  {
+  public:
+    // Form the object for the given groupby nodes.
+    explicit TableExprGroupHashMap (const vector<TableExprNode>& nodes);
+
+    // Evaluate the keys for the given rows and pack them.
+    void packKeys (const vector<TableExprNode>& nodes,
+                   const Vector<rownr_t>& rownrs);
+
+    // Get the packed key of the i-th row in the last <src>packKeys</src>.
+    // <group>
+    const char* key (size_t i) const
+      { return itsBlock.data() + itsBlockOffsets[i]; }
+    size_t keySize (size_t i) const
+      { return itsBlockOffsets[i+1] - itsBlockOffsets[i]; }
+    // </group>
+
+    // Calculate the hash value of a packed key (using FNV-1a).
+    static uInt64 hash (const char* key, size_t size);
+
+    // Find the group of the given packed key.
+    // -1 is returned if not found.
+    Int64 find (const char* key, size_t size, uInt64 hash) const;
+
+    // Add the given packed key as a new group and return its group number.
+    Int64 add (const char* key, size_t size, uInt64 hash);
+
+    // Get the number of groups.
+    size_t ngroup() const
+      { return itsHashes.size(); }
+
+    // Get the packed key and hash value of the given group.
+    // <group>
+    const char* groupKey (Int64 group) const
+      { return itsKeys.data() + itsKeyOffsets[group]; }
+    size_t groupKeySize (Int64 group) const
+      { return itsKeyOffsets[group+1] - itsKeyOffsets[group]; }
+    uInt64 groupHash (Int64 group) const
+      { return itsHashes[group]; }
+    // </group>
+
+    // Get the (approximate) number of bytes used by the groups in the map.
+    // The buffer of the packed keys of a block of rows is not included.
+    size_t nbytes() const;
+
+    // Get the (approximate) number of bytes used after adding a group
+    // with a packed key of the given size.
+    size_t nbytesAfterAdd (size_t keySize) const;
+
+    // Remove all groups and release the memory.
+    void clear();
+
+  private:
+    // Resize the table of slots and rehash the groups.
+    void rehash (size_t nslot);
+
+    //# Data members.
+    vector<TableExprNodeRep::NodeDataType> itsTypes;
+    std::string    itsBlock;          //# packed keys of a block of rows
+    vector<size_t> itsBlockOffsets;
+    std::string    itsKeys;           //# packed keys of the groups
+    vector<size_t> itsKeyOffsets;
+    vector<uInt64> itsHashes;         //# hash value of each group
+    vector<Int64>  itsSlots;          //# group number per slot; -1 is empty
+  };
+
+
   // <summary>
   // Class holding the results of groupby and aggregation
   // </summary>
@@ -180,8 +276,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // calculated in classes derived from this abstract base class.
   // <br>There is one such function object per aggregation per group. All
   // aggregation objects of a group are combined in a std::vector.
-  // This vector is mapped to a TableExprGroupKeySet object to keep track
-  // of all groups and aggregations.
+  // The packed GROUPBY keys are mapped to this vector (using a
+  // TableExprGroupHashMap) to keep track of all groups and aggregations.
   // <br> There are two types of aggregation function classes.
   // <ul>
   //  <li> Immediate classes implement the 'apply' function to immediately
@@ -197,6 +293,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   //       the table might be done in a non-sequential order.
   // </ul>
   // Most derived classes are immediate classes.
+  // <br>Immediate classes can implement the 'merge' function to merge the
+  // aggregation of another object done for a later part of the rows.
+  // In that way the rows can be aggregated by multiple threads.
   // </synopsis> 
   class TableExprGroupFuncBase
   {
@@ -217,6 +316,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the operand's value for the given row and apply it to the aggregation.
     // This function should not be called for lazy classes.
     virtual void apply (const TableExprId& id) = 0;
+    // Can the (partial) aggregation of another object be merged into this
+    // one? It makes it possible to aggregate parts of the rows in parallel.
+    // The default implementation returns False.
+    virtual Bool isMergeable() const;
+    // Merge the aggregation of another object of the same type into this one.
+    // The other object must have been applied to the rows following the rows
+    // applied to this one. It must be done before finishing the aggregation.
+    // The default implementation throws an exception.
+    virtual void merge (const TableExprGroupFuncBase& other);
     // If needed, finish the aggregation.
     // By default nothing is done.
     virtual void finish();
@@ -288,6 +396,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupFirst (TableExprNodeRep* node);
     virtual ~TableExprGroupFirst();
     virtual void apply (const TableExprId& id);
+    virtual Bool isMergeable() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual Bool getBool (const vector<TableExprId>&);
     virtual Int64 getInt (const vector<TableExprId>&);
     virtual Double getDouble (const vector<TableExprId>&);
@@ -321,6 +431,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupLast (TableExprNodeRep* node);
     virtual ~TableExprGroupLast();
     virtual void apply (const TableExprId& id);
+    virtual void merge (const TableExprGroupFuncBase& other);
   };
 
   // <summary>
@@ -341,6 +452,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     virtual ~TableExprGroupExprId();
     virtual Bool isLazy() const;
     virtual void apply (const TableExprId& id);
+    virtual Bool isMergeable() const;
+    virtual void merge (const TableExprGroupFuncBase& other);
     virtual CountedPtr<vector<TableExprId> > getIds() const;
   private:
     CountedPtr<vector<TableExprId> > itsIds;
@@ -697,7 +810,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   protected:
     // If not empty, check if the shape matches that of <src>itsValue</src>.
     // If <src>itsValue</src> is still empty, it is sized.
+    // <group>
     Bool checkShape (const MArrayBase& arr, const String& func);
+    Bool checkShape (const IPosition& shape, Bool hasMask, const String& func);
+    // </group>
     MArray<Double> itsValue;
   };
 
@@ -725,7 +841,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   protected:
     // If not empty, check if the shape matches that of <src>itsValue</src>.
     // If <src>itsValue</src> is still empty, it is sized.
+    // <group>
     Bool checkShape (const MArrayBase& arr, const String& func);
+    Bool checkShape (const IPosition& shape, Bool hasMask, const String& func);
+    // </group>
     MArray<DComplex> itsValue;
   };
 
@@ -814,6 +933,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Apply the functions to the given row.
     void apply (const TableExprId& id);
 
+    // Can all functions be merged?
+    Bool isMergeable() const;
+
+    // Merge the functions of another set (applied to later rows) into this
+    // one. The TableExprId of the other set is used thereafter.
+    void merge (const TableExprGroupFuncSet& other);
+
     // Get the vector of functions.
     const vector<CountedPtr<TableExprGroupFuncBase> >& getFuncs() const
       { return itsFuncs; }
@@ -49,6 +49,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue++;
   }
+  Bool TableExprGroupCountAll::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupCountAll::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupCountAll&>(other).itsValue;
+  }
 
   TableExprGroupCount::TableExprGroupCount (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node),
@@ -73,6 +81,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsValue++;
     }
   }
+  Bool TableExprGroupCount::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupCount::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupCount&>(other).itsValue;
+  }
 
   TableExprGroupAny::TableExprGroupAny (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
@@ -84,6 +100,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue = True;
   }
+  Bool TableExprGroupAny::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupAny::merge (const TableExprGroupFuncBase& other)
+  {
+    if (dynamic_cast<const TableExprGroupAny&>(other).itsValue) itsValue = True;
+  }
 
   TableExprGroupAll::TableExprGroupAll (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, True)
@@ -95,6 +119,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue = False;
   }
+  Bool TableExprGroupAll::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupAll::merge (const TableExprGroupFuncBase& other)
+  {
+    if (!dynamic_cast<const TableExprGroupAll&>(other).itsValue) itsValue = False;
+  }
 
   TableExprGroupNTrue::TableExprGroupNTrue (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -106,6 +138,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue++;
   }
+  Bool TableExprGroupNTrue::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupNTrue::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupNTrue&>(other).itsValue;
+  }
 
   TableExprGroupNFalse::TableExprGroupNFalse (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -117,6 +157,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue++;
   }
+  Bool TableExprGroupNFalse::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupNFalse::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupNFalse&>(other).itsValue;
+  }
 
   TableExprGroupMinInt::TableExprGroupMinInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::max())
@@ -128,6 +176,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinInt::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMinInt::merge (const TableExprGroupFuncBase& other)
+  {
+    Int64 v = dynamic_cast<const TableExprGroupMinInt&>(other).itsValue;
+    if (v<itsValue) itsValue = v;
+  }
 
   TableExprGroupMaxInt::TableExprGroupMaxInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::min())
@@ -139,6 +196,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxInt::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMaxInt::merge (const TableExprGroupFuncBase& other)
+  {
+    Int64 v = dynamic_cast<const TableExprGroupMaxInt&>(other).itsValue;
+    if (v>itsValue) itsValue = v;
+  }
 
   TableExprGroupSumInt::TableExprGroupSumInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -149,6 +215,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getInt(id);
   }
+  Bool TableExprGroupSumInt::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumInt::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumInt&>(other).itsValue;
+  }
 
   TableExprGroupProductInt::TableExprGroupProductInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, 1)
@@ -159,6 +233,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getInt(id);
   }
+  Bool TableExprGroupProductInt::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupProductInt::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue *= dynamic_cast<const TableExprGroupProductInt&>(other).itsValue;
+  }
 
   TableExprGroupSumSqrInt::TableExprGroupSumSqrInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -170,6 +252,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrInt::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrInt::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumSqrInt&>(other).itsValue;
+  }
 
 
   TableExprGroupMinDouble::TableExprGroupMinDouble(TableExprNodeRep* node)
@@ -182,6 +272,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMinDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    Double v = dynamic_cast<const TableExprGroupMinDouble&>(other).itsValue;
+    if (v<itsValue) itsValue = v;
+  }
 
   TableExprGroupMaxDouble::TableExprGroupMaxDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, std::numeric_limits<Double>::min())
@@ -193,6 +292,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMaxDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    Double v = dynamic_cast<const TableExprGroupMaxDouble&>(other).itsValue;
+    if (v>itsValue) itsValue = v;
+  }
 
   TableExprGroupSumDouble::TableExprGroupSumDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -203,6 +311,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDouble(id);
   }
+  Bool TableExprGroupSumDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumDouble&>(other).itsValue;
+  }
 
   TableExprGroupProductDouble::TableExprGroupProductDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, 1)
@@ -213,6 +329,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDouble(id);
   }
+  Bool TableExprGroupProductDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupProductDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue *= dynamic_cast<const TableExprGroupProductDouble&>(other).itsValue;
+  }
 
   TableExprGroupSumSqrDouble::TableExprGroupSumSqrDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -224,6 +348,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumSqrDouble&>(other).itsValue;
+  }
 
   TableExprGroupMeanDouble::TableExprGroupMeanDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node),
@@ -236,6 +368,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDouble(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMeanDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDouble& that =
+      dynamic_cast<const TableExprGroupMeanDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDouble::finish()
   {
     if (itsNr > 0) {
@@ -262,6 +405,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsCurMean += delta/itsNr;
     itsValue   += delta*(v-itsCurMean);   // itsValue contains the M2 value
   }
+  Bool TableExprGroupVarianceDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupVarianceDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    // Combine the partial results as described in
+    // en.wikipedia.org/wiki/Algorithms_for_calculating_variance (parallel).
+    const TableExprGroupVarianceDouble& that =
+      dynamic_cast<const TableExprGroupVarianceDouble&>(other);
+    if (that.itsNr > 0) {
+      Int64 nr = itsNr + that.itsNr;
+      Double delta = that.itsCurMean - itsCurMean;
+      itsCurMean += delta * that.itsNr / nr;
+      itsValue   += that.itsValue + delta*delta * itsNr * that.itsNr / nr;
+      itsNr = nr;
+    }
+  }
   void TableExprGroupVarianceDouble::finish()
   {
     if (itsNr > itsDdof) {
@@ -294,6 +455,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += v*v;
     itsNr++;
   }
+  Bool TableExprGroupRmsDouble::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupRmsDouble::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupRmsDouble& that =
+      dynamic_cast<const TableExprGroupRmsDouble&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupRmsDouble::finish()
   {
     if (itsNr > 0) {
@@ -339,6 +511,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupSumDComplex::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumDComplex&>(other).itsValue;
+  }
 
   TableExprGroupProductDComplex::TableExprGroupProductDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node, DComplex(1,0))
@@ -349,6 +529,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupProductDComplex::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupProductDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue *= dynamic_cast<const TableExprGroupProductDComplex&>(other).itsValue;
+  }
 
   TableExprGroupSumSqrDComplex::TableExprGroupSumSqrDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node)
@@ -360,6 +548,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex v = itsOperand->getDComplex(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDComplex::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    itsValue += dynamic_cast<const TableExprGroupSumSqrDComplex&>(other).itsValue;
+  }
 
   TableExprGroupMeanDComplex::TableExprGroupMeanDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node),
@@ -372,6 +568,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDComplex(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDComplex::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupMeanDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    const TableExprGroupMeanDComplex& that =
+      dynamic_cast<const TableExprGroupMeanDComplex&>(other);
+    itsValue += that.itsValue;
+    itsNr    += that.itsNr;
+  }
   void TableExprGroupMeanDComplex::finish()
   {
     if (itsNr > 0) {
@@ -398,6 +605,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex d = v - itsCurMean;
     itsValue += real(delta)*real(d) + imag(delta)*imag(d);
   }
+  Bool TableExprGroupVarianceDComplex::isMergeable() const
+  {
+    return True;
+  }
+  void TableExprGroupVarianceDComplex::merge (const TableExprGroupFuncBase& other)
+  {
+    // Combine the partial results as described in
+    // en.wikipedia.org/wiki/Algorithms_for_calculating_variance (parallel).
+    const TableExprGroupVarianceDComplex& that =
+      dynamic_cast<const TableExprGroupVarianceDComplex&>(other);
+    if (that.itsNr > 0) {
+      Int64 nr = itsNr + that.itsNr;
+      DComplex delta = that.itsCurMean - itsCurMean;
+      itsCurMean += delta * (Double(that.itsNr) / nr);
+      itsValue   += that.itsValue + norm(delta) * itsNr * that.itsNr / nr;
+      itsNr = nr;
+    }
+  }
   void TableExprGroupVarianceDComplex::finish()
   {
     if (itsNr > itsDdof) {
@@ -159,30 +159,6 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
-  template<typename T>
-  void TEGMeanAdd (const MArray<T>& src, Array<T>& dst, Array<Int64>& nr)
-  {
-    typename Array<Int64>::contiter itn = nr.cbegin();
-    if (src.hasMask()) {
-      typename Array<T>::const_iterator in = src.array().begin();
-      typename Array<Bool>::const_iterator min = src.mask().begin();
-      for (typename Array<T>::contiter out = dst.cbegin();
-           out != dst.cend(); ++in, ++min, ++out, ++itn) {
-        if (! *min) {
-          *out += *in;
-          (*itn)++;
-        }
-      }
-    } else {
-      typename Array<T>::const_iterator in = src.array().begin();
-      for (typename Array<T>::contiter out = dst.cbegin();
-           out != dst.cend(); ++in, ++out, ++itn) {
-        *out += *in;
-        (*itn)++;
-      }
-    }
-  }
-
   template<typename T>
   void TEGMeanFinish (MArray<T>& val, const Array<Int64>& nr)
   {
@@ -201,6 +177,289 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+
+  // The kernels below accumulate the values of a contiguous array with an
+  // optional mask (True means masked off) as given by TableExprGroupArrayData.
+  // The values can be of a narrower type (Float, Complex) than the
+  // accumulator (Double, DComplex).
+  // They are plain loops over the data, so the compiler can vectorize them.
+  // Reductions add to a local sum in the same order as before to get
+  // the same result.
+  template<typename T>
+  struct TEGSumKernel
+  {
+    TEGSumKernel() : sum(), nr(0) {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            sum += T(in[i]);
+            nr++;
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          sum += T(in[i]);
+        }
+        nr += n;
+      }
+    }
+    T     sum;
+    Int64 nr;
+  };
+
+  template<typename T>
+  struct TEGSumSqrKernel
+  {
+    TEGSumSqrKernel() : sum(), nr(0) {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            T v(in[i]);
+            sum += v*v;
+            nr++;
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          T v(in[i]);
+          sum += v*v;
+        }
+        nr += n;
+      }
+    }
+    T     sum;
+    Int64 nr;
+  };
+
+  // Minimum (or maximum if <src>MAX</src> is True) of the values.
+  template<Bool MAX>
+  struct TEGMinKernel
+  {
+    explicit TEGMinKernel (Double& value) : val(value) {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      Double v = val;
+      for (size_t i=0; i<n; ++i) {
+        if (!mask  ||  !mask[i]) {
+          Double d(in[i]);
+          if (MAX ? d>v : d<v) v = d;
+        }
+      }
+      val = v;
+    }
+    Double& val;
+  };
+
+  // Element-wise kernels. The output mask is cleared for each unmasked value.
+  template<typename T>
+  struct TEGSumsKernel
+  {
+    TEGSumsKernel (MArray<T>& value)
+      : out(value.array().data()),
+        mout(value.hasMask() ? value.wmask().data() : 0)
+    {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            mout[i] = False;
+            out[i] += T(in[i]);
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          out[i] += T(in[i]);
+        }
+      }
+    }
+    T*    out;
+    Bool* mout;
+  };
+
+  template<typename T>
+  struct TEGSumSqrsKernel
+  {
+    TEGSumSqrsKernel (MArray<T>& value)
+      : out(value.array().data()),
+        mout(value.hasMask() ? value.wmask().data() : 0)
+    {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            T v(in[i]);
+            mout[i] = False;
+            out[i] += v*v;
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          T v(in[i]);
+          out[i] += v*v;
+        }
+      }
+    }
+    T*    out;
+    Bool* mout;
+  };
+
+  template<Bool MAX>
+  struct TEGMinsKernel
+  {
+    TEGMinsKernel (MArray<Double>& value)
+      : out(value.array().data()),
+        mout(value.hasMask() ? value.wmask().data() : 0)
+    {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            Double d(in[i]);
+            mout[i] = False;
+            if (MAX ? d>out[i] : d<out[i]) out[i] = d;
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          Double d(in[i]);
+          out[i] = ((MAX ? d>out[i] : d<out[i])  ?  d : out[i]);
+        }
+      }
+    }
+    Double* out;
+    Bool*   mout;
+  };
+
+  // Add the (squared if <src>SQR</src> is True) values and count them
+  // per element.
+  template<typename T, Bool SQR>
+  struct TEGMeansKernel
+  {
+    TEGMeansKernel (Array<T>& value, Array<Int64>& nr)
+      : out(value.data()),
+        nout(nr.data())
+    {}
+    template<typename S>
+    void operator() (const S* in, const Bool* mask, size_t n)
+    {
+      if (mask) {
+        for (size_t i=0; i<n; ++i) {
+          if (! mask[i]) {
+            T v(in[i]);
+            out[i] += (SQR ? v*v : v);
+            nout[i]++;
+          }
+        }
+      } else {
+        for (size_t i=0; i<n; ++i) {
+          T v(in[i]);
+          out[i] += (SQR ? v*v : v);
+          nout[i]++;
+        }
+      }
+    }
+    T*     out;
+    Int64* nout;
+  };
+
+  // Make the array and mask contiguous (the result of an expression
+  // can be a non-contiguous slice).
+  template<typename T>
+  MArray<T> TEGContiguous (const MArray<T>& arr)
+  {
+    if (arr.array().contiguousStorage()  &&
+        (!arr.hasMask()  ||  arr.mask().contiguousStorage())) {
+      return arr;
+    }
+    if (arr.hasMask()) {
+      return MArray<T> (arr.array().copy(), arr.mask().copy());
+    }
+    return MArray<T> (arr.array().copy());
+  }
+
+  // Apply a kernel to the real or complex values.
+  template<typename Kernel>
+  void TEGApplyReal (const TableExprGroupArrayData& arr, Kernel& kernel)
+  {
+    if (arr.dataType() == TpFloat) {
+      kernel (static_cast<const Float*>(arr.data()), arr.mask(), arr.size());
+    } else {
+      kernel (static_cast<const Double*>(arr.data()), arr.mask(), arr.size());
+    }
+  }
+  template<typename Kernel>
+  void TEGApplyComplex (const TableExprGroupArrayData& arr, Kernel& kernel)
+  {
+    if (arr.dataType() == TpComplex) {
+      kernel (static_cast<const Complex*>(arr.data()), arr.mask(), arr.size());
+    } else {
+      kernel (static_cast<const DComplex*>(arr.data()), arr.mask(), arr.size());
+    }
+  }
+
+
+  TableExprGroupArrayData::TableExprGroupArrayData (TableExprNodeRep* operand,
+                                                    const TableExprId& id,
+                                                    Bool isComplex)
+    : itsType (TpOther),
+      itsData (0),
+      itsMask (0),
+      itsSize (0)
+  {
+    // Read a column directly in its own data type if possible.
+    if (isComplex) {
+      if (TableExprNodeArrayColumnComplex* col =
+          dynamic_cast<TableExprNodeArrayColumnComplex*>(operand)) {
+        setData (MArray<Complex>(col->getArrayBuffer(id)), TpComplex);
+      } else if (TableExprNodeArrayColumnDComplex* col =
+                 dynamic_cast<TableExprNodeArrayColumnDComplex*>(operand)) {
+        setData (MArray<DComplex>(col->getArrayBuffer(id)), TpDComplex);
+      } else {
+        itsDComplex.reference (TEGContiguous (operand->getArrayDComplex(id)));
+        setData (itsDComplex, TpDComplex);
+      }
+    } else {
+      if (TableExprNodeArrayColumnFloat* col =
+          dynamic_cast<TableExprNodeArrayColumnFloat*>(operand)) {
+        setData (MArray<Float>(col->getArrayBuffer(id)), TpFloat);
+      } else if (TableExprNodeArrayColumnDouble* col =
+                 dynamic_cast<TableExprNodeArrayColumnDouble*>(operand)) {
+        setData (MArray<Double>(col->getArrayBuffer(id)), TpDouble);
+      } else {
+        itsDouble.reference (TEGContiguous (operand->getArrayDouble(id)));
+        setData (itsDouble, TpDouble);
+      }
+    }
+  }
+
+  template<typename T>
+  void TableExprGroupArrayData::setData (const MArray<T>& arr, DataType dtype)
+  {
+    itsType  = dtype;
+    itsSize  = arr.size();
+    itsShape = arr.shape();
+    if (itsSize > 0) {
+      itsData = arr.array().data();
+      if (arr.hasMask()) {
+        itsMask = arr.mask().data();
+      }
+    }
+  }
+
+
   TableExprGroupArrayAny::TableExprGroupArrayAny(TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
   {}
@@ -317,11 +576,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMinArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
-    if (! arr.empty()) {
-      Double v = min(arr);
-      if (v<itsValue) itsValue = v;
-    }
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGMinKernel<False> kernel(itsValue);
+    TEGApplyReal (arr, kernel);
   }
 
   TableExprGroupMaxArrayDouble::TableExprGroupMaxArrayDouble(TableExprNodeRep* node)
@@ -331,11 +588,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMaxArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
-    if (! arr.empty()) {
-      Double v = max(arr);
-      if (v>itsValue) itsValue = v;
-    }
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGMinKernel<True> kernel(itsValue);
+    TEGApplyReal (arr, kernel);
   }
 
   TableExprGroupSumArrayDouble::TableExprGroupSumArrayDouble(TableExprNodeRep* node)
@@ -345,7 +600,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumArrayDouble::apply (const TableExprId& id)
   {
-    itsValue += sum(itsOperand->getArrayDouble(id));
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGSumKernel<Double> kernel;
+    TEGApplyReal (arr, kernel);
+    itsValue += kernel.sum;
   }
 
   TableExprGroupProductArrayDouble::TableExprGroupProductArrayDouble(TableExprNodeRep* node)
@@ -368,8 +626,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumSqrArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
-    itsValue += sum(arr*arr);
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGSumSqrKernel<Double> kernel;
+    TEGApplyReal (arr, kernel);
+    itsValue += kernel.sum;
   }
 
   TableExprGroupMeanArrayDouble::TableExprGroupMeanArrayDouble(TableExprNodeRep* node)
@@ -380,13 +640,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMeanArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
-    itsValue += sum(arr);
-    if (arr.hasMask()) {
-      itsNr += nfalse(arr.mask());
-    } else {
-      itsNr += arr.size();
-    }
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGSumKernel<Double> kernel;
+    TEGApplyReal (arr, kernel);
+    itsValue += kernel.sum;
+    itsNr    += kernel.nr;
   }
   void TableExprGroupMeanArrayDouble::finish()
   {
@@ -461,13 +719,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupRmsArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
-    itsValue += sum(arr*arr);
-    if (arr.hasMask()) {
-      itsNr += nfalse(arr.mask());
-    } else  {
-      itsNr += arr.size();
-    }
+    TableExprGroupArrayData arr(itsOperand, id, False);
+    TEGSumSqrKernel<Double> kernel;
+    TEGApplyReal (arr, kernel);
+    itsValue += kernel.sum;
+    itsNr    += kernel.nr;
   }
   void TableExprGroupRmsArrayDouble::finish()
   {
@@ -526,7 +782,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumArrayDComplex::apply (const TableExprId& id)
   {
-    itsValue += sum(itsOperand->getArrayDComplex(id));
+    TableExprGroupArrayData arr(itsOperand, id, True);
+    TEGSumKernel<DComplex> kernel;
+    TEGApplyComplex (arr, kernel);
+    itsValue += kernel.sum;
   }
 
   TableExprGroupProductArrayDComplex::TableExprGroupProductArrayDComplex(TableExprNodeRep* node)
@@ -549,8 +808,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumSqrArrayDComplex::apply (const TableExprId& id)
   {
-    MArray<DComplex> arr = itsOperand->getArrayDComplex(id);
-    itsValue += sum(arr*arr);
+    TableExprGroupArrayData arr(itsOperand, id, True);
+    TEGSumSqrKernel<DComplex> kernel;
+    TEGApplyComplex (arr, kernel);
+    itsValue += kernel.sum;
   }
 
   TableExprGroupMeanArrayDComplex::TableExprGroupMeanArrayDComplex(TableExprNodeRep* node)
@@ -561,13 +822,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMeanArrayDComplex::apply (const TableExprId& id)
   {
-    MArray<DComplex> arr = itsOperand->getArrayDComplex(id);
-    itsValue += sum(arr);
-    if (arr.hasMask()) {
-      itsNr += nfalse(arr.mask());
-    } else {
-      itsNr += arr.size();
-    }
+    TableExprGroupArrayData arr(itsOperand, id, True);
+    TEGSumKernel<DComplex> kernel;
+    TEGApplyComplex (arr, kernel);
+    itsValue += kernel.sum;
+    itsNr    += kernel.nr;
   }
   void TableExprGroupMeanArrayDComplex::finish()
   {
@@ -882,13 +1141,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMinsArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr(itsOperand->getArrayDouble(id));
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GMINS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GMINS")) {
         itsValue.array() = std::numeric_limits<Double>::max();
         itsValue.wmask() = True;
       }
-      TEGMin (arr, itsValue);
+      TEGMinsKernel<False> kernel(itsValue);
+      TEGApplyReal (arr, kernel);
     }
   }
   void TableExprGroupMinsArrayDouble::finish()
@@ -903,13 +1163,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMaxsArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GMAXS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GMAXS")) {
         itsValue.array() = std::numeric_limits<Double>::min();
         itsValue.wmask() = True;
       }
-      TEGMax (arr, itsValue);
+      TEGMinsKernel<True> kernel(itsValue);
+      TEGApplyReal (arr, kernel);
     }
   }
   void TableExprGroupMaxsArrayDouble::finish()
@@ -924,13 +1185,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumsArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GSUMS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GSUMS")) {
         itsValue.array() = 0;
         itsValue.wmask() = True;
       }
-      TEGSum (arr, itsValue);
+      TEGSumsKernel<Double> kernel(itsValue);
+      TEGApplyReal (arr, kernel);
     }
   }
 
@@ -962,13 +1224,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumSqrsArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GSUMSQRS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GSUMSQRS")) {
         itsValue.array() = 0;
         itsValue.wmask() = True;
       }
-      TEGSumSqr (arr, itsValue);
+      TEGSumSqrsKernel<Double> kernel(itsValue);
+      TEGApplyReal (arr, kernel);
     }
   }
 
@@ -979,15 +1242,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMeansArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GMEANS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GMEANS")) {
         itsValue.array() = 0;
         itsValue.wmask() = False;
         itsNr.resize (arr.shape());
         itsNr = 0;
       }
-      TEGMeanAdd (arr, itsValue.array(), itsNr);
+      TEGMeansKernel<Double,False> kernel(itsValue.array(), itsNr);
+      TEGApplyReal (arr, kernel);
     }
   }
   void TableExprGroupMeansArrayDouble::finish()
@@ -1078,32 +1342,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupRmssArrayDouble::apply (const TableExprId& id)
   {
-    MArray<Double> arr = itsOperand->getArrayDouble(id);
+    TableExprGroupArrayData arr(itsOperand, id, False);
     if (! arr.empty()) {
-      if (checkShape (arr, "GRMSS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GRMSS")) {
         itsValue.array() = 0;
         itsValue.wmask() = False;
         itsNr.resize (arr.shape());
         itsNr = 0;
       }
-      Array<Int64>::contiter itn = itsNr.cbegin();
-      Array<Double>::const_iterator in = arr.array().begin();
-      if (arr.hasMask()) {
-        Array<Bool>::const_iterator min = arr.mask().begin();
-        for (Array<Double>::contiter out = itsValue.array().cbegin();
-             out != itsValue.array().cend(); ++in, ++min, ++out, ++itn) {
-          if (! *min) {
-            *out += *in * *in;
-            (*itn)++;
-          }
-        }
-      } else {
-        for (Array<Double>::contiter out = itsValue.array().cbegin();
-             out != itsValue.array().cend(); ++in, ++out, ++itn) {
-          *out += *in * *in;
-          (*itn)++;
-        }
-      }
+      TEGMeansKernel<Double,True> kernel(itsValue.array(), itsNr);
+      TEGApplyReal (arr, kernel);
     }
   }
   void TableExprGroupRmssArrayDouble::finish()
@@ -1129,13 +1377,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumsArrayDComplex::apply (const TableExprId& id)
   {
-    MArray<DComplex> arr = itsOperand->getArrayDComplex(id);
+    TableExprGroupArrayData arr(itsOperand, id, True);
     if (! arr.empty()) {
-      if (checkShape (arr, "GSUMS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GSUMS")) {
         itsValue.array() = DComplex();
         itsValue.wmask() = True;
       }
-      TEGSum (arr, itsValue);
+      TEGSumsKernel<DComplex> kernel(itsValue);
+      TEGApplyComplex (arr, kernel);
     }
   }
 
@@ -1165,13 +1414,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupSumSqrsArrayDComplex::apply (const TableExprId& id)
   {
-    MArray<DComplex> arr = itsOperand->getArrayDComplex(id);
+    TableExprGroupArrayData arr(itsOperand, id, True);
     if (! arr.empty()) {
-      if (checkShape (arr, "GSUMSQRS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GSUMSQRS")) {
         itsValue.array() = DComplex();
         itsValue.wmask() = True;
       }
-      TEGSumSqr (arr, itsValue);
+      TEGSumSqrsKernel<DComplex> kernel(itsValue);
+      TEGApplyComplex (arr, kernel);
     }
   }
 
@@ -1182,15 +1432,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {}
   void TableExprGroupMeansArrayDComplex::apply (const TableExprId& id)
   {
-    MArray<DComplex> arr = itsOperand->getArrayDComplex(id);
+    TableExprGroupArrayData arr(itsOperand, id, True);
     if (! arr.empty()) {
-      if (checkShape (arr, "GMEANS")) {
+      if (checkShape (arr.shape(), arr.mask() != 0, "GMEANS")) {
         itsValue.array() = DComplex();
         itsValue.wmask() = False;
         itsNr.resize (arr.shape());
         itsNr = 0;
       }
-      TEGMeanAdd (arr, itsValue.array(), itsNr);
+      TEGMeansKernel<DComplex,False> kernel(itsValue.array(), itsNr);
+      TEGApplyComplex (arr, kernel);
     }
   }
   void TableExprGroupMeansArrayDComplex::finish()
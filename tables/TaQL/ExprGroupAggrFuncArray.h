@@ -37,6 +37,67 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 
+  // <summary>
+  // Contiguous array values of an aggregate function's operand
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tExprGroupArray">
+  // </reviewed>
+  // <synopsis>
+  // This class gives the array of the operand in a row as a pointer to
+  // contiguous data and an optional mask (True means masked off).
+  // It makes it possible for the array aggregate functions to accumulate
+  // the values directly using simple loops over the data.
+  // <br>If the operand is a Float, Double, Complex or DComplex array column,
+  // the array is read into a buffer kept by the column node, so no MArray
+  // is created and the values are not converted to Double or DComplex.
+  // Otherwise the operand's MArray is used, which is copied if not
+  // contiguous.
+  // </synopsis>
+  class TableExprGroupArrayData
+  {
+  public:
+    // Get the array of the operand in the given row.
+    // If <src>isComplex</src> is True, the values are complex, otherwise real.
+    TableExprGroupArrayData (TableExprNodeRep* operand, const TableExprId& id,
+                             Bool isComplex);
+
+    // Is the array empty?
+    Bool empty() const
+      { return itsSize == 0; }
+    // Get the data type of the values (TpFloat, TpDouble, TpComplex or
+    // TpDComplex).
+    DataType dataType() const
+      { return itsType; }
+    // Get the values. They are of the type given by <src>dataType()</src>.
+    const void* data() const
+      { return itsData; }
+    // Get the mask. It is a null pointer if the array has no mask.
+    const Bool* mask() const
+      { return itsMask; }
+    // Get the size and shape of the array.
+    // <group>
+    size_t size() const
+      { return itsSize; }
+    const IPosition& shape() const
+      { return itsShape; }
+    // </group>
+
+  private:
+    // Set the data and mask from the given MArray.
+    template<typename T>
+    void setData (const MArray<T>& arr, DataType dtype);
+
+    DataType         itsType;
+    const void*      itsData;
+    const Bool*      itsMask;
+    size_t           itsSize;
+    IPosition        itsShape;
+    MArray<Double>   itsDouble;
+    MArray<DComplex> itsDComplex;
+  };
+
+
   // <summary>
   // Aggregate class counting if any array value in a group is true
   // </summary>
@@ -0,0 +1,298 @@
+//# ExprJoinNode.cc: Nodes representing a column of a joined table in a TaQL expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/TaQL/ExprJoinNode.h>
+#include <casacore/tables/TaQL/MArray.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Quanta/MVTime.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TableExprJoinMap::TableExprJoinMap (const std::shared_ptr<Vector<Int64>>& rowMap)
+  : rowMap_p         (rowMap),
+    hasSelection_p   (False),
+    applySelection_p (True)
+{}
+
+void TableExprJoinMap::applySelection (const Vector<rownr_t>& rownrs)
+{
+  if (applySelection_p) {
+    // Apply the selection on top of a previous one (as rowid() does).
+    Vector<rownr_t> newRows(rownrs.size());
+    for (rownr_t i=0; i<rownrs.size(); ++i) {
+      newRows[i] = (hasSelection_p ? selRows_p[rownrs[i]] : rownrs[i]);
+    }
+    selRows_p.reference (newRows);
+    hasSelection_p = True;
+  }
+}
+
+inline rownr_t TableExprJoinMap::mapRow (rownr_t rownr) const
+{
+  if (hasSelection_p) {
+    rownr = selRows_p[rownr];
+  }
+  Int64 joinRow = (*rowMap_p)[rownr];
+  if (joinRow < 0) {
+    throw TableInvExpr ("Row " + String::toString(rownr) +
+                        " has no matching row in the joined table");
+  }
+  return joinRow;
+}
+
+rownr_t TableExprJoinMap::joinRow (const TableExprId& id) const
+{
+  AlwaysAssert (id.byRow(), AipsError);
+  return mapRow (id.rownr());
+}
+
+Vector<rownr_t> TableExprJoinMap::joinRows (const Vector<rownr_t>& rownrs) const
+{
+  Vector<rownr_t> rows(rownrs.size());
+  for (rownr_t i=0; i<rownrs.size(); ++i) {
+    rows[i] = mapRow (rownrs[i]);
+  }
+  return rows;
+}
+
+
+
+TableExprNodeJoinColumn::TableExprNodeJoinColumn
+(const TENShPtr& column, const Table& table,
+ const std::shared_ptr<Vector<Int64>>& rowMap)
+  : TableExprNodeBinary (column->dataType(), *column, OtUndef),
+    map_p               (rowMap)
+{
+  // The node acts as a column in the first table.
+  table_p = table;
+  lnode_p = column;
+}
+
+TableExprNodeJoinColumn::~TableExprNodeJoinColumn()
+{}
+
+void TableExprNodeJoinColumn::getColumnNodes (std::vector<TableExprNodeRep*>& cols)
+{
+  cols.push_back (this);
+}
+
+void TableExprNodeJoinColumn::disableApplySelection()
+{
+  map_p.disableApplySelection();
+}
+
+void TableExprNodeJoinColumn::applySelection (const Vector<rownr_t>& rownrs)
+{
+  map_p.applySelection (rownrs);
+}
+
+Bool TableExprNodeJoinColumn::isParallelSafe() const
+{
+  return lnode_p->isParallelSafe();
+}
+
+Bool TableExprNodeJoinColumn::getColumnDataType (DataType& dt) const
+{
+  return lnode_p->getColumnDataType (dt);
+}
+
+Bool TableExprNodeJoinColumn::getBool (const TableExprId& id)
+{
+  return lnode_p->getBool (map_p.joinRow(id));
+}
+Int64 TableExprNodeJoinColumn::getInt (const TableExprId& id)
+{
+  return lnode_p->getInt (map_p.joinRow(id));
+}
+Double TableExprNodeJoinColumn::getDouble (const TableExprId& id)
+{
+  return lnode_p->getDouble (map_p.joinRow(id));
+}
+DComplex TableExprNodeJoinColumn::getDComplex (const TableExprId& id)
+{
+  return lnode_p->getDComplex (map_p.joinRow(id));
+}
+String TableExprNodeJoinColumn::getString (const TableExprId& id)
+{
+  return lnode_p->getString (map_p.joinRow(id));
+}
+MVTime TableExprNodeJoinColumn::getDate (const TableExprId& id)
+{
+  return lnode_p->getDate (map_p.joinRow(id));
+}
+
+void TableExprNodeJoinColumn::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                            Vector<Bool>& values)
+{
+  lnode_p->getBoolBatch (map_p.joinRows(rownrs), values);
+}
+void TableExprNodeJoinColumn::getIntBatch (const Vector<rownr_t>& rownrs,
+                                           Vector<Int64>& values)
+{
+  lnode_p->getIntBatch (map_p.joinRows(rownrs), values);
+}
+void TableExprNodeJoinColumn::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                              Vector<Double>& values)
+{
+  lnode_p->getDoubleBatch (map_p.joinRows(rownrs), values);
+}
+
+
+
+TableExprNodeArrayJoinColumn::TableExprNodeArrayJoinColumn
+(const TENShPtr& column, const Table& table,
+ const std::shared_ptr<Vector<Int64>>& rowMap)
+  : TableExprNodeArray (*column, column->dataType(), OtUndef),
+    column_p           (dynamic_cast<TableExprNodeArray*>(column.get())),
+    map_p              (rowMap)
+{
+  AlwaysAssert (column_p, AipsError);
+  table_p = table;
+  lnode_p = column;
+}
+
+TableExprNodeArrayJoinColumn::~TableExprNodeArrayJoinColumn()
+{}
+
+void TableExprNodeArrayJoinColumn::getColumnNodes (std::vector<TableExprNodeRep*>& cols)
+{
+  cols.push_back (this);
+}
+
+void TableExprNodeArrayJoinColumn::disableApplySelection()
+{
+  map_p.disableApplySelection();
+}
+
+void TableExprNodeArrayJoinColumn::applySelection (const Vector<rownr_t>& rownrs)
+{
+  map_p.applySelection (rownrs);
+}
+
+Bool TableExprNodeArrayJoinColumn::isParallelSafe() const
+{
+  return lnode_p->isParallelSafe();
+}
+
+Bool TableExprNodeArrayJoinColumn::isDefined (const TableExprId& id)
+{
+  return column_p->isDefined (map_p.joinRow(id));
+}
+const IPosition& TableExprNodeArrayJoinColumn::getShape (const TableExprId& id)
+{
+  return column_p->getShape (map_p.joinRow(id));
+}
+
+MArray<Bool> TableExprNodeArrayJoinColumn::getArrayBool (const TableExprId& id)
+{
+  return column_p->getArrayBool (map_p.joinRow(id));
+}
+MArray<Int64> TableExprNodeArrayJoinColumn::getArrayInt (const TableExprId& id)
+{
+  return column_p->getArrayInt (map_p.joinRow(id));
+}
+MArray<Double> TableExprNodeArrayJoinColumn::getArrayDouble (const TableExprId& id)
+{
+  return column_p->getArrayDouble (map_p.joinRow(id));
+}
+MArray<DComplex> TableExprNodeArrayJoinColumn::getArrayDComplex (const TableExprId& id)
+{
+  return column_p->getArrayDComplex (map_p.joinRow(id));
+}
+MArray<String> TableExprNodeArrayJoinColumn::getArrayString (const TableExprId& id)
+{
+  return column_p->getArrayString (map_p.joinRow(id));
+}
+MArray<MVTime> TableExprNodeArrayJoinColumn::getArrayDate (const TableExprId& id)
+{
+  return column_p->getArrayDate (map_p.joinRow(id));
+}
+
+Bool TableExprNodeArrayJoinColumn::getElemBool (const TableExprId& id,
+                                                const Slicer& index)
+{
+  return column_p->getElemBool (map_p.joinRow(id), index);
+}
+Int64 TableExprNodeArrayJoinColumn::getElemInt (const TableExprId& id,
+                                                const Slicer& index)
+{
+  return column_p->getElemInt (map_p.joinRow(id), index);
+}
+Double TableExprNodeArrayJoinColumn::getElemDouble (const TableExprId& id,
+                                                    const Slicer& index)
+{
+  return column_p->getElemDouble (map_p.joinRow(id), index);
+}
+DComplex TableExprNodeArrayJoinColumn::getElemDComplex (const TableExprId& id,
+                                                        const Slicer& index)
+{
+  return column_p->getElemDComplex (map_p.joinRow(id), index);
+}
+String TableExprNodeArrayJoinColumn::getElemString (const TableExprId& id,
+                                                    const Slicer& index)
+{
+  return column_p->getElemString (map_p.joinRow(id), index);
+}
+MVTime TableExprNodeArrayJoinColumn::getElemDate (const TableExprId& id,
+                                                  const Slicer& index)
+{
+  return column_p->getElemDate (map_p.joinRow(id), index);
+}
+
+MArray<Bool> TableExprNodeArrayJoinColumn::getSliceBool (const TableExprId& id,
+                                                         const Slicer& index)
+{
+  return column_p->getSliceBool (map_p.joinRow(id), index);
+}
+MArray<Int64> TableExprNodeArrayJoinColumn::getSliceInt (const TableExprId& id,
+                                                         const Slicer& index)
+{
+  return column_p->getSliceInt (map_p.joinRow(id), index);
+}
+MArray<Double> TableExprNodeArrayJoinColumn::getSliceDouble (const TableExprId& id,
+                                                             const Slicer& index)
+{
+  return column_p->getSliceDouble (map_p.joinRow(id), index);
+}
+MArray<DComplex> TableExprNodeArrayJoinColumn::getSliceDComplex (const TableExprId& id,
+                                                                 const Slicer& index)
+{
+  return column_p->getSliceDComplex (map_p.joinRow(id), index);
+}
+MArray<String> TableExprNodeArrayJoinColumn::getSliceString (const TableExprId& id,
+                                                             const Slicer& index)
+{
+  return column_p->getSliceString (map_p.joinRow(id), index);
+}
+MArray<MVTime> TableExprNodeArrayJoinColumn::getSliceDate (const TableExprId& id,
+                                                           const Slicer& index)
+{
+  return column_p->getSliceDate (map_p.joinRow(id), index);
+}
+
+} //# NAMESPACE CASACORE - END
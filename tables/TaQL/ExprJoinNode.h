@@ -0,0 +1,223 @@
+//# ExprJoinNode.h: Nodes representing a column of a joined table in a TaQL expression
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_EXPRJOINNODE_H
+#define TABLES_EXPRJOINNODE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <memory>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Row mapping of a joined table in a table select expression tree
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTableParseJoin">
+// </reviewed>
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TableParseJoin>TableParseJoin</linkto>
+// </prerequisite>
+// <synopsis>
+// This class maps a row number in the first table of a query to the
+// matching row number in a joined table. The mapping is shared with the
+// <linkto class=TableParseJoin>TableParseJoin</linkto> object filling it
+// when the join is executed. A value -1 means that the row has no match.
+// <br>Like a table column node, it adheres to a selection of rows in the
+// first table (see <src>applySelection</src>), which is applied on top
+// of the mapping.
+// </synopsis>
+
+class TableExprJoinMap
+{
+public:
+  explicit TableExprJoinMap (const std::shared_ptr<Vector<Int64>>& rowMap);
+
+  // Do not apply the selection.
+  void disableApplySelection()
+    { applySelection_p = False; }
+
+  // Apply a selection of rows in the first table.
+  void applySelection (const Vector<rownr_t>& rownrs);
+
+  // Get the row number in the joined table.
+  // An exception is thrown if the row has no match.
+  rownr_t joinRow (const TableExprId& id) const;
+
+  // Get the row numbers in the joined table for a block of rows.
+  Vector<rownr_t> joinRows (const Vector<rownr_t>& rownrs) const;
+
+private:
+  rownr_t mapRow (rownr_t rownr) const;
+
+  std::shared_ptr<Vector<Int64>> rowMap_p;
+  Vector<rownr_t>                selRows_p;
+  Bool                           hasSelection_p;
+  Bool                           applySelection_p;
+};
+
+
+// <summary>
+// Scalar column of a joined table in a table select expression tree
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTableParseJoin">
+// </reviewed>
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> <linkto class=TableParseJoin>TableParseJoin</linkto>
+// </prerequisite>
+// <synopsis>
+// This class represents a scalar column of a table joined in TaQL using
+// JOIN ... ON. It gets the value from the row in the joined table
+// matching the row in the first table.
+// The node behaves as a column node of the first table, so its number of
+// rows is the number of rows in the first table.
+// </synopsis>
+
+class TableExprNodeJoinColumn : public TableExprNodeBinary
+{
+public:
+  // Construct from the column node in the joined table and the row mapping.
+  TableExprNodeJoinColumn (const TENShPtr& column, const Table& table,
+                           const std::shared_ptr<Vector<Int64>>& rowMap);
+  ~TableExprNodeJoinColumn();
+
+  // The node acts as a column node.
+  virtual void getColumnNodes (std::vector<TableExprNodeRep*>& cols);
+  virtual void disableApplySelection();
+  virtual void applySelection (const Vector<rownr_t>& rownrs);
+
+  // It can be evaluated in parallel if its child can.
+  virtual Bool isParallelSafe() const;
+
+  // Get the data type of the column in the joined table.
+  virtual Bool getColumnDataType (DataType&) const;
+
+  virtual Bool     getBool     (const TableExprId& id);
+  virtual Int64    getInt      (const TableExprId& id);
+  virtual Double   getDouble   (const TableExprId& id);
+  virtual DComplex getDComplex (const TableExprId& id);
+  virtual String   getString   (const TableExprId& id);
+  virtual MVTime   getDate     (const TableExprId& id);
+  virtual void getBoolBatch   (const Vector<rownr_t>& rownrs,
+                               Vector<Bool>& values);
+  virtual void getIntBatch    (const Vector<rownr_t>& rownrs,
+                               Vector<Int64>& values);
+  virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                               Vector<Double>& values);
+
+private:
+  TableExprJoinMap map_p;
+};
+
+
+// <summary>
+// Array column of a joined table in a table select expression tree
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTableParseJoin">
+// </reviewed>
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> <linkto class=TableParseJoin>TableParseJoin</linkto>
+// </prerequisite>
+// <synopsis>
+// This class represents an array column of a table joined in TaQL using
+// JOIN ... ON. It gets the array from the row in the joined table
+// matching the row in the first table.
+// </synopsis>
+
+class TableExprNodeArrayJoinColumn : public TableExprNodeArray
+{
+public:
+  // Construct from the column node in the joined table and the row mapping.
+  TableExprNodeArrayJoinColumn (const TENShPtr& column, const Table& table,
+                                const std::shared_ptr<Vector<Int64>>& rowMap);
+  ~TableExprNodeArrayJoinColumn();
+
+  // The node acts as a column node.
+  virtual void getColumnNodes (std::vector<TableExprNodeRep*>& cols);
+  virtual void disableApplySelection();
+  virtual void applySelection (const Vector<rownr_t>& rownrs);
+
+  // It can be evaluated in parallel if its child can.
+  virtual Bool isParallelSafe() const;
+
+  virtual Bool isDefined (const TableExprId& id);
+  virtual const IPosition& getShape (const TableExprId& id);
+
+  virtual MArray<Bool>     getArrayBool     (const TableExprId& id);
+  virtual MArray<Int64>    getArrayInt      (const TableExprId& id);
+  virtual MArray<Double>   getArrayDouble   (const TableExprId& id);
+  virtual MArray<DComplex> getArrayDComplex (const TableExprId& id);
+  virtual MArray<String>   getArrayString   (const TableExprId& id);
+  virtual MArray<MVTime>   getArrayDate     (const TableExprId& id);
+
+  virtual Bool     getElemBool     (const TableExprId& id,
+                                    const Slicer& index);
+  virtual Int64    getElemInt      (const TableExprId& id,
+                                    const Slicer& index);
+  virtual Double   getElemDouble   (const TableExprId& id,
+                                    const Slicer& index);
+  virtual DComplex getElemDComplex (const TableExprId& id,
+                                    const Slicer& index);
+  virtual String   getElemString   (const TableExprId& id,
+                                    const Slicer& index);
+  virtual MVTime   getElemDate     (const TableExprId& id,
+                                    const Slicer& index);
+
+  virtual MArray<Bool>     getSliceBool     (const TableExprId& id,
+                                             const Slicer&);
+  virtual MArray<Int64>    getSliceInt      (const TableExprId& id,
+                                             const Slicer&);
+  virtual MArray<Double>   getSliceDouble   (const TableExprId& id,
+                                             const Slicer&);
+  virtual MArray<DComplex> getSliceDComplex (const TableExprId& id,
+                                             const Slicer&);
+  virtual MArray<String>   getSliceString   (const TableExprId& id,
+                                             const Slicer&);
+  virtual MArray<MVTime>   getSliceDate     (const TableExprId& id,
+                                             const Slicer&);
+
+private:
+  TableExprNodeArray* column_p;     //# the same as lnode_p
+  TableExprJoinMap    map_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
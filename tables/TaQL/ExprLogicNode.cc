@@ -29,15 +29,67 @@
 #include <casacore/tables/TaQL/ExprNodeSetOpt.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Quanta/MVTime.h>
-#include <float.h>                     // for DBL_MAX
-#include <limits.h>                     // for DBL_MAX
+#include <functional>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Evaluate both operands for a block of rows and compare them.
+template<typename T, typename Cmp>
+static void compareBatch (TableExprNodeRep& left, TableExprNodeRep& right,
+                          const Vector<rownr_t>& rownrs, Vector<Bool>& values,
+                          Cmp cmp)
+{
+    Vector<T> lvalues, rvalues;
+    left.getBatch  (rownrs, lvalues);
+    right.getBatch (rownrs, rvalues);
+    size_t n = rownrs.size();
+    values.resize (n);
+    Bool* vec = values.data();
+    const T* lvec = lvalues.data();
+    const T* rvec = rvalues.data();
+    for (size_t i=0; i<n; ++i) {
+        vec[i] = cmp (lvec[i], rvec[i]);
+    }
+}
+
+// Evaluate the right operand of a logical and/or for a block of rows,
+// but only for the rows where the result is not known yet from the
+// left operand (i.e., where the left value differs from skipValue).
+// In this way the same short-circuit behaviour as in getBool is obtained.
+static void logicalBatch (TableExprNodeRep& left, TableExprNodeRep& right,
+                          const Vector<rownr_t>& rownrs, Vector<Bool>& values,
+                          Bool skipValue)
+{
+    left.getBoolBatch (rownrs, values);
+    size_t n = rownrs.size();
+    Bool* vec = values.data();
+    Vector<rownr_t> subrows(n);
+    size_t nsub = 0;
+    for (size_t i=0; i<n; ++i) {
+        if (vec[i] != skipValue) {
+            subrows[nsub++] = rownrs[i];
+        }
+    }
+    if (nsub > 0) {
+        subrows.resize (nsub, True);
+        Vector<Bool> rvalues;
+        right.getBoolBatch (subrows, rvalues);
+        const Bool* rvec = rvalues.data();
+        nsub = 0;
+        for (size_t i=0; i<n; ++i) {
+            if (vec[i] != skipValue) {
+                vec[i] = rvec[nsub++];
+            }
+        }
+    }
+}
+
 // Implement the comparison operators for each data type.
 
 TableExprNodeEQBool::TableExprNodeEQBool (const TableExprNodeRep& node)
@@ -55,6 +107,11 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+void TableExprNodeEQInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values, std::equal_to<Int64>());
+}
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -63,6 +120,11 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+void TableExprNodeEQDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values, std::equal_to<Double>());
+}
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -112,6 +174,11 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+void TableExprNodeNEInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values, std::not_equal_to<Int64>());
+}
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -120,6 +187,11 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+void TableExprNodeNEDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values, std::not_equal_to<Double>());
+}
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -161,6 +233,11 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+void TableExprNodeGTInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values, std::greater<Int64>());
+}
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -169,6 +246,11 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+void TableExprNodeGTDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values, std::greater<Double>());
+}
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -202,6 +284,11 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+void TableExprNodeGEInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values, std::greater_equal<Int64>());
+}
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -210,6 +297,11 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+void TableExprNodeGEDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values, std::greater_equal<Double>());
+}
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -355,6 +447,11 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+void TableExprNodeOR::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                    Vector<Bool>& values)
+{
+    logicalBatch (*lnode_p, *rnode_p, rownrs, values, True);
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -364,6 +461,11 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+void TableExprNodeAND::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                     Vector<Bool>& values)
+{
+    logicalBatch (*lnode_p, *rnode_p, rownrs, values, False);
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -373,55 +475,43 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
-
-
-
-void TableExprNodeEQDouble::ranges (Block<TableExprRange>& blrange)
+void TableExprNodeNOT::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                     Vector<Bool>& values)
 {
-    Double dval = 0;
-    TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        dval = rnode_p->getDouble (0);
-    }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  rnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            dval = lnode_p->getDouble (0);
-        }
+    lnode_p->getBoolBatch (rownrs, values);
+    Bool* vec = values.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; ++i) {
+        vec[i] = !vec[i];
     }
-    //# Now create a range (if possible).
-    //# The cast is harmless, since it is surely that object type.
-    TableExprNodeRep::createRange (blrange,
-                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
-                                   dval, dval);
 }
 
-void TableExprNodeGEDouble::ranges (Block<TableExprRange>& blrange)
+
+
+//# Create the range for a comparison of a scalar column with a constant
+//# (left or right). The range is closed, so for > it is the same as for >=.
+//# If the constant is on the left side, the comparison is mirrored.
+//# An open bound is infinite, so zones containing +-inf are not pruned.
+static void makeCompareRange (Block<TableExprRange>& blrange,
+                              const TENShPtr& lnode, const TENShPtr& rnode,
+                              Bool isEqual)
 {
     Double st = 0;
     Double end = 0;
     TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        st = rnode_p->getDouble (0);
-        end = DBL_MAX;
+    if (lnode->operType()  == TableExprNodeRep::OtColumn
+    &&  lnode->valueType() == TableExprNodeRep::VTScalar
+    &&  rnode->operType()  == TableExprNodeRep::OtLiteral) {
+        tsncol = lnode;
+        st = rnode->getDouble (0);
+        end = (isEqual ? st : std::numeric_limits<Double>::infinity());
     }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  rnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            end = lnode_p->getDouble (0);
-            st = -DBL_MAX;
+        if (rnode->operType()  == TableExprNodeRep::OtColumn
+        &&  rnode->valueType() == TableExprNodeRep::VTScalar
+        &&  lnode->operType()  == TableExprNodeRep::OtLiteral) {
+            tsncol = rnode;
+            end = lnode->getDouble (0);
+            st = (isEqual ? end : -std::numeric_limits<Double>::infinity());
         }
     }
     //# Now create a range (if possible).
@@ -431,36 +521,46 @@ void TableExprNodeGEDouble::ranges (Block<TableExprRange>& blrange)
                                    st, end);
 }
 
+void TableExprNodeEQInt::ranges (Block<TableExprRange>& blrange)
+{
+    makeCompareRange (blrange, lnode_p, rnode_p, True);
+}
+
+void TableExprNodeEQDouble::ranges (Block<TableExprRange>& blrange)
+{
+    makeCompareRange (blrange, lnode_p, rnode_p, True);
+}
+
+void TableExprNodeGEInt::ranges (Block<TableExprRange>& blrange)
+{
+    makeCompareRange (blrange, lnode_p, rnode_p, False);
+}
+
+void TableExprNodeGEDouble::ranges (Block<TableExprRange>& blrange)
+{
+    makeCompareRange (blrange, lnode_p, rnode_p, False);
+}
+
+void TableExprNodeGTInt::ranges (Block<TableExprRange>& blrange)
+{
+    makeCompareRange (blrange, lnode_p, rnode_p, False);
+}
+
 void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 {
-    Double st = 0;
-    Double end = 0;
-    TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        st = rnode_p->getDouble (0);
-        end = DBL_MAX;
-    }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            end = lnode_p->getDouble (0);
-            st = -DBL_MAX;
-        }
-    }
-    //# Now create a range (if possible).
-    //# The cast is harmless, since it is surely that object type.
-    TableExprNodeRep::createRange (blrange,
-                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
-                                   st, end);
+    makeCompareRange (blrange, lnode_p, rnode_p, False);
 }
 
 
+//# Test if two range columns are the same column of the same table.
+//# Columns with equal names can be in different tables (e.g. t1.TIME and
+//# t2.TIME), so their ranges cannot be combined.
+static Bool isSameColumn (const TableColumn& left, const TableColumn& right)
+{
+    return left.columnDesc().name() == right.columnDesc().name()
+       &&  left.table().isSameRoot (right.table());
+}
+
 //# Or two blocks of ranges.
 void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
 {
@@ -476,8 +576,7 @@ void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
     size_t nr=0;
     for (size_t i=0; i<left.nelements(); i++) {
         for (size_t j=0; j<right.nelements(); j++) {
-            if (right[j].getColumn().columnDesc().name() ==
-                                left[i].getColumn().columnDesc().name()) {
+            if (isSameColumn (right[j].getColumn(), left[i].getColumn())) {
                 blrange.resize(nr+1, True);
                 blrange[nr] = left[i];
                 blrange[nr].mixOr (right[j]);
@@ -511,8 +610,7 @@ void TableExprNodeAND::ranges (Block<TableExprRange>& blrange)
     vec = 0;
     for (size_t i=0; i<blrange.nelements(); i++) {
         for (size_t j=0; j<other.nelements(); j++) {
-            if (other[j].getColumn().columnDesc().name() ==
-                                blrange[i].getColumn().columnDesc().name()) {
+            if (isSameColumn (other[j].getColumn(), blrange[i].getColumn())) {
                 blrange[i].mixAnd (other[j]);
                 vec(j) = 1;
             }
@@ -104,6 +104,9 @@ public:
     TableExprNodeEQInt (const TableExprNodeRep&);
     ~TableExprNodeEQInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -134,6 +137,8 @@ public:
     TableExprNodeEQDouble (const TableExprNodeRep&);
     ~TableExprNodeEQDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -316,6 +321,8 @@ public:
     TableExprNodeNEInt (const TableExprNodeRep&);
     ~TableExprNodeNEInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
 };
 
 
@@ -346,6 +353,8 @@ public:
     TableExprNodeNEDouble (const TableExprNodeRep&);
     ~TableExprNodeNEDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
 };
 
 
@@ -497,6 +506,9 @@ public:
     TableExprNodeGTInt (const TableExprNodeRep&);
     ~TableExprNodeGTInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -527,6 +539,8 @@ public:
     TableExprNodeGTDouble (const TableExprNodeRep&);
     ~TableExprNodeGTDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -649,6 +663,9 @@ public:
     TableExprNodeGEInt (const TableExprNodeRep&);
     ~TableExprNodeGEInt() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
+    void ranges (Block<TableExprRange>&) override;
 };
 
 
@@ -679,6 +696,8 @@ public:
     TableExprNodeGEDouble (const TableExprNodeRep&);
     ~TableExprNodeGEDouble() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -966,6 +985,8 @@ public:
     TableExprNodeOR (const TableExprNodeRep&);
     ~TableExprNodeOR() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -995,6 +1016,8 @@ public:
     TableExprNodeAND (const TableExprNodeRep&);
     ~TableExprNodeAND() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
     void ranges (Block<TableExprRange>&) override;
 };
 
@@ -1024,6 +1047,8 @@ public:
     TableExprNodeNOT (const TableExprNodeRep&);
     ~TableExprNodeNOT() = default;
     Bool getBool (const TableExprId& id) override;
+    void getBoolBatch (const Vector<rownr_t>& rownrs,
+                       Vector<Bool>& values) override;
 };
 
 
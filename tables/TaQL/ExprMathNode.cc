@@ -30,9 +30,27 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Quanta/MVTime.h>
 #include <casacore/casa/BasicMath/Math.h>
+#include <functional>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Evaluate both operands for a block of rows and combine them.
+template<typename T, typename Op>
+static void binaryBatch (TableExprNodeRep& left, TableExprNodeRep& right,
+                         const Vector<rownr_t>& rownrs, Vector<T>& values,
+                         Op oper)
+{
+    Vector<T> rvalues;
+    left.getBatch  (rownrs, values);
+    right.getBatch (rownrs, rvalues);
+    T* vec = values.data();
+    const T* rvec = rvalues.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; ++i) {
+        vec[i] = oper (vec[i], rvec[i]);
+    }
+}
+
 // Implement the arithmetic operators for each data type.
 
 TableExprNodePlus::TableExprNodePlus (NodeDataType dt,
@@ -53,6 +71,9 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+void TableExprNodePlusInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Int64>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::plus<Int64>()); }
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -63,6 +84,9 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+void TableExprNodePlusDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                              Vector<Double>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::plus<Double>()); }
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -125,6 +149,9 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+void TableExprNodeMinusInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Int64>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::minus<Int64>()); }
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -143,6 +170,9 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+void TableExprNodeMinusDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                               Vector<Double>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::minus<Double>()); }
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -198,6 +228,9 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+void TableExprNodeTimesInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Int64>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::multiplies<Int64>()); }
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -208,6 +241,9 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+void TableExprNodeTimesDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                               Vector<Double>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::multiplies<Double>()); }
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -264,6 +300,9 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+void TableExprNodeDivideDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                                Vector<Double>& values)
+    { binaryBatch (*lnode_p, *rnode_p, rownrs, values, std::divides<Double>()); }
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
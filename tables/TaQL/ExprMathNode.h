@@ -103,6 +103,7 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
 };
 
 
@@ -135,6 +136,7 @@ public:
     ~TableExprNodePlusDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 };
 
 
@@ -291,6 +293,7 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
 };
 
 
@@ -323,6 +326,7 @@ public:
     virtual void handleUnits();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 };
 
 
@@ -446,6 +450,7 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
 };
 
 
@@ -477,6 +482,7 @@ public:
     ~TableExprNodeTimesDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 };
 
 
@@ -567,6 +573,7 @@ public:
     ~TableExprNodeDivideDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values);
 };
 
 
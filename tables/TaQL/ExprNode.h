@@ -341,6 +341,20 @@ public:
     Array<DComplex> getArrayDComplex (const TableExprId& id) const;
     Array<String>   getArrayString   (const TableExprId& id) const;
     Array<MVTime>   getArrayDate     (const TableExprId& id) const;
+    // </group>
+
+    // Get the scalar values for a block of rows.
+    // This evaluates the expression tree a block at a time instead of
+    // row by row, which is much faster for large tables.
+    // <group>
+    void getBoolBatch   (const Vector<rownr_t>& rownrs,
+                         Vector<Bool>& values) const;
+    void getIntBatch    (const Vector<rownr_t>& rownrs,
+                         Vector<Int64>& values) const;
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values) const;
+    // </group>
+
     // Get a value as an array, even it it is a scalar.
     // This is useful in case one can give an argument as scalar or array.
     // <group>
@@ -352,8 +366,6 @@ public:
     MArray<MVTime>   getDateAS     (const TableExprId& id) const;
     // </group>
 
-    // </group>
-
     // Get the data type for doing a getColumn on the expression.
     // This is the data type of the column if the expression
     // consists of a single column only.
@@ -634,6 +646,15 @@ inline MVTime TableExprNode::getDate (const TableExprId& id) const
     { return node_p->getDate (id); }
 inline String TableExprNode::getString (const TableExprId& id) const
     { return node_p->getString (id); }
+inline void TableExprNode::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Bool>& values) const
+    { node_p->getBoolBatch (rownrs, values); }
+inline void TableExprNode::getIntBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Int64>& values) const
+    { node_p->getIntBatch (rownrs, values); }
+inline void TableExprNode::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                           Vector<Double>& values) const
+    { node_p->getDoubleBatch (rownrs, values); }
 inline Array<Bool> TableExprNode::getArrayBool (const TableExprId& id) const
     { return node_p->getArrayBool (id).array(); }
 inline Array<Int64> TableExprNode::getArrayInt (const TableExprId& id) const
@@ -1002,6 +1002,16 @@ Array<Float> TableExprNodeArrayColumnFloat::getElemColumnFloat
 {
     return col_p.getColumnCells (rownrs, index);
 }
+const Array<Float>& TableExprNodeArrayColumnFloat::getArrayBuffer
+                                                     (const TableExprId& id)
+{
+  if (tabCol_p.isDefined (id.rownr())) {
+    col_p.get (id.rownr(), buf_p, True);
+  } else {
+    buf_p.resize();
+  }
+  return buf_p;
+}
 
 TableExprNodeArrayColumnDouble::TableExprNodeArrayColumnDouble
                                            (const TableColumn& col,
@@ -1046,6 +1056,16 @@ Array<Double> TableExprNodeArrayColumnDouble::getElemColumnDouble
 {
     return col_p.getColumnCells (rownrs, index);
 }
+const Array<Double>& TableExprNodeArrayColumnDouble::getArrayBuffer
+                                                     (const TableExprId& id)
+{
+  if (tabCol_p.isDefined (id.rownr())) {
+    col_p.get (id.rownr(), buf_p, True);
+  } else {
+    buf_p.resize();
+  }
+  return buf_p;
+}
 
 TableExprNodeArrayColumnComplex::TableExprNodeArrayColumnComplex
                                            (const TableColumn& col,
@@ -1097,6 +1117,16 @@ Array<Complex> TableExprNodeArrayColumnComplex::getElemColumnComplex
 {
     return col_p.getColumnCells (rownrs, index);
 }
+const Array<Complex>& TableExprNodeArrayColumnComplex::getArrayBuffer
+                                                     (const TableExprId& id)
+{
+  if (tabCol_p.isDefined (id.rownr())) {
+    col_p.get (id.rownr(), buf_p, True);
+  } else {
+    buf_p.resize();
+  }
+  return buf_p;
+}
 
 TableExprNodeArrayColumnDComplex::TableExprNodeArrayColumnDComplex
                                            (const TableColumn& col,
@@ -1142,6 +1172,16 @@ Array<DComplex> TableExprNodeArrayColumnDComplex::getElemColumnDComplex
 {
     return col_p.getColumnCells (rownrs, index);
 }
+const Array<DComplex>& TableExprNodeArrayColumnDComplex::getArrayBuffer
+                                                     (const TableExprId& id)
+{
+  if (tabCol_p.isDefined (id.rownr())) {
+    col_p.get (id.rownr(), buf_p, True);
+  } else {
+    buf_p.resize();
+  }
+  return buf_p;
+}
 
 TableExprNodeArrayColumnString::TableExprNodeArrayColumnString
                                            (const TableColumn& col,
@@ -554,8 +554,15 @@ public:
                                           const Slicer&);
     virtual Array<Float>  getElemColumnFloat (const Vector<rownr_t>& rownrs,
                                               const Slicer&);
+    // Read the array in the given row into a buffer that is reused for
+    // all rows, thus without creating (and converting) an array per row.
+    // An empty array is returned if the row does not contain an array.
+    // <br>It is meant for the array aggregate functions which use the
+    // values before the next row is read.
+    const Array<Float>& getArrayBuffer (const TableExprId& id);
 protected:
     ArrayColumn<Float> col_p;
+    Array<Float>       buf_p;
 };
 
 
@@ -593,8 +600,12 @@ public:
                                           const Slicer&);
     virtual Array<Double> getElemColumnDouble (const Vector<rownr_t>& rownrs,
                                                const Slicer&);
+    // Read the array in the given row into a buffer reused for all rows.
+    // See class TableExprNodeArrayColumnFloat.
+    const Array<Double>& getArrayBuffer (const TableExprId& id);
 protected:
     ArrayColumn<Double> col_p;
+    Array<Double>       buf_p;
 };
 
 
@@ -632,8 +643,12 @@ public:
                                               const Slicer&);
     virtual Array<Complex>  getElemColumnComplex (const Vector<rownr_t>& rownrs,
                                                   const Slicer&);
+    // Read the array in the given row into a buffer reused for all rows.
+    // See class TableExprNodeArrayColumnFloat.
+    const Array<Complex>& getArrayBuffer (const TableExprId& id);
 protected:
     ArrayColumn<Complex> col_p;
+    Array<Complex>       buf_p;
 };
 
 
@@ -671,8 +686,12 @@ public:
                                               const Slicer&);
     virtual Array<DComplex> getElemColumnDComplex (const Vector<rownr_t>& rownrs,
                                                    const Slicer&);
+    // Read the array in the given row into a buffer reused for all rows.
+    // See class TableExprNodeArrayColumnFloat.
+    const Array<DComplex>& getArrayBuffer (const TableExprId& id);
 protected:
     ArrayColumn<DComplex> col_p;
+    Array<DComplex>       buf_p;
 };
 
 
@@ -41,6 +41,8 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+const rownr_t TableExprNodeRep::BatchSize;
+
 // The constructor to be used by the derived classes.
 TableExprNodeRep::TableExprNodeRep (NodeDataType dtype, ValueType vtype,
                                     OperType optype,
@@ -113,6 +115,11 @@ void TableExprNodeRep::getAggrNodes (vector<TableExprNodeRep*>&)
 void TableExprNodeRep::getColumnNodes (vector<TableExprNodeRep*>&)
 {}
 
+Bool TableExprNodeRep::isParallelSafe() const
+{
+  return False;
+}
+
 void TableExprNodeRep::checkAggrFuncs()
 {
   vector<TableExprNodeRep*> aggr;
@@ -344,6 +351,53 @@ MArray<MVTime> TableExprNodeRep::getDateAS (const TableExprId& id)
   return MArray<MVTime>(res);
 }
 
+void TableExprNodeRep::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                     Vector<Bool>& values)
+{
+  TableExprId id;
+  rownr_t nrrow = rownrs.size();
+  values.resize (nrrow);
+  Bool* vec = values.data();
+  for (rownr_t i=0; i<nrrow; i++) {
+    id.setRownr (rownrs[i]);
+    vec[i] = getBool (id);
+  }
+}
+void TableExprNodeRep::getIntBatch (const Vector<rownr_t>& rownrs,
+                                    Vector<Int64>& values)
+{
+  TableExprId id;
+  rownr_t nrrow = rownrs.size();
+  values.resize (nrrow);
+  Int64* vec = values.data();
+  for (rownr_t i=0; i<nrrow; i++) {
+    id.setRownr (rownrs[i]);
+    vec[i] = getInt (id);
+  }
+}
+void TableExprNodeRep::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Double>& values)
+{
+  rownr_t nrrow = rownrs.size();
+  values.resize (nrrow);
+  Double* vec = values.data();
+  // An integer node can be evaluated as a whole and converted.
+  if (dtype_p == NTInt) {
+    Vector<Int64> ivalues;
+    getIntBatch (rownrs, ivalues);
+    const Int64* ivec = ivalues.data();
+    for (rownr_t i=0; i<nrrow; i++) {
+      vec[i] = ivec[i];
+    }
+    return;
+  }
+  TableExprId id;
+  for (rownr_t i=0; i<nrrow; i++) {
+    id.setRownr (rownrs[i]);
+    vec[i] = getDouble (id);
+  }
+}
+
 Bool TableExprNodeRep::contains (const TableExprId& id, Bool value)
 {
     return (value == getBool(id));
@@ -693,6 +747,39 @@ void TableExprNodeBinary::getColumnNodes (vector<TableExprNodeRep*>& cols)
   }
 }
 
+Bool TableExprNodeBinary::isParallelSafe() const
+{
+  if (vtype_p != VTScalar) {
+    return False;
+  }
+  switch (optype_p) {
+  case OtPlus:
+  case OtMinus:
+  case OtTimes:
+  case OtDivide:
+  case OtModulo:
+  case OtBitAnd:
+  case OtBitOr:
+  case OtBitXor:
+  case OtBitNegate:
+  case OtEQ:
+  case OtGE:
+  case OtGT:
+  case OtNE:
+  case OtAND:
+  case OtOR:
+  case OtNOT:
+  case OtMIN:
+  case OtLiteral:
+  case OtColumn:
+    break;
+  default:
+    return False;
+  }
+  return (!lnode_p  ||  lnode_p->isParallelSafe())  &&
+         (!rnode_p  ||  rnode_p->isParallelSafe());
+}
+
 // Check the datatypes and get the common one.
 // For use with operands.
 TableExprNodeRep::NodeDataType TableExprNodeBinary::getDT
@@ -248,6 +248,12 @@ public:
     // Get the nodes representing a table column.
     virtual void getColumnNodes (std::vector<TableExprNodeRep*>& cols);
   
+    // Can the expression be evaluated by multiple threads at the same time
+    // (for different rows)? It is only true if the node and all its
+    // children have no state changing during evaluation.
+    // The default implementation returns False.
+    virtual Bool isParallelSafe() const;
+
     // Create the correct immediate aggregate function object.
     // The default implementation throws an exception, because it should
     // only be called for TableExprAggrNode(Array).
@@ -324,6 +330,36 @@ public:
     MArray<MVTime> getDateAS       (const TableExprId& id);
     // </group>
 
+    // The number of rows a select or update evaluates at a time
+    // using the batch get functions.
+    static const rownr_t BatchSize = 4096;
+
+    // Get the scalar values of this node for a block of rows.
+    // The result vector is resized to the number of rows if needed.
+    // The default implementation evaluates the rows one by one using
+    // the get functions above. Derived classes for columns, constants,
+    // arithmetic and logical operators evaluate the block as a whole
+    // (reading the columns with getColumnCells), which avoids the
+    // virtual function call per row.
+    // <group>
+    virtual void getBoolBatch   (const Vector<rownr_t>& rownrs,
+                                 Vector<Bool>& values);
+    virtual void getIntBatch    (const Vector<rownr_t>& rownrs,
+                                 Vector<Int64>& values);
+    virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Vector<Double>& values);
+    // </group>
+
+    // General batch get functions for template purposes.
+    // <group>
+    void getBatch (const Vector<rownr_t>& rownrs, Vector<Bool>& values)
+      { getBoolBatch (rownrs, values); }
+    void getBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values)
+      { getIntBatch (rownrs, values); }
+    void getBatch (const Vector<rownr_t>& rownrs, Vector<Double>& values)
+      { getDoubleBatch (rownrs, values); }
+    // </group>
+
     // Does a set or array contain the value?
     // The default implementation assumes the set is a single scalar,
     // thus tests if it is equal to the given value.
@@ -573,6 +609,10 @@ public:
     // Get the nodes representing a table column.
     virtual void getColumnNodes (std::vector<TableExprNodeRep*>& cols);
   
+    // Scalar arithmetic, comparison and logical operators, literals and
+    // columns can be evaluated in parallel if their children can.
+    virtual Bool isParallelSafe() const;
+
     // Check the data types and get the common one.
     static NodeDataType getDT (NodeDataType leftDtype,
                                NodeDataType rightDype,
@@ -124,6 +124,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return iter->second;
   }
 
+  template<typename T>
+  std::vector<T> TableExprNodeSetOptUSet<T>::values() const
+  {
+    std::vector<T> vals;
+    vals.reserve (itsMap.size());
+    for (const auto& elem : itsMap) {
+      vals.push_back (elem.first);
+    }
+    return vals;
+  }
+
 
 
   template<typename T>
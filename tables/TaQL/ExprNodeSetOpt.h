@@ -30,6 +30,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNodeRep.h>
 #include <unordered_map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -130,6 +131,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Where does a value occur in the set? -1 is no match.
     Int64 find (T value) const override;
 
+    // Get the values in the set (in arbitrary order).
+    std::vector<T> values() const;
+
   private:
     std::unordered_map<T,Int64> itsMap;
   };
@@ -61,7 +61,7 @@ class TableColumn;
 // TableExprRange holds the ranges of values for a column as specified
 // in a table select expression.
 // It traverses the expression tree and composes the hull of the values.
-// Only double values are taken into account.
+// Only numeric values are taken into account (converted to double).
 // It can handle operators &&, ||, ==, >, >=, <, <=, !.
 // It can handle a comparison operator only for a column with a constant.
 // Other operators and expressions are non-convertable.
@@ -74,7 +74,8 @@ class TableColumn;
 // <motivation>
 // TableExprRange gives great possibilities in optimizing a table
 // selection. It allows to get a rough estimate of the values needed
-// for a column which can be used to do a fast preselect using an index.
+// for a column which can be used to do a fast preselect using an index
+// or using the zone maps kept by a storage manager.
 // </motivation>
 
 // <todo asof="$DATE:$">
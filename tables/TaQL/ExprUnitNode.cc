@@ -140,6 +140,16 @@ Double TableExprNodeUnit::getDouble (const TableExprId& id)
 DComplex TableExprNodeUnit::getDComplex (const TableExprId& id)
   { return factor_p * lnode_p->getDComplex(id); }
 
+Bool TableExprNodeUnit::isParallelSafe() const
+  { return lnode_p->isParallelSafe(); }
+
+void TableExprNodeUnit::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Double>& values)
+{
+  lnode_p->getDoubleBatch (rownrs, values);
+  values *= factor_p;
+}
+
 
 
 
@@ -89,8 +89,13 @@ public:
   // Get the unit factor.
   virtual Double getUnitFactor() const;
 
+  // It can be evaluated in parallel if its child can.
+  virtual Bool isParallelSafe() const;
+
   virtual Double   getDouble   (const TableExprId& id);
   virtual DComplex getDComplex (const TableExprId& id);
+  virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                               Vector<Double>& values);
 private:
   Double factor_p;
 };
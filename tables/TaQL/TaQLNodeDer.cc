@@ -727,7 +727,7 @@ void TaQLJoinNodeRep::show (std::ostream& os) const
     itsTables.show (os);
     os << ' ';
   }
-  os << "ON CONDITION ";
+  os << "ON ";
   itsCondition.show (os);
 }
 void TaQLJoinNodeRep::save (AipsIO& aio) const
@@ -385,8 +385,8 @@ public:
 //   <li> <linkto class=TaQLNodeRep>TaQLNodeRep</linkto>
 // </prerequisite>
 // <synopsis> 
-// This class is a TaQLNodeRep holding the expressions of a join operation.
-// This is, however, a placeholder and not implemented yet.
+// This class is a TaQLNodeRep holding the table and condition of a join
+// operation (<src>JOIN table ON condition</src>).
 // </synopsis> 
 
 class TaQLJoinNodeRep: public TaQLNodeRep
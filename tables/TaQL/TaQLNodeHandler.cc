@@ -50,6 +50,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 
 
+  TaQLNodeHandler::TaQLNodeHandler()
+    : itsExplain (False)
+  {}
+
   TaQLNodeHandler::~TaQLNodeHandler()
   {
     clearStack();
@@ -386,12 +390,52 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return TaQLNodeResult();
   }
 
-  TaQLNodeResult TaQLNodeHandler::visitJoinNode (const TaQLJoinNodeRep&)
+  TaQLNodeResult TaQLNodeHandler::visitJoinNode (const TaQLJoinNodeRep& node)
   {
-    throw TableInvExpr ("join is not supported yet");
+    const std::vector<TaQLNode>& nodes = node.itsTables.getMultiRep()->itsNodes;
+    if (nodes.size() != 1) {
+      throw TableInvExpr ("Exactly one table has to be given in a JOIN");
+    }
+    // The joined table is part of the FROM list, so its shorthand can be used.
+    TaQLNodeResult result = visitNode (nodes[0]);
+    const TaQLNodeHRValue& res = getHR(result);
+    Table table = topStack()->tableList().addTable (res.getInt(),
+                                                    res.getString(),
+                                                    res.getTable(),
+                                                    res.getAlias(),
+                                                    True, itsTempTables,
+                                                    itsStack);
+    TableParseJoin& join = topStack()->addJoin (table, res.getAlias());
+    // Get the operands of the AND-ed equality comparisons in the condition.
+    std::vector<TableExprNode> left, right;
+    handleJoinCond (node.itsCondition, left, right);
+    join.setCondition (left, right);
     return TaQLNodeResult();
   }
 
+  void TaQLNodeHandler::handleJoinCond (const TaQLNode& node,
+                                        std::vector<TableExprNode>& left,
+                                        std::vector<TableExprNode>& right)
+  {
+    if (node.nodeType() == TaQLNode_Binary) {
+      const TaQLBinaryNodeRep& bin =
+        *dynamic_cast<const TaQLBinaryNodeRep*>(node.getRep());
+      if (bin.itsType == TaQLBinaryNodeRep::B_AND) {
+        handleJoinCond (bin.itsLeft, left, right);
+        handleJoinCond (bin.itsRight, left, right);
+        return;
+      } else if (bin.itsType == TaQLBinaryNodeRep::B_EQ) {
+        TaQLNodeResult lres = visitNode (bin.itsLeft);
+        TaQLNodeResult rres = visitNode (bin.itsRight);
+        left.push_back  (getHR(lres).getExpr());
+        right.push_back (getHR(rres).getExpr());
+        return;
+      }
+    }
+    throw TableInvExpr ("A JOIN condition must consist of one or more "
+                        "AND-ed equality comparisons");
+  }
+
   TaQLNodeResult TaQLNodeHandler::visitGroupNode (const TaQLGroupNodeRep& node)
   {
     const TaQLMultiNodeRep* keys = node.itsNodes.getMultiRep();
@@ -511,6 +555,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Add an entry to the stack.
     Bool outer = itsStack.empty();
     TableParseQuery* curSel = pushStack (TableParseQuery::PSELECT);
+    curSel->setNThreads (node.style().nthreads());
+    curSel->setUseIndex (node.style().useIndex(), node.style().makeIndex());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -529,7 +575,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Furthermore, handle GIVING first, because projection needs to know
     // the resulting table name.
     visitNode     (node.itsGiving);
-    visitNode     (node.itsJoin);
+    handleJoins   (node.itsJoin);
     handleWhere   (node.itsWhere);
     visitNode     (node.itsGroupby);
     visitNode     (node.itsColumns);
@@ -538,7 +584,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     if (! node.getNoExecute()) {
-      if (outer) {
+      if (outer  &&  itsExplain) {
+        itsExplainInfo = curSel->explain();
+      } else if (outer) {
         curSel->execute (node.style().doTiming(), False, False, 0,
                          node.style().doTracing(), itsTempTables, itsStack);
         hrval->setTable (curSel->getTable());
@@ -560,6 +608,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitUpdateNode (const TaQLUpdateNodeRep& node)
   {
     TableParseQuery* curSel = pushStack (TableParseQuery::PUPDATE);
+    curSel->setNThreads (node.style().nthreads());
+    curSel->setUseIndex (node.style().useIndex(), node.style().makeIndex());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -570,6 +620,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
+    if (itsExplain) {
+      itsExplainInfo = curSel->explain();
+      popStack();
+      return TaQLNodeResult(new TaQLNodeHRValue());
+    }
     curSel->execute (node.style().doTiming(), False, True, 0);
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
@@ -620,11 +675,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitDeleteNode (const TaQLDeleteNodeRep& node)
   {
     TableParseQuery* curSel = pushStack (TableParseQuery::PDELETE);
+    curSel->setNThreads (node.style().nthreads());
+    curSel->setUseIndex (node.style().useIndex(), node.style().makeIndex());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     handleWhere   (node.itsWhere);
     visitNode     (node.itsSort);
     visitNode     (node.itsLimitOff);
+    if (itsExplain) {
+      itsExplainInfo = curSel->explain();
+      popStack();
+      return TaQLNodeResult(new TaQLNodeHRValue());
+    }
     curSel->execute (node.style().doTiming(), False, True, 0);
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
@@ -638,6 +700,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     Bool outer = itsStack.empty();
     TableParseQuery* curSel = pushStack (TableParseQuery::PCOUNT);
+    curSel->setNThreads (node.style().nthreads());
+    curSel->setUseIndex (node.style().useIndex(), node.style().makeIndex());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     visitNode     (node.itsColumns);
@@ -646,7 +710,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
     TaQLNodeResult res(hrval);
     AlwaysAssert (! node.getNoExecute(), AipsError);
-    if (outer) {
+    if (outer  &&  itsExplain) {
+      itsExplainInfo = curSel->explain();
+    } else if (outer) {
       curSel->execute (node.style().doTiming(), False, True, 0);
       hrval->setTable (curSel->getTable());
       Block<String> block = curSel->getColumnNames();
@@ -1024,6 +1090,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         info = curSel->getTableInfo (parts, node.style());
         doInfo = False;
         popStack();
+      } else if (parts[0] == "explain"  &&  nodes.size() > 1) {
+        // Parse the query and tell how its WHERE would be done.
+        TaQLNodeResult result = visitNode (nodes[1]);
+        parts[1] = getHR(result).getExpr().getString(0);
+        TaQLNodeHandler handler;
+        handler.itsExplain = True;
+        handler.handleTree (TaQLNode::parse(parts[1]), itsTempTables);
+        if (handler.itsExplainInfo.empty()) {
+          throw TableInvExpr ("show explain can only be used for a "
+                              "SELECT, COUNT, UPDATE or DELETE command");
+        }
+        info = "\n" + handler.itsExplainInfo;
+        doInfo = False;
       } else {
         for (uInt i=1; i<nodes.size(); ++i) {
           TaQLNodeResult result = visitNode (nodes[i]);
@@ -1081,6 +1160,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return TaQLNodeResult (new TaQLNodeHRValue());
   }
   
+  void TaQLNodeHandler::handleJoins (const TaQLNode& node)
+  {
+    if (node.isValid()) {
+      AlwaysAssert (node.nodeType() == TaQLNode_Multi, AipsError);
+      const TaQLMultiNodeRep& joins =
+        *dynamic_cast<const TaQLMultiNodeRep*>(node.getRep());
+      for (const TaQLNode& join : joins.itsNodes) {
+        visitNode (join);
+      }
+    }
+  }
+
   void TaQLNodeHandler::handleWhere (const TaQLNode& node)
   {
     if (node.isValid()) {
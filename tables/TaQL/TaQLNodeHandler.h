@@ -95,6 +95,8 @@ class TaQLNodeHRValue;
 class TaQLNodeHandler : public TaQLNodeVisitor
 {
 public:
+  TaQLNodeHandler();
+
   virtual ~TaQLNodeHandler();
 
   // Handle and process the raw parse tree.
@@ -174,6 +176,13 @@ private:
   // Make a ConcatTable from a nested set of tables.
   Table makeConcatTable (const TaQLMultiNodeRep& node);
 
+  // Handle the JOIN clauses.
+  void handleJoins (const TaQLNode&);
+
+  // Get the operands of the AND-ed equality comparisons in a JOIN condition.
+  void handleJoinCond (const TaQLNode&, std::vector<TableExprNode>& left,
+                       std::vector<TableExprNode>& right);
+
   // Handle the WHERE clause.
   void handleWhere (const TaQLNode&);
 
@@ -204,6 +213,9 @@ private:
   std::vector<TableParseQuery*> itsStack;
   //# The temporary tables referred to by $i in the TaQL string.
   std::vector<const Table*> itsTempTables;
+  //# Only explain the WHERE of a query (for 'show explain')?
+  Bool   itsExplain;
+  String itsExplainInfo;
 };
 
 
@@ -58,6 +58,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   const char* infoHelp[] = {
     "Possible show/help commands:",
     "  show table tablename              table information (a la showtableinfo)",
+    "  show explain 'command'            how the WHERE of a command is done",
     "  show command(s) [command]         TaQL commands and their syntax",
     "  show expr(essions)                how to form an expression",
     "  show oper(ators)                  available operators",
@@ -96,10 +97,32 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "      recur   norecur   show subtables recursively?"
   };
 
+  const char* explainHelp[] = {
+    "Usage:   show explain 'command'",
+    "  Show how the WHERE clause of a SELECT, COUNT, UPDATE or DELETE command",
+    "  is done without executing the command.",
+    "  The AND-ed predicates col==const, col IN [const,...] and col<const",
+    "  (or >, <=, >=) on integer and string columns can be served from an",
+    "  index on the column. By default an existing persistent column index",
+    "  is used; the remaining predicates are only evaluated for the rows",
+    "  found using the indices. The style can be set in the command:",
+    "    using style noindex     do not use indices",
+    "    using style makeindex   make missing indices (persistent if possible)",
+    "  For example:",
+    "    show explain 'using style makeindex select from my.ms",
+    "                  where ANTENNA1 in [1,2] and DATA_DESC_ID==0'",
+    "  It also shows how the JOINs of a SELECT are done. A JOIN condition",
+    "  consists of AND-ed equality comparisons of an expression of the",
+    "  joined table and an expression of the other tables. The keys of the",
+    "  smaller of both tables are put in a hash table. For example:",
+    "    show explain 'select t1.TIME, t2.NAME from my.ms t1",
+    "                  join my.ms::FIELD t2 on t1.FIELD_ID == t2.rowid()'"
+  };
+
   const char* commandHelp[] = {
     "Select a subset from a table, possibly calculating new values.",
     "  SELECT [[DISTINCT] expression_list] [INTO table [AS options]]",
-    "    [FROM table_list] [WHERE expression]",
+    "    [FROM table_list [JOIN table ON condition ...]] [WHERE expression]",
     "    [GROUPBY expression_list] [HAVING expression]",
     "    [ORDERBY [DISTINCT] sort_list] [LIMIT expression] [OFFSET expression]",
     "    [GIVING table [AS options] | set] [DMINFO datamanagers]",
@@ -1100,6 +1123,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     type.downcase();
     if (cmd == "table") {
       return showTable (parts);
+    } else if (cmd == "explain") {
+      return getHelp (explainHelp);
     } else if (cmd == "command"  ||  cmd == "commands") {
       return showCommand (type);
     } else if (cmd == "expr"  ||  cmd == "expression") {
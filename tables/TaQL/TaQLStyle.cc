@@ -28,6 +28,8 @@
 #include <casacore/tables/TaQL/TaQLStyle.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <cctype>
+#include <cstdlib>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -37,7 +39,10 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsNThreads  (1),
+    itsUseIndex  (True),
+    itsMakeIndex (False)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -75,6 +80,15 @@ void TaQLStyle::set (const String& value)
     itsDoTracing = True;
   } else if (val == "NOTRACE") {
     itsDoTracing = False;
+  } else if (val == "USEINDEX") {
+    itsUseIndex  = True;
+    itsMakeIndex = False;
+  } else if (val == "NOINDEX") {
+    itsUseIndex  = False;
+    itsMakeIndex = False;
+  } else if (val == "MAKEINDEX") {
+    itsUseIndex  = True;
+    itsMakeIndex = True;
   } else {
     throw TableError(value + " is an invalid TaQL STYLE value");
   }
@@ -85,6 +99,9 @@ void TaQLStyle::reset()
   set ("GLISH");
   itsDoTiming  = False;
   itsDoTracing = False;
+  itsNThreads  = 1;
+  itsUseIndex  = True;
+  itsMakeIndex = False;
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
@@ -101,6 +118,23 @@ void TaQLStyle::defineSynonym (const String& command)
                  trim(String(cmd.after(pos))));
 }
 
+void TaQLStyle::setKeyValue (const String& command)
+{
+  String cmd(command);  // to make it non-const
+  String::size_type pos = cmd.find ('=');
+  AlwaysAssert (pos != String::npos, AipsError);
+  String key = downcase (trim(String(cmd.before(pos))));
+  String value = trim(String(cmd.after(pos)));
+  if (key == "threads") {
+    if (value.empty()  ||  !isdigit(value[0])) {
+      throw TableError(value + " is an invalid TaQL STYLE threads value");
+    }
+    itsNThreads = atoi (value.c_str());
+  } else {
+    defineSynonym (key, value);
+  }
+}
+
 String TaQLStyle::findSynonym (const String& synonym) const
 {
   map<String,String>::const_iterator it = itsUDFLibNameMap.find (synonym);
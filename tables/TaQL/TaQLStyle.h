@@ -56,6 +56,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // The class is also used to tell the TaQL execution engine if timings
 // or tracing of the various parts of the TaQL command need to be done.
 //
+// It also tells the number of threads to use when evaluating the
+// expressions in WHERE and SELECT and when grouping the rows in GROUPBY.
+// It is set using 'threads=n' where
+// n=0 means using all cores (as given by OMP_NUM_THREADS). A single thread
+// is used if a table cannot be read concurrently (e.g., if it uses
+// AutoLocking; see Table::setConcurrentRead).
+//
+// Furthermore it tells if column indices can be used in a WHERE.
+// By default an existing persistent index is used (USEINDEX). NOINDEX
+// means that no index is used, while MAKEINDEX means that missing indices
+// are made (and made persistent if possible).
+//
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
 // (or even 'mc') can be defined for it.
@@ -64,15 +76,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TaQLStyle
 {
 public:
-  // Default style is Glish and no timing/tracing.
+  // Default style is Glish, no timing/tracing, and a single thread.
   explicit TaQLStyle (uInt origin=1);
 
-  // Reset to the default Glish style and no timing/tracing.
+  // Reset to the default Glish style, no timing/tracing, and a single thread.
   void reset();
 
   // Set the style according to the (case-insensitive) value.
   // Possible values are Glish, Python, Base0, Base1, FortranOrder, Corder,
-  // InclEnd, and ExclEnd.
+  // InclEnd, ExclEnd, Time, NoTime, Trace, NoTrace, UseIndex, NoIndex,
+  // and MakeIndex.
   void set (const String& value);
 
   // Define a UDF library name synonym.
@@ -85,6 +98,11 @@ public:
   // Set a synonym using a command like 'synonym = udflibname'.
   void defineSynonym (const String& command);
 
+  // Handle a command like 'key = value'.
+  // If the key is 'threads', the value gives the number of threads to use.
+  // Otherwise it defines a UDF library name synonym.
+  void setKeyValue (const String& command);
+
   // Find the UDF library name belonging to a synonym.
   // If undefined, the synonym itself is returned.
   String findSynonym (const String& synonym) const;
@@ -115,12 +133,31 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set the number of threads to use (0 means all cores).
+  void setNThreads (uInt nthreads)
+    { itsNThreads = nthreads; }
+
+  // Get the number of threads to use (0 means all cores).
+  uInt nthreads() const
+    { return itsNThreads; }
+
+  // Can column indices be used in a WHERE?
+  Bool useIndex() const
+    { return itsUseIndex; }
+
+  // Can missing column indices be made?
+  Bool makeIndex() const
+    { return itsMakeIndex; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  uInt itsNThreads;
+  Bool itsUseIndex;
+  Bool itsMakeIndex;
   std::map<String,String> itsUDFLibNameMap;
 };
 
@@ -201,8 +201,8 @@ TEMPTAB   [$]{INT}(("."{NAME})?("::"{NAME}("."{NAME})*)*)
    NOTE: when changing NAMETABC, also change TaQLNodeRep::addEscape. */
 NAMETABC  ([A-Za-z0-9_./+\-~$@:]|(\\.))+
 NAMETAB   {NAMETABC}|(({STRING}|{NAMETABC})+)
-/* A UDFlib synonym */
-UDFLIBSYN {NAME}{WHITE}"="{WHITE}{NAME}
+/* A UDFlib synonym or a numeric style value (like threads=4) */
+UDFLIBSYN {NAME}{WHITE}"="{WHITE}({NAME}|{INT})
 /* A regular expression can be delimited by / % or @ optionall=y followed by i
    to indicate case-insensitive matching.
      m is a partial match (match if part of string matches the regex)
@@ -469,13 +469,15 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             BEGIN(EXPRstate);
             return HAVING;
           }
-{JOIN} {
+{JOIN}    {
             tableGramPosition() += yyleng;
-            throw (TableInvExpr ("JOIN ON is not supported yet"));
+            BEGIN(TABLENAMEstate);
+            return JOIN;
           }
-{ON}  {
+{ON}      {
             tableGramPosition() += yyleng;
-            throw (TableInvExpr ("JOIN ON is not supported yet"));
+            BEGIN(EXPRstate);
+            return ON;
           }
 
 {AS}      {
@@ -515,7 +517,7 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             return SEMICOL;
           }
 
- /* UDF libname synonym definition */
+ /* UDF libname synonym definition or style value */
 <STYLEstate>{UDFLIBSYN} {
             tableGramPosition() += yyleng;
             lvalp->val = new TaQLConstNode(
@@ -64,6 +64,8 @@ Expect them, so bison does not generate an error message.
 %token GROUPBY
 %token GROUPROLL
 %token HAVING
+%token JOIN
+%token ON
 %token ORDERBY
 %token NODUPL
 %token GIVING
@@ -86,7 +88,7 @@ Expect them, so bison does not generate an error message.
 %token DMINFO
 %token ALL                  /* ALL (in SELECT ALL) */
 %token <val> NAME           /* name of function, field, table, or alias */
-%token <val> UDFLIBSYN      /* UDF library name synonym definition */
+%token <val> UDFLIBSYN      /* UDF library name synonym or style value */
 %token <val> FLDNAME        /* name of field or table */
 %token <val> TABNAME        /* table name */
 %token <val> LITERAL
@@ -149,6 +151,8 @@ Expect them, so bison does not generate an error message.
 %type <nodelist> fromtabs
 %type <nodelist> tables
 %type <nodelist> tablist
+%type <nodelist> joins
+%type <nodelist> joinlist
 %type <nodelist> likedrop
 %type <nodelist> likedropac
 %type <nodelist> concsub
@@ -301,15 +305,16 @@ stylecoms: stylecoms stylecomm
 stylecomm: STYLE stylelist
          ;
 
-/* A style can consist of multiple keywords and UDFLIB synonyms */
+/* A style can consist of multiple keywords, key=value pairs (like
+   threads=4) and UDFLIB synonyms */
 stylelist: stylelist COMMA NAME
              { TaQLNode::theirStyle.set ($3->getString()); }
          | NAME
              { TaQLNode::theirStyle.set ($1->getString()); }
          | stylelist COMMA UDFLIBSYN
-             { TaQLNode::theirStyle.defineSynonym ($3->getString()); }
+             { TaQLNode::theirStyle.setKeyValue ($3->getString()); }
          | UDFLIBSYN
-             { TaQLNode::theirStyle.defineSynonym ($1->getString()); }
+             { TaQLNode::theirStyle.setKeyValue ($1->getString()); }
          ;
 
 /* The possible TaQL commands; nestedcomm can be used in a nested FROM */
@@ -408,17 +413,17 @@ withpart:  {   /* no WITH part */
 
 /* The SELECT command; note that many parts are optional which is handled
    in the rule of that part. The FROM part being optional is handled here
-   because later a join might be added. */
-selcomm:   withpart SELECT selcol FROM tables whexpr groupby having order limitoff given dminfo {
+   because the joins can only be given after a FROM. */
+selcomm:   withpart SELECT selcol FROM tables joins whexpr groupby having order limitoff given dminfo {
                $$ = new TaQLQueryNode(
-                    new TaQLSelectNodeRep (*$3, *$1, *$5, 0, *$6, *$7, *$8,
-					   *$9, *$10, *$11, *$12));
+                    new TaQLSelectNodeRep (*$3, *$1, *$5, *$6, *$7, *$8, *$9,
+					   *$10, *$11, *$12, *$13));
 	       TaQLNode::theirNodesCreated.push_back ($$);
            }
-         | withpart SELECT selcol into FROM tables whexpr groupby having order limitoff dminfo {
+         | withpart SELECT selcol into FROM tables joins whexpr groupby having order limitoff dminfo {
                $$ = new TaQLQueryNode(
-		    new TaQLSelectNodeRep (*$3, *$1, *$6, 0, *$7, *$8, *$9,
-					   *$10, *$11, *$4, *$12));
+		    new TaQLSelectNodeRep (*$3, *$1, *$6, *$7, *$8, *$9, *$10,
+					   *$11, *$12, *$4, *$13));
 	       TaQLNode::theirNodesCreated.push_back ($$);
            }
          | withpart SELECT selcol whexpr groupby having order limitoff given dminfo {
@@ -435,6 +440,28 @@ selcomm:   withpart SELECT selcol FROM tables whexpr groupby having order limito
            }
          ;
 
+/* Zero or more tables joined with the first FROM table */
+joins:     {   /* no joins */
+               $$ = new TaQLMultiNode();
+	       TaQLNode::theirNodesCreated.push_back ($$);
+           }
+         | joinlist {
+               $$ = $1;
+           }
+         ;
+
+joinlist:  JOIN tables ON orexpr {
+               $$ = new TaQLMultiNode(False);
+	       TaQLNode::theirNodesCreated.push_back ($$);
+               $$->setSeparator ("");
+               $$->add (new TaQLJoinNodeRep (*$2, *$4));
+           }
+         | joinlist JOIN tables ON orexpr {
+               $$ = $1;
+               $$->add (new TaQLJoinNodeRep (*$3, *$5));
+           }
+         ;
+
 /* The column list can be preceded by ALL or DISTINCT */
 selcol:    normcol {
                $$ = $1;
@@ -28,9 +28,22 @@
 //# Includes
 #include <casacore/tables/TaQL/TableParseGroupby.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
+#include <casacore/tables/TaQL/ExprAggrNode.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/System/AipsrcValue.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/OS/OMP.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
 
 using namespace std;
 
@@ -127,7 +140,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   CountedPtr<TableExprGroupResult> TableParseGroupby::execGroupAggr
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // If only 'select count(*)' was given, get the size of the WHERE,
     // thus the size of rownrs_p.
@@ -135,7 +148,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         (itsGroupAggrUsed & GROUPBY) == 0) {
       return countAll (rownrs);
     }
-    return aggregate (rownrs);
+    return aggregate (rownrs, nthreads);
   }
 
   Bool TableParseGroupby::execHaving
@@ -161,7 +174,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   CountedPtr<TableExprGroupResult> TableParseGroupby::aggregate
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // Get the aggregate functions to be evaluated lazily.
     std::vector<TableExprNodeRep*> immediateNodes;
@@ -187,18 +200,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (! lazyNodes.empty()) {
       immediateNodes.push_back (&expridNode);
     }
-    std::vector<CountedPtr<TableExprGroupFuncSet>> funcSets;
-    // Use a faster way for a single groupby key.
-    if (itsGroupbyNodes.size() == 1  &&
-        itsGroupbyNodes[0].dataType() == TpDouble) {
-      funcSets = singleKey<Double> (immediateNodes, rownrs);
-    } else if (itsGroupbyNodes.size() == 1  &&
-               itsGroupbyNodes[0].dataType() == TpInt) {
-      funcSets = singleKey<Int64> (immediateNodes, rownrs);
-    } else {
-      funcSets = multiKey (immediateNodes, rownrs);
-    }
-    // Let the function nodes finish their operation.
+    // The function nodes have finished their operation.
+    std::vector<CountedPtr<TableExprGroupFuncSet>> funcSets =
+      hashKey (immediateNodes, rownrs, !lazyNodes.empty(), nthreads);
     // Form the rownr vector from the rows kept in the aggregate objects.
     // Similarly, form the TableExprId vector if there are lazy nodes.
     Vector<rownr_t> resRownrs(funcSets.size());
@@ -206,11 +210,6 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     ids.reserve (funcSets.size());
     rownr_t n=0;
     for (uInt i=0; i<funcSets.size(); ++i) {
-      const std::vector<CountedPtr<TableExprGroupFuncBase> >& funcs
-        = funcSets[i]->getFuncs();
-      for (uInt j=0; j<funcs.size(); ++j) {
-        funcs[j]->finish();
-      }
       resRownrs[n++] = funcSets[i]->getId().rownr();
       if (! lazyNodes.empty()) {
         ids.push_back (funcSets[i]->getFuncs()[nimmediate]->getIds());
@@ -247,35 +246,362 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return CountedPtr<TableExprGroupResult>(new TableExprGroupResult(funcSets));
   }
 
-  std::vector<CountedPtr<TableExprGroupFuncSet>> TableParseGroupby::multiKey
-  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs) const
+  std::atomic<Int64> TableParseGroupby::theirBudget(-1);
+  std::atomic<Int64> TableParseGroupby::theirLastMemoryUsed(0);
+
+  Int64 TableParseGroupby::memoryBudget()
+  {
+    Int64 nbytes = theirBudget.load();
+    if (nbytes < 0) {
+      Int nMiB;
+      AipsrcValue<Int>::find (nMiB, "taql.groupby.budget", 0);
+      nbytes = (nMiB > 0  ?  Int64(nMiB) * 1024 * 1024 : 0);
+      // Do not overwrite a budget set in the meantime.
+      Int64 unset = -1;
+      theirBudget.compare_exchange_strong (unset, nbytes);
+      nbytes = theirBudget.load();
+    }
+    return nbytes;
+  }
+
+  void TableParseGroupby::setMemoryBudget (Int64 nbytes)
+  {
+    theirBudget = std::max (nbytes, Int64(0));
+  }
+
+  Int64 TableParseGroupby::lastMemoryUsed()
+  {
+    return theirLastMemoryUsed;
+  }
+
+  std::vector<CountedPtr<TableExprGroupFuncSet>> TableParseGroupby::hashKey
+  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs,
+   Bool collectIds, uInt nthreads) const
   {
     // Group the data according to the (maybe empty) groupby.
     // Step through the table in the normal order which may not be the
     // groupby order.
-    // A map<key,int> is used to keep track of the results where the int
-    // is the index in a vector of a set of aggregate function objects.
-    std::vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-    std::map<TableExprGroupKeySet, Int> keyFuncMap;
-    // Create the set of groupby key objects.
-    TableExprGroupKeySet keySet(itsGroupbyNodes);
-    // Loop through all rows.
-    // For each row generate the key to get the right entry.
+    std::vector<CountedPtr<TableExprGroupFuncSet>> funcSets;
+    std::vector<rownr_t> firstInx;
+    GroupMemory memory;
+    memory.budget = memoryBudget();
+    // The estimated size of the state of a group (an aggregate function
+    // takes about 64 bytes) and of a row if its TableExprId is kept.
+    const size_t funcSize = 64;
+    memory.groupSize = (sizeof(TableExprGroupFuncSet) +
+                        sizeof(CountedPtr<TableExprGroupFuncSet>) +
+                        sizeof(rownr_t) + nodes.size() * funcSize);
+    memory.rowSize   = (collectIds ? sizeof(TableExprId) : 0);
+    memory.state     = 0;
+    memory.peak      = 0;
+    // The rows can only be grouped by multiple threads if no memory budget
+    // is used, because the groups of all threads are kept until merged.
+    uInt nthr = (nthreads == 0  ?  OMP::maxThreads() : nthreads);
+    TableExprConcurrentRead concurrentRead;
+    if (nthr > 1  &&  memory.budget == 0  &&
+        rownrs.size() > TableExprNodeRep::BatchSize  &&
+        canGroupParallel (nodes, concurrentRead)) {
+      hashGroupsParallel (nodes, rownrs, nthr, memory, funcSets, firstInx);
+    } else {
+      hashGroups (nodes, rownrs, 0, 0, memory, funcSets, firstInx);
+    }
+    theirLastMemoryUsed = memory.peak;
+    // If rows were spilled, the groups are not in order of first appearance.
+    // Reorder them, so the result does not depend on the memory budget.
+    if (! std::is_sorted (firstInx.begin(), firstInx.end())) {
+      std::vector<size_t> order(funcSets.size());
+      for (size_t i=0; i<order.size(); ++i) {
+        order[i] = i;
+      }
+      std::sort (order.begin(), order.end(),
+                 [&firstInx] (size_t i1, size_t i2)
+                 { return firstInx[i1] < firstInx[i2]; });
+      std::vector<CountedPtr<TableExprGroupFuncSet>> sorted;
+      sorted.reserve (funcSets.size());
+      for (size_t inx : order) {
+        sorted.push_back (funcSets[inx]);
+      }
+      funcSets.swap (sorted);
+    }
+    return funcSets;
+  }
+
+  void TableParseGroupby::hashGroups
+  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs,
+   const Vector<rownr_t>* partInx, uInt level, GroupMemory& memory,
+   std::vector<CountedPtr<TableExprGroupFuncSet>>& funcSets,
+   std::vector<rownr_t>& firstInx) const
+  {
+    // The number of partitions (a power of 2) used when spilling and the
+    // maximum spill level.
+    const uInt nrPartBits = 4;
+    const uInt maxLevel   = 3;
+    TableExprGroupHashMap map(itsGroupbyNodes);
+    size_t firstGroup = funcSets.size();
+    // The rows of new groups are spilled to a temporary table if the
+    // memory budget would be exceeded. The partition is defined by the most
+    // significant bits of the hash value (the slot by the least significant).
+    // The memory counted is the hash map of this level and the state of
+    // all groups (also the ones finished at other levels).
+    Table spillTable;
+    std::vector<rownr_t> spillInx;
+    std::vector<Int>     spillPart;
+    rownr_t nrow = (partInx ? partInx->size() : rownrs.size());
+    const rownr_t batchSize = TableExprNodeRep::BatchSize;
+    Vector<rownr_t> blkRows;
     TableExprId rowid(0);
-    for (rownr_t i=0; i<rownrs.size(); ++i) {
-      rowid.setRownr (rownrs[i]);
-      keySet.fill (itsGroupbyNodes, rowid);
-      Int groupnr = funcSets.size();
-      std::map<TableExprGroupKeySet, Int>::iterator iter=keyFuncMap.find (keySet);
-      if (iter == keyFuncMap.end()) {
-        keyFuncMap[keySet] = groupnr;
-        funcSets.push_back (new TableExprGroupFuncSet (nodes));
+    for (rownr_t st=0; st<nrow; st+=batchSize) {
+      rownr_t nr = std::min(batchSize, nrow-st);
+      if (partInx) {
+        blkRows.resize (nr);
+        for (rownr_t i=0; i<nr; ++i) {
+          blkRows[i] = rownrs[(*partInx)[st+i]];
+        }
       } else {
-        groupnr = iter->second;
+        blkRows.reference (rownrs(Slice(st, nr)));
+      }
+      map.packKeys (itsGroupbyNodes, blkRows);
+      // Consecutive rows often have the same key, so check the previous one.
+      // A group number -1 means that the previous row was spilled.
+      const char* lastKey = 0;
+      size_t lastSize = 0;
+      Int64 groupnr = -1;
+      uInt64 hash = 0;
+      for (rownr_t i=0; i<nr; ++i) {
+        const char* key = map.key(i);
+        size_t size = map.keySize(i);
+        rownr_t inx = (partInx ? (*partInx)[st+i] : st+i);
+        if (!lastKey  ||  size != lastSize  ||
+            memcmp (key, lastKey, size) != 0) {
+          hash = TableExprGroupHashMap::hash (key, size);
+          groupnr = map.find (key, size, hash);
+          if (groupnr < 0) {
+            // A new group; spill if the budget would be exceeded. Note that
+            // once exceeded, it remains exceeded for this map, so all rows
+            // of a group are either in memory or spilled. At the deepest
+            // level nothing can be spilled anymore.
+            Int64 used = (map.nbytesAfterAdd (size) + memory.state +
+                          memory.groupSize + memory.rowSize);
+            if (memory.budget == 0  ||  used <= memory.budget) {
+              groupnr = map.add (key, size, hash);
+              funcSets.push_back (new TableExprGroupFuncSet (nodes));
+              firstInx.push_back (inx);
+              memory.state += memory.groupSize;
+            } else if (level == maxLevel) {
+              throwBudget (memory);
+            }
+          }
+          lastKey  = key;
+          lastSize = size;
+        }
+        if (groupnr >= 0) {
+          // The state of a group can grow if its TableExprIds are kept,
+          // which cannot be spilled.
+          memory.state += memory.rowSize;
+          if (memory.budget > 0  &&
+              Int64(map.nbytes()) + memory.state > memory.budget) {
+            throwBudget (memory);
+          }
+          rowid.setRownr (blkRows[i]);
+          funcSets[firstGroup + groupnr]->apply (rowid);
+        } else {
+          spillInx.push_back (inx);
+          spillPart.push_back ((hash >> (64 - nrPartBits * (level+1))) &
+                               ((1 << nrPartBits) - 1));
+        }
+      }
+      memory.peak = std::max (memory.peak, Int64(map.nbytes()) + memory.state);
+      if (! spillInx.empty()) {
+        writeSpill (spillTable, spillInx, spillPart);
       }
-      funcSets[groupnr]->apply (rowid);
     }
-    return funcSets;
+    // Finish the groups of this level and release the map, so only the
+    // (final) state of the groups is kept while doing the next partitions.
+    for (size_t i=firstGroup; i<funcSets.size(); ++i) {
+      for (const CountedPtr<TableExprGroupFuncBase>& func :
+             funcSets[i]->getFuncs()) {
+        func->finish();
+      }
+    }
+    map.clear();
+    // Group the spilled rows per partition.
+    if (! spillTable.isNull()) {
+      for (Int part=0; part < (1 << nrPartBits); ++part) {
+        Table partTable = spillTable(spillTable.col("PARTITION") == part);
+        if (partTable.nrow() > 0) {
+          Vector<Int64> inx = ScalarColumn<Int64>(partTable, "INDEX").getColumn();
+          Vector<rownr_t> partRows(inx.size());
+          std::copy (inx.begin(), inx.end(), partRows.begin());
+          hashGroups (nodes, rownrs, &partRows, level+1, memory,
+                      funcSets, firstInx);
+        }
+      }
+    }
+  }
+
+  Bool TableParseGroupby::canGroupParallel
+  (const std::vector<TableExprNodeRep*>& nodes,
+   TableExprConcurrentRead& concurrentRead) const
+  {
+    // All aggregate functions must be able to merge partial results.
+    if (! TableExprGroupFuncSet(nodes).isMergeable()) {
+      return False;
+    }
+    // The keys and the operands of the functions must be parallel safe
+    // and their tables must be readable concurrently.
+    for (const TableExprNode& key : itsGroupbyNodes) {
+      if (! key.getRep()->isParallelSafe()  ||
+          ! concurrentRead.add (key.getRep())) {
+        return False;
+      }
+    }
+    for (TableExprNodeRep* node : nodes) {
+      TableExprAggrNode* aggrNode = dynamic_cast<TableExprAggrNode*>(node);
+      if (! aggrNode) {
+        return False;
+      }
+      TENShPtr operand = aggrNode->operand();
+      if (operand  &&  (! operand->isParallelSafe()  ||
+                        ! concurrentRead.add (operand))) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  void TableParseGroupby::hashGroupsParallel
+  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs,
+   uInt nthr, GroupMemory& memory,
+   std::vector<CountedPtr<TableExprGroupFuncSet>>& funcSets,
+   std::vector<rownr_t>& firstInx) const
+  {
+    // Each thread groups a contiguous chunk of blocks of rows in its own map.
+    const rownr_t batchSize = TableExprNodeRep::BatchSize;
+    rownr_t nblk = (rownrs.size() + batchSize - 1) / batchSize;
+    nthr = std::min (rownr_t(nthr), nblk);
+    rownr_t chunkSize = (nblk + nthr - 1) / nthr * batchSize;
+    std::vector<TableExprGroupHashMap> maps (nthr,
+                                             TableExprGroupHashMap(itsGroupbyNodes));
+    std::vector<std::vector<CountedPtr<TableExprGroupFuncSet>>> chunkSets(nthr);
+    std::vector<std::vector<rownr_t>> chunkInx(nthr);
+    std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthr) schedule(static, 1)
+    for (Int64 chunk=0; chunk<Int64(nthr); ++chunk) {
+      try {
+        TableExprGroupHashMap& map = maps[chunk];
+        std::vector<CountedPtr<TableExprGroupFuncSet>>& sets = chunkSets[chunk];
+        rownr_t end = std::min (rownr_t(rownrs.size()), (chunk+1) * chunkSize);
+        Vector<rownr_t> blkRows;
+        TableExprId rowid(0);
+        for (rownr_t st=chunk*chunkSize; st<end; st+=batchSize) {
+          rownr_t nr = std::min(batchSize, end-st);
+          blkRows.resize (nr);
+          for (rownr_t i=0; i<nr; ++i) {
+            blkRows[i] = rownrs[st+i];
+          }
+          map.packKeys (itsGroupbyNodes, blkRows);
+          const char* lastKey = 0;
+          size_t lastSize = 0;
+          Int64 groupnr = -1;
+          for (rownr_t i=0; i<nr; ++i) {
+            const char* key = map.key(i);
+            size_t size = map.keySize(i);
+            if (!lastKey  ||  size != lastSize  ||
+                memcmp (key, lastKey, size) != 0) {
+              uInt64 hash = TableExprGroupHashMap::hash (key, size);
+              groupnr = map.find (key, size, hash);
+              if (groupnr < 0) {
+                groupnr = map.add (key, size, hash);
+                // Making the function objects sets a pointer in the nodes.
+#pragma omp critical(TableParseGroupby_makeFuncSet)
+                sets.push_back (new TableExprGroupFuncSet (nodes));
+                chunkInx[chunk].push_back (st+i);
+              }
+              lastKey  = key;
+              lastSize = size;
+            }
+            rowid.setRownr (blkRows[i]);
+            sets[groupnr]->apply (rowid);
+          }
+        }
+      } catch (...) {
+#pragma omp critical(TableParseGroupby_hashGroupsParallel)
+        excp = std::current_exception();
+      }
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
+    }
+    Int64 used = rownrs.size() * memory.rowSize;
+    for (uInt chunk=0; chunk<nthr; ++chunk) {
+      used += maps[chunk].nbytes() + maps[chunk].ngroup() * memory.groupSize;
+    }
+    // Merge the groups of the chunks in row order, so the groups are in order
+    // of first appearance and the partial results are merged in row order.
+    TableExprGroupHashMap map(itsGroupbyNodes);
+    size_t firstGroup = funcSets.size();
+    for (uInt chunk=0; chunk<nthr; ++chunk) {
+      const TableExprGroupHashMap& chunkMap = maps[chunk];
+      for (size_t group=0; group<chunkMap.ngroup(); ++group) {
+        const char* key = chunkMap.groupKey (group);
+        size_t size = chunkMap.groupKeySize (group);
+        uInt64 hash = chunkMap.groupHash (group);
+        Int64 groupnr = map.find (key, size, hash);
+        if (groupnr < 0) {
+          map.add (key, size, hash);
+          funcSets.push_back (chunkSets[chunk][group]);
+          firstInx.push_back (chunkInx[chunk][group]);
+        } else {
+          funcSets[firstGroup + groupnr]->merge (*chunkSets[chunk][group]);
+        }
+      }
+      maps[chunk].clear();
+      chunkSets[chunk].clear();
+    }
+    memory.state = (funcSets.size() - firstGroup) * memory.groupSize +
+                   rownrs.size() * memory.rowSize;
+    memory.peak  = std::max (memory.peak, used + Int64(map.nbytes()));
+    for (size_t i=firstGroup; i<funcSets.size(); ++i) {
+      for (const CountedPtr<TableExprGroupFuncBase>& func :
+             funcSets[i]->getFuncs()) {
+        func->finish();
+      }
+    }
+  }
+
+  void TableParseGroupby::throwBudget (const GroupMemory& memory) const
+  {
+    throw TableInvExpr ("GROUPBY needs more memory than its budget of " +
+                        String::toString(memory.budget) + " bytes (see"
+                        " aipsrc variable taql.groupby.budget)");
+  }
+
+  void TableParseGroupby::writeSpill (Table& spillTable,
+                                      std::vector<rownr_t>& spillInx,
+                                      std::vector<Int>& spillPart) const
+  {
+    // Create the temporary table if not done yet.
+    // It is a scratch table, so it is deleted when no longer used.
+    if (spillTable.isNull()) {
+      TableDesc td;
+      td.addColumn (ScalarColumnDesc<Int64> ("INDEX"));
+      td.addColumn (ScalarColumnDesc<Int>   ("PARTITION"));
+      SetupNewTable newtab("", td, Table::Scratch);
+      StandardStMan ssm;
+      newtab.bindAll (ssm);
+      spillTable = Table(newtab);
+    }
+    rownr_t nrow = spillTable.nrow();
+    rownr_t nr = spillInx.size();
+    spillTable.addRow (nr);
+    Vector<Int64> inx(nr);
+    std::copy (spillInx.begin(), spillInx.end(), inx.begin());
+    ScalarColumn<Int64>(spillTable, "INDEX").putColumnRange
+      (Slicer(IPosition(1,nrow), IPosition(1,nr)), inx);
+    ScalarColumn<Int>(spillTable, "PARTITION").putColumnRange
+      (Slicer(IPosition(1,nrow), IPosition(1,nr)), Vector<Int>(spillPart));
+    spillInx.clear();
+    spillPart.clear();
   }
 
 
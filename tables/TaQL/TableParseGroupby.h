@@ -32,12 +32,15 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/tables/Tables/Table.h>
+#include <atomic>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   //# Forward declarations
   class TableParseQuery;
+  class TableExprConcurrentRead;
 
   
   // <summary>
@@ -55,6 +58,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // It checks that the commands and functions are given in a valid way.
   // <br>Note that some hooks are present for the ROLLUP keyword, but it is not
   // possible to use it yet.
+  // <p>
+  // The grouping is done using a hash map on the packed values of the keys,
+  // which are evaluated in blocks of rows. To limit the memory, rows can
+  // be spilled to a temporary table and grouped thereafter per partition
+  // (see <src>setMemoryBudget</src>). The memory of the hash map and the
+  // state of all groups is counted against the budget. Because the state
+  // of the groups is needed for the result, an exception is thrown if it
+  // does not fit in the budget.
   // </synopsis>
 
   class TableParseGroupby
@@ -103,19 +114,48 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Execute the grouping and aggregation and return the results.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    CountedPtr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs) const;
+    // The rows are grouped by multiple threads (0 means all cores) if no
+    // memory budget is used, the keys and aggregate functions are
+    // parallel safe, and the partial results of the functions can be merged.
+    CountedPtr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs,
+                                                    uInt nthreads=1) const;
 
     // Execute the HAVING clause (if present).
     // Return False in no HAVING.
     Bool execHaving (Vector<rownr_t>& rownrs,
                      const CountedPtr<TableExprGroupResult>& groups);
 
+    // Get or set the memory budget (in bytes) for grouping.
+    // If exceeded, rows are spilled to a temporary table. If the state
+    // of the groups (including the row ids needed for lazy aggregate
+    // functions like median) does not fit, an exception is thrown.
+    // The default budget is given by the aipsrc variable
+    // <src>taql.groupby.budget</src> in MiB. 0 means unlimited (the default).
+    // <group>
+    static Int64 memoryBudget();
+    static void setMemoryBudget (Int64 nbytes);
+    // </group>
+
+    // Get the maximum number of bytes (as estimated) used by the last
+    // grouping. It is meant for test purposes.
+    static Int64 lastMemoryUsed();
+
   private:
+    // The memory accounting while grouping.
+    struct GroupMemory {
+      Int64  budget;      //# 0 is unlimited
+      Int64  groupSize;   //# estimated state size of a group
+      Int64  rowSize;     //# state size of a row (if its id is kept)
+      Int64  state;       //# state size of all groups
+      Int64  peak;        //# maximum memory used
+    };
+
     // Do the grouping and aggregation and return the results.
     // It distinguishes the immediate and lazy aggregate functions.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    CountedPtr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs) const;
+    CountedPtr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs,
+                                                uInt nthreads) const;
 
     // Do the grouping and aggregation and return the results.
     // It consists of a single COUNTALL operation.
@@ -124,48 +164,50 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     CountedPtr<TableExprGroupResult> countAll (Vector<rownr_t>& rownrs) const;
 
     // Create the set of aggregate functions and groupby keys.
-    std::vector<CountedPtr<TableExprGroupFuncSet>> multiKey
-    (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs) const;
-
-    // Create the set of aggregate functions and groupby keys in case
-    // a single groupby key is given.
-    // This offers much faster map access then the general multipleKeys.
-    template<typename T>
-    std::vector<CountedPtr<TableExprGroupFuncSet>> singleKey
-    (const std::vector<TableExprNodeRep*>& nodes,
-     const Vector<rownr_t>& rownrs) const
-    {
-      // We have to group the data according to the (possibly empty) groupby.
-      // We step through the table in the normal order which may not be the
-      // groupby order.
-      // A map<key,int> is used to keep track of the results where the int
-      // is the index in a vector of a set of aggregate function objects.
-      std::vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-      std::map<T, int> keyFuncMap;
-      T lastKey = std::numeric_limits<T>::max();
-      int groupnr = -1;
-      // Loop through all rows.
-      // For each row generate the key to get the right entry.
-      TableExprId rowid(0);
-      T key;
-      for (rownr_t i=0; i<rownrs.size(); ++i) {
-        rowid.setRownr (rownrs[i]);
-        itsGroupbyNodes[0].get (rowid, key);
-        if (key != lastKey) {
-          typename std::map<T, int>::iterator iter = keyFuncMap.find (key);
-          if (iter == keyFuncMap.end()) {
-            groupnr = funcSets.size();
-            keyFuncMap[key] = groupnr;
-            funcSets.push_back (new TableExprGroupFuncSet (nodes));
-          } else {
-            groupnr = iter->second;
-          }
-        }
-        rowid.setRownr (rownrs[i]);
-        funcSets[groupnr]->apply (rowid);
-      }
-      return funcSets;
-    }
+    // It uses a TableExprGroupHashMap on the packed keys of each row.
+    // If the memory used exceeds the budget, the rows of new groups are
+    // spilled to a temporary table in partitions defined by the hash value
+    // of the keys. Each partition is grouped thereafter in the same way.
+    // The groups are returned in order of first appearance, as if no spilling
+    // was done. The aggregate functions have been finished.
+    // <src>collectIds</src> tells if the TableExprIds of the rows are kept
+    // (for lazy aggregate functions), which is accounted for in the memory.
+    std::vector<CountedPtr<TableExprGroupFuncSet>> hashKey
+    (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs,
+     Bool collectIds, uInt nthreads) const;
+
+    // Can the rows be grouped by multiple threads?
+    // The tables used are added to <src>concurrentRead</src>.
+    Bool canGroupParallel (const std::vector<TableExprNodeRep*>& nodes,
+                           TableExprConcurrentRead& concurrentRead) const;
+
+    // Group the rows by multiple threads, each grouping a contiguous chunk
+    // of the rows in its own map. Thereafter the groups are merged in
+    // row order and finished.
+    void hashGroupsParallel (const std::vector<TableExprNodeRep*>& nodes,
+                             const Vector<rownr_t>& rownrs, uInt nthr,
+                             GroupMemory& memory,
+                             std::vector<CountedPtr<TableExprGroupFuncSet>>& funcSets,
+                             std::vector<rownr_t>& firstInx) const;
+
+    // Group the given rows (or a partition of them given by their indices
+    // in rownrs) and apply the aggregate functions.
+    // The index of the first row in each new group is added to firstInx.
+    // The groups are finished before the spilled partitions are grouped.
+    void hashGroups (const std::vector<TableExprNodeRep*>& nodes,
+                     const Vector<rownr_t>& rownrs,
+                     const Vector<rownr_t>* partInx, uInt level,
+                     GroupMemory& memory,
+                     std::vector<CountedPtr<TableExprGroupFuncSet>>& funcSets,
+                     std::vector<rownr_t>& firstInx) const;
+
+    // Throw an exception that the memory budget is too small.
+    void throwBudget (const GroupMemory& memory) const;
+
+    // Write the indices of the spilled rows and their partitions to the
+    // temporary table (which is created if null) and clear the vectors.
+    void writeSpill (Table& spillTable, std::vector<rownr_t>& spillInx,
+                     std::vector<Int>& spillPart) const;
 
     // Get pointers to the possible aggregate nodes in the node expression.
     //# Note that the const has to be casted away.
@@ -185,6 +227,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Pointers to the aggregate function nodes.
     std::vector<TableExprNodeRep*> itsAggrNodes;
     Int itsGroupAggrUsed;
+    //# The memory budget; -1 is not initialized yet.
+    static std::atomic<Int64> theirBudget;
+    static std::atomic<Int64> theirLastMemoryUsed;
   };
 
 
@@ -0,0 +1,491 @@
+//# TableParseIndex.cc: Use column indices for a TaQL WHERE clause
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/TaQL/TableParseIndex.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprNodeSetOpt.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/GenSort.h>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <cmath>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // Get the range of values of an integer data type.
+  static void intTypeRange (DataType dtype, Int64& minVal, Int64& maxVal)
+  {
+    switch (dtype) {
+    case TpUChar:
+      minVal = std::numeric_limits<uChar>::min();
+      maxVal = std::numeric_limits<uChar>::max();
+      break;
+    case TpShort:
+      minVal = std::numeric_limits<Short>::min();
+      maxVal = std::numeric_limits<Short>::max();
+      break;
+    case TpInt:
+      minVal = std::numeric_limits<Int>::min();
+      maxVal = std::numeric_limits<Int>::max();
+      break;
+    case TpUInt:
+      minVal = std::numeric_limits<uInt>::min();
+      maxVal = std::numeric_limits<uInt>::max();
+      break;
+    default:
+      minVal = std::numeric_limits<Int64>::min();
+      maxVal = std::numeric_limits<Int64>::max();
+      break;
+    }
+  }
+
+  // Define an integer key field with the data type of the column.
+  static void defineIntKey (Record& key, const String& name,
+                            DataType dtype, Int64 value)
+  {
+    switch (dtype) {
+    case TpUChar:
+      key.define (name, uChar(value));
+      break;
+    case TpShort:
+      key.define (name, Short(value));
+      break;
+    case TpInt:
+      key.define (name, Int(value));
+      break;
+    case TpUInt:
+      key.define (name, uInt(value));
+      break;
+    default:
+      key.define (name, value);
+      break;
+    }
+  }
+
+  // Get the integer value of a literal. False is returned if it
+  // is not an exact integer value.
+  static Bool getIntLiteral (const TENShPtr& node, Int64& value)
+  {
+    if (node->operType() != TableExprNodeRep::OtLiteral) {
+      return False;
+    }
+    if (node->dataType() == TableExprNodeRep::NTInt) {
+      value = node->getInt (0);
+      return True;
+    }
+    if (node->dataType() == TableExprNodeRep::NTDouble) {
+      Double dval = node->getDouble (0);
+      if (dval == std::floor(dval)  &&  std::fabs(dval) < 9.2e18) {
+        value = Int64(dval);
+        return True;
+      }
+    }
+    return False;
+  }
+
+
+  TableParseIndex::TableParseIndex (const Table& table,
+                                    const TableExprNode& where,
+                                    Bool useIndex, Bool makeIndex)
+    : table_p       (table),
+      useIndex_p    (useIndex),
+      makeIndex_p   (makeIndex),
+      hasRows_p     (False),
+      nrowScanned_p (-1),
+      nrowResult_p  (-1)
+  {
+    if (! where.isNull()) {
+      analyze (where.getRep());
+    }
+  }
+
+  TableParseIndex::~TableParseIndex()
+  {}
+
+  void TableParseIndex::analyze (const TENShPtr& node)
+  {
+    // Split an AND into its operands.
+    if (node->operType() == TableExprNodeRep::OtAND  &&
+        node->valueType() == TableExprNodeRep::VTScalar) {
+      const TableExprNodeBinary* andNode =
+        dynamic_cast<const TableExprNodeBinary*>(node.get());
+      if (andNode) {
+        analyze (andNode->getLeftChild());
+        analyze (andNode->getRightChild());
+        return;
+      }
+    }
+    if (! addKey (node)) {
+      remainder_p.push_back (node);
+    }
+  }
+
+  Bool TableParseIndex::addKey (const TENShPtr& node)
+  {
+    TableExprNodeRep::OperType oper = node->operType();
+    if (oper != TableExprNodeRep::OtEQ  &&  oper != TableExprNodeRep::OtIN  &&
+        oper != TableExprNodeRep::OtGE  &&  oper != TableExprNodeRep::OtGT) {
+      return False;
+    }
+    const TableExprNodeBinary* binNode =
+      dynamic_cast<const TableExprNodeBinary*>(node.get());
+    if (!binNode  ||  !table_p.isRootTable()) {
+      return False;
+    }
+    // Find the column operand, which has to be a scalar column in the table.
+    // For IN it has to be the left operand.
+    TENShPtr colNode = binNode->getLeftChild();
+    TENShPtr constNode = binNode->getRightChild();
+    Bool colLeft = True;
+    if (colNode->operType() != TableExprNodeRep::OtColumn  &&
+        oper != TableExprNodeRep::OtIN) {
+      std::swap (colNode, constNode);
+      colLeft = False;
+    }
+    if (colNode->operType() != TableExprNodeRep::OtColumn  ||
+        colNode->valueType() != TableExprNodeRep::VTScalar) {
+      return False;
+    }
+    const TableColumn& column =
+      dynamic_cast<const TableExprNodeColumn&>(*colNode).getColumn();
+    const Table& colTable = column.table();
+    if (!colTable.isRootTable()  ||  !colTable.isSameRoot(table_p)) {
+      return False;
+    }
+    const String& name = column.columnDesc().name();
+    DataType dtype = column.columnDesc().dataType();
+    Bool isInt = (dtype == TpUChar  ||  dtype == TpShort  ||  dtype == TpInt  ||
+                  dtype == TpUInt   ||  dtype == TpInt64);
+    if (!isInt  &&  !(dtype == TpString  &&  oper != TableExprNodeRep::OtGE  &&
+                      oper != TableExprNodeRep::OtGT)) {
+      return False;
+    }
+    if (! canUseIndex (name)) {
+      return False;
+    }
+    // Get the constant value(s).
+    if (oper == TableExprNodeRep::OtIN) {
+      std::vector<Int64> intValues;
+      std::vector<String> strValues;
+      const TableExprNodeSetOptUSet<Int64>* intSet =
+        dynamic_cast<const TableExprNodeSetOptUSet<Int64>*>(constNode.get());
+      const TableExprNodeSetOptUSet<String>* strSet =
+        dynamic_cast<const TableExprNodeSetOptUSet<String>*>(constNode.get());
+      if (isInt  &&  intSet) {
+        intValues = intSet->values();
+      } else if (!isInt  &&  strSet) {
+        strValues = strSet->values();
+      } else if (constNode->isConstant()  &&
+                 constNode->valueType() == TableExprNodeRep::VTArray  &&
+                 constNode->dataType() == (isInt ? TableExprNodeRep::NTInt :
+                                           TableExprNodeRep::NTString)) {
+        if (isInt) {
+          MArray<Int64> arr = constNode->getArrayInt (0);
+          if (arr.hasMask()) {
+            return False;
+          }
+          intValues.assign (arr.array().begin(), arr.array().end());
+        } else {
+          MArray<String> arr = constNode->getArrayString (0);
+          if (arr.hasMask()) {
+            return False;
+          }
+          strValues.assign (arr.array().begin(), arr.array().end());
+        }
+      } else {
+        return False;
+      }
+      IndexKey& key = getKey (name, dtype, False);
+      key.intValues.swap (intValues);
+      key.strValues.swap (strValues);
+      return True;
+    }
+    if (isInt) {
+      Int64 value;
+      if (! getIntLiteral (constNode, value)) {
+        return False;
+      }
+      if (oper == TableExprNodeRep::OtEQ) {
+        getKey(name, dtype, False).intValues.push_back (value);
+        return True;
+      }
+      // A range; col>val is the same as col>=val+1 for integers.
+      IndexKey& key = getKey (name, dtype, True);
+      const Int64 maxInt = std::numeric_limits<Int64>::max();
+      const Int64 minInt = std::numeric_limits<Int64>::min();
+      Bool gt = (oper == TableExprNodeRep::OtGT);
+      if (colLeft) {
+        if (gt  &&  value == maxInt) {
+          key.lower = maxInt;
+          key.upper = minInt;
+        } else {
+          key.lower = std::max (key.lower, gt ? value+1 : value);
+        }
+      } else {
+        if (gt  &&  value == minInt) {
+          key.lower = maxInt;
+          key.upper = minInt;
+        } else {
+          key.upper = std::min (key.upper, gt ? value-1 : value);
+        }
+      }
+      return True;
+    }
+    if (constNode->operType() != TableExprNodeRep::OtLiteral  ||
+        constNode->dataType() != TableExprNodeRep::NTString) {
+      return False;
+    }
+    getKey(name, dtype, False).strValues.push_back (constNode->getString(0));
+    return True;
+  }
+
+  Bool TableParseIndex::canUseIndex (const String& column) const
+  {
+    if (! useIndex_p) {
+      return False;
+    }
+    return makeIndex_p  ||
+      ColumnsIndex::hasPersistentIndex (table_p, Vector<String>(1, column));
+  }
+
+  TableParseIndex::IndexKey& TableParseIndex::getKey (const String& column,
+                                                      DataType dtype,
+                                                      Bool isRange)
+  {
+    // The ranges of a column are combined.
+    if (isRange) {
+      for (IndexKey& key : keys_p) {
+        if (key.isRange  &&  key.column == column) {
+          return key;
+        }
+      }
+    }
+    IndexKey key;
+    key.column   = column;
+    key.dataType = dtype;
+    key.isRange  = isRange;
+    key.lower    = std::numeric_limits<Int64>::min();
+    key.upper    = std::numeric_limits<Int64>::max();
+    key.persistent = ColumnsIndex::hasPersistentIndex
+                                      (table_p, Vector<String>(1, column));
+    key.nrow     = -1;
+    keys_p.push_back (key);
+    return keys_p.back();
+  }
+
+  ColumnsIndex& TableParseIndex::getIndex (const String& column)
+  {
+    std::shared_ptr<ColumnsIndex>& index = indices_p[column];
+    if (! index) {
+      // Use (or make) a persistent index if possible.
+      index.reset (new ColumnsIndex (table_p, column, 0, False, True));
+    }
+    return *index;
+  }
+
+  Vector<rownr_t> TableParseIndex::lookup (const IndexKey& key)
+  {
+    ColumnsIndex& index = getIndex (key.column);
+    std::vector<rownr_t> rows;
+    Int64 minVal, maxVal;
+    intTypeRange (key.dataType, minVal, maxVal);
+    if (key.isRange) {
+      Int64 lower = std::max (key.lower, minVal);
+      Int64 upper = std::min (key.upper, maxVal);
+      if (lower <= upper) {
+        defineIntKey (index.accessLowerKey(), key.column, key.dataType, lower);
+        defineIntKey (index.accessUpperKey(), key.column, key.dataType, upper);
+        RowNumbers keyRows = index.getRowNumbers (True, True);
+        rows.assign (keyRows.begin(), keyRows.end());
+      }
+    } else if (key.dataType == TpString) {
+      for (const String& value : key.strValues) {
+        index.accessKey().define (key.column, value);
+        RowNumbers keyRows = index.getRowNumbers();
+        rows.insert (rows.end(), keyRows.begin(), keyRows.end());
+      }
+    } else {
+      for (Int64 value : key.intValues) {
+        // A value outside the range of the data type cannot match.
+        if (value >= minVal  &&  value <= maxVal) {
+          defineIntKey (index.accessKey(), key.column, key.dataType, value);
+          RowNumbers keyRows = index.getRowNumbers();
+          rows.insert (rows.end(), keyRows.begin(), keyRows.end());
+        }
+      }
+    }
+    Vector<rownr_t> result(rows);
+    uInt64 nr = GenSort<rownr_t>::sort (result, Sort::Ascending,
+                                        Sort::NoDuplicates);
+    result.resize (nr, True);
+    return result;
+  }
+
+  Table TableParseIndex::select (rownr_t maxRow)
+  {
+    AlwaysAssert (isUsed(), AipsError);
+    // Intersect the rows found for the index keys (and the given rows).
+    Vector<rownr_t> rows;
+    if (hasRows_p) {
+      rows.reference (rows_p);
+    }
+    for (size_t i=0; i<keys_p.size(); ++i) {
+      Vector<rownr_t> keyRows = lookup (keys_p[i]);
+      keys_p[i].nrow = keyRows.size();
+      if (i == 0  &&  !hasRows_p) {
+        rows.reference (keyRows);
+      } else {
+        std::vector<rownr_t> isect;
+        std::set_intersection (rows.begin(), rows.end(),
+                               keyRows.begin(), keyRows.end(),
+                               std::back_inserter(isect));
+        rows.reference (Vector<rownr_t>(isect));
+      }
+    }
+    nrowScanned_p = rows.size();
+    if (! remainder_p.empty()) {
+      // Evaluate the remaining predicates in blocks of the rows found.
+      TableExprNode remainder(remainder_p[0]);
+      for (size_t i=1; i<remainder_p.size(); ++i) {
+        remainder = remainder && TableExprNode(remainder_p[i]);
+      }
+      std::vector<rownr_t> selRows;
+      Vector<Bool> values;
+      const rownr_t batchSize = TableExprNodeRep::BatchSize;
+      for (rownr_t st=0; st<rows.size(); st+=batchSize) {
+        Vector<rownr_t> blkRows (IPosition(1, std::min(batchSize,
+                                                       rows.size()-st)),
+                                 rows.data() + st, SHARE);
+        remainder.getBoolBatch (blkRows, values);
+        for (rownr_t i=0; i<blkRows.size(); ++i) {
+          if (values[i]) {
+            selRows.push_back (blkRows[i]);
+          }
+        }
+        // Stop if max #rows reached (maxRow==0 means no limit).
+        if (maxRow > 0  &&  selRows.size() >= maxRow) {
+          break;
+        }
+      }
+      rows.reference (Vector<rownr_t>(selRows));
+    }
+    if (maxRow > 0  &&  rows.size() > maxRow) {
+      rows.resize (maxRow, True);
+    }
+    nrowResult_p = rows.size();
+    return table_p(rows);
+  }
+
+  void TableParseIndex::setRows (const Vector<rownr_t>& rows)
+  {
+    rows_p.reference (rows);
+    hasRows_p = True;
+  }
+
+  String TableParseIndex::keyString (const IndexKey& key)
+  {
+    std::ostringstream os;
+    if (key.isRange) {
+      if (key.lower != std::numeric_limits<Int64>::min()) {
+        os << key.lower << " <= ";
+      }
+      os << key.column;
+      if (key.upper != std::numeric_limits<Int64>::max()) {
+        os << " <= " << key.upper;
+      }
+    } else {
+      size_t nval = key.intValues.size() + key.strValues.size();
+      os << key.column << (nval == 1 ? " == " : " IN [");
+      // Do not show too many values.
+      for (size_t i=0; i<std::min(nval, size_t(10)); ++i) {
+        if (i > 0) {
+          os << ',';
+        }
+        if (key.dataType == TpString) {
+          os << '"' << key.strValues[i] << '"';
+        } else {
+          os << key.intValues[i];
+        }
+      }
+      if (nval > 10) {
+        os << ",... (" << nval << " values)";
+      }
+      if (nval != 1) {
+        os << ']';
+      }
+    }
+    return os.str();
+  }
+
+  String TableParseIndex::explain() const
+  {
+    std::ostringstream os;
+    os << "WHERE on table " << table_p.tableName() << " with "
+       << table_p.nrow() << " rows" << endl;
+    if (! useIndex_p) {
+      os << "  the use of indices is switched off" << endl;
+    }
+    for (const IndexKey& key : keys_p) {
+      os << "  index  " << keyString(key);
+      if (key.persistent) {
+        os << "  (persistent index)";
+      } else {
+        os << "  (new index)";
+      }
+      if (key.nrow >= 0) {
+        os << "  -> " << key.nrow << " rows";
+      }
+      os << endl;
+    }
+    if (! remainder_p.empty()) {
+      os << "  scan   " << remainder_p.size() << " predicate"
+         << (remainder_p.size() == 1 ? "" : "s");
+      if (! keys_p.empty()) {
+        os << " on the rows found using the indices";
+      } else if (hasRows_p) {
+        os << " on the rows matched by the joins";
+      } else {
+        os << " on all rows";
+      }
+      if (nrowScanned_p >= 0) {
+        os << "  (" << nrowScanned_p << " rows)";
+      }
+      os << endl;
+    }
+    if (nrowResult_p >= 0) {
+      os << "  result " << nrowResult_p << " rows" << endl;
+    }
+    return os.str();
+  }
+
+
+} //# NAMESPACE CASACORE - END
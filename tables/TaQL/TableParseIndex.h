@@ -0,0 +1,172 @@
+//# TableParseIndex.h: Use column indices for a TaQL WHERE clause
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TABLEPARSEINDEX_H
+#define TABLES_TABLEPARSEINDEX_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class ColumnsIndex;
+
+
+  // <summary>
+  // Helper class to use column indices in a TaQL WHERE clause
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tTableParseIndex">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //   <li> <linkto class=ColumnsIndex>ColumnsIndex</linkto>
+  //   <li> <linkto class=TableParseQuery>TableParseQuery</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // TableParseIndex splits a WHERE expression into its AND-ed parts
+  // (predicates) and finds out which predicates can be served by a
+  // <linkto class=ColumnsIndex>ColumnsIndex</linkto> on a column of the
+  // table. Such a predicate is a comparison of a scalar column with a
+  // constant:
+  // <ul>
+  //  <li> <src>col == const</src> or <src>col IN [const, ...]</src> for an
+  //       integer or String column.
+  //  <li> <src>col > const</src>, <src>col >= const</src>,
+  //       <src>col < const</src>, or <src>col <= const</src>
+  //       for an integer column. The ranges of a column are combined.
+  // </ul>
+  // Floating point columns are not served from an index, because NaN values
+  // do not have a well-defined sort order.
+  // <br>A predicate is served from an index if a persistent index exists
+  // for its column (see <src>ColumnsIndex::hasPersistentIndex</src>).
+  // If <src>makeIndex</src> is set, a missing index is built (and made
+  // persistent if possible), so later queries can use it.
+  // <p>
+  // The selection intersects the row numbers found for the indexed
+  // predicates. The remaining predicates are evaluated for those rows only.
+  // If no predicate can be served from an index, the WHERE has to be done
+  // by a full scan using <src>Table::operator()</src>, unless the rows
+  // to evaluate are restricted using <src>setRows</src> (for a join).
+  // <p>
+  // Function <src>explain</src> tells which predicates are served from
+  // an index. It is used by the TaQL command <src>show explain</src>.
+  // </synopsis>
+
+  class TableParseIndex
+  {
+  public:
+    // Analyze the WHERE expression for the given table.
+    // No index is used if <src>useIndex</src> is False.
+    TableParseIndex (const Table& table, const TableExprNode& where,
+                     Bool useIndex, Bool makeIndex);
+
+    ~TableParseIndex();
+
+    // Restrict the selection to the given rows (in ascending order).
+    // It is used to evaluate the WHERE only for the rows matched by a join.
+    void setRows (const Vector<rownr_t>& rows);
+
+    // Is any predicate served from an index or is the selection restricted?
+    Bool isUsed() const
+      { return !keys_p.empty()  ||  hasRows_p; }
+
+    // Do the selection using the indices and evaluate the remaining
+    // predicates for the rows found. The resulting rows are in ascending
+    // order. At most <src>maxRow</src> rows are selected (0 means all).
+    // It can only be used if <src>isUsed()</src> is True.
+    Table select (rownr_t maxRow);
+
+    // Tell how the WHERE is done. If <src>select</src> has been done,
+    // the number of rows found is shown as well.
+    String explain() const;
+
+  private:
+    // The values or range of an indexed predicate.
+    struct IndexKey {
+      String              column;
+      DataType            dataType;
+      Bool                isRange;
+      std::vector<Int64>  intValues;
+      std::vector<String> strValues;
+      Int64               lower;
+      Int64               upper;
+      Bool                persistent; //# persistent index existed?
+      Int64               nrow;       //# -1 is not evaluated yet
+    };
+
+    // Analyze the predicates in an AND-ed expression.
+    void analyze (const TENShPtr& node);
+
+    // Try to add the predicate as an index key.
+    // False is returned if not possible.
+    Bool addKey (const TENShPtr& node);
+
+    // Can the index on the column be used (possibly after making it)?
+    Bool canUseIndex (const String& column) const;
+
+    // Get the key for a column (making it if not existing yet).
+    IndexKey& getKey (const String& column, DataType dtype, Bool isRange);
+
+    // Get the index for a column (creating it if needed).
+    ColumnsIndex& getIndex (const String& column);
+
+    // Get the (ascending and unique) row numbers matching the key.
+    Vector<rownr_t> lookup (const IndexKey& key);
+
+    // Format a key for function explain.
+    static String keyString (const IndexKey& key);
+
+    Table                  table_p;
+    Bool                   useIndex_p;
+    Bool                   makeIndex_p;
+    std::vector<IndexKey>  keys_p;
+    std::vector<TENShPtr>  remainder_p;
+    std::map<String,std::shared_ptr<ColumnsIndex>> indices_p;
+    Vector<rownr_t>        rows_p;
+    Bool                   hasRows_p;
+    Int64                  nrowScanned_p;   //# -1 is not evaluated yet
+    Int64                  nrowResult_p;    //# -1 is not evaluated yet
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,390 @@
+//# TableParseJoin.cc: Class handling a hash join in a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/TaQL/TableParseJoin.h>
+#include <casacore/tables/TaQL/ExprJoinNode.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <unordered_map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  TableParseJoin::TableParseJoin (const Table& firstTable,
+                                  const Table& joinTable,
+                                  const String& shorthand)
+    : firstTable_p    (firstTable),
+      joinTable_p     (joinTable),
+      shorthand_p     (shorthand),
+      rowMap_p        (new Vector<Int64>()),
+      hashJoinTable_p (joinTable.nrow() <= firstTable.nrow()),
+      nrowProbed_p    (-1),
+      nrowMatched_p   (-1)
+  {}
+
+  TableParseJoin::~TableParseJoin()
+  {}
+
+  void TableParseJoin::addConditionColumn (const TableExprNode& node)
+  {
+    condColumns_p.push_back (node);
+  }
+
+  Bool TableParseJoin::usesJoinTable (const TableExprNode& node) const
+  {
+    std::vector<TableExprNodeRep*> cols;
+    node.getRep()->getColumnNodes (cols);
+    uInt njoin = 0;
+    for (const TableExprNodeRep* col : cols) {
+      for (const TableExprNode& condCol : condColumns_p) {
+        if (col == condCol.getNodeRep()) {
+          njoin++;
+          break;
+        }
+      }
+    }
+    if (njoin > 0  &&  njoin != cols.size()) {
+      throw TableInvExpr ("An operand in the JOIN condition of table " +
+                          shorthand_p + " cannot use columns of the joined"
+                          " and other tables");
+    }
+    if (cols.empty()) {
+      // No columns are used (e.g., t2.rowid()), so look at the table
+      // of the expression. It is ambiguous for a self-join.
+      const Table& tab = node.getRep()->table();
+      return (!tab.isNull()  &&  tab.isSameRoot (joinTable_p)  &&
+              !tab.isSameRoot (firstTable_p));
+    }
+    return njoin > 0;
+  }
+
+  void TableParseJoin::setCondition (const std::vector<TableExprNode>& left,
+                                     const std::vector<TableExprNode>& right)
+  {
+    AlwaysAssert (left.size() == right.size()  &&  !left.empty(), AipsError);
+    for (size_t i=0; i<left.size(); ++i) {
+      Bool leftJoin  = usesJoinTable (left[i]);
+      Bool rightJoin = usesJoinTable (right[i]);
+      if (leftJoin == rightJoin) {
+        throw TableInvExpr ("Each comparison in the JOIN condition of table " +
+                            shorthand_p + " must have one operand using the"
+                            " joined table and one using the other tables");
+      }
+      const TableExprNode& joinKey = (leftJoin ? left[i] : right[i]);
+      const TableExprNode& mainKey = (leftJoin ? right[i] : left[i]);
+      if (! (joinKey.isScalar()  &&  mainKey.isScalar())) {
+        throw TableInvExpr ("The operands in the JOIN condition of table " +
+                            shorthand_p + " must be scalars");
+      }
+      TableExprNodeRep::NodeDataType dtj = joinKey.getNodeRep()->dataType();
+      TableExprNodeRep::NodeDataType dtm = mainKey.getNodeRep()->dataType();
+      KeyType keyType;
+      if (dtj == TableExprNodeRep::NTBool  &&  dtm == dtj) {
+        keyType = KeyBool;
+      } else if (dtj == TableExprNodeRep::NTInt  &&  dtm == dtj) {
+        keyType = KeyInt;
+      } else if ((dtj == TableExprNodeRep::NTInt  ||
+                  dtj == TableExprNodeRep::NTDouble)  &&
+                 (dtm == TableExprNodeRep::NTInt  ||
+                  dtm == TableExprNodeRep::NTDouble)) {
+        keyType = KeyDouble;
+      } else if (dtj == TableExprNodeRep::NTString  &&  dtm == dtj) {
+        keyType = KeyString;
+      } else {
+        throw TableInvExpr ("The operands in the JOIN condition of table " +
+                            shorthand_p + " must both be Bool, numeric"
+                            " (integer or real) or String");
+      }
+      joinKeys_p.push_back (joinKey);
+      mainKeys_p.push_back (mainKey);
+      keyTypes_p.push_back (keyType);
+    }
+    // The condition columns are not needed anymore.
+    condColumns_p.clear();
+  }
+
+  TableExprNode TableParseJoin::makeColumnNode (const TableExprNode& column) const
+  {
+    AlwaysAssert (isFinished(), AipsError);
+    if (column.isScalar()) {
+      return new TableExprNodeJoinColumn (column.getRep(), firstTable_p,
+                                          rowMap_p);
+    }
+    return new TableExprNodeArrayJoinColumn (column.getRep(), firstTable_p,
+                                             rowMap_p);
+  }
+
+  Vector<rownr_t> TableParseJoin::execute (const Vector<rownr_t>& rows)
+  {
+    AlwaysAssert (isFinished(), AipsError);
+    Vector<rownr_t> matched;
+    if (keyTypes_p.size() == 1  &&  keyTypes_p[0] != KeyDouble  &&
+        keyTypes_p[0] != KeyString) {
+      matched.reference (doJoin<Int64> (rows));
+    } else {
+      matched.reference (doJoin<std::string> (rows));
+    }
+    nrowProbed_p  = rows.size();
+    nrowMatched_p = matched.size();
+    return matched;
+  }
+
+  template<typename K>
+  Vector<rownr_t> TableParseJoin::doJoin (const Vector<rownr_t>& rows)
+  {
+    Vector<Int64>& rowMap = *rowMap_p;
+    rowMap.resize (firstTable_p.nrow());
+    rowMap = -1;
+    Vector<rownr_t> joinRows(joinTable_p.nrow());
+    indgen (joinRows);
+    const rownr_t batchSize = TableExprNodeRep::BatchSize;
+    std::vector<K> keys;
+    // Put the keys of the smallest table in the hash table.
+    hashJoinTable_p = (joinRows.size() <= rows.size());
+    if (hashJoinTable_p) {
+      // A key occurring multiple times is marked by -1, because it cannot
+      // be used for a match.
+      std::unordered_map<K,Int64> map;
+      map.reserve (joinRows.size());
+      for (rownr_t st=0; st<joinRows.size(); st+=batchSize) {
+        Vector<rownr_t> blkRows
+          (joinRows(Slice(st, std::min(batchSize, joinRows.size()-st))));
+        getKeys (joinKeys_p, blkRows, keys);
+        for (size_t i=0; i<keys.size(); ++i) {
+          if (validKey(keys[i])) {
+            auto res = map.emplace (keys[i], Int64(blkRows[i]));
+            if (! res.second) {
+              res.first->second = -1;
+            }
+          }
+        }
+      }
+      // Probe the hash table with the keys of the first table.
+      for (rownr_t st=0; st<rows.size(); st+=batchSize) {
+        Vector<rownr_t> blkRows
+          (rows(Slice(st, std::min(batchSize, rows.size()-st))));
+        getKeys (mainKeys_p, blkRows, keys);
+        for (size_t i=0; i<keys.size(); ++i) {
+          if (validKey(keys[i])) {
+            auto iter = map.find (keys[i]);
+            if (iter != map.end()) {
+              if (iter->second < 0) {
+                throwMultipleMatch (blkRows[i]);
+              }
+              rowMap[blkRows[i]] = iter->second;
+            }
+          }
+        }
+      }
+    } else {
+      // Put the keys of the first table in the hash table. Rows with
+      // the same key are chained (map gives the head of the chain).
+      std::unordered_map<K,Int64> map;
+      std::vector<Int64> next(rows.size(), -1);
+      for (rownr_t st=0; st<rows.size(); st+=batchSize) {
+        Vector<rownr_t> blkRows
+          (rows(Slice(st, std::min(batchSize, rows.size()-st))));
+        getKeys (mainKeys_p, blkRows, keys);
+        for (size_t i=0; i<keys.size(); ++i) {
+          if (validKey(keys[i])) {
+            Int64 inx = st+i;
+            auto res = map.emplace (keys[i], inx);
+            if (! res.second) {
+              next[inx] = res.first->second;
+              res.first->second = inx;
+            }
+          }
+        }
+      }
+      // Probe with the joined table. A key matched before means that
+      // the rows of the first table match multiple rows.
+      for (rownr_t st=0; st<joinRows.size(); st+=batchSize) {
+        Vector<rownr_t> blkRows
+          (joinRows(Slice(st, std::min(batchSize, joinRows.size()-st))));
+        getKeys (joinKeys_p, blkRows, keys);
+        for (size_t i=0; i<keys.size(); ++i) {
+          if (validKey(keys[i])) {
+            auto iter = map.find (keys[i]);
+            if (iter != map.end()) {
+              if (rowMap[rows[iter->second]] >= 0) {
+                throwMultipleMatch (rows[iter->second]);
+              }
+              for (Int64 inx=iter->second; inx>=0; inx=next[inx]) {
+                rowMap[rows[inx]] = blkRows[i];
+              }
+            }
+          }
+        }
+      }
+    }
+    // Collect the rows having a match.
+    std::vector<rownr_t> matched;
+    matched.reserve (rows.size());
+    for (rownr_t row : rows) {
+      if (rowMap[row] >= 0) {
+        matched.push_back (row);
+      }
+    }
+    return Vector<rownr_t>(matched);
+  }
+
+  void TableParseJoin::throwMultipleMatch (rownr_t row) const
+  {
+    throw TableInvExpr ("Row " + String::toString(row) + " of the first"
+                        " table matches multiple rows of the joined table " +
+                        shorthand_p + "; only a join with at most one"
+                        " matching row is supported");
+  }
+
+  void TableParseJoin::getKeys (const std::vector<TableExprNode>& nodes,
+                                const Vector<rownr_t>& rows,
+                                std::vector<Int64>& keys) const
+  {
+    keys.resize (rows.size());
+    if (keyTypes_p[0] == KeyBool) {
+      Vector<Bool> values;
+      nodes[0].getBoolBatch (rows, values);
+      std::copy (values.begin(), values.end(), keys.begin());
+    } else {
+      Vector<Int64> values;
+      nodes[0].getIntBatch (rows, values);
+      std::copy (values.begin(), values.end(), keys.begin());
+    }
+  }
+
+  void TableParseJoin::getKeys (const std::vector<TableExprNode>& nodes,
+                                const Vector<rownr_t>& rows,
+                                std::vector<std::string>& keys) const
+  {
+    keys.assign (rows.size(), std::string());
+    std::vector<Bool> invalid(rows.size(), False);
+    Vector<Bool>   bvalues;
+    Vector<Int64>  ivalues;
+    Vector<Double> dvalues;
+    for (size_t k=0; k<nodes.size(); ++k) {
+      switch (keyTypes_p[k]) {
+      case KeyBool:
+        nodes[k].getBoolBatch (rows, bvalues);
+        for (size_t i=0; i<rows.size(); ++i) {
+          keys[i].push_back (bvalues[i] ? '1' : '0');
+        }
+        break;
+      case KeyInt:
+        nodes[k].getIntBatch (rows, ivalues);
+        for (size_t i=0; i<rows.size(); ++i) {
+          keys[i].append (reinterpret_cast<const char*>(&ivalues[i]),
+                          sizeof(Int64));
+        }
+        break;
+      case KeyDouble:
+        // An integer operand is kept as an integer. An integral real value
+        // fitting in an Int64 is converted to an integer, so integers and
+        // reals are compared exactly (also beyond 2^53).
+        // A character tells if an integer or real value follows.
+        if (nodes[k].getNodeRep()->dataType() == TableExprNodeRep::NTInt) {
+          nodes[k].getIntBatch (rows, ivalues);
+          for (size_t i=0; i<rows.size(); ++i) {
+            keys[i].push_back ('i');
+            keys[i].append (reinterpret_cast<const char*>(&ivalues[i]),
+                            sizeof(Int64));
+          }
+        } else {
+          // The range of Doubles that can be converted to an Int64.
+          static const Double minInt64 = -std::ldexp (1., 63);
+          static const Double maxInt64 =  std::ldexp (1., 63);
+          nodes[k].getDoubleBatch (rows, dvalues);
+          for (size_t i=0; i<rows.size(); ++i) {
+            Double value = dvalues[i];
+            if (isNaN(value)) {
+              invalid[i] = True;
+            }
+            if (value >= minInt64  &&  value < maxInt64  &&
+                value == std::floor(value)) {
+              // Note that -0 and 0 become equal.
+              Int64 ivalue = Int64(value);
+              keys[i].push_back ('i');
+              keys[i].append (reinterpret_cast<const char*>(&ivalue),
+                              sizeof(Int64));
+            } else {
+              keys[i].push_back ('d');
+              keys[i].append (reinterpret_cast<const char*>(&value),
+                              sizeof(Double));
+            }
+          }
+        }
+        break;
+      case KeyString:
+        for (size_t i=0; i<rows.size(); ++i) {
+          String value = nodes[k].getString (rows[i]);
+          uInt64 size = value.size();
+          keys[i].append (reinterpret_cast<const char*>(&size),
+                          sizeof(uInt64));
+          keys[i].append (value);
+        }
+        break;
+      }
+    }
+    for (size_t i=0; i<rows.size(); ++i) {
+      if (invalid[i]) {
+        keys[i].clear();
+      }
+    }
+  }
+
+  String TableParseJoin::explain() const
+  {
+    static const char* typeNames[] = {"Bool", "Int", "Double", "String"};
+    std::ostringstream os;
+    os << "JOIN table " << joinTable_p.tableName();
+    if (! shorthand_p.empty()) {
+      os << " (" << shorthand_p << ')';
+    }
+    os << " with " << joinTable_p.nrow() << " rows on "
+       << keyTypes_p.size() << " key" << (keyTypes_p.size() == 1 ? "" : "s")
+       << " (";
+    for (size_t i=0; i<keyTypes_p.size(); ++i) {
+      if (i > 0) {
+        os << ',';
+      }
+      os << typeNames[keyTypes_p[i]];
+    }
+    os << ')' << endl;
+    os << "  hash   the keys of the "
+       << (hashJoinTable_p ? "joined" : "first") << " table" << endl;
+    if (nrowProbed_p >= 0) {
+      os << "  result " << nrowMatched_p << " of " << nrowProbed_p
+         << " rows have a match" << endl;
+    }
+    return os.str();
+  }
+
+} //# NAMESPACE CASACORE - END
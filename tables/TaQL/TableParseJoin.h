@@ -0,0 +1,190 @@
+//# TableParseJoin.h: Class handling a hash join in a TaQL query
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TABLEPARSEJOIN_H
+#define TABLES_TABLEPARSEJOIN_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  // <summary>
+  // Class handling a join of a table in a TaQL query
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tTableParseJoin">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //   <li> <linkto class=TableParseQuery>TableParseQuery</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // This class is used by TableParseQuery to handle a
+  // <src>JOIN table ON condition</src> clause. The condition has to consist
+  // of one or more AND-ed equality comparisons, each comparing an
+  // expression of the joined table with an expression of the other tables
+  // (the key). For example:
+  // <srcblock>
+  //   select t1.TIME, t2.NAME from my.ms t1
+  //     join my.ms::FIELD t2 on t1.FIELD_ID == t2.rowid()
+  // </srcblock>
+  // The join is done as a hash join. The keys of the smaller of the two
+  // tables are put in a hash table, which is probed with the keys of
+  // the other table. The keys are evaluated in blocks of rows using the
+  // batch get functions of the expression nodes.
+  // <br>The result is a mapping of the rows in the first table to the
+  // matching rows in the joined table. A column of the joined table used
+  // in the query is represented by a
+  // <linkto class=TableExprNodeJoinColumn>TableExprNodeJoinColumn</linkto>
+  // using this mapping. It is an inner join, thus rows in the first table
+  // without a matching row are not part of the query result. A row in the
+  // first table can match at most one row in the joined table (thus the
+  // keys in the joined table have to be unique); otherwise an exception
+  // is thrown.
+  // <p>
+  // A key can be a Bool, integer, floating point or String expression.
+  // An integer and a floating point key can be compared. They are compared
+  // exactly, thus also integers beyond 2^53 are handled correctly.
+  // </synopsis>
+
+  class TableParseJoin
+  {
+  public:
+    // Create the join of the first table in a query with the given table.
+    TableParseJoin (const Table& firstTable, const Table& joinTable,
+                    const String& shorthand);
+
+    ~TableParseJoin();
+
+    // Get the shorthand of the joined table.
+    const String& shorthand() const
+      { return shorthand_p; }
+
+    // Get the joined table.
+    const Table& joinTable() const
+      { return joinTable_p; }
+
+    // Is the join condition given (thus the join fully defined)?
+    Bool isFinished() const
+      { return ! joinKeys_p.empty(); }
+
+    // Register a column node of the joined table used in the join condition.
+    void addConditionColumn (const TableExprNode& node);
+
+    // Set the join condition given as the operands of its AND-ed equality
+    // comparisons. It finds out which operand is the key in the joined
+    // table. An exception is thrown if the condition cannot be used.
+    void setCondition (const std::vector<TableExprNode>& left,
+                       const std::vector<TableExprNode>& right);
+
+    // Make a node for a column of the joined table giving the value
+    // in the row matching the row in the first table.
+    TableExprNode makeColumnNode (const TableExprNode& column) const;
+
+    // Execute the join for the given rows of the first table.
+    // It returns the rows having a match (in ascending order).
+    // An exception is thrown if a row matches multiple rows in the
+    // joined table.
+    Vector<rownr_t> execute (const Vector<rownr_t>& rows);
+
+    // Tell how the join is done. If <src>execute</src> has been done,
+    // the number of rows having a match is shown as well.
+    String explain() const;
+
+  private:
+    // The data types of the keys.
+    enum KeyType {
+      KeyBool,
+      KeyInt,
+      KeyDouble,
+      KeyString
+    };
+
+    // Does the expression refer to the joined table?
+    // An exception is thrown if it refers to both tables.
+    Bool usesJoinTable (const TableExprNode& node) const;
+
+    // Do the join using keys of the given type.
+    template<typename K>
+    Vector<rownr_t> doJoin (const Vector<rownr_t>& rows);
+
+    // Throw an exception telling that a row of the first table matches
+    // multiple rows in the joined table.
+    void throwMultipleMatch (rownr_t row) const;
+
+    // Get the keys for a block of rows.
+    // A single Bool or integer key is kept as an Int64. Otherwise the
+    // key values are serialized into a string, which is empty if the key
+    // contains a NaN (which matches nothing). An integral real value is
+    // serialized as an integer, so it can match an integer key exactly.
+    // <group>
+    void getKeys (const std::vector<TableExprNode>& nodes,
+                  const Vector<rownr_t>& rows,
+                  std::vector<Int64>& keys) const;
+    void getKeys (const std::vector<TableExprNode>& nodes,
+                  const Vector<rownr_t>& rows,
+                  std::vector<std::string>& keys) const;
+    // </group>
+
+    // Test if a key can be matched.
+    // <group>
+    static Bool validKey (Int64)
+      { return True; }
+    static Bool validKey (const std::string& key)
+      { return ! key.empty(); }
+    // </group>
+
+    //# Data members
+    Table                          firstTable_p;
+    Table                          joinTable_p;
+    String                         shorthand_p;
+    std::vector<TableExprNode>     condColumns_p;
+    std::vector<TableExprNode>     mainKeys_p;
+    std::vector<TableExprNode>     joinKeys_p;
+    std::vector<KeyType>           keyTypes_p;
+    std::shared_ptr<Vector<Int64>> rowMap_p;
+    Bool                           hashJoinTable_p;
+    Int64                          nrowProbed_p;   //# -1 is not executed yet
+    Int64                          nrowMatched_p;  //# -1 is not executed yet
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -109,7 +109,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
             }
           }
           // Get the keywords for this column (to copy unit, etc.)
-          TableColumn tabcol(columnExpr_p[nrcol].table(), oldName);
+          // A column of a joined table acts as a column in the first table.
+          Table keyTable = columnExpr_p[nrcol].table();
+          if (inx >= 0) {
+            TableParseJoin* join = tpq.findJoin (str.before(inx));
+            if (join) {
+              keyTable = join->joinTable();
+            }
+          }
+          TableColumn tabcol(keyTable, oldName);
           columnKeywords_p[nrcol] = tabcol.keywordSet();
         }
       } else {
@@ -809,6 +817,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
           }
         }
       }
+      // A column of a joined table is handled differently.
+      TableParseJoin* join = tpq.findJoin (shand);
+      if (join) {
+        return handleJoinCol (*join, tab, name, columnName, fieldNames, tpq);
+      }
       // If it is a column, check if all tables used have the same size.
       // Note: the projected table (used above) should not be checked.
       if (tab.tableDesc().isColumn (columnName)) {
@@ -843,6 +856,33 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return TableExprNode::newKeyConst (col.keywordSet(), fieldNames);
   }
 
+  TableExprNode TableParseProject::handleJoinCol (TableParseJoin& join,
+                                                  const Table& tab,
+                                                  const String& name,
+                                                  const String& columnName,
+                                                  const Vector<String>& fieldNames,
+                                                  TableParseQuery& tpq)
+  {
+    TableExprNode node;
+    try {
+      node = tab.keyCol (columnName, fieldNames);
+    } catch (const TableError&) {
+      throw TableInvExpr(name + " is an unknown column (or keyword) in table "
+                         + tab.tableName());
+    }
+    if (! node.getNodeRep()->isConstant()) {
+      if (join.isFinished()) {
+        // Use the row in the joined table matching the row in the first table.
+        node = join.makeColumnNode (node);
+        tpq.addApplySelNode (node);
+      } else {
+        // The column is used in the join condition.
+        join.addConditionColumn (node);
+      }
+    }
+    return node;
+  }
+
   Table TableParseProject::project (const Table& tab)
   {
     // First do projection using the original column names.
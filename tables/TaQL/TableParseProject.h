@@ -42,6 +42,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   //# Forward Declarations
   class TableParseUpdate;
+  class TableParseJoin;
   class TableExprGroupResult;
 
 
@@ -168,6 +169,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void checkCountColumns() const;
     
   private:
+    // Create the node for a column of a joined table.
+    // While the join condition is handled, the column node of the joined
+    // table is returned and registered in the join. Thereafter it is a node
+    // giving the value in the row matching the row in the first table.
+    TableExprNode handleJoinCol (TableParseJoin& join, const Table& tab,
+                                 const String& name, const String& columnName,
+                                 const Vector<String>& fieldNames,
+                                 TableParseQuery& tpq);
+
     // Make the (empty) table for the expression in the SELECT clause.
     Table makeProjectExprTable (TableParseQuery&);
 
@@ -28,6 +28,7 @@
 #include <casacore/tables/TaQL/TableParseQuery.h>
 #include <casacore/tables/TaQL/TableParseFunc.h>
 #include <casacore/tables/TaQL/TableParseUtil.h>
+#include <casacore/tables/TaQL/TableParseIndex.h>
 #include <casacore/tables/TaQL/TaQLNode.h>
 #include <casacore/tables/TaQL/TaQLStyle.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
@@ -58,8 +59,10 @@
 #include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/ostream.h>
 #include <algorithm>
+#include <exception>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -81,7 +84,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       stride_p        (1),
       insSel_p        (0),
       noDupl_p        (False),
-      order_p         (Sort::Ascending)
+      order_p         (Sort::Ascending),
+      nthreads_p      (1),
+      useIndex_p      (True),
+      makeIndex_p     (False)
   {}
 
   TableParseQuery::~TableParseQuery()
@@ -598,12 +604,62 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // If needed, make the expression's unit the same as the column unit.
       key.adaptUnit (TableExprNodeColumn::getColumnUnit (cols[i]));
     }
-    // Loop through all rows in the table and update each row.
-    TableExprIdAggr rowid(groups);
-    for (rownr_t row=0; row<rownrs.size(); ++row) {
-      rowid.setRownr (rownrs[row]);
-      for (uInt i=0; i<nrkey; i++) {
-        update_p[i]->updateColumn (cols[i], maskCols[i], row, rowid);
+    // If no aggregation is done and all columns are scalars with a simple
+    // expression, the expressions are evaluated for a block of rows at a time.
+    Bool useBatch = groups.null();
+    for (uInt i=0; i<nrkey  &&  useBatch; i++) {
+      useBatch = update_p[i]->canUpdateBatch (cols[i]);
+    }
+    if (useBatch) {
+      // The blocks can be done in parallel if all expressions allow it.
+      // The tables used are read (and written) concurrently, so their
+      // data managers are locked when accessed by multiple threads.
+      uInt nthr = (nthreads_p == 0  ?  OMP::maxThreads() : nthreads_p);
+      TableExprConcurrentRead concurrentRead;
+      for (uInt i=0; i<nrkey  &&  nthr > 1; i++) {
+        if (! update_p[i]->isParallelSafe()) {
+          nthr = 1;
+        }
+      }
+      if (nthr > 1) {
+        Bool ok = concurrentRead.add (updTable);
+        for (uInt i=0; i<nrkey  &&  ok; i++) {
+          ok = concurrentRead.add (update_p[i]->node().getRep());
+        }
+        if (! ok) {
+          nthr = 1;
+        }
+      }
+      const rownr_t batchSize = TableExprNodeRep::BatchSize;
+      Int64 nblk = (rownrs.size() + batchSize - 1) / batchSize;
+      std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthr) schedule(dynamic) if (nthr > 1)
+      for (Int64 blk=0; blk<nblk; ++blk) {
+        try {
+          rownr_t st = blk * batchSize;
+          rownr_t nr = std::min (rownrs.size() - st, batchSize);
+          Vector<rownr_t> rows(nr);
+          indgen (rows, st);
+          Vector<rownr_t> exprRownrs (rownrs(Slice(st, nr)));
+          for (uInt i=0; i<nrkey; i++) {
+            update_p[i]->updateColumnBatch (cols[i], rows, exprRownrs);
+          }
+        } catch (...) {
+#pragma omp critical(TableParseQuery_doUpdate)
+          excp = std::current_exception();
+        }
+      }
+      if (excp) {
+        std::rethrow_exception (excp);
+      }
+    } else {
+      // Loop through all rows in the table and update each row.
+      TableExprIdAggr rowid(groups);
+      for (rownr_t row=0; row<rownrs.size(); ++row) {
+        rowid.setRownr (rownrs[row]);
+        for (uInt i=0; i<nrkey; i++) {
+          update_p[i]->updateColumn (cols[i], maskCols[i], row, rowid);
+        }
       }
     }
     if (showTimings) {
@@ -775,7 +831,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   (Bool showTimings)
   {
     Timer timer;
-    CountedPtr<TableExprGroupResult> result = groupby_p.execGroupAggr(rownrs_p);
+    CountedPtr<TableExprGroupResult> result = groupby_p.execGroupAggr(rownrs_p, nthreads_p);
     if (showTimings) {
       timer.show ("  Groupby     ");
     }
@@ -1175,7 +1231,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
     //# Give an error if no command part has been given.
     if (mustSelect  &&  commandType_p == PSELECT
-        &&  node_p.isNull()  &&  sort_p.size() == 0
+        &&  node_p.isNull()  &&  joins_p.empty()  &&  sort_p.size() == 0
         &&  tableProject_p.getColumnNames().empty()  &&  resultSet_p == 0
         &&  limit_p == 0  &&  endrow_p == 0  &&  stride_p == 1  &&  offset_p == 0) {
       throw (TableInvExpr
@@ -1230,8 +1286,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         cerr << "pre-empt WHERE at " << nrmax << " rows" << endl;
       }
     }
-    //# First do the where selection.
+    //# First do the joins and the where selection.
     Table resultTable(table);
+    Vector<rownr_t> joinRows;
+    Bool useJoinRows = doJoins (table, joinRows, showTimings, doTracing);
     if (! node_p.isNull()) {
       //#//        cout << "Showing TableExprRange values ..." << endl;
       //#//        Block<TableExprRange> rang;
@@ -1241,13 +1299,29 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       //#//                 << rang[i].end() << endl;
       //#//        }
       Timer timer;
-      resultTable = table(node_p, nrmax);
+      // Use column indices for the predicates if possible.
+      // The rows not matched by a join do not need to be evaluated.
+      TableParseIndex index(table, node_p, useIndex_p, makeIndex_p);
+      if (useJoinRows) {
+        index.setRows (joinRows);
+      }
+      if (index.isUsed()) {
+        resultTable = index.select (nrmax);
+      } else {
+        resultTable = table(node_p, nrmax, 0, nthreads_p);
+      }
       if (showTimings) {
         timer.show ("  Where       ");
       }
       if (doTracing) {
+        cerr << index.explain();
         cerr << "WHERE resulted in " << resultTable.nrow() << " rows" << endl;
       }
+    } else if (useJoinRows) {
+      if (nrmax > 0  &&  joinRows.size() > nrmax) {
+        joinRows.resize (nrmax, True);
+      }
+      resultTable = table(joinRows);
     }
     // Get the row numbers of the result of the possible first step.
     rownrs_p.reference (resultTable.rowNumbers(table));
@@ -1412,6 +1486,68 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  TableParseJoin& TableParseQuery::addJoin (const Table& table,
+                                            const String& shorthand)
+  {
+    if (shorthand.empty()) {
+      throw TableInvExpr ("A shorthand has to be given for joined table " +
+                          table.tableName());
+    }
+    joins_p.push_back (std::make_shared<TableParseJoin>
+                       (tableList_p.first(), table, shorthand));
+    return *joins_p.back();
+  }
+
+  TableParseJoin* TableParseQuery::findJoin (const String& shorthand) const
+  {
+    // The first table cannot be joined.
+    if (! shorthand.empty()) {
+      for (const std::shared_ptr<TableParseJoin>& join : joins_p) {
+        if (join->shorthand() == shorthand) {
+          return join.get();
+        }
+      }
+    }
+    return 0;
+  }
+
+  Bool TableParseQuery::doJoins (const Table& table, Vector<rownr_t>& rows,
+                                 Bool showTimings, Bool doTracing)
+  {
+    if (joins_p.empty()) {
+      return False;
+    }
+    Timer timer;
+    // A join only needs to be done for the rows matched by previous joins.
+    rows.resize (table.nrow());
+    indgen (rows);
+    for (const std::shared_ptr<TableParseJoin>& join : joins_p) {
+      rows.reference (join->execute (rows));
+      if (doTracing) {
+        cerr << join->explain();
+      }
+    }
+    if (showTimings) {
+      timer.show ("  Join        ");
+    }
+    return rows.size() < table.nrow();
+  }
+
+  String TableParseQuery::explain() const
+  {
+    String info;
+    for (const std::shared_ptr<TableParseJoin>& join : joins_p) {
+      info += join->explain();
+    }
+    if (node_p.isNull()) {
+      return info + "No WHERE clause given\n";
+    }
+    TableParseIndex index(tableList_p.first(), node_p,
+                          useIndex_p, makeIndex_p);
+    return info + index.explain();
+  }
+
+
   void TableParseQuery::show (ostream& os) const
   {
     if (! node_p.isNull()) {
@@ -35,6 +35,7 @@
 #include <casacore/tables/TaQL/TableParseUpdate.h>
 #include <casacore/tables/TaQL/TableParseSortKey.h>
 #include <casacore/tables/TaQL/TableParseGroupby.h>
+#include <casacore/tables/TaQL/TableParseJoin.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprGroup.h>
@@ -42,6 +43,7 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Containers/Block.h>
+#include <memory>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -296,6 +298,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void setDMInfo (const Record& dminfo)
       { tableProject_p.setDMInfo (dminfo); }
 
+    // Set the number of threads to use for evaluating the WHERE expression
+    // and the projection (0 means all cores).
+    void setNThreads (uInt nthreads)
+      { nthreads_p = nthreads; }
+
+    // Set if column indices can be used for the WHERE expression and if
+    // missing indices can be made (see class TableParseIndex).
+    void setUseIndex (Bool useIndex, Bool makeIndex)
+      { useIndex_p = useIndex; makeIndex_p = makeIndex; }
+
     // Get the projected column names.
     const Block<String>& getColumnNames() const
       { return tableProject_p.getColumnNames(); }
@@ -307,6 +319,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Show the structure of fromTables_p[0] using the options given in parts[2:].
     String getTableInfo (const Vector<String>& parts, const TaQLStyle& style);
 
+    // Add a join of the first table with the given table.
+    // The join condition has to be set in the returned object.
+    TableParseJoin& addJoin (const Table& table, const String& shorthand);
+
+    // Find the join for the table with the given shorthand.
+    // A null pointer is returned if the table is not joined.
+    TableParseJoin* findJoin (const String& shorthand) const;
+
+    // Tell how the joins and WHERE expression would be done; i.e., which
+    // predicates can be served from an index. It is used by 'show explain'.
+    String explain() const;
+
     // Add a column node to applySelNodes_p.
     void addApplySelNode (const TableExprNode& node)
       { applySelNodes_p.push_back (node); }
@@ -360,6 +384,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // It returns the Table containing the subset of rows in the input Table.
     Table adjustApplySelNodes (const Table&);
 
+    // Do the joins (if any) for all rows in the table.
+    // It fills the rows having a match in all joins. False is returned
+    // if all rows match, thus if no selection of rows is needed.
+    Bool doJoins (const Table& table, Vector<rownr_t>& rows,
+                  Bool showTimings, Bool doTracing);
+
     // Do the groupby/aggregate step and return its result.
     CountedPtr<TableExprGroupResult> doGroupby (bool showTimings);
 
@@ -435,6 +465,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool  noDupl_p;
     //# The default sort order.
     Sort::Order order_p;
+    //# The number of threads to use (0 means all cores).
+    uInt nthreads_p;
+    //# Can column indices be used and made for the WHERE expression?
+    Bool useIndex_p;
+    Bool makeIndex_p;
+    //# The tables joined with the first table.
+    std::vector<std::shared_ptr<TableParseJoin>> joins_p;
     //# All nodes that need to be adjusted for a selection of rownrs.
     //# It can consist of column nodes and the rowid function node.
     //# Some nodes (in aggregate functions) can later be disabled for adjustment.
@@ -31,7 +31,9 @@
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/TableError.h>
 
 
@@ -135,6 +137,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     col.putScalar (row, value);
   }
 
+  template<typename TCOL, typename TNODE>
+  void TableParseUpdate::updateScalarBatch (const Vector<rownr_t>& rows,
+                                            const Vector<rownr_t>& exprRownrs,
+                                            TableColumn& col)
+  {
+    Vector<TNODE> vals;
+    node_p.getRep()->getBatch (exprRownrs, vals);
+    Vector<TCOL> values(vals.size());
+    for (size_t i=0; i<vals.size(); ++i) {
+      values[i] = static_cast<TCOL>(vals[i]);
+    }
+    ScalarColumn<TCOL> scol(col);
+    scol.putColumnCells (RefRows(rows, False, True), values);
+  }
+
   template<typename TCOL, typename TNODE>
   void TableParseUpdate::updateArray (rownr_t row, const TableExprId& rowid,
                                       const TableExprNode& node,
@@ -509,6 +526,93 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableParseUpdate::canUpdateBatch (const TableColumn& col) const
+  {
+    if (indexPtr_p != 0  ||  ! mask_p.isNull()  ||
+        ! columnNameMask_p.empty()  ||  ! node_p.isScalar()  ||
+        ! col.columnDesc().isScalar()) {
+      return False;
+    }
+    DataType colType = col.columnDesc().dataType();
+    switch (node_p.getNodeRep()->dataType()) {
+    case TableExprNodeRep::NTBool:
+      return colType == TpBool;
+    case TableExprNodeRep::NTInt:
+    case TableExprNodeRep::NTDouble:
+      return (colType == TpUChar  ||  colType == TpShort  ||
+              colType == TpUShort  ||  colType == TpInt  ||
+              colType == TpUInt  ||  colType == TpInt64  ||
+              colType == TpFloat  ||  colType == TpDouble);
+    default:
+      break;
+    }
+    return False;
+  }
+
+  void TableParseUpdate::updateColumnBatch (TableColumn& col,
+                                            const Vector<rownr_t>& rows,
+                                            const Vector<rownr_t>& exprRownrs)
+  {
+    AlwaysAssert (canUpdateBatch(col), AipsError);
+    if (node_p.getNodeRep()->dataType() == TableExprNodeRep::NTBool) {
+      updateScalarBatch<Bool,Bool> (rows, exprRownrs, col);
+    } else if (node_p.getNodeRep()->dataType() == TableExprNodeRep::NTInt) {
+      switch (col.columnDesc().dataType()) {
+      case TpUChar:
+        updateScalarBatch<uChar,Int64> (rows, exprRownrs, col);
+        break;
+      case TpShort:
+        updateScalarBatch<Short,Int64> (rows, exprRownrs, col);
+        break;
+      case TpUShort:
+        updateScalarBatch<uShort,Int64> (rows, exprRownrs, col);
+        break;
+      case TpInt:
+        updateScalarBatch<Int,Int64> (rows, exprRownrs, col);
+        break;
+      case TpUInt:
+        updateScalarBatch<uInt,Int64> (rows, exprRownrs, col);
+        break;
+      case TpInt64:
+        updateScalarBatch<Int64,Int64> (rows, exprRownrs, col);
+        break;
+      case TpFloat:
+        updateScalarBatch<Float,Int64> (rows, exprRownrs, col);
+        break;
+      default:
+        updateScalarBatch<Double,Int64> (rows, exprRownrs, col);
+        break;
+      }
+    } else {
+      switch (col.columnDesc().dataType()) {
+      case TpUChar:
+        updateScalarBatch<uChar,Double> (rows, exprRownrs, col);
+        break;
+      case TpShort:
+        updateScalarBatch<Short,Double> (rows, exprRownrs, col);
+        break;
+      case TpUShort:
+        updateScalarBatch<uShort,Double> (rows, exprRownrs, col);
+        break;
+      case TpInt:
+        updateScalarBatch<Int,Double> (rows, exprRownrs, col);
+        break;
+      case TpUInt:
+        updateScalarBatch<uInt,Double> (rows, exprRownrs, col);
+        break;
+      case TpInt64:
+        updateScalarBatch<Int64,Double> (rows, exprRownrs, col);
+        break;
+      case TpFloat:
+        updateScalarBatch<Float,Double> (rows, exprRownrs, col);
+        break;
+      default:
+        updateScalarBatch<Double,Double> (rows, exprRownrs, col);
+        break;
+      }
+    }
+  }
+
   void TableParseUpdate::check (const Table& origTable,
                                 const Table& updTable) const
   {
@@ -110,6 +110,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void setColumnNameMask (const String& name)
       { columnNameMask_p = name; }
 
+    // Get the node expression.
+    const TableExprNode& node() const
+      { return node_p; }
+
     // Get the column name.
     const String& columnName() const
       { return columnName_p; }
@@ -134,6 +138,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void updateColumn (TableColumn& col, ArrayColumn<Bool>& maskCol,
                        rownr_t row, const TableExprId& rowid);
 
+    // Can the column be updated for a block of rows at a time?
+    // That is possible if a scalar Bool or real expression without
+    // subscripts or mask is put into a scalar column.
+    Bool canUpdateBatch (const TableColumn& col) const;
+
+    // Can the expression be evaluated by multiple threads at the same time?
+    Bool isParallelSafe() const
+      { return node_p.getNodeRep()->isParallelSafe(); }
+
+    // Update the values in the given rows of the column with the values
+    // of the node_p expression evaluated for the given expression rows.
+    // It can only be used if <src>canUpdateBatch</src> returns True.
+    // It can be called by multiple threads for different rows if
+    // <src>isParallelSafe</src> returns True and the tables are read
+    // concurrently (see TableExprConcurrentRead).
+    void updateColumnBatch (TableColumn& col, const Vector<rownr_t>& rows,
+                            const Vector<rownr_t>& exprRownrs);
+
   private:
     // Update the values in the columns (helpers of updateColumn).
     // It converts the data type of the expression to that opf the column.
@@ -149,6 +171,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                        const TableExprNode& node,
                        TableColumn& col);
     template<typename TCOL, typename TNODE>
+    void updateScalarBatch (const Vector<rownr_t>& rows,
+                            const Vector<rownr_t>& exprRownrs,
+                            TableColumn& col);
+    template<typename TCOL, typename TNODE>
     void updateArray (rownr_t row, const TableExprId& rowid,
                       const TableExprNode& node,
                       const Array<TNODE>& res,
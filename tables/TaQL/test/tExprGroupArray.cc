@@ -33,6 +33,12 @@
 #include <casacore/tables/TaQL/ExprGroupAggrFuncArray.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
@@ -295,6 +301,66 @@ void doDComplexArr()
              recs, arr, "gaggr");
 }
 
+// Test the aggregation of Float and Complex array columns which are
+// accumulated directly from the column's buffer, also with a mask.
+void doColumnArr()
+{
+  cout << "Test array columns" << endl;
+  const uInt nrow = 10;
+  const uInt nelem = 4;
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float>   ("FDATA", IPosition(1,nelem)));
+  td.addColumn (ArrayColumnDesc<Complex> ("CDATA", IPosition(1,nelem)));
+  td.addColumn (ArrayColumnDesc<Bool>    ("FLAG", IPosition(1,nelem)));
+  SetupNewTable newtab("tExprGroupArray_tmp.tab", td, Table::New);
+  Table tab(newtab, nrow);
+  ArrayColumn<Float> fdata(tab, "FDATA");
+  ArrayColumn<Complex> cdata(tab, "CDATA");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Vector<Float> fv(nelem);
+  Vector<Complex> cv(nelem);
+  Vector<Bool> flv(nelem);
+  Vector<Double> sums(nelem, 0.);
+  Double sumUnflagged = 0;
+  Int64 nUnflagged = 0;
+  for (uInt i=0; i<nrow; ++i) {
+    for (uInt j=0; j<nelem; ++j) {
+      fv[j]  = Float(i*nelem + j) - 10;
+      cv[j]  = Complex(i, j);
+      flv[j] = (i+j)%3 == 0;
+      sums[j] += fv[j];
+      if (!flv[j]) {
+        sumUnflagged += fv[j];
+        nUnflagged++;
+      }
+    }
+    fdata.put (i, fv);
+    cdata.put (i, cv);
+    flag.put (i, flv);
+  }
+  Table res = tableCommand
+    ("select gsums(FDATA) as S, gmaxs(FDATA) as MX, gmeans(CDATA) as M,"
+     " gsum(FDATA) as SS, gmin(FDATA) as MN, gmean(marray(FDATA,FLAG)) as FM"
+     " from tExprGroupArray_tmp.tab").table();
+  AlwaysAssertExit (res.nrow() == 1);
+  Vector<Double> s = ArrayColumn<Double>(res, "S")(0);
+  Vector<Double> mx = ArrayColumn<Double>(res, "MX")(0);
+  Vector<DComplex> m = ArrayColumn<DComplex>(res, "M")(0);
+  for (uInt j=0; j<nelem; ++j) {
+    if (s[j] != sums[j]  ||  mx[j] != Double((nrow-1)*nelem + j) - 10  ||
+        m[j] != DComplex((nrow-1)/2., j)) {
+      foundError = True;
+      cout << "gsums/gmaxs/gmeans: found " << s << mx << m << endl;
+    }
+  }
+  if (ScalarColumn<Double>(res, "SS")(0) != sum(sums)  ||
+      ScalarColumn<Double>(res, "MN")(0) != -10  ||
+      ScalarColumn<Double>(res, "FM")(0) != sumUnflagged / nUnflagged) {
+    foundError = True;
+    cout << "gsum/gmin/gmean: found unexpected values" << endl;
+  }
+}
+
 
 int main()
 {
@@ -303,6 +369,7 @@ int main()
     doIntArr();
     doDoubleArr();
     doDComplexArr();
+    doColumnArr();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
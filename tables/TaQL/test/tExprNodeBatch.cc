@@ -0,0 +1,185 @@
+//# tExprNodeBatch.cc: Test program for the batch evaluation of expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the batch get functions of the TaQL expression nodes.
+// The results are compared with the row by row evaluation.
+// </summary>
+
+Table makeTable (uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Bool>   ("ab"));
+  td.addColumn (ScalarColumnDesc<Int>    ("ai"));
+  td.addColumn (ScalarColumnDesc<uInt>   ("au"));
+  td.addColumn (ScalarColumnDesc<Float>  ("af"));
+  td.addColumn (ScalarColumnDesc<Double> ("ad"));
+  SetupNewTable newtab("tExprNodeBatch_tmp.tab", td, Table::New);
+  // No AutoLocking, so the table can be read by multiple threads.
+  Table tab(newtab, TableLock(TableLock::PermanentLocking), nrow);
+  ScalarColumn<Bool>   ab(tab, "ab");
+  ScalarColumn<Int>    ai(tab, "ai");
+  ScalarColumn<uInt>   au(tab, "au");
+  ScalarColumn<Float>  af(tab, "af");
+  ScalarColumn<Double> ad(tab, "ad");
+  for (uInt i=0; i<nrow; ++i) {
+    ab.put (i, i%3 == 0);
+    ai.put (i, Int(i%17) - 8);
+    au.put (i, i%5);
+    af.put (i, i%11 * 0.5);
+    ad.put (i, (Int(i%23) - 11) * 1.25);
+  }
+  return tab;
+}
+
+void checkBool (const TableExprNode& expr, const Vector<rownr_t>& rownrs)
+{
+  Vector<Bool> batch;
+  expr.getBoolBatch (rownrs, batch);
+  AlwaysAssertExit (batch.size() == rownrs.size());
+  for (uInt i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (batch[i] == expr.getBool (rownrs[i]));
+  }
+}
+
+void checkInt (const TableExprNode& expr, const Vector<rownr_t>& rownrs)
+{
+  Vector<Int64> batch;
+  expr.getIntBatch (rownrs, batch);
+  AlwaysAssertExit (batch.size() == rownrs.size());
+  for (uInt i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (batch[i] == expr.getInt (rownrs[i]));
+  }
+}
+
+void checkDouble (const TableExprNode& expr, const Vector<rownr_t>& rownrs)
+{
+  Vector<Double> batch;
+  expr.getDoubleBatch (rownrs, batch);
+  AlwaysAssertExit (batch.size() == rownrs.size());
+  for (uInt i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (batch[i] == expr.getDouble (rownrs[i]));
+  }
+}
+
+void checkSelect (const Table& tab, const TableExprNode& expr)
+{
+  Table sel = tab(expr);
+  Vector<rownr_t> rows = sel.rowNumbers();
+  uInt nr = 0;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (expr.getBool(i)) {
+      AlwaysAssertExit (nr < rows.size()  &&  rows[nr] == i);
+      nr++;
+    }
+  }
+  AlwaysAssertExit (nr == rows.size());
+  // Evaluating in parallel must give the same result, also if only
+  // part of the matching rows is selected.
+  for (uInt nthr=0; nthr<5; nthr+=2) {
+    AlwaysAssertExit (allEQ (tab(expr, 0, 0, nthr).rowNumbers(), rows));
+    if (rows.size() > 10) {
+      Vector<rownr_t> part (tab(expr, rows.size()-9, 7, nthr).rowNumbers());
+      AlwaysAssertExit (allEQ (part, rows(Slice(7, rows.size()-9))));
+    }
+    // Concurrent reading is only set while evaluating.
+    AlwaysAssertExit (! tab.isConcurrentRead());
+  }
+}
+
+void doIt (const Table& tab)
+{
+  // Use all rows and a random subset of the rows.
+  Vector<rownr_t> allRows(tab.nrow());
+  indgen (allRows);
+  Vector<rownr_t> someRows(tab.nrow() / 3);
+  for (uInt i=0; i<someRows.size(); ++i) {
+    someRows[i] = (i*7) % tab.nrow();
+  }
+  TableExprNode ab = tab.col("ab");
+  TableExprNode ai = tab.col("ai");
+  TableExprNode au = tab.col("au");
+  TableExprNode af = tab.col("af");
+  TableExprNode ad = tab.col("ad");
+  for (int j=0; j<2; ++j) {
+    const Vector<rownr_t>& rownrs = (j==0 ? allRows : someRows);
+    checkBool (ab, rownrs);
+    checkInt (ai, rownrs);
+    checkInt (au, rownrs);
+    checkDouble (af, rownrs);
+    checkDouble (ad, rownrs);
+    checkDouble (ai, rownrs);
+    checkInt (ai + au*2 - 3, rownrs);
+    checkDouble ((ai + 2) * ad / 3.5 - af, rownrs);
+    checkDouble (sqrt(abs(ad)) + sin(af) * max(ad, af), rownrs);
+    checkBool (ai == au, rownrs);
+    checkBool (ai != 3, rownrs);
+    checkBool (ad > af, rownrs);
+    checkBool (ad <= 2.5, rownrs);
+    checkBool (ai >= Int64(2), rownrs);
+    checkBool (ai < Int64(-2), rownrs);
+    checkBool (!ab, rownrs);
+    checkBool (ab && ad > 0., rownrs);
+    checkBool (ab || ai < 0, rownrs);
+    checkBool ((ad/af > 1. && ai != 0) || (!ab && af > 1.), rownrs);
+  }
+  checkSelect (tab, ai > 3);
+  checkSelect (tab, ab && (ad + af > 2. || au == 4u));
+  checkSelect (tab, ad*ad < 20.  &&  !ab);
+  checkSelect (tab, sqrt(abs(ad)) * 2 > af  &&  ai % 3 != 1);
+  AlwaysAssertExit ((ai + 2*ad > af  &&  !ab).getNodeRep()->isParallelSafe());
+  AlwaysAssertExit (! (ai > 2  &&  tab.nodeRownr() < 10).getNodeRep()->
+                    isParallelSafe());
+}
+
+int main()
+{
+  try {
+    // Use a size exceeding the block size used by the selection.
+    Table tab = makeTable (10000);
+    doIt (tab);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,215 @@
+//# tTableParseGroupby.cc: Test program for the hash grouping in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/TaQL/TableParseGroupby.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the hash grouping in class TableParseGroupby.
+// The results with a small memory budget (thus spilling rows to a
+// temporary table) are compared with the results without a budget.
+// It also checks that the memory used does not exceed the budget.
+// Furthermore, the results of grouping with multiple threads are compared
+// with those of a single thread.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA2"));
+  td.addColumn (ScalarColumnDesc<Bool>   ("FLAG"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  td.addColumn (ScalarColumnDesc<String> ("LONGNAME"));
+  SetupNewTable newtab("tTableParseGroupby_tmp.tab", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ant1(tab, "ANTENNA1");
+  ScalarColumn<Int> ant2(tab, "ANTENNA2");
+  ScalarColumn<Bool> flag(tab, "FLAG");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> name(tab, "NAME");
+  ScalarColumn<String> longName(tab, "LONGNAME");
+  // The long names make the hash map larger than the state of the groups.
+  String prefix(500, 'x');
+  for (rownr_t i=0; i<nrow; ++i) {
+    ant1.put (i, (i*7)%23);
+    ant2.put (i, (i*11)%19);
+    flag.put (i, i%3 == 0);
+    Double t = 1000. + i%37;
+    if (i%37 == 1) {
+      setNaN (t);
+    } else if (i%37 == 2) {
+      t = -0.;
+    } else if (i%37 == 3) {
+      t = 0.;
+    }
+    time.put (i, t);
+    name.put (i, "n" + String::toString(i%5));
+    longName.put (i, prefix + String::toString(i%400));
+  }
+}
+
+// Compare the columns of both tables.
+template<typename T>
+void compareColumn (const Table& tab1, const Table& tab2, const String& name)
+{
+  Vector<T> v1 = ScalarColumn<T>(tab1, name).getColumn();
+  Vector<T> v2 = ScalarColumn<T>(tab2, name).getColumn();
+  AlwaysAssertExit (v1.size() == v2.size()  &&  allEQ (v1, v2));
+}
+// NaNs compare equal.
+template<>
+void compareColumn<Double> (const Table& tab1, const Table& tab2,
+                            const String& name)
+{
+  Vector<Double> v1 = ScalarColumn<Double>(tab1, name).getColumn();
+  Vector<Double> v2 = ScalarColumn<Double>(tab2, name).getColumn();
+  AlwaysAssertExit (v1.size() == v2.size());
+  for (size_t i=0; i<v1.size(); ++i) {
+    AlwaysAssertExit (v1[i] == v2[i]  ||  (isNaN(v1[i])  &&  isNaN(v2[i])));
+  }
+}
+
+// Do the query without a budget and with a budget being the given fraction
+// of the memory used without budget, and compare the results.
+// All aggregate functions are used or only immediate ones. Note that the
+// lazy ones (like median) keep the ids of all rows, which cannot be spilled.
+// It returns the number of groups.
+rownr_t checkGroupby (const String& keys, Double fraction,
+                      Bool allFuncs=True)
+{
+  String command = "select " + keys + ", gcount() as N, gsum(TIME) as S";
+  if (allFuncs) {
+    command += ", gmin(ANTENNA2) as MN, gfirst(TIME) as F, glast(NAME) as L,"
+      " gmedian(ANTENNA1+ANTENNA2) as MD";
+  }
+  command += " from tTableParseGroupby_tmp.tab groupby " + keys;
+  TableParseGroupby::setMemoryBudget (0);
+  Table tab1 = tableCommand(command).table();
+  Int64 budget = Int64(fraction * TableParseGroupby::lastMemoryUsed());
+  TableParseGroupby::setMemoryBudget (budget);
+  Table tab2 = tableCommand(command).table();
+  TableParseGroupby::setMemoryBudget (0);
+  // The memory used must be within the budget.
+  AlwaysAssertExit (TableParseGroupby::lastMemoryUsed() <= budget);
+  AlwaysAssertExit (tab1.nrow() == tab2.nrow());
+  compareColumn<Int64>  (tab1, tab2, "N");
+  compareColumn<Double> (tab1, tab2, "S");
+  if (allFuncs) {
+    compareColumn<Int64>  (tab1, tab2, "MN");
+    compareColumn<Double> (tab1, tab2, "F");
+    compareColumn<String> (tab1, tab2, "L");
+    compareColumn<Double> (tab1, tab2, "MD");
+  }
+  return tab1.nrow();
+}
+
+// Do the query with multiple threads and compare with a single thread.
+// The partial results of the threads are merged, so the variance can
+// differ slightly.
+void checkThreads (const String& keys)
+{
+  String command = "select " + keys + ", gcount() as N, gsum(TIME) as S,"
+    " gmin(ANTENNA2) as MN, gmax(TIME) as MX, gfirst(TIME) as F,"
+    " glast(NAME) as L, gvariance(ANTENNA1) as V, gall(FLAG) as A,"
+    " gmedian(ANTENNA1+ANTENNA2) as MD"
+    " from tTableParseGroupby_tmp.tab groupby " + keys;
+  Table tab1 = tableCommand(command).table();
+  Table tab2 = tableCommand("using style threads=4 " + command).table();
+  AlwaysAssertExit (tab1.nrow() == tab2.nrow());
+  compareColumn<Int64>  (tab1, tab2, "N");
+  compareColumn<Double> (tab1, tab2, "S");
+  compareColumn<Int64>  (tab1, tab2, "MN");
+  compareColumn<Double> (tab1, tab2, "MX");
+  compareColumn<Double> (tab1, tab2, "F");
+  compareColumn<String> (tab1, tab2, "L");
+  compareColumn<Bool>   (tab1, tab2, "A");
+  compareColumn<Double> (tab1, tab2, "MD");
+  Vector<Double> v1 = ScalarColumn<Double>(tab1, "V").getColumn();
+  Vector<Double> v2 = ScalarColumn<Double>(tab2, "V").getColumn();
+  AlwaysAssertExit (allNear (v1, v2, 1e-10));
+}
+
+// A budget too small for the state of the groups results in an exception.
+void checkTooSmall (const String& keys, Int64 budget)
+{
+  TableParseGroupby::setMemoryBudget (budget);
+  Bool failed = False;
+  try {
+    tableCommand ("select gcount() from tTableParseGroupby_tmp.tab"
+                  " groupby " + keys);
+  } catch (const TableInvExpr&) {
+    failed = True;
+  }
+  TableParseGroupby::setMemoryBudget (0);
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    createTable (10000);
+    // Check the number of groups for various key types.
+    AlwaysAssertExit (checkGroupby ("ANTENNA1", 2) == 23);
+    AlwaysAssertExit (checkGroupby ("ANTENNA1, ANTENNA2", 2) == 23*19);
+    AlwaysAssertExit (checkGroupby ("ANTENNA1, NAME", 2) == 23*5);
+    AlwaysAssertExit (checkGroupby ("FLAG, NAME", 2) == 2*5);
+    // All NaNs are in the same group and -0 equals 0.
+    AlwaysAssertExit (checkGroupby ("TIME", 2) == 37-1);
+    AlwaysAssertExit (checkGroupby ("ANTENNA2, TIME, NAME", 2) > 37);
+    // The hash map of the long keys does not fit, so rows are spilled.
+    AlwaysAssertExit (checkGroupby ("LONGNAME", 0.5, False) == 400);
+    AlwaysAssertExit (checkGroupby ("LONGNAME, FLAG", 0.5, False) == 2*400);
+    // Grouping with multiple threads gives the same results.
+    checkThreads ("ANTENNA1");
+    checkThreads ("ANTENNA1, ANTENNA2");
+    checkThreads ("TIME, NAME");
+    checkThreads ("LONGNAME");
+    // A tiny budget does not fit, also not after spilling.
+    checkTooSmall ("ANTENNA1, ANTENNA2", 1);
+    checkTooSmall ("LONGNAME", 10000);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,170 @@
+//# tTableParseIndex.cc: Test program for the use of column indices in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/TaQL/TableParseIndex.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for class TableParseIndex using column indices for the
+// predicates in a TaQL WHERE clause.
+// The results using indices are compared with the results of a full scan.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Short>  ("FIELD"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  SetupNewTable newtab("tTableParseIndex_tmp.tab", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ScalarColumn<Short> field(tab, "FIELD");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> name(tab, "NAME");
+  for (rownr_t i=0; i<nrow; ++i) {
+    ant.put (i, (i*7)%13);
+    field.put (i, i/500);
+    time.put (i, 1000. + i/10);
+    name.put (i, "n" + String::toString(i%5));
+  }
+}
+
+// Do the selection using the indices and compare the result with the
+// result of a full scan. It returns the explanation.
+String checkSelect (const Table& tab, const TableExprNode& where,
+                    Bool makeIndex, Bool expUsed)
+{
+  Vector<rownr_t> expRows = tab(where).rowNumbers();
+  TableParseIndex index(tab, where, True, makeIndex);
+  AlwaysAssertExit (index.isUsed() == expUsed);
+  if (expUsed) {
+    Vector<rownr_t> rows = index.select(0).rowNumbers(tab);
+    AlwaysAssertExit (rows.size() == expRows.size()  &&
+                      allEQ (rows, expRows));
+    // Also check a limit.
+    TableParseIndex index5(tab, where, True, makeIndex);
+    rows.reference (index5.select(5).rowNumbers(tab));
+    AlwaysAssertExit (rows.size() == std::min(expRows.size(), size_t(5)));
+    if (rows.size() > 0) {
+      AlwaysAssertExit (allEQ (rows, expRows(Slice(0, rows.size()))));
+    }
+  }
+  // Without indices nothing can be done.
+  AlwaysAssertExit (! TableParseIndex(tab, where, False, makeIndex).isUsed());
+  return index.explain();
+}
+
+void checkSelects (const Table& tab, Bool makeIndex, Bool expUsed)
+{
+  TableExprNode ant = tab.col("ANTENNA1");
+  TableExprNode field = tab.col("FIELD");
+  TableExprNode time = tab.col("TIME");
+  TableExprNode name = tab.col("NAME");
+  Vector<Int> antSet(3);
+  antSet[0] = 2;
+  antSet[1] = 4;
+  antSet[2] = 17;
+  Vector<String> nameSet(2);
+  nameSet[0] = "n1";
+  nameSet[1] = "n3";
+  checkSelect (tab, ant == 3, makeIndex, expUsed);
+  checkSelect (tab, 3 == ant, makeIndex, expUsed);
+  checkSelect (tab, ant == 300, makeIndex, expUsed);
+  checkSelect (tab, ant.in (TableExprNode(antSet)), makeIndex, expUsed);
+  checkSelect (tab, ant == 3  &&  field == 2, makeIndex, expUsed);
+  checkSelect (tab, ant > 10, makeIndex, expUsed);
+  checkSelect (tab, ant >= 3  &&  ant < 5  &&  time > 1200., makeIndex,
+               expUsed);
+  checkSelect (tab, field < 2  &&  2 <= ant  &&  name == "n2", makeIndex,
+               expUsed);
+  checkSelect (tab, field == 3  &&  (ant == 1  ||  ant == 2), makeIndex,
+               expUsed);
+  checkSelect (tab, field > 40000, makeIndex, expUsed);
+  checkSelect (tab, field > 3  &&  field < 3, makeIndex, expUsed);
+  checkSelect (tab, ant == 3  &&  tab.nodeRownr() % 2 == 0, makeIndex,
+               expUsed);
+  // A non-integer value or a Double column cannot use an index.
+  checkSelect (tab, ant == 3.5, makeIndex, False);
+  checkSelect (tab, time == 1200., makeIndex, False);
+  checkSelect (tab, ant == 3  ||  field == 2, makeIndex, False);
+  // String indices are never persistent, so they have to be made.
+  checkSelect (tab, name.in (TableExprNode(nameSet))  &&  time > 1300.,
+               makeIndex, makeIndex);
+}
+
+int main()
+{
+  try {
+    createTable (5000);
+    Table tab("tTableParseIndex_tmp.tab");
+    TableExprNode ant = tab.col("ANTENNA1");
+    TableExprNode field = tab.col("FIELD");
+    TableExprNode time = tab.col("TIME");
+    Vector<String> col(1, "ANTENNA1");
+    // Without indices a full scan is needed.
+    checkSelects (tab, False, False);
+    AlwaysAssertExit (checkSelect (tab, ant == 3, False, False).contains
+                      ("scan   1 predicate on all rows"));
+    AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, col));
+    // Make the indices.
+    checkSelects (tab, True, True);
+    AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, col));
+    // Now the persistent indices can be used.
+    checkSelects (tab, False, True);
+    String info = checkSelect (tab, ant == 3, False, True);
+    AlwaysAssertExit (info.contains ("index  ANTENNA1 == 3  "
+                                     "(persistent index)"));
+    AlwaysAssertExit (! info.contains ("scan"));
+    info = checkSelect (tab, ant >= 3  &&  ant < 5  &&  time > 1200.,
+                        False, True);
+    AlwaysAssertExit (info.contains ("index  3 <= ANTENNA1 <= 4"));
+    AlwaysAssertExit (info.contains ("scan   1 predicate on the rows found"));
+    info = checkSelect (tab, field > 3  &&  field <= 7  &&  ant == 5,
+                        False, True);
+    AlwaysAssertExit (info.contains ("index  4 <= FIELD <= 7"));
+    AlwaysAssertExit (info.contains ("index  ANTENNA1 == 5"));
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,261 @@
+//# tTableParseJoin.cc: Test program for the hash join in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the JOIN ... ON clause in TaQL, which is done as a
+// hash join by class TableParseJoin.
+// The results are compared with the expected values.
+// </summary>
+
+// The main table has a FIELD_ID referring to rows in the field table
+// and a source NAME referring to the source table. Some rows do not have
+// a matching field or source.
+void createTables (rownr_t nrow)
+{
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>    ("FIELD_ID"));
+    td.addColumn (ScalarColumnDesc<String> ("SOURCE"));
+    td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+    SetupNewTable newtab("tTableParseJoin_tmp.main", td, Table::New);
+    Table tab(newtab, nrow);
+    ScalarColumn<Int> field(tab, "FIELD_ID");
+    ScalarColumn<String> source(tab, "SOURCE");
+    ScalarColumn<Double> time(tab, "TIME");
+    for (rownr_t i=0; i<nrow; ++i) {
+      field.put (i, i%25);
+      source.put (i, "src" + String::toString(i%7));
+      time.put (i, 1000. + i);
+    }
+  }
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<String> ("NAME"));
+    td.addColumn (ScalarColumnDesc<Int>    ("CODE"));
+    td.addColumn (ArrayColumnDesc<Double>  ("DIR", IPosition(1,2),
+                                            ColumnDesc::FixedShape));
+    SetupNewTable newtab("tTableParseJoin_tmp.field", td, Table::New);
+    Table tab(newtab, 20);
+    ScalarColumn<String> name(tab, "NAME");
+    ScalarColumn<Int> code(tab, "CODE");
+    ArrayColumn<Double> dir(tab, "DIR");
+    Vector<Double> dirv(2);
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+      name.put (i, "f" + String::toString(i));
+      code.put (i, 10*i);
+      dirv[0] = i;
+      dirv[1] = -Double(i);
+      dir.put (i, dirv);
+    }
+  }
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<String> ("NAME"));
+    td.addColumn (ScalarColumnDesc<Double> ("FLUX"));
+    SetupNewTable newtab("tTableParseJoin_tmp.source", td, Table::New);
+    Table tab(newtab, 5);
+    ScalarColumn<String> name(tab, "NAME");
+    ScalarColumn<Double> flux(tab, "FLUX");
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+      name.put (i, "src" + String::toString(i));
+      flux.put (i, 0.5*i);
+    }
+  }
+}
+
+// Join with the field table using its row number.
+void testRowid (rownr_t nrow)
+{
+  Table tab = tableCommand
+    ("select t1.TIME, t2.NAME as FNAME, t2.CODE, t2.DIR[2] as DEC"
+     " from tTableParseJoin_tmp.main t1"
+     " join tTableParseJoin_tmp.field t2 on t1.FIELD_ID == t2.rowid()").table();
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> fname(tab, "FNAME");
+  ScalarColumn<Int64> code(tab, "CODE");
+  ScalarColumn<Double> dec(tab, "DEC");
+  rownr_t row = 0;
+  for (rownr_t i=0; i<nrow; ++i) {
+    Int fieldId = i%25;
+    if (fieldId < 20) {
+      AlwaysAssertExit (time(row) == 1000. + i);
+      AlwaysAssertExit (fname(row) == "f" + String::toString(fieldId));
+      AlwaysAssertExit (code(row) == 10*fieldId);
+      AlwaysAssertExit (dec(row) == -fieldId);
+      row++;
+    }
+  }
+  AlwaysAssertExit (tab.nrow() == row);
+}
+
+// Join with two tables, one on a String key, and select on joined columns.
+void testMulti (rownr_t nrow)
+{
+  Table tab = tableCommand
+    ("select t1.TIME, t3.FLUX from tTableParseJoin_tmp.main t1"
+     " join tTableParseJoin_tmp.field t2 on t2.CODE == 10*t1.FIELD_ID"
+     " join tTableParseJoin_tmp.source t3 on t1.SOURCE == t3.NAME"
+     " where t2.CODE < 150 && t3.FLUX > 0").table();
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Double> flux(tab, "FLUX");
+  rownr_t row = 0;
+  for (rownr_t i=0; i<nrow; ++i) {
+    if (i%25 < 15  &&  i%7 > 0  &&  i%7 < 5) {
+      AlwaysAssertExit (time(row) == 1000. + i);
+      AlwaysAssertExit (flux(row) == 0.5*(i%7));
+      row++;
+    }
+  }
+  AlwaysAssertExit (tab.nrow() == row);
+}
+
+// Join a small table with a larger one on a mixed integer/double key.
+// The first table is then put in the hash table.
+void testSmallFirst()
+{
+  Table tab = tableCommand
+    ("select t2.NAME, t1.TIME from tTableParseJoin_tmp.field t2"
+     " join tTableParseJoin_tmp.main t1 on t2.CODE == 10*(t1.TIME-1000)"
+     " orderby t2.NAME desc").table();
+  AlwaysAssertExit (tab.nrow() == 20);
+  ScalarColumn<String> name(tab, "NAME");
+  ScalarColumn<Double> time(tab, "TIME");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    Int fieldId = atoi (name(i).substr(1).c_str());
+    AlwaysAssertExit (time(i) == 1000. + fieldId);
+  }
+  String info = tableCommand
+    ("show explain 'select from tTableParseJoin_tmp.field t2"
+     " join tTableParseJoin_tmp.main t1 on t2.CODE == 10*(t1.TIME-1000)'")
+    .node().getString(0);
+  AlwaysAssertExit (info.contains ("on 1 key (Double)"));
+  AlwaysAssertExit (info.contains ("hash   the keys of the first table"));
+}
+
+// Integer and real keys beyond 2^53 are compared exactly.
+// Only the even integers can be represented exactly as a Double, so
+// otherwise the odd ones would match as well.
+void testLargeKey (rownr_t nrow)
+{
+  Table tab = tableCommand
+    ("select t1.FIELD_ID, t2.NAME from tTableParseJoin_tmp.main t1"
+     " join tTableParseJoin_tmp.field t2 on"
+     " t2.rowid() + 9007199254740992 == 2*t1.FIELD_ID + 9007199254740992.")
+    .table();
+  ScalarColumn<Int> field(tab, "FIELD_ID");
+  ScalarColumn<String> name(tab, "NAME");
+  rownr_t row = 0;
+  for (rownr_t i=0; i<nrow; ++i) {
+    Int fieldId = i%25;
+    if (fieldId < 10) {
+      AlwaysAssertExit (field(row) == fieldId);
+      AlwaysAssertExit (name(row) == "f" + String::toString(2*fieldId));
+      row++;
+    }
+  }
+  AlwaysAssertExit (tab.nrow() == row);
+}
+
+// A row matching multiple rows in the joined table is an error,
+// whichever table is put in the hash table.
+void testMultipleMatch()
+{
+  const char* commands[] = {
+    "select from tTableParseJoin_tmp.field t2"
+    " join tTableParseJoin_tmp.main t1 on t2.CODE/10 == t1.FIELD_ID",
+    "select from tTableParseJoin_tmp.main t1"
+    " join tTableParseJoin_tmp.field t2 on t1.FIELD_ID == t2.rowid()%5"
+  };
+  for (const char* command : commands) {
+    Bool failed = False;
+    try {
+      tableCommand (command);
+    } catch (const TableInvExpr&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+  }
+}
+
+// Check the errors in the JOIN condition.
+void testErrors()
+{
+  const char* commands[] = {
+    "select from tTableParseJoin_tmp.main t1"
+    " join tTableParseJoin_tmp.field t2 on t1.FIELD_ID > t2.rowid()",
+    "select from tTableParseJoin_tmp.main t1"
+    " join tTableParseJoin_tmp.field t2 on t1.FIELD_ID == 3",
+    "select from tTableParseJoin_tmp.main t1"
+    " join tTableParseJoin_tmp.field t2 on t1.FIELD_ID == t2.NAME",
+    "select from tTableParseJoin_tmp.main t1"
+    " join tTableParseJoin_tmp.field on t1.FIELD_ID == rowid()"
+  };
+  for (const char* command : commands) {
+    Bool failed = False;
+    try {
+      tableCommand (command);
+    } catch (const TableInvExpr&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+  }
+}
+
+int main()
+{
+  try {
+    rownr_t nrow = 1000;
+    createTables (nrow);
+    testRowid (nrow);
+    testMulti (nrow);
+    testSmallFirst();
+    testLargeKey (nrow);
+    testMultipleMatch();
+    testErrors();
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
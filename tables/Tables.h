@@ -46,6 +46,7 @@
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/tables/Tables/TableUtil.h>
+#include <casacore/tables/Tables/TableArrowExporter.h>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/Slice.h>
@@ -126,18 +126,22 @@ void ArrayColumnData::setShapeColumn (const IPosition& shp)
 
 Bool ArrayColumnData::isDefined (rownr_t rownr) const
 {
+    auto dmLock = lockDataManager();
     return dataColPtr_p->isShapeDefined(rownr);
 }
 uInt ArrayColumnData::ndim (rownr_t rownr) const
 {
+    auto dmLock = lockDataManager();
     return dataColPtr_p->ndim(rownr);
 }
 IPosition ArrayColumnData::shape (rownr_t rownr) const
 {
+    auto dmLock = lockDataManager();
     return dataColPtr_p->shape(rownr);
 }
 IPosition ArrayColumnData::tileShape (rownr_t rownr) const
 {
+    auto dmLock = lockDataManager();
     return dataColPtr_p->tileShape(rownr);
 }
 
@@ -146,6 +150,7 @@ void ArrayColumnData::setShape (rownr_t rownr, const IPosition& shp)
 {
     checkShape (shp);
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->setShape (rownr, shp);
     autoReleaseLock();
 }
@@ -154,6 +159,7 @@ void ArrayColumnData::setShape (rownr_t rownr, const IPosition& shp,
 {
     checkShape (shp);
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->setShapeTiled (rownr, shp, tileShp);
     autoReleaseLock();
 }
@@ -171,6 +177,7 @@ void ArrayColumnData::getArray (rownr_t rownr, ArrayBase& array) const
                          array.shape());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getArrayV (rownr, array);
     autoReleaseLock();
 }
@@ -184,6 +191,7 @@ void ArrayColumnData::getSlice (rownr_t rownr, const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getSliceV (rownr, ns, array);
     autoReleaseLock();
 }
@@ -199,6 +207,7 @@ void ArrayColumnData::putArray (rownr_t rownr, const ArrayBase& array)
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putArrayV (rownr, array);
     autoReleaseLock();
 }
@@ -215,6 +224,7 @@ void ArrayColumnData::putSlice (rownr_t rownr, const Slicer& ns,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putSliceV (rownr, ns, array);
     autoReleaseLock();
 }
@@ -231,6 +241,7 @@ void ArrayColumnData::getArrayColumn (ArrayBase& array) const
                          array.shape());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getArrayColumnV (array);
     autoReleaseLock();
 }
@@ -244,6 +255,7 @@ void ArrayColumnData::getArrayColumnCells (const RefRows& rownrs,
                          array.shape());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getArrayColumnCellsV (rownrs, array);
     autoReleaseLock();
 }
@@ -257,6 +269,7 @@ void ArrayColumnData::getColumnSlice (const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getColumnSliceV (ns, array);
     autoReleaseLock();
 }
@@ -271,6 +284,7 @@ void ArrayColumnData::getColumnSliceCells (const RefRows& rownrs,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getColumnSliceCellsV (rownrs, ns, array);
     autoReleaseLock();
 }
@@ -285,6 +299,7 @@ void ArrayColumnData::putArrayColumn (const ArrayBase& array)
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putArrayColumnV (array);
     autoReleaseLock();
 }
@@ -300,6 +315,7 @@ void ArrayColumnData::putArrayColumnCells (const RefRows& rownrs,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putArrayColumnCellsV (rownrs, array);
     autoReleaseLock();
 }
@@ -316,6 +332,7 @@ void ArrayColumnData::putColumnSlice (const Slicer& ns,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putColumnSliceV (ns, array);
     autoReleaseLock();
 }
@@ -333,6 +350,7 @@ void ArrayColumnData::putColumnSliceCells (const RefRows& rownrs,
       checkValueLength (static_cast<const Array<String>*>(&array));
     }
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putColumnSliceCellsV (rownrs, ns, array);
     autoReleaseLock();
 }
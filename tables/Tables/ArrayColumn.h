@@ -298,6 +298,31 @@ public:
     Array<T> getColumnCells (const RefRows& rownrs) const;
     // </group>
 
+    // Let <src>arr</src> reference the array (section) in a cell or the
+    // arrays in a range of (consecutive) rows without copying the data.
+    // This is possible if the storage manager holds the data in local
+    // format in contiguous memory, for instance for a TiledStMan using
+    // memory-mapped IO (see <linkto class=TSMOption>TSMOption</linkto>)
+    // if the section is contained in a single tile and consists of full
+    // vectors or planes of it.
+    // <br>Views are only made if the table is not writable, because its
+    // files are mapped readonly then. The array must not be changed;
+    // doing so results in a segmentation fault.
+    // <br>False is returned if a view is not possible, in which case a
+    // normal get has to be done. <src>arr</src> is then made empty, so it
+    // does not reference a view made before (into which the get would
+    // write otherwise).
+    // <br>The array keeps the mapped data alive (also after the table is
+    // closed). Note that the mapping is shared with the file, so the
+    // contents of the view change if the table is written thereafter
+    // (in this or another process).
+    // <group>
+    Bool getView (rownr_t rownr, Array<T>& arr) const;
+    Bool getSliceView (rownr_t rownr, const Slicer& arraySection,
+                       Array<T>& arr) const;
+    Bool getColumnRangeView (const Slicer& rowRange, Array<T>& arr) const;
+    // </group>
+
     // Get slices from some arrays in a column.
     // The first Slicer object can be used to specify start, end (or length),
     // and stride of the rows to get. The second Slicer object can be
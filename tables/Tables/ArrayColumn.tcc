@@ -280,6 +280,26 @@ void ArrayColumn<T>::getColumnRange (const Slicer& rowRange,
     acbGetColumnRange (rowRange, arr, resize);
 }
 
+template<class T>
+Bool ArrayColumn<T>::getView (rownr_t rownr, Array<T>& arr) const
+{
+    return acbGetView (rownr, 0, arr);
+}
+
+template<class T>
+Bool ArrayColumn<T>::getSliceView (rownr_t rownr, const Slicer& arraySection,
+                                   Array<T>& arr) const
+{
+    return acbGetView (rownr, &arraySection, arr);
+}
+
+template<class T>
+Bool ArrayColumn<T>::getColumnRangeView (const Slicer& rowRange,
+                                         Array<T>& arr) const
+{
+    return acbGetColumnRangeView (rowRange, arr);
+}
+
 template<class T>
 Array<T> ArrayColumn<T>::getColumnCells (const RefRows& rownrs) const
 {
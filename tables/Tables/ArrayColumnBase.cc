@@ -223,6 +223,44 @@ void ArrayColumnBase::acbGetColumnRange (const Slicer& rowRange,
   }
 }
 
+Bool ArrayColumnBase::acbGetView (rownr_t rownr, const Slicer* arraySection,
+                                  ArrayBase& arr) const
+{
+  TABLECOLUMNCHECKROW(rownr);
+  //# Only a readonly table is mapped readonly, so the data cannot be
+  //# changed through the view.
+  if (baseTabPtr_p->isWritable()  ||  ! isDefined(rownr)
+  ||  ! baseColPtr_p->getArrayView (rownr, arraySection, arr)) {
+    detachView (arr);
+    return False;
+  }
+  return True;
+}
+
+Bool ArrayColumnBase::acbGetColumnRangeView (const Slicer& rowRange,
+                                             ArrayBase& arr) const
+{
+  IPosition shp, blc, trc, inc;
+  shp = rowRange.inferShapeFromSource (IPosition(1,nrow()), blc, trc, inc);
+  //# Only consecutive rows of a readonly table can be referenced.
+  if (baseTabPtr_p->isWritable()  ||  shp(0) == 0  ||  inc(0) != 1
+  ||  !isDefined(blc(0))  ||  !isDefined(trc(0))
+  ||  !baseColPtr_p->getColumnRangeView (blc(0), shp(0), arr)) {
+    detachView (arr);
+    return False;
+  }
+  return True;
+}
+
+void ArrayColumnBase::detachView (ArrayBase& arr)
+{
+  //# The array might still reference a (readonly) view made before,
+  //# so a subsequent get must not write into it.
+  if (arr.nelements() > 0) {
+    arr.resize (IPosition(arr.ndim(), 0));
+  }
+}
+
 void ArrayColumnBase::acbGetColumnCells (const RefRows& rownrs,
                                          ArrayBase& arr, Bool resize) const
 {
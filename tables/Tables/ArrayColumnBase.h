@@ -219,6 +219,16 @@ class String;
     void acbGetColumnCells (const RefRows& rownrs, ArrayBase& arr,
                             Bool resize) const;
 
+    // Let the array reference the data in a cell (section) or in a range
+    // of rows without copying them. False is returned if not possible,
+    // in which case the array is made empty.
+    // A null pointer <src>arraySection</src> means the entire array.
+    // <group>
+    Bool acbGetView (rownr_t rownr, const Slicer* arraySection,
+                     ArrayBase& arr) const;
+    Bool acbGetColumnRangeView (const Slicer& rowRange, ArrayBase& arr) const;
+    // </group>
+
     // Get slices from some arrays in a column.
     // The first Slicer object can be used to specify start, end (or length),
     // and stride of the rows to get. The second Slicer object can be
@@ -338,6 +348,10 @@ class String;
     // Put the contents of that column into this one.
     void acbPutColumn (const ArrayColumnBase& that);
 
+    // Let the array not reference its current data anymore by resizing it
+    // to an empty array. It is used if a view cannot be made.
+    static void detachView (ArrayBase& arr);
+
     // Adapt the shape of the array if possible. If the array is empty or
     // if <src>resize=True</src>, the array is resized if needed.
     // Otherwise checkShape is used to throw an exception if not conforming.
@@ -206,6 +206,22 @@ void BaseColumn::putColumnSliceCells (const RefRows&,
 }
 
 
+Bool BaseColumn::getZoneMap (Vector<rownr_t>&, Vector<Double>&,
+                             Vector<Double>&) const
+{
+  return False;
+}
+
+Bool BaseColumn::getArrayView (rownr_t, const Slicer*, ArrayBase&) const
+{
+  return False;
+}
+
+Bool BaseColumn::getColumnRangeView (rownr_t, rownr_t, ArrayBase&) const
+{
+  return False;
+}
+
 void BaseColumn::makeSortKey (Sort&, CountedPtr<BaseCompare>&, Int,
                               CountedPtr<ArrayBase>&)
 {
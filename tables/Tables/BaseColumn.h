@@ -281,6 +281,25 @@ public:
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes) = 0;
 
+    // Get the zone map (min/max per range of rows) of the column.
+    // The default implementation returns False (no zone map available).
+    virtual Bool getZoneMap (Vector<rownr_t>& endRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues) const;
+
+    // Make <src>arr</src> reference the array (or a section of it) in
+    // the given row without copying the data (see
+    // DataManagerColumn::getArrayViewV). <src>section</src> is a null
+    // pointer to reference the full array.
+    // The default implementation returns False (not possible).
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* section,
+                               ArrayBase& arr) const;
+
+    // Make <src>arr</src> reference the arrays in a range of rows without
+    // copying them. The default implementation returns False.
+    virtual Bool getColumnRangeView (rownr_t startRow, rownr_t nrow,
+                                     ArrayBase& arr) const;
+
     // Add this column and its data to the Sort object.
     // It may allocate some storage on the heap, which will be saved
     // in the argument dataSave.
@@ -32,6 +32,10 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -64,14 +68,21 @@ BaseTableIterator::BaseTableIterator (const std::shared_ptr<BaseTable>& btp,
     // The passed in compare functions are for the iteration.
     if (option == TableIterator::NoSort) {
         sortTab_p = btp;
+    } else if (option == TableIterator::HashGroup  &&
+               hashGroups (btp, keys, cmp)) {
+        // The group boundaries are known, so use them.
+        cacheIterationBoundaries = true;
     }else{
         Sort::Option sortopt = Sort::QuickSort;
         if (option == TableIterator::HeapSort) {
             sortopt = Sort::HeapSort;
-        } else if (option == TableIterator::ParSort) {
+        } else if (option == TableIterator::ParSort  ||
+                   option == TableIterator::HashGroup) {
             sortopt = Sort::ParSort;
         } else if (option == TableIterator::InsSort) {
             sortopt = Sort::InsSort;
+        } else if (option == TableIterator::RadixSort) {
+            sortopt = Sort::RadixSort;
         }
         Block<Int> ord(nrkeys_p, Sort::Ascending);
         for (uInt i=0; i<nrkeys_p; i++) {
@@ -103,6 +114,169 @@ BaseTableIterator::BaseTableIterator (const std::shared_ptr<BaseTable>& btp,
 }
 
 
+// Fill the hash codes of a key column. Equal values get equal codes.
+template<typename T>
+static void fillHashCodes (const BaseColumn* col, rownr_t nrow,
+                           uInt nrkeys, uInt key, uInt64* codes)
+{
+    Vector<T> vals(nrow);
+    col->getScalarColumn (vals);
+    for (rownr_t i=0; i<nrow; ++i) {
+        codes[i*nrkeys + key] = uInt64(Int64(vals[i]));
+    }
+}
+
+// For floating point values the bit pattern is used, where -0 equals +0.
+template<typename T>
+static void fillHashCodesReal (const BaseColumn* col, rownr_t nrow,
+                               uInt nrkeys, uInt key, uInt64* codes)
+{
+    Vector<T> vals(nrow);
+    col->getScalarColumn (vals);
+    for (rownr_t i=0; i<nrow; ++i) {
+        Double v = vals[i];
+        if (v == 0) v = 0;
+        memcpy (codes + i*nrkeys + key, &v, sizeof(Double));
+    }
+}
+
+// Strings are numbered in order of appearance.
+static void fillHashCodesString (const BaseColumn* col, rownr_t nrow,
+                                 uInt nrkeys, uInt key, uInt64* codes)
+{
+    Vector<String> vals(nrow);
+    col->getScalarColumn (vals);
+    std::unordered_map<std::string,uInt64> strMap;
+    for (rownr_t i=0; i<nrow; ++i) {
+        codes[i*nrkeys + key] =
+          strMap.emplace (vals[i], strMap.size()).first->second;
+    }
+}
+
+// Hash and compare the key codes of a row.
+struct HashGroupCodes
+{
+    HashGroupCodes (const uInt64* codes, uInt nrkeys)
+      : codes_p(codes), nrkeys_p(nrkeys) {}
+    size_t operator() (rownr_t row) const
+    {
+        const uInt64* c = codes_p + row*nrkeys_p;
+        uInt64 h = 0;
+        for (uInt i=0; i<nrkeys_p; ++i) {
+            h = (h ^ c[i]) * 0x100000001b3ULL;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+    bool operator() (rownr_t row1, rownr_t row2) const
+    {
+        return std::equal (codes_p + row1*nrkeys_p,
+                           codes_p + (row1+1)*nrkeys_p,
+                           codes_p + row2*nrkeys_p);
+    }
+    const uInt64* codes_p;
+    uInt nrkeys_p;
+};
+
+Bool BaseTableIterator::hashGroups
+                     (const std::shared_ptr<BaseTable>& btp,
+                      const Block<String>& keys,
+                      const Block<CountedPtr<BaseCompare> >& cmp)
+{
+    rownr_t nrow = btp->nrow();
+    // Get a code per key value. Equal codes mean equal values.
+    std::vector<uInt64> codes(nrow*nrkeys_p);
+    for (uInt i=0; i<nrkeys_p; ++i) {
+        if (!cmp[i].null()  &&  cmp[i]->dataType() == TpOther) {
+            return False;
+        }
+        const BaseColumn* col = btp->getColumn (keys[i]);
+        if (! col->columnDesc().isScalar()) {
+            return False;
+        }
+        switch (col->columnDesc().dataType()) {
+        case TpBool:
+            fillHashCodes<Bool> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpUChar:
+            fillHashCodes<uChar> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpShort:
+            fillHashCodes<Short> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpUShort:
+            fillHashCodes<uShort> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpInt:
+            fillHashCodes<Int> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpUInt:
+            fillHashCodes<uInt> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpInt64:
+            fillHashCodes<Int64> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpFloat:
+            fillHashCodesReal<Float> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpDouble:
+            fillHashCodesReal<Double> (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        case TpString:
+            fillHashCodesString (col, nrow, nrkeys_p, i, codes.data());
+            break;
+        default:
+            return False;
+        }
+    }
+    // Assign a group number to each row in order of first appearance.
+    HashGroupCodes hashCodes (codes.data(), nrkeys_p);
+    std::unordered_map<rownr_t,rownr_t,HashGroupCodes,HashGroupCodes>
+      groupMap (1024, hashCodes, hashCodes);
+    std::vector<rownr_t> groupNr(nrow);
+    std::vector<rownr_t> firstRow;
+    for (rownr_t i=0; i<nrow; ++i) {
+        auto res = groupMap.emplace (i, firstRow.size());
+        if (res.second) {
+            firstRow.push_back (i);
+        }
+        groupNr[i] = res.first->second;
+    }
+    // Determine the group boundaries and the key changing between groups.
+    rownr_t ngroup = firstRow.size();
+    sortIterBoundaries_p   = std::make_shared<Vector<rownr_t>>(ngroup, 0);
+    sortIterKeyIdxChange_p = std::make_shared<Vector<size_t>>(ngroup, 0);
+    for (rownr_t i=0; i<nrow; ++i) {
+        if (groupNr[i]+1 < ngroup) {
+            (*sortIterBoundaries_p)[groupNr[i]+1]++;
+        }
+    }
+    for (rownr_t g=1; g<ngroup; ++g) {
+        (*sortIterBoundaries_p)[g] += (*sortIterBoundaries_p)[g-1];
+        const uInt64* c1 = codes.data() + firstRow[g-1]*nrkeys_p;
+        const uInt64* c2 = codes.data() + firstRow[g]*nrkeys_p;
+        size_t k = 0;
+        while (c1[k] == c2[k]) ++k;
+        (*sortIterKeyIdxChange_p)[g-1] = k;
+    }
+    // Order the rows per group; the rows in a group keep their order.
+    Vector<rownr_t> rownrs(nrow);
+    Vector<rownr_t> offsets(sortIterBoundaries_p->copy());
+    Bool inOrder = True;
+    for (rownr_t i=0; i<nrow; ++i) {
+        rownr_t inx = offsets[groupNr[i]]++;
+        rownrs[inx] = i;
+        inOrder = inOrder && inx == i;
+    }
+    if (inOrder) {
+        sortTab_p = btp;
+    } else {
+        sortTab_p = btp->select (rownrs);
+    }
+    return True;
+}
+
+
 BaseTableIterator* BaseTableIterator::clone() const
 {
     BaseTableIterator* newbti = new BaseTableIterator (*this);
@@ -73,6 +73,10 @@ class String;
 // order and then creating a RefTable for each step containing the
 // rows for that iteration step. Each iteration step assembles the
 // rows with equal key values.
+// <br>If option TableIterator::HashGroup is given, the rows are grouped
+// by hashing the key values instead of sorting them. The groups are
+// ordered in order of first appearance and the group boundaries are
+// cached as done for the sort.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -136,6 +140,15 @@ protected:
 
     std::shared_ptr<BaseTable> noCachedIterBoundariesNext();
 
+    // Group the rows by hashing the key values and make sortTab_p
+    // containing the rows in group order. The group boundaries are set
+    // as well.
+    // It returns False if not possible, because a key column is not
+    // a scalar of a standard data type or has a non-default compare object.
+    Bool hashGroups (const std::shared_ptr<BaseTable>&,
+                     const Block<String>& columnNames,
+                     const Block<CountedPtr<BaseCompare> >& cmpObjs);
+
 private:
     // Assignment is not needed, because the assignment operator in
     // the envelope class TableIterator has reference semantics.
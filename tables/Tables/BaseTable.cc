@@ -25,6 +25,7 @@
 //#
 //# $Id$
 
+#include <exception>
 #include <thread>
 #include <utility>
 
@@ -37,6 +38,8 @@
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/Tables/BaseTabIter.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
@@ -56,6 +59,7 @@
 #include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/casa/Utilities/Assert.h>
 
 
@@ -121,6 +125,18 @@ BaseTable::~BaseTable()
     }
 }
 
+void BaseTable::setConcurrentRead (Bool)
+{
+    throw TableInvOper ("Table " + tableName() + " cannot be read"
+                        " concurrently; only plain, memory and reference"
+                        " tables can");
+}
+
+Bool BaseTable::isConcurrentRead() const
+{
+    return False;
+}
+
 Bool BaseTable::isNull() const
 {
   return False;
@@ -362,6 +378,11 @@ void BaseTable::writeEnd (AipsIO& ios)
 void BaseTable::setTableChanged()
 {}
 
+Bool BaseTable::hasUnflushedChanges() const
+{
+    return False;
+}
+
 
 void BaseTable::markForDelete (Bool callback, const String& oldName)
 {
@@ -765,7 +786,8 @@ std::shared_ptr<BaseTable> BaseTable::select (rownr_t maxRow, rownr_t offset)
 
 // Do the row selection.
 std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
-                                              rownr_t maxRow, rownr_t offset)
+                                              rownr_t maxRow, rownr_t offset,
+                                              uInt nthreads)
 {
     // Check we don't deal with a null table.
     AlwaysAssert (!isNull(), AipsError);
@@ -802,22 +824,74 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
     std::shared_ptr<BaseTable> resultBaseTab = makeRefTable (True, 0);
     RefTable* resultTable = dynamic_cast<RefTable*>(resultBaseTab.get());
     DebugAssert (resultTable, AipsError);
-    Bool val;
-    rownr_t nrrow = nrow();
-    TableExprId id;
-    for (rownr_t i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
+    //# The expression is evaluated for a block of rows at a time.
+    //# If possible, multiple blocks are evaluated in parallel; thereafter
+    //# the results are handled in row order to apply offset and maxRow.
+    //# The tables used are read concurrently, so their data managers are
+    //# locked when accessed by multiple threads.
+    uInt nthr = (nthreads == 0  ?  OMP::maxThreads() : nthreads);
+    TableExprConcurrentRead concurrentRead;
+    if (nthr > 1  &&  (!node.getNodeRep()->isParallelSafe()  ||
+                       !concurrentRead.add (node.getRep()))) {
+      nthr = 1;
+    }
+    //# Only the rows in the zones possibly matching are evaluated.
+    std::vector<std::pair<rownr_t,rownr_t>> zones = selectZones (node);
+    const rownr_t batchSize = TableExprNodeRep::BatchSize;
+    std::vector<Vector<rownr_t>> rows(nthr);
+    std::vector<Vector<Bool>> vals(nthr);
+    size_t zone = 0;
+    rownr_t row = (zones.empty() ? 0 : zones[0].first);
+    Bool done = False;
+    while (zone < zones.size()  &&  !done) {
+      // Collect the row numbers of the next blocks.
+      Int nblk = 0;
+      while (nblk < Int(nthr)  &&  zone < zones.size()) {
+        Vector<rownr_t>& rownrs = rows[nblk];
+        rownrs.resize (batchSize);
+        rownr_t nr = 0;
+        while (nr < batchSize  &&  zone < zones.size()) {
+          rownr_t n = std::min (batchSize-nr, zones[zone].second - row);
+          for (rownr_t j=0; j<n; ++j) {
+            rownrs[nr++] = row++;
+          }
+          if (row == zones[zone].second  &&  ++zone < zones.size()) {
+            row = zones[zone].first;
+          }
+        }
+        rownrs.resize (nr, True);
+        nblk++;
+      }
+      std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthr) if (nblk > 1)
+      for (Int blk=0; blk<nblk; ++blk) {
+        try {
+          node.getBoolBatch (rows[blk], vals[blk]);
+        } catch (...) {
+#pragma omp critical(BaseTable_select)
+          excp = std::current_exception();
+        }
+      }
+      if (excp) {
+        std::rethrow_exception (excp);
+      }
+      for (Int blk=0; blk<nblk && !done; ++blk) {
+        const Vector<rownr_t>& blkrows = rows[blk];
+        const Vector<Bool>& blkvals = vals[blk];
+        for (rownr_t i=0; i<blkvals.size(); i++) {
+          if (blkvals[i]) {
+            if (offset == 0) {
+              resultTable->addRownr (blkrows[i]);       // add row
+              // Stop if max #rows reached (maxRow==0 means no limit).
+              if (resultTable->nrow() == maxRow) {
+                done = True;
+                break;
+              }
+            } else {
+              // Skip first offset matching rows.
+              offset--;
+            }
           }
-        } else {
-          // Skip first offset matching rows.
-          offset--;
         }
       }
     }
@@ -825,6 +899,65 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
     return resultBaseTab;
 }
 
+std::vector<std::pair<rownr_t,rownr_t>> BaseTable::selectZones
+                                        (const TableExprNode& node) const
+{
+    //# Start with all rows (as a half-open interval).
+    std::vector<std::pair<rownr_t,rownr_t>> result;
+    if (nrow() > 0) {
+      result.push_back (std::make_pair (rownr_t(0), nrow()));
+    }
+    //# Get the value ranges of the columns used in the expression.
+    //# For each column in this table having a zone map, only keep the zones
+    //# whose [min,max] overlaps one of the ranges.
+    Block<TableExprRange> ranges;
+    TableExprNode(node).ranges (ranges);
+    for (size_t i=0; i<ranges.size(); ++i) {
+      const TableExprRange& range = ranges[i];
+      Vector<rownr_t> endRows;
+      Vector<Double> minValues, maxValues;
+      if (range.getColumn().table().baseTablePtr() != this
+      ||  !range.getColumn().getZoneMap (endRows, minValues, maxValues)) {
+        continue;
+      }
+      std::vector<std::pair<rownr_t,rownr_t>> zones;
+      rownr_t st = 0;
+      for (size_t j=0; j<endRows.size(); ++j) {
+        Bool match = False;
+        for (size_t k=0; k<range.start().size() && !match; ++k) {
+          match = (minValues[j] <= range.end()[k]  &&
+                   maxValues[j] >= range.start()[k]);
+        }
+        if (match) {
+          if (!zones.empty()  &&  zones.back().second == st) {
+            zones.back().second = endRows[j] + 1;
+          } else {
+            zones.push_back (std::make_pair (st, endRows[j] + 1));
+          }
+        }
+        st = endRows[j] + 1;
+      }
+      //# Intersect with the zones found so far.
+      std::vector<std::pair<rownr_t,rownr_t>> isect;
+      size_t ir = 0;
+      size_t iz = 0;
+      while (ir < result.size()  &&  iz < zones.size()) {
+        rownr_t zst  = std::max (result[ir].first, zones[iz].first);
+        rownr_t zend = std::min (result[ir].second, zones[iz].second);
+        if (zst < zend) {
+          isect.push_back (std::make_pair (zst, zend));
+        }
+        if (result[ir].second < zones[iz].second) {
+          ir++;
+        } else {
+          iz++;
+        }
+      }
+      result.swap (isect);
+    }
+    return result;
+}
+
 std::shared_ptr<BaseTable> BaseTable::select (const Vector<rownr_t>& rownrs)
 {
     AlwaysAssert (!isNull(), AipsError);
@@ -40,6 +40,8 @@
 #include <casacore/casa/IO/FileLocker.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
 #include <memory>
+#include <vector>
+#include <utility>
 
 #ifdef HAVE_MPI
 #include <mpi.h>
@@ -146,6 +148,14 @@ public:
     // be read or written safely?
     virtual Bool hasLock (FileLocker::LockType) const = 0;
 
+    // Allow or disallow the table to be read by multiple threads.
+    // The default implementation throws a "not possible" exception.
+    virtual void setConcurrentRead (Bool concurrent);
+
+    // Can the table be read by multiple threads?
+    // The default implementation returns False.
+    virtual Bool isConcurrentRead() const;
+
     // Try to lock the table for read or write access.
     virtual Bool lock (FileLocker::LockType, uInt nattempts) = 0;
 
@@ -162,6 +172,10 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const = 0;
 
+    // Has the table been changed since it was flushed the last time?
+    // By default it returns False.
+    virtual Bool hasUnflushedChanges() const;
+
     // Set the table to being changed. By default it does nothing.
     virtual void setTableChanged();
 
@@ -348,8 +362,13 @@ public:
     // Select rows using the given expression (which can be null).
     // Skip first <src>offset</src> matching rows.
     // Return at most <src>maxRow</src> matching rows.
+    // The expression is evaluated by <src>nthreads</src> threads
+    // (0 means all cores) if it is safe to do so.
+    // Rows are skipped if the zone maps of the columns tell they cannot
+    // match (see <linkto class=StandardStMan>StandardStMan</linkto>).
     std::shared_ptr<BaseTable> select (const TableExprNode&,
-                                       rownr_t maxRow, rownr_t offset);
+                                       rownr_t maxRow, rownr_t offset,
+                                       uInt nthreads=1);
 
     // Select maxRow rows and skip first offset rows. maxRow=0 means all.
     std::shared_ptr<BaseTable> select (rownr_t maxRow, rownr_t offset);
@@ -580,6 +599,12 @@ private:
     // used in the logical operation on the table.
     Vector<rownr_t> logicRows();
 
+    // Get the row intervals [start,end) that can contain rows matching
+    // the selection expression. It uses the value ranges of the columns in
+    // the expression and the zone maps of those columns (if available).
+    std::vector<std::pair<rownr_t,rownr_t>> selectZones
+                                        (const TableExprNode&) const;
+
     // Make an empty table description.
     // This is used if one asks for the description of a NullTable.
     // Creating an empty TableDesc in the NullTable takes too much time.
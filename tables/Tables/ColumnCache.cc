@@ -33,7 +33,8 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 ColumnCache::ColumnCache()
-: itsIncr (1)
+: itsIncr       (1),
+  itsConcurrent (False)
 {
     invalidate();
 }
@@ -71,6 +71,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // The <src>invalidate</src> function can be used to invalidate the
 // cache. This is for instance needed when a table lock is acquired
 // or released to be sure that the cache gets refreshed.
+// <p>
+// The cache is updated by the data manager, thus cannot be used when
+// multiple threads read the column (see Table::setConcurrentRead).
+// In that case <src>setConcurrent</src> is used to make
+// <src>offset</src> always return -1, so <src>ScalarColumn::get</src>
+// always calls the data manager which serializes the access.
 // </synopsis>
 
 // <motivation>
@@ -101,8 +107,14 @@ public:
     // This clears the data pointer and sets startRow>endRow.
     void invalidate();
 
+    // Tell if the column can be accessed by multiple threads.
+    // If so, <src>offset</src> always returns -1.
+    void setConcurrent (Bool concurrent)
+      { itsConcurrent = concurrent; }
+
     // Calculate the offset in the cached data for the given row.
-    // -1 is returned if the row is not within the cached rows.
+    // -1 is returned if the row is not within the cached rows or if
+    // the column can be accessed concurrently.
     Int64 offset (rownr_t rownr) const;
 
     // Give a pointer to the data.
@@ -124,6 +136,7 @@ private:
     rownr_t  itsEnd;
     rownr_t  itsIncr;
     const void* itsData;
+    Bool     itsConcurrent;
 };
 
 
@@ -139,7 +152,7 @@ inline void ColumnCache::invalidate()
 
 inline Int64 ColumnCache::offset (rownr_t rownr) const
 {
-    if (rownr < itsStart || rownr > itsEnd) {
+    if (itsConcurrent || rownr < itsStart || rownr > itsEnd) {
         return -1;
     }
     const rownr_t offset = (rownr - itsStart) * itsIncr;
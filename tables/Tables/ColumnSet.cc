@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/ColumnCache.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/IO/MultiFile.h>
@@ -55,7 +56,9 @@ ColumnSet::ColumnSet (TableDesc* tdesc, const StorageOption& opt)
   baseTablePtr_p  (0),
   lockPtr_p       (0),
   seqCount_p      (0),
-  blockDataMan_p  (0)
+  blockDataMan_p  (0),
+  unflushed_p     (False),
+  concurrentRead_p(False)
 {
     //# Loop through all columns in the description and create
     //# a column out of them.
@@ -145,6 +148,7 @@ void ColumnSet::initSomeDataManagers (uInt from, Table& tab)
     //# Now give the data managers the opportunity to create files as needed.
     //# Thereafter to prepare things.
     for (uInt i=from; i<blockDataMan_p.nelements(); i++) {
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	BLOCKDATAMANVAL(i)->create64 (nrrow_p);
     }
     prepareSomeDataManagers (from);
@@ -161,6 +165,7 @@ void ColumnSet::prepareSomeDataManagers (uInt from)
 	}
     }
     for (uInt i=from; i<blockDataMan_p.nelements(); i++) {
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	BLOCKDATAMANVAL(i)->prepare();
     }
 }
@@ -206,6 +211,7 @@ rownr_t ColumnSet::resync (rownr_t nrrow, Bool forceSync)
 		                   blockDataMan_p.nelements(), AipsError);
 	for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
 	    if (dataManChanged_p[i]  ||  nrrow != nrrow_p  ||  forceSync) {
+                auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
                 rownr_t nrr = BLOCKDATAMANVAL(i)->resync64 (nrrow);
                 if (nrr > nrrow) {
                     nrrow = nrr;
@@ -226,6 +232,36 @@ void ColumnSet::invalidateColumnCaches()
     }
 }
 
+std::recursive_mutex& ColumnSet::accessMutex (const DataManager* dataManager)
+{
+    // The data managers using a MultiFile share its buffers.
+    if (multiFile_p  &&  dataManager->multiFile()) {
+	return multiFileMutex_p;
+    }
+    return dataManager->accessMutex();
+}
+
+std::unique_lock<std::recursive_mutex> ColumnSet::lockDataManager
+                                                  (const DataManager* dmPtr)
+{
+    return std::unique_lock<std::recursive_mutex> (accessMutex (dmPtr));
+}
+
+void ColumnSet::setConcurrentRead (Bool concurrent)
+{
+    if (concurrent  &&  lockPtr_p->option() == TableLock::AutoLocking) {
+	throw TableInvOper ("Table " + baseTablePtr_p->tableName() +
+			    " cannot be read concurrently when AutoLocking"
+			    " is used");
+    }
+    concurrentRead_p = concurrent;
+    for (auto& x : colMap_p) {
+	ColumnCache& cache = COLMAPCAST(x.second)->columnCache();
+	cache.invalidate();
+	cache.setConcurrent (concurrent);
+    }
+}
+
 
 //# Do all data managers allow to add and remove rows and columns?
 Bool ColumnSet::canAddRow() const
@@ -275,11 +311,13 @@ void ColumnSet::addRow (rownr_t nrrow)
     // First add row to storage managers, thereafter to virtual engines.
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
         if (BLOCKDATAMANVAL(i)->isStorageManager()) {
+            auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	    BLOCKDATAMANVAL(i)->addRow64 (nrrow);
 	}
     }
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
         if (! BLOCKDATAMANVAL(i)->isStorageManager()) {
+            auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	    BLOCKDATAMANVAL(i)->addRow64 (nrrow);
 	}
     }
@@ -299,6 +337,7 @@ void ColumnSet::removeRow (rownr_t rownr)
 			     " (#rows=" + String::toString(nrrow_p) + ")"));
     }
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	BLOCKDATAMANVAL(i)->removeRow64 (rownr);
     }
     nrrow_p--;
@@ -395,6 +434,7 @@ void ColumnSet::doAddColumn (const ColumnDesc& columnDesc,
     String msg;
     DataManagerColumn* dmcol = 0;
     uInt nrcol = dataManPtr->ncolumn();
+    auto dmLock = lockDataManager (dataManPtr);
     try {
 	col->createDataManagerColumn();
 	dmcol = col->dataManagerColumn();
@@ -421,6 +461,7 @@ void ColumnSet::doAddColumn (const ColumnDesc& columnDesc,
     if (error) {
 	throw (AipsError (msg));
     }
+    col->columnCache().setConcurrent (concurrentRead_p);
     autoReleaseLock();
 }
 
@@ -465,6 +506,7 @@ void ColumnSet::addColumn (const TableDesc& tableDesc,
 	    colMap_p.insert (std::make_pair(cd.name(), col));
 	    col->bind (dmptr);
 	    col->createDataManagerColumn();
+	    col->columnCache().setConcurrent (concurrentRead_p);
 	}
 	// Let the new data manager create space, etc. for its columns.
 	initSomeDataManagers (blockDataMan_p.nelements() - 1, tab);
@@ -499,7 +541,10 @@ void ColumnSet::removeColumn (const Vector<String>& columnNames)
     for (auto& x : dmCounts) {
         if (x.second < 0) {
 	    DataManager* dmPtr = static_cast<DataManager *>(const_cast<void *>(x.first));
-	    dmPtr->deleteManager();
+            {
+                auto dmLock = lockDataManager (dmPtr);
+                dmPtr->deleteManager();
+            }
 	    Bool found = False;
 	    for (uInt j=0; j<blockDataMan_p.nelements(); j++) {
 	        if (dmPtr == blockDataMan_p[j]) {
@@ -534,6 +579,7 @@ void ColumnSet::removeColumn (const Vector<String>& columnNames)
 	DataManager* dmPtr = colPtr->dataManager();
 	if (dmCounts.at(dmPtr) >= 0) {
 	    DataManagerColumn* dmcolPtr = colPtr->dataManagerColumn();
+            auto dmLock = lockDataManager (dmPtr);
 	    dmPtr->removeColumn (dmcolPtr);
 	}
 	delete colPtr;
@@ -731,6 +777,7 @@ void ColumnSet::reopenRW()
     }
     // Reopen all data managers.
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	BLOCKDATAMANVAL(i)->reopenRW();
     }
     // Reopen tables in all column keyword sets.
@@ -807,6 +854,7 @@ Bool ColumnSet::putFile (Bool writeTable, AipsIO& ios,
     MemoryIO memio;
     AipsIO aio(&memio);
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
         if (BLOCKDATAMANVAL(i)->flush (aio, fsync)) {
 	    dataManChanged_p[i] = True;
 	    written = True;
@@ -819,6 +867,7 @@ Bool ColumnSet::putFile (Bool writeTable, AipsIO& ios,
     if (multiFile_p) {
       multiFile_p->flush();
     }
+    unflushed_p = False;
     return written;
 }
 
@@ -899,6 +948,7 @@ rownr_t ColumnSet::getFile (AipsIO& ios, Table& tab, rownr_t nrrow, Bool bigEndi
 	ios.getnew (leng, data);
 	MemoryIO memio (data, leng);
 	AipsIO aio(&memio);
+        auto dmLock = lockDataManager (BLOCKDATAMANVAL(i));
 	rownr_t nrrow = BLOCKDATAMANVAL(i)->open64 (nrrow_p, aio);
         if (nrrow > nrrow_p) {
           nrrow_p = nrrow;
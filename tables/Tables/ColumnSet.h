@@ -38,6 +38,7 @@
 #include <casacore/casa/Arrays/ArrayFwd.h>
 
 #include <map>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -235,6 +236,11 @@ public:
     // Get the data manager change flags (used by PlainTable).
     Block<Bool>& dataManChanged();
 
+    // Has the table been changed since the last flush?
+    // It is set when a write lock is checked, thus before data are changed.
+    Bool hasUnflushedChanges() const
+      { return unflushed_p; }
+
     // Synchronize the data managers when data in them have changed.
     // It returns the number of rows it think it has, which is needed for
     // storage managers like LofarStMan.
@@ -246,6 +252,28 @@ public:
     // Invalidate the column caches for all columns.
     void invalidateColumnCaches();
 
+    // Allow or disallow the columns to be read by multiple threads.
+    // If allowed, the access to a data manager is serialized and the
+    // column caches are not used by ScalarColumn::get.
+    // An exception is thrown if AutoLocking is used, because acquiring
+    // and releasing a lock is not thread-safe.
+    void setConcurrentRead (Bool concurrent);
+
+    // Can the columns be read by multiple threads?
+    Bool isConcurrentRead() const
+      { return concurrentRead_p; }
+
+    // Get the mutex serializing the access to the given data manager.
+    // If a MultiFile is used, the data managers using it share a mutex.
+    std::recursive_mutex& accessMutex (const DataManager* dataManager);
+
+    // Lock the mutex of the given data manager. It is locked while the data
+    // manager is used, so the CacheManager can see if the data manager is
+    // idle (see DataManager::cacheReleaseMutex).
+    // The lock is released when the returned object goes out of scope.
+    std::unique_lock<std::recursive_mutex> lockDataManager
+                                             (const DataManager* dmPtr);
+
     // Get the correct data manager.
     // This is used by the column objects to link themselves to the
     // correct datamanagers when they are read back.
@@ -324,6 +352,9 @@ private:
     //#                                           (used for unique seqnr)
     Block<void*>            blockDataMan_p;   //# list of data managers
     Block<Bool>             dataManChanged_p; //# data has changed
+    Bool                    unflushed_p;      //# changed since last flush?
+    Bool                    concurrentRead_p; //# read by multiple threads?
+    std::recursive_mutex    multiFileMutex_p; //# mutex for the MultiFile
 };
 
 
@@ -356,6 +387,7 @@ inline void ColumnSet::checkWriteLock (Bool wait)
     if (! lockPtr_p->hasLock (FileLocker::Write)) {
 	doLock (FileLocker::Write, wait);
     }
+    unflushed_p = True;
 }
 inline void ColumnSet::userUnlock (Bool releaseFlag)
 {
@@ -27,6 +27,7 @@
 
 //# Includes
 #include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/ColumnsIndexFile.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
@@ -36,26 +37,29 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/ValType.h>
 #include <casacore/tables/Tables/TableError.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 ColumnsIndex::ColumnsIndex (const Table& table, const String& columnName,
-			    Compare* compareFunction, Bool noSort)
+			    Compare* compareFunction, Bool noSort,
+                            Bool persistent)
 : itsLowerKeyPtr (0),
   itsUpperKeyPtr (0)
 {
   Vector<String> columnNames(1);
   columnNames(0) = columnName;
-  create (table, columnNames, compareFunction, noSort);
+  create (table, columnNames, compareFunction, noSort, persistent);
 }
 
 ColumnsIndex::ColumnsIndex (const Table& table,
 			    const Vector<String>& columnNames,
-			    Compare* compareFunction, Bool noSort)
+			    Compare* compareFunction, Bool noSort,
+                            Bool persistent)
 {
-  create (table, columnNames, compareFunction, noSort);
+  create (table, columnNames, compareFunction, noSort, persistent);
 }
 
 ColumnsIndex::ColumnsIndex (const ColumnsIndex& that)
@@ -84,6 +88,8 @@ void ColumnsIndex::copy (const ColumnsIndex& that)
     itsNrrow   = itsTable.nrow();
     itsNoSort  = that.itsNoSort;
     itsCompare = that.itsCompare;
+    itsFileName = that.itsFileName;
+    itsMayLoad  = that.itsMayLoad;
     makeObjects (that.itsLowerKeyPtr->description());
   }
 }
@@ -171,6 +177,12 @@ void ColumnsIndex::deleteObjects()
   delete itsUpperKeyPtr;
   itsLowerKeyPtr = 0;
   itsUpperKeyPtr = 0;
+  // Do not keep referencing the data of a mapped index file.
+  if (itsIndexFile) {
+    itsDataIndex.resize (0);
+    itsUniqueIndex.resize (0);
+    itsIndexFile.reset();
+  }
 }
 
 void ColumnsIndex::addColumnToDesc (RecordDesc& description,
@@ -188,7 +200,7 @@ void ColumnsIndex::addColumnToDesc (RecordDesc& description,
 void ColumnsIndex::create (const Table& table,
 			   const Vector<String>& columnNames,
 			   Compare* compareFunction,
-			   Bool noSort)
+			   Bool noSort, Bool persistent)
 {
   itsTable = table;
   itsNrrow = itsTable.nrow();
@@ -203,8 +215,149 @@ void ColumnsIndex::create (const Table& table,
 		     TableColumn (itsTable, columnNames(i)));
   }
   makeObjects (description);
+  itsMayLoad = True;
+  // An index sorted with a user compare function cannot be persistent,
+  // because its file could be used with another compare function.
+  if (persistent  &&  compareFunction == 0) {
+    itsFileName = indexFileName (itsTable, columnNames, itsDataTypes, noSort);
+  }
   readData();
 }
+
+Bool ColumnsIndex::hasPersistentIndex (const Table& table,
+                                       const Vector<String>& columnNames,
+                                       Bool noSort)
+{
+  Block<Int> dataTypes(columnNames.size());
+  for (uInt i=0; i<columnNames.size(); i++) {
+    if (! table.tableDesc().isColumn (columnNames[i])) {
+      return False;
+    }
+    dataTypes[i] = table.tableDesc()[columnNames[i]].dataType();
+  }
+  String fileName = indexFileName (table, columnNames, dataTypes, noSort);
+  if (fileName.empty()) {
+    return False;
+  }
+  Table tab(table);
+  TableLocker locker(tab, FileLocker::Read);
+  uInt64 stamp;
+  if (! ColumnsIndexFile::getStamp (table, stamp)) {
+    return False;
+  }
+  ColumnsIndexFile file(fileName, table.nrow(), stamp, dataTypes);
+  return file.isValid()  &&  file.nsection() == 2 + columnNames.size();
+}
+
+String ColumnsIndex::indexFileName (const Table& table,
+                                    const Vector<String>& columnNames,
+                                    const Block<Int>& dataTypes, Bool noSort)
+{
+  // String data cannot be used from a mapped file.
+  String name;
+  for (uInt i=0; i<columnNames.size(); i++) {
+    if (dataTypes[i] == TpString) {
+      return String();
+    }
+    if (i > 0) {
+      name += '_';
+    }
+    name += columnNames[i];
+  }
+  if (noSort) {
+    name += "_nosort";
+  }
+  return ColumnsIndexFile::fileName (table, name);
+}
+
+Bool ColumnsIndex::loadIndex()
+{
+  if (itsNrrow == 0) {
+    return False;
+  }
+  uInt64 stamp;
+  if (! ColumnsIndexFile::getStamp (itsTable, stamp)) {
+    return False;
+  }
+  uInt nrfield = itsDataTypes.nelements();
+  std::shared_ptr<ColumnsIndexFile> file = std::make_shared<ColumnsIndexFile>
+    (itsFileName, itsNrrow, stamp, itsDataTypes);
+  if (!file->isValid()  ||  file->nsection() != 2 + nrfield) {
+    return False;
+  }
+  // Check if the sizes of the sections are correct.
+  Block<const void*> sections(2 + nrfield);
+  uInt64 nunique = 0;
+  for (uInt i=0; i<sections.nelements(); i++) {
+    uInt64 nbytes;
+    sections[i] = file->section (i, nbytes);
+    uInt64 expSize = itsNrrow;
+    if (i == 1) {
+      nunique = nbytes / sizeof(rownr_t);
+      expSize = nunique;
+    }
+    expSize *= (i < 2  ?  sizeof(rownr_t) :
+                ValType::getTypeSize (DataType(itsDataTypes[i-2])));
+    if (nbytes != expSize) {
+      return False;
+    }
+  }
+  releaseIndex();
+  itsIndexFile = file;
+  itsDataIndex.takeStorage (IPosition(1, itsNrrow),
+                            (rownr_t*)(sections[0]), SHARE);
+  itsUniqueIndex.takeStorage (IPosition(1, nunique),
+                              (rownr_t*)(sections[1]), SHARE);
+  itsDataInx = itsDataIndex.data();
+  itsUniqueInx = itsUniqueIndex.data();
+  for (uInt i=0; i<nrfield; i++) {
+    itsData[i] = ColumnsIndexFile::shareVector (itsDataTypes[i],
+                                                itsDataVectors[i],
+                                                sections[i+2], itsNrrow);
+  }
+  itsColumnChanged.set (False);
+  itsChanged = False;
+  return True;
+}
+
+void ColumnsIndex::releaseIndex()
+{
+  if (itsIndexFile) {
+    // The data vectors do not share the mapped data anymore, so all
+    // columns have to be reread.
+    for (uInt i=0; i<itsDataTypes.nelements(); i++) {
+      itsData[i] = ColumnsIndexFile::shareVector (itsDataTypes[i],
+                                                  itsDataVectors[i], 0, 0);
+    }
+    itsDataIndex.resize (0);
+    itsUniqueIndex.resize (0);
+    itsColumnChanged.set (True);
+    itsIndexFile.reset();
+  }
+}
+
+void ColumnsIndex::saveIndex()
+{
+  if (itsNrrow == 0) {
+    return;
+  }
+  uInt nrfield = itsDataTypes.nelements();
+  Block<const void*> sections(2 + nrfield);
+  Block<uInt64> sizes(2 + nrfield);
+  sections[0] = itsDataInx;
+  sizes[0] = itsDataIndex.size() * sizeof(rownr_t);
+  sections[1] = itsUniqueInx;
+  sizes[1] = itsUniqueIndex.size() * sizeof(rownr_t);
+  for (uInt i=0; i<nrfield; i++) {
+    sections[i+2] = itsData[i];
+    sizes[i+2] = itsNrrow * ValType::getTypeSize (DataType(itsDataTypes[i]));
+  }
+  uInt64 stamp;
+  if (ColumnsIndexFile::getStamp (itsTable, stamp, True)) {
+    ColumnsIndexFile::write (itsFileName, itsNrrow, stamp,
+                             itsDataTypes, sections, sizes);
+  }
+}
 	    
 void ColumnsIndex::makeObjects (const RecordDesc& description)
 {
@@ -327,6 +480,13 @@ void ColumnsIndex::readData()
   if (!itsChanged) {
     return;
   }
+  // Use the persistent index if possible, otherwise it is rebuilt.
+  if (isPersistent()) {
+    if (itsMayLoad  &&  loadIndex()) {
+      return;
+    }
+    releaseIndex();
+  }
   Sort sort;
   Bool deleteIt;
   const RecordDesc& desc = itsLowerKeyPtr->description();
@@ -463,6 +623,9 @@ void ColumnsIndex::readData()
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
   itsChanged = False;
+  if (isPersistent()) {
+    saveIndex();
+  }
 }
 
 rownr_t ColumnsIndex::bsearch (Bool& found, const Block<void*>& fieldPtrs) const
@@ -723,6 +886,8 @@ void ColumnsIndex::setChanged()
 {
   itsColumnChanged.set (True);
   itsChanged = True;
+  // The data in the persistent index file might not be up to date anymore.
+  itsMayLoad = False;
 }
 
 void ColumnsIndex::setChanged (const String& columnName)
@@ -733,6 +898,7 @@ void ColumnsIndex::setChanged (const String& columnName)
     if (desc.name(i) == columnName) {
       itsColumnChanged[i] = True;
       itsChanged = True;
+      itsMayLoad = False;
       break;
     }
   }
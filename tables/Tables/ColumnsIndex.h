@@ -35,12 +35,14 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class String;
 class TableColumn;
+class ColumnsIndexFile;
 template<typename T> class RecordFieldPtr;
 
 // <summary>
@@ -110,6 +112,21 @@ template<typename T> class RecordFieldPtr;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and optionally resorting the data. This will be deferred
 // until the next key lookup.
+// <p>
+// Reading and sorting the data can take several seconds for large tables.
+// Therefore the index can be made persistent by giving
+// <src>persistent=True</src> when constructing the object. In that case
+// the sorted index and the key data are written into a file in the table
+// directory (see <linkto class=ColumnsIndexFile>ColumnsIndexFile</linkto>)
+// which is memory-mapped when an index on the same columns is created
+// again. The file is automatically invalidated (and rewritten) when the
+// table has been changed since the index was written.
+// Note that a writable table is flushed before the index file is used
+// or written, so changes not flushed yet are taken into account.
+// <br>An index can only be persistent for a persistent plain table
+// (thus not for a reference or memory table), if no key column has
+// data type String, and if the default compare function is used.
+// Otherwise the flag is ignored and the index is only held in memory.
 // </synopsis>
 
 // <example>
@@ -247,8 +264,11 @@ public:
     // column and the sort step will not be done.
     // The default compare function is provided by this class. It simply
     // compares each field in the key.
+    // If <src>persistent==True</src>, the index is kept in a file in the
+    // table directory (see the synopsis).
     ColumnsIndex (const Table&, const String& columnName,
-		  Compare* compareFunction = 0, Bool noSort = False);
+		  Compare* compareFunction = 0, Bool noSort = False,
+                  Bool persistent = False);
 
     // Create an index on the given table for the given columns, thus
     // the key is formed by multiple columns.
@@ -258,7 +278,8 @@ public:
     // The default compare function is provided by this class. It simply
     // compares each field in the key.
     ColumnsIndex (const Table&, const Vector<String>& columnNames,
-		  Compare* compareFunction = 0, Bool noSort = False);
+		  Compare* compareFunction = 0, Bool noSort = False,
+                  Bool persistent = False);
 
     // Copy constructor (copy semantics).
     ColumnsIndex (const ColumnsIndex& that);
@@ -274,6 +295,15 @@ public:
     // Return the names of the columns forming the index.
     Vector<String> columnNames() const;
 
+    // Is the index kept in a file in the table directory?
+    Bool isPersistent() const;
+
+    // Test if the table has a valid persistent index on the given columns,
+    // thus if creating a persistent index on them is cheap.
+    static Bool hasPersistentIndex (const Table&,
+                                    const Vector<String>& columnNames,
+                                    Bool noSort = False);
+
     // Get the table for which this index is created.
     const Table& table() const;
 
@@ -352,7 +382,7 @@ protected:
 
     // Create the various members in the object.
     void create (const Table& table, const Vector<String>& columnNames,
-		 Compare* compareFunction, Bool noSort);
+		 Compare* compareFunction, Bool noSort, Bool persistent);
 
     // Make the various internal <src>RecordFieldPtr</src> objects.
     void makeObjects (const RecordDesc& description);
@@ -361,6 +391,22 @@ protected:
     // form the index.
     void readData();
 
+    // Use the data in a valid persistent index file.
+    // It returns False if there is no valid file.
+    Bool loadIndex();
+
+    // Write the index into the persistent index file.
+    void saveIndex();
+
+    // Release the data of a loaded persistent index file.
+    void releaseIndex();
+
+    // Get the name of the persistent index file for the given columns.
+    // It is empty if the index cannot be persistent.
+    static String indexFileName (const Table& table,
+                                 const Vector<String>& columnNames,
+                                 const Block<Int>& dataTypes, Bool noSort);
+
     // Do a binary search on <src>itsUniqueIndex</src> for the key in
     // <src>fieldPtrs</src>.
     // If the key is found, <src>found</src> is set to True and the index
@@ -412,6 +458,9 @@ private:
     Vector<rownr_t> itsUniqueIndex;
     rownr_t*        itsDataInx;           //# pointer to data in itsDataIndex
     rownr_t*        itsUniqueInx;         //# pointer to data in itsUniqueIndex
+    String          itsFileName;          //# name of persistent index file
+    Bool            itsMayLoad;           //# can the index file be used?
+    std::shared_ptr<ColumnsIndexFile> itsIndexFile;  //# loaded index file
 };
 
 
@@ -419,6 +468,10 @@ inline Bool ColumnsIndex::isUnique() const
 {
     return (itsDataIndex.nelements() == itsUniqueIndex.nelements());
 }
+inline Bool ColumnsIndex::isPersistent() const
+{
+    return !itsFileName.empty();
+}
 inline const Table& ColumnsIndex::table() const
 {
     return itsTable;
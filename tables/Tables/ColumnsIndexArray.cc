@@ -28,6 +28,7 @@
 //# Includes
 #include <casacore/tables/Tables/ColumnsIndexArray.h>
 #include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/ColumnsIndexFile.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
@@ -38,15 +39,18 @@
 #include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/ValType.h>
 #include <casacore/tables/Tables/TableError.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 ColumnsIndexArray::ColumnsIndexArray (const Table& table,
-				      const String& columnName)
+				      const String& columnName,
+                                      Bool persistent)
 : itsLowerKeyPtr (0),
-  itsUpperKeyPtr (0)
+  itsUpperKeyPtr (0),
+  itsMayLoad     (True)
 {
   itsTable = table;
   itsNrrow = itsTable.nrow();
@@ -54,6 +58,9 @@ ColumnsIndexArray::ColumnsIndexArray (const Table& table,
   RecordDesc description;
   addColumnToDesc (description, TableColumn (itsTable, columnName));
   makeObjects (description);
+  if (persistent) {
+    itsFileName = indexFileName (itsTable, columnName, itsDataType);
+  }
   readData();
 }
 
@@ -81,6 +88,8 @@ void ColumnsIndexArray::copy (const ColumnsIndexArray& that)
     deleteObjects();
     itsTable = that.itsTable;
     itsNrrow = itsTable.nrow();
+    itsFileName = that.itsFileName;
+    itsMayLoad  = that.itsMayLoad;
     makeObjects (that.itsLowerKeyPtr->description());
   }
 }
@@ -135,6 +144,12 @@ void ColumnsIndexArray::deleteObjects()
   delete itsUpperKeyPtr;
   itsLowerKeyPtr = 0;
   itsUpperKeyPtr = 0;
+  // Do not keep referencing the data of a mapped index file.
+  if (itsIndexFile) {
+    itsDataIndex.resize (0);
+    itsUniqueIndex.resize (0);
+    itsIndexFile.reset();
+  }
 }
 
 void ColumnsIndexArray::addColumnToDesc (RecordDesc& description,
@@ -159,6 +174,7 @@ void ColumnsIndexArray::makeObjects (const RecordDesc& description)
   // Initialize the column and field block.
   itsDataVector = 0;
   itsData = 0;
+  itsRownrsPtr = 0;
   itsLowerField = 0;
   itsUpperField = 0;
   itsChanged = True;
@@ -226,6 +242,13 @@ void ColumnsIndexArray::readData()
   if (!itsChanged) {
     return;
   }
+  // Use the persistent index if possible, otherwise it is rebuilt.
+  if (isPersistent()) {
+    if (itsMayLoad  &&  loadIndex()) {
+      return;
+    }
+    releaseIndex();
+  }
   Sort sort;
   Bool deleteIt;
   const RecordDesc& desc = itsLowerKeyPtr->description();
@@ -290,7 +313,124 @@ void ColumnsIndexArray::readData()
   sort.unique (itsUniqueIndex, itsDataIndex);
   itsDataInx = itsDataIndex.getStorage (deleteIt);
   itsUniqueInx = itsUniqueIndex.getStorage (deleteIt);
+  itsRownrsPtr = itsRownrs.storage();
   itsChanged = False;
+  if (isPersistent()) {
+    saveIndex();
+  }
+}
+
+Bool ColumnsIndexArray::hasPersistentIndex (const Table& table,
+                                            const String& columnName)
+{
+  if (! table.tableDesc().isColumn (columnName)) {
+    return False;
+  }
+  Block<Int> dataTypes(1, table.tableDesc()[columnName].dataType());
+  String fileName = indexFileName (table, columnName, dataTypes[0]);
+  if (fileName.empty()) {
+    return False;
+  }
+  Table tab(table);
+  TableLocker locker(tab, FileLocker::Read);
+  uInt64 stamp;
+  if (! ColumnsIndexFile::getStamp (table, stamp)) {
+    return False;
+  }
+  ColumnsIndexFile file(fileName, table.nrow(), stamp, dataTypes);
+  return file.isValid()  &&  file.nsection() == 4;
+}
+
+String ColumnsIndexArray::indexFileName (const Table& table,
+                                         const String& columnName,
+                                         Int dataType)
+{
+  // String data cannot be used from a mapped file.
+  if (dataType == TpString) {
+    return String();
+  }
+  return ColumnsIndexFile::fileName (table, columnName);
+}
+
+Bool ColumnsIndexArray::loadIndex()
+{
+  if (itsNrrow == 0) {
+    return False;
+  }
+  uInt64 stamp;
+  if (! ColumnsIndexFile::getStamp (itsTable, stamp)) {
+    return False;
+  }
+  Block<Int> dataTypes(1, itsDataType);
+  std::shared_ptr<ColumnsIndexFile> file = std::make_shared<ColumnsIndexFile>
+    (itsFileName, itsNrrow, stamp, dataTypes);
+  if (!file->isValid()  ||  file->nsection() != 4) {
+    return False;
+  }
+  // The sections are the data index, unique index, row numbers and data.
+  // Check if their sizes are correct.
+  Block<const void*> sections(4);
+  Block<uInt64> sizes(4);
+  for (uInt i=0; i<4; i++) {
+    sections[i] = file->section (i, sizes[i]);
+  }
+  uInt64 npts = sizes[0] / sizeof(rownr_t);
+  uInt64 nunique = sizes[1] / sizeof(rownr_t);
+  if (sizes[0] != npts * sizeof(rownr_t)  ||
+      sizes[1] != nunique * sizeof(rownr_t)  ||
+      sizes[2] != npts * sizeof(rownr_t)  ||
+      sizes[3] != npts * ValType::getTypeSize (DataType(itsDataType))) {
+    return False;
+  }
+  releaseIndex();
+  itsIndexFile = file;
+  itsDataIndex.takeStorage (IPosition(1, npts),
+                            (rownr_t*)(sections[0]), SHARE);
+  itsUniqueIndex.takeStorage (IPosition(1, nunique),
+                              (rownr_t*)(sections[1]), SHARE);
+  itsDataInx = itsDataIndex.data();
+  itsUniqueInx = itsUniqueIndex.data();
+  itsRownrsPtr = static_cast<const rownr_t*>(sections[2]);
+  itsData = ColumnsIndexFile::shareVector (itsDataType, itsDataVector,
+                                           sections[3], npts);
+  itsChanged = False;
+  return True;
+}
+
+void ColumnsIndexArray::releaseIndex()
+{
+  if (itsIndexFile) {
+    itsData = ColumnsIndexFile::shareVector (itsDataType, itsDataVector,
+                                             0, 0);
+    itsDataIndex.resize (0);
+    itsUniqueIndex.resize (0);
+    itsRownrsPtr = 0;
+    itsIndexFile.reset();
+  }
+}
+
+void ColumnsIndexArray::saveIndex()
+{
+  if (itsNrrow == 0) {
+    return;
+  }
+  uInt64 npts = itsDataIndex.size();
+  Block<Int> dataTypes(1, itsDataType);
+  Block<const void*> sections(4);
+  Block<uInt64> sizes(4);
+  sections[0] = itsDataInx;
+  sizes[0] = npts * sizeof(rownr_t);
+  sections[1] = itsUniqueInx;
+  sizes[1] = itsUniqueIndex.size() * sizeof(rownr_t);
+  sections[2] = itsRownrsPtr;
+  sizes[2] = npts * sizeof(rownr_t);
+  sections[3] = itsData;
+  sizes[3] = npts * ValType::getTypeSize (DataType(itsDataType));
+  uInt64 stamp;
+  if (ColumnsIndexFile::getStamp (itsTable, stamp, True)) {
+    ColumnsIndexFile::write (itsFileName, itsNrrow, stamp,
+                             dataTypes, sections, sizes);
+  }
 }
 
 rownr_t ColumnsIndexArray::bsearch (Bool& found, void* fieldPtr) const
@@ -410,7 +550,7 @@ rownr_t ColumnsIndexArray::getRowNumber (Bool& found)
   readData();
   rownr_t inx = bsearch (found, itsLowerField);
   if (found) {
-    inx = itsRownrs[itsDataInx[inx]];
+    inx = itsRownrsPtr[itsDataInx[inx]];
   }
   return inx;
 }
@@ -489,7 +629,7 @@ void ColumnsIndexArray::fillRowNumbers (Vector<rownr_t>& rows,
   Bool deleteIt;
   rownr_t* rowStorage = rows.getStorage (deleteIt);
   for (rownr_t i=0; i<nr; i++) {
-    rowStorage[i] = itsRownrs[itsDataInx[start+i]];
+    rowStorage[i] = itsRownrsPtr[itsDataInx[start+i]];
   }
   rows.putStorage (rowStorage, deleteIt);
   if (unique) {
@@ -502,6 +642,8 @@ void ColumnsIndexArray::fillRowNumbers (Vector<rownr_t>& rows,
 void ColumnsIndexArray::setChanged()
 {
   itsChanged = True;
+  // The data in the persistent index file might not be up to date anymore.
+  itsMayLoad = False;
 }
 
 void ColumnsIndexArray::setChanged (const String& columnName)
@@ -509,6 +651,7 @@ void ColumnsIndexArray::setChanged (const String& columnName)
   const RecordDesc& desc = itsLowerKeyPtr->description();
   if (desc.name(0) == columnName) {
     itsChanged = True;
+    itsMayLoad = False;
   }
 }
 
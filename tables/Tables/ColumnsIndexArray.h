@@ -35,12 +35,14 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class String;
 class TableColumn;
+class ColumnsIndexFile;
 
 
 // <summary>
@@ -110,6 +112,11 @@ class TableColumn;
 // <br>If data have changed, the entire index will be recreated by
 // rereading and resorting the data. This will be deferred
 // until the next key lookup.
+// <p>
+// Like <linkto class=ColumnsIndex>ColumnsIndex</linkto> the index can
+// be made persistent, in which case it is kept in a memory-mapped file in
+// the table directory. It is only possible for non-String columns in a
+// persistent plain table.
 // </synopsis>
 
 // <example>
@@ -152,7 +159,10 @@ public:
   // If <src>noSort==True</src>, the table is already in order of that
   // column and the sort step will not be done.
   // It only supports String and integer columns.
-  ColumnsIndexArray (const Table&, const String& columnName);
+  // If <src>persistent==True</src>, the index is kept in a file in the
+  // table directory (see the synopsis).
+  ColumnsIndexArray (const Table&, const String& columnName,
+                     Bool persistent = False);
 
   // Copy constructor (copy semantics).
   ColumnsIndexArray (const ColumnsIndexArray& that);
@@ -168,6 +178,12 @@ public:
   // Return the names of the columns forming the index.
   const String& columnName() const;
 
+  // Is the index kept in a file in the table directory?
+  Bool isPersistent() const;
+
+  // Test if the table has a valid persistent index on the given column.
+  static Bool hasPersistentIndex (const Table&, const String& columnName);
+
   // Get the table for which this index is created.
   const Table& table() const;
 
@@ -263,6 +279,21 @@ protected:
   // form the index.
   void readData();
 
+  // Use the data in a valid persistent index file.
+  // It returns False if there is no valid file.
+  Bool loadIndex();
+
+  // Write the index into the persistent index file.
+  void saveIndex();
+
+  // Release the data of a loaded persistent index file.
+  void releaseIndex();
+
+  // Get the name of the persistent index file for the given column.
+  // It is empty if the index cannot be persistent.
+  static String indexFileName (const Table& table, const String& columnName,
+                               Int dataType);
+
   // Do a binary search on <src>itsUniqueIndexArray</src> for the key in
   // <src>fieldPtrs</src>.
   // If the key is found, <src>found</src> is set to True and the index
@@ -314,8 +345,12 @@ private:
   //# Indices in itsDataIndex for each unique key
   Vector<rownr_t> itsUniqueIndex;
   Block<rownr_t>  itsRownrs;            //# rownr for each value
+  const rownr_t*  itsRownrsPtr;         //# itsRownrs or rownrs in index file
   rownr_t*        itsDataInx;           //# pointer to data in itsDataIndex
   rownr_t*        itsUniqueInx;         //# pointer to data in itsUniqueIndex
+  String          itsFileName;          //# name of persistent index file
+  Bool            itsMayLoad;           //# can the index file be used?
+  std::shared_ptr<ColumnsIndexFile> itsIndexFile;  //# loaded index file
 };
 
 
@@ -323,6 +358,10 @@ inline Bool ColumnsIndexArray::isUnique() const
 {
     return (itsDataIndex.nelements() == itsUniqueIndex.nelements());
 }
+inline Bool ColumnsIndexArray::isPersistent() const
+{
+    return !itsFileName.empty();
+}
 inline const Table& ColumnsIndexArray::table() const
 {
     return itsTable;
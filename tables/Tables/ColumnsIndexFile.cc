@@ -0,0 +1,267 @@
+//# ColumnsIndexFile.cc: Persistent file holding the data of a column index
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/ColumnsIndexFile.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/BaseTable.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <functional>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The file header consists of 64-bit values (in native byte order):
+//#   magic value, version, endian check value, nrrow, table stamp,
+//#   number of data types, the data types, number of sections,
+//#   offset and size of each section.
+static const uInt64 theMagic = 0x58444e49434f4c43ULL;
+static const uInt64 theVersion = 2;
+static const uInt64 theEndianCheck = 0x0102030405060708ULL;
+
+ColumnsIndexFile::ColumnsIndexFile (const String& fileName, rownr_t nrrow,
+                                    uInt64 stamp,
+                                    const Block<Int>& dataTypes)
+: itsValid (False)
+{
+    RegularFile file(fileName);
+    if (fileName.empty()  ||  !file.exists()) {
+        return;
+    }
+    try {
+        itsFile = std::make_shared<MMapIO> (file);
+    } catch (const AipsError&) {
+        return;
+    }
+    Int64 fileSize = itsFile->getFileSize();
+    if (fileSize < Int64(6*sizeof(uInt64))) {
+        return;
+    }
+    const uInt64* hdr = static_cast<const uInt64*>(itsFile->getReadPointer(0));
+    uInt64 nhdr = fileSize / sizeof(uInt64);
+    uInt64 nr = 6;
+    if (nhdr < nr  ||  hdr[0] != theMagic  ||  hdr[1] != theVersion  ||
+        hdr[2] != theEndianCheck  ||  hdr[3] != nrrow  ||
+        hdr[4] != stamp  ||  hdr[5] != dataTypes.nelements()) {
+        return;
+    }
+    if (nhdr < nr + dataTypes.nelements() + 1) {
+        return;
+    }
+    for (uInt i=0; i<dataTypes.nelements(); ++i) {
+        if (hdr[nr++] != uInt64(dataTypes[i])) {
+            return;
+        }
+    }
+    uInt64 nsect = hdr[nr++];
+    if (nhdr < nr + 2*nsect) {
+        return;
+    }
+    itsSections.resize (nsect);
+    itsSizes.resize (nsect);
+    for (uInt64 i=0; i<nsect; ++i) {
+        itsSections[i] = hdr[nr++];
+        itsSizes[i] = hdr[nr++];
+        if (itsSections[i] + itsSizes[i] > uInt64(fileSize)) {
+            return;
+        }
+    }
+    itsValid = True;
+}
+
+ColumnsIndexFile::~ColumnsIndexFile()
+{}
+
+const void* ColumnsIndexFile::section (uInt index, uInt64& nbytes) const
+{
+    nbytes = itsSizes[index];
+    return itsFile->getReadPointer (itsSections[index]);
+}
+
+Bool ColumnsIndexFile::write (const String& fileName, rownr_t nrrow,
+                              uInt64 stamp,
+                              const Block<Int>& dataTypes,
+                              const Block<const void*>& sections,
+                              const Block<uInt64>& sectionSizes)
+{
+    if (fileName.empty()) {
+        return False;
+    }
+    uInt nsect = sections.nelements();
+    Block<uInt64> hdr(7 + dataTypes.nelements() + 2*nsect);
+    uInt nr = 0;
+    hdr[nr++] = theMagic;
+    hdr[nr++] = theVersion;
+    hdr[nr++] = theEndianCheck;
+    hdr[nr++] = nrrow;
+    hdr[nr++] = stamp;
+    hdr[nr++] = dataTypes.nelements();
+    for (uInt i=0; i<dataTypes.nelements(); ++i) {
+        hdr[nr++] = dataTypes[i];
+    }
+    hdr[nr++] = nsect;
+    uInt64 offset = hdr.nelements() * sizeof(uInt64);
+    for (uInt i=0; i<nsect; ++i) {
+        hdr[nr++] = offset;
+        hdr[nr++] = sectionSizes[i];
+        offset += (sectionSizes[i] + 7) / 8 * 8;
+    }
+    // Use a unique temporary name in case another process writes as well.
+    String tmpName = fileName + "_tmp" + String::toString(getpid());
+    try {
+        RegularFile tmpFile(tmpName);
+        {
+            RegularFileIO fio(tmpFile, ByteIO::New);
+            fio.write (hdr.nelements() * sizeof(uInt64), hdr.storage());
+            const char pad[8] = {0,0,0,0,0,0,0,0};
+            for (uInt i=0; i<nsect; ++i) {
+                fio.write (sectionSizes[i], sections[i]);
+                uInt npad = (8 - sectionSizes[i] % 8) % 8;
+                fio.write (npad, pad);
+            }
+        }
+        tmpFile.move (fileName);
+    } catch (const AipsError&) {
+        return False;
+    }
+    return True;
+}
+
+// Let a data vector share the data of a section.
+template<typename T>
+static void* shareVectorData (void* vecptr, const void* data, uInt64 nelem)
+{
+  Vector<T>* vec = static_cast<Vector<T>*>(vecptr);
+  if (data == 0) {
+    // Do not share anymore, so the vector can be refilled.
+    vec->resize (0);
+  } else {
+    vec->takeStorage (IPosition(1, nelem),
+                      static_cast<T*>(const_cast<void*>(data)), SHARE);
+  }
+  return vec->data();
+}
+
+void* ColumnsIndexFile::shareVector (Int dataType, void* vecptr,
+                                     const void* data, uInt64 nelem)
+{
+  switch (dataType) {
+  case TpBool:
+    return shareVectorData<Bool> (vecptr, data, nelem);
+  case TpUChar:
+    return shareVectorData<uChar> (vecptr, data, nelem);
+  case TpShort:
+    return shareVectorData<Short> (vecptr, data, nelem);
+  case TpInt:
+    return shareVectorData<Int> (vecptr, data, nelem);
+  case TpUInt:
+    return shareVectorData<uInt> (vecptr, data, nelem);
+  case TpInt64:
+    return shareVectorData<Int64> (vecptr, data, nelem);
+  case TpFloat:
+    return shareVectorData<Float> (vecptr, data, nelem);
+  case TpDouble:
+    return shareVectorData<Double> (vecptr, data, nelem);
+  case TpComplex:
+    return shareVectorData<Complex> (vecptr, data, nelem);
+  case TpDComplex:
+    return shareVectorData<DComplex> (vecptr, data, nelem);
+  default:
+    throw (TableError ("ColumnsIndexFile: data type " +
+                        String::toString(dataType) +
+                        " cannot be persistent"));
+  }
+}
+
+String ColumnsIndexFile::fileName (const Table& table, const String& name)
+{
+    if (table.isNull()  ||  !table.isRootTable()  ||
+        table.tableType() != Table::Plain  ||  table.isMarkedForDelete()) {
+        return String();
+    }
+    return table.tableName() + "/table.colindex_" + name;
+}
+
+// Combine a value into the stamp (as done by boost::hash_combine).
+static void combineStamp (uInt64& stamp, uInt64 value)
+{
+    stamp ^= value + 0x9e3779b97f4a7c15ULL + (stamp << 6) + (stamp >> 2);
+}
+
+Bool ColumnsIndexFile::getStamp (const Table& table, uInt64& stamp,
+                                 Bool flush)
+{
+    if (flush  &&  table.isWritable()) {
+        Table tab(table);
+        tab.flush();
+    }
+    if (table.baseTablePtr()->hasUnflushedChanges()) {
+        return False;
+    }
+    // The modify counter alone does not suffice, because it restarts when
+    // the lock file is recreated. So use the status of the data files as
+    // well. The table description file is not used, because it is always
+    // rewritten when a writable table is closed.
+    stamp = 0;
+    combineStamp (stamp, table.baseTablePtr()->getModifyCounter());
+    Directory dir(table.tableName());
+    for (DirectoryIterator iter(dir); !iter.pastEnd(); ++iter) {
+        String name = iter.name();
+        if (name == "table.dat"  ||  name == "table.info"  ||
+            name == "table.lock"  ||  name.startsWith ("table.colindex_")) {
+            continue;
+        }
+        struct stat buf;
+        String path = table.tableName() + '/' + name;
+        if (stat (path.chars(), &buf) != 0  ||  !S_ISREG(buf.st_mode)) {
+            continue;
+        }
+        combineStamp (stamp, std::hash<std::string>()(name));
+        combineStamp (stamp, buf.st_ino);
+        combineStamp (stamp, buf.st_size);
+#if defined(__APPLE__)
+        combineStamp (stamp, buf.st_mtimespec.tv_sec);
+        combineStamp (stamp, buf.st_mtimespec.tv_nsec);
+#else
+        combineStamp (stamp, buf.st_mtim.tv_sec);
+        combineStamp (stamp, buf.st_mtim.tv_nsec);
+#endif
+    }
+    return True;
+}
+
+} //# NAMESPACE CASACORE - END
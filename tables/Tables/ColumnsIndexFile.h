@@ -0,0 +1,153 @@
+//# ColumnsIndexFile.h: Persistent file holding the data of a column index
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_COLUMNSINDEXFILE_H
+#define TABLES_COLUMNSINDEXFILE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <memory>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class Table;
+class MMapIO;
+
+
+// <summary>
+// Persistent file holding the data of a column index.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tColumnsIndex.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=ColumnsIndex>ColumnsIndex</linkto>
+// </prerequisite>
+
+// <synopsis>
+// ColumnsIndexFile is used by <linkto class=ColumnsIndex>ColumnsIndex</linkto>
+// and <linkto class=ColumnsIndexArray>ColumnsIndexArray</linkto> to keep
+// the sorted index of the key columns in a file in the table directory.
+// Thus, the index does not need to be rebuilt each time the table is opened.
+// <p>
+// The file contains a small header followed by a number of sections,
+// each being a raw array (e.g., the sorted row numbers and the key values).
+// The sections are aligned on 8 bytes and are stored in the native
+// byte order, so they can be used directly from the memory-mapped file.
+// <br>The header contains the number of rows and a stamp of the table
+// when the index was written. If they do not match the table, the file is
+// invalid and the index has to be rebuilt (and rewritten).
+// The stamp is made from the modify counter of the table and the size,
+// inode and modification time of the data files in the table directory,
+// so the index is automatically invalidated when the table has been
+// changed.
+// The modify counter alone does not suffice, because it restarts when the
+// lock file is recreated. A table with changes not flushed yet has no
+// stamp, thus its index files are invalid.
+// A file written on a machine with another byte order is invalid as well.
+// <br>An index can only be persisted for a persistent plain table;
+// a reference table or memory table does not have its own directory.
+// </synopsis>
+
+class ColumnsIndexFile
+{
+public:
+    // Open and map an existing index file.
+    // The file is valid if it exists, has the correct format, and matches
+    // the given number of rows, table stamp and key data types.
+    ColumnsIndexFile (const String& fileName, rownr_t nrrow,
+                      uInt64 stamp, const Block<Int>& dataTypes);
+
+    ~ColumnsIndexFile();
+
+    // Is the file valid (see constructor)?
+    Bool isValid() const
+      { return itsValid; }
+
+    // Get the number of sections.
+    uInt nsection() const
+      { return itsSections.nelements(); }
+
+    // Get a pointer to the data of a section in the mapped file.
+    // The size of the section (in bytes) is returned as well.
+    const void* section (uInt index, uInt64& nbytes) const;
+
+    // Write an index file containing the given sections (with their sizes
+    // in bytes). It is written into a temporary file first which is
+    // renamed, so a reader never sees a partly written file.
+    // It returns False if the file could not be written (e.g. because
+    // the table directory is not writable).
+    static Bool write (const String& fileName, rownr_t nrrow,
+                       uInt64 stamp, const Block<Int>& dataTypes,
+                       const Block<const void*>& sections,
+                       const Block<uInt64>& sectionSizes);
+
+    // Let the <src>Vector<T></src> pointed to by <src>vecptr</src> share
+    // the data of a section (as returned by function <src>section</src>).
+    // The template type T is given by <src>dataType</src>; String is not
+    // supported. If <src>data</src> is a null pointer, the vector is
+    // resized to zero length, so it does not reference the data anymore.
+    // It returns the pointer to the data of the vector.
+    static void* shareVector (Int dataType, void* vecptr, const void* data,
+                              uInt64 nelem);
+
+    // Get the name of the index file for the given name in the table
+    // directory. An empty string is returned if the table is not a
+    // persistent plain table.
+    static String fileName (const Table& table, const String& name);
+
+    // Get the current stamp of the table (see the synopsis).
+    // It returns False if the table has changes not flushed yet.
+    // If <src>flush=True</src>, a writable table is flushed first, which
+    // should only be done when writing an index file.
+    // A read lock must have been acquired.
+    static Bool getStamp (const Table& table, uInt64& stamp,
+                          Bool flush = False);
+
+private:
+    // Forbid copy constructor and assignment.
+    // <group>
+    ColumnsIndexFile (const ColumnsIndexFile&);
+    ColumnsIndexFile& operator= (const ColumnsIndexFile&);
+    // </group>
+
+    std::shared_ptr<MMapIO> itsFile;
+    Bool                    itsValid;
+    Block<uInt64>           itsSections;    //# offset of each section
+    Block<uInt64>           itsSizes;       //# size of each section
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -127,6 +127,16 @@ Bool MemoryTable::hasLock (FileLocker::LockType) const
   return True;
 }
 
+void MemoryTable::setConcurrentRead (Bool concurrent)
+{
+  colSetPtr_p->setConcurrentRead (concurrent);
+}
+
+Bool MemoryTable::isConcurrentRead() const
+{
+  return colSetPtr_p->isConcurrentRead();
+}
+
 Bool MemoryTable::lock (FileLocker::LockType, uInt)
 {
   return True;
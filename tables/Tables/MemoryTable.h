@@ -118,6 +118,12 @@ public:
   // It always returns True.
   virtual Bool hasLock (FileLocker::LockType) const;
 
+  // Allow or disallow the table to be read by multiple threads.
+  virtual void setConcurrentRead (Bool concurrent);
+
+  // Can the table be read by multiple threads?
+  virtual Bool isConcurrentRead() const;
+
   // Locking the table is a no-op.
   virtual Bool lock (FileLocker::LockType, uInt nattempts);
 
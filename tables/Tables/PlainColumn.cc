@@ -99,7 +99,51 @@ ColumnCache& PlainColumn::columnCache()
     { return dataColPtr_p->columnCache(); }
 
 void PlainColumn::setMaximumCacheSize (uInt nbytes)
-    { dataManPtr_p->setMaximumCacheSize (nbytes); }
+{
+    auto dmLock = lockDataManager();
+    dataManPtr_p->setMaximumCacheSize (nbytes);
+}
+
+std::unique_lock<std::recursive_mutex> PlainColumn::lockDataManager() const
+{
+    return colSetPtr_p->lockDataManager (dataManPtr_p);
+}
+
+Bool PlainColumn::getZoneMap (Vector<rownr_t>& endRows,
+                              Vector<Double>& minValues,
+                              Vector<Double>& maxValues) const
+{
+    checkReadLock (True);
+    auto dmLock = lockDataManager();
+    Bool fnd = dataColPtr_p->getZoneMap (endRows, minValues, maxValues);
+    autoReleaseLock();
+    return fnd;
+}
+
+Bool PlainColumn::getArrayView (rownr_t rownr, const Slicer* section,
+                                ArrayBase& arr) const
+{
+    // A view can refer to a buffer that is changed by another thread.
+    if (colSetPtr_p->isConcurrentRead()) {
+        return False;
+    }
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getArrayViewV (rownr, section, arr);
+    autoReleaseLock();
+    return fnd;
+}
+
+Bool PlainColumn::getColumnRangeView (rownr_t startRow, rownr_t nrow,
+                                      ArrayBase& arr) const
+{
+    if (colSetPtr_p->isConcurrentRead()) {
+        return False;
+    }
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getColumnRangeViewV (startRow, nrow, arr);
+    autoReleaseLock();
+    return fnd;
+}
 
 
 //# Read/write the column.
@@ -35,6 +35,7 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -131,6 +132,19 @@ public:
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
+    // Get the zone map from the data manager column.
+    virtual Bool getZoneMap (Vector<rownr_t>& endRows,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues) const;
+
+    // Get a view on the data from the data manager column.
+    // <group>
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* section,
+                               ArrayBase& arr) const;
+    virtual Bool getColumnRangeView (rownr_t startRow, rownr_t nrow,
+                                     ArrayBase& arr) const;
+    // </group>
+
     // Write the column.
     void putFile (AipsIO&, const TableAttr&);
 
@@ -179,6 +193,12 @@ protected:
     // Inspect the auto lock when the inspection interval has expired and
     // release it when another process needs the lock.
     void autoReleaseLock() const;
+
+    // Lock the data manager. It serializes the access if the table is read
+    // by multiple threads (see ColumnSet::setConcurrentRead) and tells the
+    // CacheManager that the data manager is in use.
+    // The lock is released when the returned object goes out of scope.
+    std::unique_lock<std::recursive_mutex> lockDataManager() const;
 };
 
 
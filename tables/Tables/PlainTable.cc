@@ -419,6 +419,14 @@ Bool PlainTable::hasLock (FileLocker::LockType type) const
 {
     return lockPtr_p->hasLock (type);
 }
+void PlainTable::setConcurrentRead (Bool concurrent)
+{
+    colSetPtr_p->setConcurrentRead (concurrent);
+}
+Bool PlainTable::isConcurrentRead() const
+{
+    return colSetPtr_p->isConcurrentRead();
+}
 Bool PlainTable::lock (FileLocker::LockType type, uInt nattempts)
 {
     //# When the table is already locked (read locked is sufficient),
@@ -505,6 +513,11 @@ uInt PlainTable::getModifyCounter() const
     return lockSync_p.getModifyCounter();
 }
 
+Bool PlainTable::hasUnflushedChanges() const
+{
+    return tableChanged_p  ||  colSetPtr_p->hasUnflushedChanges();
+}
+
 
 void PlainTable::flush (Bool fsync, Bool recursive)
 {
@@ -153,6 +153,12 @@ public:
     // be read or written safely?
     virtual Bool hasLock (FileLocker::LockType) const;
 
+    // Allow or disallow the table to be read by multiple threads.
+    virtual void setConcurrentRead (Bool concurrent);
+
+    // Can the table be read by multiple threads?
+    virtual Bool isConcurrentRead() const;
+
     // Try to lock the table for read or write access.
     virtual Bool lock (FileLocker::LockType, uInt nattempts);
 
@@ -180,6 +186,9 @@ public:
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
+    // Has the table been changed since it was flushed the last time?
+    virtual Bool hasUnflushedChanges() const;
+
     // Set the table to being changed.
     virtual void setTableChanged();
 
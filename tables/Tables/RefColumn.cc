@@ -105,6 +105,25 @@ void RefColumn::getArray (rownr_t rownr, ArrayBase& data) const
 void RefColumn::getSlice (rownr_t rownr, const Slicer& ns, ArrayBase& data) const
     { colPtr_p->getSlice (refTabPtr_p->rootRownr(rownr), ns, data); }
 
+Bool RefColumn::getArrayView (rownr_t rownr, const Slicer* ns,
+                              ArrayBase& data) const
+    { return colPtr_p->getArrayView (refTabPtr_p->rootRownr(rownr), ns, data); }
+
+Bool RefColumn::getColumnRangeView (rownr_t startRow, rownr_t nrow,
+                                    ArrayBase& data) const
+{
+    if (nrow == 0) {
+        return False;
+    }
+    rownr_t rootRow = refTabPtr_p->rootRownr(startRow);
+    for (rownr_t i=1; i<nrow; ++i) {
+        if (refTabPtr_p->rootRownr(startRow+i) != rootRow+i) {
+            return False;
+        }
+    }
+    return colPtr_p->getColumnRangeView (rootRow, nrow, data);
+}
+
 void RefColumn::put (rownr_t rownr, const void* dataPtr)
     { colPtr_p->put (refTabPtr_p->rootRownr(rownr), dataPtr); }
 
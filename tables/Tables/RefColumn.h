@@ -154,6 +154,15 @@ public:
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
+    // Get a view on the array (section) in a particular cell.
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* section,
+                               ArrayBase& arr) const;
+
+    // Get a view on the arrays in a range of rows. It is only possible if
+    // the rows are also consecutive in the referenced table.
+    virtual Bool getColumnRangeView (rownr_t startRow, rownr_t nrow,
+                                     ArrayBase& arr) const;
+
     // Get the vector of all scalar values in a column.
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
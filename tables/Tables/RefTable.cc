@@ -208,6 +208,14 @@ Bool RefTable::hasLock (FileLocker::LockType type) const
 {
     return baseTabPtr_p->hasLock (type);
 }
+void RefTable::setConcurrentRead (Bool concurrent)
+{
+    baseTabPtr_p->setConcurrentRead (concurrent);
+}
+Bool RefTable::isConcurrentRead() const
+{
+    return baseTabPtr_p->isConcurrentRead();
+}
 Bool RefTable::lock (FileLocker::LockType type, uInt nattempts)
 {
     return baseTabPtr_p->lock (type, nattempts);
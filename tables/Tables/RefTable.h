@@ -176,6 +176,13 @@ public:
     // be read or written safely?
     virtual Bool hasLock (FileLocker::LockType) const;
 
+    // Allow or disallow the table to be read by multiple threads.
+    // It is done for the root table.
+    virtual void setConcurrentRead (Bool concurrent);
+
+    // Can the table be read by multiple threads?
+    virtual Bool isConcurrentRead() const;
+
     // Try to lock the table for read or write access.
     virtual Bool lock (FileLocker::LockType, uInt nattempts);
 
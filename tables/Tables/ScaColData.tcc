@@ -91,6 +91,7 @@ Bool ScalarColumnData<T>::isDefined (rownr_t rownr) const
 	return True;
     }
     T val;
+    auto dmLock = lockDataManager();
     dataColPtr_p->get (rownr, &val);
     return ( (!(val == undefVal_p)));
 }
@@ -103,6 +104,7 @@ void ScalarColumnData<T>::get (rownr_t rownr, void* val) const
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr);
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->get (rownr, static_cast<T*>(val));
     autoReleaseLock();
 }
@@ -118,6 +120,7 @@ void ScalarColumnData<T>::getScalarColumn (ArrayBase& val) const
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumn"));
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getScalarColumnV (val);
     autoReleaseLock();
 }
@@ -133,6 +136,7 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumnCells"));
     }
     checkReadLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->getScalarColumnCellsV (rownrs, val);
     autoReleaseLock();
 }
@@ -146,6 +150,7 @@ void ScalarColumnData<T>::put (rownr_t rownr, const void* val)
     }
     checkValueLength (static_cast<const T*>(val));
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->put (rownr, static_cast<const T*>(val));
     autoReleaseLock();
 }
@@ -161,6 +166,7 @@ void ScalarColumnData<T>::putScalarColumn (const ArrayBase& val)
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putScalarColumnV (val);
     autoReleaseLock();
 }
@@ -177,6 +183,7 @@ void ScalarColumnData<T>::putScalarColumnCells (const RefRows& rownrs,
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
+    auto dmLock = lockDataManager();
     dataColPtr_p->putScalarColumnCellsV (rownrs, val);
     autoReleaseLock();
 }
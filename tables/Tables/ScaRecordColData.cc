@@ -168,6 +168,7 @@ void ScalarRecordColumnData::putScalarColumnCells (const RefRows& rownrs,
 
 void ScalarRecordColumnData::getRecord (rownr_t rownr, TableRecord& rec) const
 {
+    auto dmLock = lockDataManager();
     if (! dataColPtr_p->isShapeDefined (rownr)) {
 	rec = TableRecord();
     } else {
@@ -191,6 +192,7 @@ void ScalarRecordColumnData::putRecord (rownr_t rownr, const TableRecord& rec)
     rec.putRecord (aio, TableAttr(dataManager()->table().tableName()));
     IPosition shape (1, Int(memio.length()));
     Vector<uChar> data(shape, (uChar*)(memio.getBuffer()), SHARE);
+    auto dmLock = lockDataManager();
     dataColPtr_p->setShape (rownr, shape);
     dataColPtr_p->putArrayV (rownr, data);
 }
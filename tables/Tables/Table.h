@@ -166,6 +166,7 @@ friend class TableIterator;
 friend class RODataManAccessor;
 friend class TableExprNode;
 friend class TableExprNodeRep;
+friend class ColumnsIndexFile;
 
 public:
     // Define the possible options how a table can be opened.
@@ -411,6 +412,28 @@ public:
     Bool hasLock (Bool write) const;
     // </group>
 
+    // Allow or disallow the table to be read by multiple threads at the
+    // same time using the same Table and column objects.
+    // <br>If allowed, the get functions of the column objects (such as
+    // ScalarColumn and ArrayColumn) are thread-safe. The access to a data
+    // manager is serialized, so columns in different data managers can be
+    // read in parallel, while a multi-threaded pipeline does not need to
+    // open the table in each thread. Array views (see
+    // ArrayColumn::getColumnRangeView) are not given in this mode.
+    // <br>It can be used for plain and memory tables and for reference
+    // tables (for which it applies to the root table). AutoLocking cannot
+    // be used, because acquiring and releasing a lock is not thread-safe.
+    // When using UserLocking, the table has to be locked beforehand.
+    // Note that changing the table (e.g. adding rows or columns) is not
+    // thread-safe, even if allowed.
+    // <br>An exception is thrown if the table cannot be read concurrently.
+    void setConcurrentRead (Bool concurrent = True)
+        { baseTabPtr_p->setConcurrentRead (concurrent); }
+
+    // Can the table be read by multiple threads?
+    Bool isConcurrentRead() const
+        { return baseTabPtr_p->isConcurrentRead(); }
+
     // Try to lock the table for read or write access (default is write).
     // The number of attempts (default = forever) can be specified when
     // acquiring the lock does not succeed immediately. If nattempts>1,
@@ -781,7 +804,13 @@ public:
     // when <src>maxRow</src> rows are selected.
     // <br>The TableExprNode argument can be empty (null) meaning that only
     // the <src>maxRow/offset</src> arguments are taken into account.
-    Table operator() (const TableExprNode&, rownr_t maxRow=0, rownr_t offset=0) const;
+    // <br>If <src>nthreads</src> is not 1, the expression is evaluated by
+    // multiple threads if it is safe to do so (0 means all cores). Thereto
+    // the tables used are read concurrently during the selection, which
+    // is not possible if they use AutoLocking (see
+    // <src>setConcurrentRead</src>).
+    Table operator() (const TableExprNode&, rownr_t maxRow=0, rownr_t offset=0,
+                      uInt nthreads=1) const;
 
     // Select rows using a vector of row numbers.
     // This can, for instance, be used to select the same rows as
@@ -825,7 +854,9 @@ public:
     // Per column a compare function can be provided. By default
     // the standard compare function defined in Compare.h will be used.
     // Default sort order is ascending.
-    // Default sorting algorithm is the parallel sort.
+    // Default sorting algorithm is the parallel sort. For large tables
+    // Sort::RadixSort is faster if all columns are numeric and use the
+    // standard compare function, but it needs more memory.
     // <group>
     // Sort on one column.
     Table sort (const String& columnName,
@@ -0,0 +1,573 @@
+//# TableArrowExporter.cc: Export table columns in the Arrow columnar format
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableArrowExporter.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <errno.h>
+#include <string>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The private data of the exported Arrow structs.
+//# They own the strings and buffers referenced by the structs and the
+//# children, so a release callback can free everything.
+namespace {
+
+  struct SchemaData {
+    std::string format;
+    std::string name;
+    std::vector<std::unique_ptr<ArrowSchema>> children;
+    std::vector<ArrowSchema*> childPtrs;
+  };
+
+  struct ArrayData {
+    std::vector<const void*> buffers;
+    std::vector<std::unique_ptr<ArrowArray>> children;
+    std::vector<ArrowArray*> childPtrs;
+    std::vector<std::shared_ptr<void>> holders;
+  };
+
+  struct StreamData {
+    StreamData (const TableArrowExporter& exporter)
+      : exporter  (exporter),
+        nextChunk (0)
+    {}
+    TableArrowExporter exporter;
+    rownr_t            nextChunk;
+    std::string        lastError;
+  };
+
+  // A non-null pointer for empty buffers.
+  const int64_t emptyBuffer = 0;
+
+  void releaseSchema (ArrowSchema* schema)
+  {
+    SchemaData* data = static_cast<SchemaData*>(schema->private_data);
+    for (std::unique_ptr<ArrowSchema>& child : data->children) {
+      if (child->release) {
+        child->release (child.get());
+      }
+    }
+    delete data;
+    schema->release = 0;
+  }
+
+  void initSchema (ArrowSchema* schema, const std::string& format,
+                   const std::string& name)
+  {
+    SchemaData* data = new SchemaData;
+    data->format = format;
+    data->name   = name;
+    schema->format       = data->format.c_str();
+    schema->name         = data->name.c_str();
+    schema->metadata     = 0;
+    schema->flags        = 0;
+    schema->n_children   = 0;
+    schema->children     = 0;
+    schema->dictionary   = 0;
+    schema->release      = &releaseSchema;
+    schema->private_data = data;
+  }
+
+  ArrowSchema* addChild (ArrowSchema* schema)
+  {
+    SchemaData* data = static_cast<SchemaData*>(schema->private_data);
+    data->children.push_back (std::unique_ptr<ArrowSchema>(new ArrowSchema));
+    data->children.back()->release = 0;
+    data->childPtrs.push_back (data->children.back().get());
+    schema->n_children = data->childPtrs.size();
+    schema->children   = data->childPtrs.data();
+    return data->childPtrs.back();
+  }
+
+  void releaseArray (ArrowArray* array)
+  {
+    ArrayData* data = static_cast<ArrayData*>(array->private_data);
+    for (std::unique_ptr<ArrowArray>& child : data->children) {
+      if (child->release) {
+        child->release (child.get());
+      }
+    }
+    delete data;
+    array->release = 0;
+  }
+
+  ArrayData* initArray (ArrowArray* array, int64_t length, uInt nbuffers)
+  {
+    ArrayData* data = new ArrayData;
+    // The first buffer is always the validity bitmap, which is not
+    // needed because all values are valid.
+    data->buffers.resize (nbuffers, 0);
+    array->length       = length;
+    array->null_count   = 0;
+    array->offset       = 0;
+    array->n_buffers    = nbuffers;
+    array->n_children   = 0;
+    array->buffers      = data->buffers.data();
+    array->children     = 0;
+    array->dictionary   = 0;
+    array->release      = &releaseArray;
+    array->private_data = data;
+    return data;
+  }
+
+  ArrowArray* addChild (ArrowArray* array)
+  {
+    ArrayData* data = static_cast<ArrayData*>(array->private_data);
+    data->children.push_back (std::unique_ptr<ArrowArray>(new ArrowArray));
+    data->children.back()->release = 0;
+    data->childPtrs.push_back (data->children.back().get());
+    array->n_children = data->childPtrs.size();
+    array->children   = data->childPtrs.data();
+    return data->childPtrs.back();
+  }
+
+  // Get the Arrow format of the (element) data type.
+  std::string arrowFormat (DataType dtype)
+  {
+    switch (dtype) {
+    case TpBool:
+      return "b";
+    case TpUChar:
+      return "C";
+    case TpShort:
+      return "s";
+    case TpUShort:
+      return "S";
+    case TpInt:
+      return "i";
+    case TpUInt:
+      return "I";
+    case TpInt64:
+      return "l";
+    case TpFloat:
+    case TpComplex:
+      return "f";
+    case TpDouble:
+    case TpDComplex:
+      return "g";
+    case TpString:
+      return "u";
+    default:
+      break;
+    }
+    return std::string();
+  }
+
+  // Get the values in the given rows of a column.
+  // For an array column it tries to get them without a copy.
+  template<typename T>
+  std::shared_ptr<Array<T>> getValues (const Table& table,
+                                       const String& name, Bool isArray,
+                                       const IPosition& shape,
+                                       rownr_t startRow, rownr_t nrow)
+  {
+    std::shared_ptr<Array<T>> arr = std::make_shared<Array<T>>();
+    Slicer rows (IPosition(1, startRow), IPosition(1, nrow));
+    if (isArray) {
+      ArrayColumn<T> col(table, name);
+      if (! col.getColumnRangeView (rows, *arr)) {
+        // Check the shapes, because getColumnRange only uses the first one.
+        for (rownr_t i=0; i<nrow; ++i) {
+          if (! col.shape(startRow+i).isEqual (shape)) {
+            throw TableError ("TableArrowExporter: array in row " +
+                              String::toString(startRow+i) + " of column " +
+                              name + " has a shape differing from " +
+                              shape.toString());
+          }
+        }
+        col.getColumnRange (rows, *arr, True);
+      }
+      IPosition expShape (shape);
+      expShape.append (IPosition(1, nrow));
+      AlwaysAssert (arr->shape().isEqual (expShape), AipsError);
+    } else {
+      Vector<T> vec;
+      ScalarColumn<T>(table, name).getColumnRange (rows, vec, True);
+      arr->reference (vec);
+    }
+    return arr;
+  }
+
+  // Fill a leaf array with the values of a numeric type.
+  template<typename T>
+  void fillNumeric (ArrowArray* leaf, const Table& table, const String& name,
+                    Bool isArray, const IPosition& shape,
+                    rownr_t startRow, rownr_t nrow, int64_t nvalues)
+  {
+    ArrayData* data = initArray (leaf, nvalues, 2);
+    if (nrow == 0) {
+      data->buffers[1] = &emptyBuffer;
+      return;
+    }
+    std::shared_ptr<Array<T>> arr = getValues<T> (table, name, isArray,
+                                                  shape, startRow, nrow);
+    AlwaysAssert (arr->contiguousStorage(), AipsError);
+    data->buffers[1] = arr->data();
+    data->holders.push_back (arr);
+  }
+
+  // Fill a leaf array with Bools as a bitmap.
+  void fillBool (ArrowArray* leaf, const Table& table, const String& name,
+                 Bool isArray, const IPosition& shape,
+                 rownr_t startRow, rownr_t nrow, int64_t nvalues)
+  {
+    ArrayData* data = initArray (leaf, nvalues, 2);
+    std::shared_ptr<std::vector<uChar>> bits =
+      std::make_shared<std::vector<uChar>> ((nvalues+7) / 8 + 1, 0);
+    if (nrow > 0) {
+      std::shared_ptr<Array<Bool>> arr = getValues<Bool> (table, name, isArray,
+                                                          shape, startRow,
+                                                          nrow);
+      // Arrow uses least-significant bit numbering.
+      int64_t i = 0;
+      for (Array<Bool>::const_iterator iter=arr->begin();
+           iter!=arr->end(); ++iter, ++i) {
+        if (*iter) {
+          (*bits)[i/8] |= uChar(1 << (i%8));
+        }
+      }
+    }
+    data->buffers[1] = bits->data();
+    data->holders.push_back (bits);
+  }
+
+  // Fill a leaf array with utf8 strings (using 32-bit offsets).
+  void fillString (ArrowArray* leaf, const Table& table, const String& name,
+                   Bool isArray, const IPosition& shape,
+                   rownr_t startRow, rownr_t nrow, int64_t nvalues)
+  {
+    ArrayData* data = initArray (leaf, nvalues, 3);
+    std::shared_ptr<std::vector<int32_t>> offsets =
+      std::make_shared<std::vector<int32_t>> (nvalues+1, 0);
+    std::shared_ptr<std::vector<char>> chars =
+      std::make_shared<std::vector<char>>();
+    if (nrow > 0) {
+      std::shared_ptr<Array<String>> arr = getValues<String>
+        (table, name, isArray, shape, startRow, nrow);
+      size_t nchar = 0;
+      for (Array<String>::const_iterator iter=arr->begin();
+           iter!=arr->end(); ++iter) {
+        nchar += iter->size();
+      }
+      if (nchar > 0x7fffffff) {
+        throw TableError ("TableArrowExporter: strings in column " + name +
+                          " exceed 2 GB; use a smaller chunk size");
+      }
+      chars->reserve (nchar + 1);
+      int64_t i = 0;
+      for (Array<String>::const_iterator iter=arr->begin();
+           iter!=arr->end(); ++iter) {
+        chars->insert (chars->end(), iter->begin(), iter->end());
+        (*offsets)[++i] = chars->size();
+      }
+    }
+    // Make sure the data pointer is not null.
+    chars->push_back (0);
+    data->buffers[1] = offsets->data();
+    data->buffers[2] = chars->data();
+    data->holders.push_back (offsets);
+    data->holders.push_back (chars);
+  }
+
+  // The Arrow stream callbacks.
+  int streamGetSchema (ArrowArrayStream* stream, ArrowSchema* out)
+  {
+    StreamData* data = static_cast<StreamData*>(stream->private_data);
+    try {
+      data->exporter.exportSchema (out);
+    } catch (const std::exception& x) {
+      data->lastError = x.what();
+      return EIO;
+    }
+    return 0;
+  }
+
+  int streamGetNext (ArrowArrayStream* stream, ArrowArray* out)
+  {
+    StreamData* data = static_cast<StreamData*>(stream->private_data);
+    try {
+      if (data->nextChunk >= data->exporter.nchunk()) {
+        // End of stream.
+        out->release = 0;
+      } else {
+        data->exporter.exportChunk (data->nextChunk, out);
+        data->nextChunk++;
+      }
+    } catch (const std::exception& x) {
+      data->lastError = x.what();
+      return EIO;
+    }
+    return 0;
+  }
+
+  const char* streamGetLastError (ArrowArrayStream* stream)
+  {
+    StreamData* data = static_cast<StreamData*>(stream->private_data);
+    return data->lastError.empty()  ?  0 : data->lastError.c_str();
+  }
+
+  void streamRelease (ArrowArrayStream* stream)
+  {
+    delete static_cast<StreamData*>(stream->private_data);
+    stream->release = 0;
+  }
+
+} //# end anonymous namespace
+
+
+TableArrowExporter::TableArrowExporter (const Table& table,
+                                        const Vector<String>& columnNames,
+                                        rownr_t chunkSize)
+: itsTable     (table),
+  itsChunkSize (chunkSize)
+{
+  if (itsChunkSize == 0) {
+    throw TableError ("TableArrowExporter: chunk size cannot be 0");
+  }
+  ColumnInfo info;
+  if (columnNames.empty()) {
+    Vector<String> names = itsTable.tableDesc().columnNames();
+    for (const String& name : names) {
+      if (getColumnInfo (itsTable, name, info)) {
+        itsColumns.push_back (info);
+      }
+    }
+  } else {
+    for (const String& name : columnNames) {
+      if (! getColumnInfo (itsTable, name, info)) {
+        throw TableError ("TableArrowExporter: column " + name +
+                          " cannot be exported");
+      }
+      itsColumns.push_back (info);
+    }
+  }
+}
+
+Vector<String> TableArrowExporter::columnNames() const
+{
+  Vector<String> names(itsColumns.size());
+  for (uInt i=0; i<itsColumns.size(); ++i) {
+    names[i] = itsColumns[i].name;
+  }
+  return names;
+}
+
+rownr_t TableArrowExporter::nchunk() const
+{
+  return (itsTable.nrow() + itsChunkSize - 1) / itsChunkSize;
+}
+
+Bool TableArrowExporter::canExport (const Table& table,
+                                    const String& columnName)
+{
+  ColumnInfo info;
+  return getColumnInfo (table, columnName, info);
+}
+
+Bool TableArrowExporter::getColumnInfo (const Table& table,
+                                        const String& columnName,
+                                        ColumnInfo& info)
+{
+  if (! table.tableDesc().isColumn (columnName)) {
+    return False;
+  }
+  const ColumnDesc& cd = table.tableDesc().columnDesc (columnName);
+  info.name    = columnName;
+  info.dtype   = cd.dataType();
+  info.isArray = cd.isArray();
+  info.shape.resize (0);
+  if (info.dtype != TpComplex  &&  info.dtype != TpDComplex
+  &&  arrowFormat(info.dtype).empty()) {
+    return False;
+  }
+  if (info.isArray) {
+    // The cells must have the same shape; use the shape in the first row
+    // if not defined in the column description.
+    if (cd.isFixedShape()  &&  cd.shape().size() > 0) {
+      info.shape = cd.shape();
+    } else {
+      TableColumn col(table, columnName);
+      if (table.nrow() == 0  ||  !col.isDefined(0)) {
+        return False;
+      }
+      info.shape = col.shape(0);
+    }
+  } else if (! cd.isScalar()) {
+    return False;
+  }
+  return True;
+}
+
+void TableArrowExporter::exportSchema (ArrowSchema* out) const
+{
+  initSchema (out, "+s", "");
+  try {
+    for (const ColumnInfo& info : itsColumns) {
+      ArrowSchema* cur = addChild (out);
+      std::string name = info.name;
+      // A nested fixed-size list per axis; the outer one is the last axis.
+      for (Int i=Int(info.shape.size())-1; i>=0; --i) {
+        initSchema (cur, "+w:" + std::to_string(info.shape[i]), name);
+        cur = addChild (cur);
+        name = "item";
+      }
+      if (info.dtype == TpComplex  ||  info.dtype == TpDComplex) {
+        initSchema (cur, "+w:2", name);
+        cur = addChild (cur);
+        name = "item";
+      }
+      initSchema (cur, arrowFormat(info.dtype), name);
+    }
+  } catch (...) {
+    out->release (out);
+    throw;
+  }
+}
+
+void TableArrowExporter::exportColumn (const ColumnInfo& info,
+                                       rownr_t startRow, rownr_t nrow,
+                                       ArrowArray* out) const
+{
+  ArrowArray* cur = out;
+  int64_t length = nrow;
+  for (Int i=Int(info.shape.size())-1; i>=0; --i) {
+    initArray (cur, length, 1);
+    length *= info.shape[i];
+    cur = addChild (cur);
+  }
+  if (info.dtype == TpComplex  ||  info.dtype == TpDComplex) {
+    initArray (cur, length, 1);
+    length *= 2;
+    cur = addChild (cur);
+  }
+  switch (info.dtype) {
+  case TpBool:
+    fillBool (cur, itsTable, info.name, info.isArray, info.shape,
+              startRow, nrow, length);
+    break;
+  case TpUChar:
+    fillNumeric<uChar> (cur, itsTable, info.name, info.isArray, info.shape,
+                        startRow, nrow, length);
+    break;
+  case TpShort:
+    fillNumeric<Short> (cur, itsTable, info.name, info.isArray, info.shape,
+                        startRow, nrow, length);
+    break;
+  case TpUShort:
+    fillNumeric<uShort> (cur, itsTable, info.name, info.isArray, info.shape,
+                         startRow, nrow, length);
+    break;
+  case TpInt:
+    fillNumeric<Int> (cur, itsTable, info.name, info.isArray, info.shape,
+                      startRow, nrow, length);
+    break;
+  case TpUInt:
+    fillNumeric<uInt> (cur, itsTable, info.name, info.isArray, info.shape,
+                       startRow, nrow, length);
+    break;
+  case TpInt64:
+    fillNumeric<Int64> (cur, itsTable, info.name, info.isArray, info.shape,
+                        startRow, nrow, length);
+    break;
+  case TpFloat:
+    fillNumeric<Float> (cur, itsTable, info.name, info.isArray, info.shape,
+                        startRow, nrow, length);
+    break;
+  case TpDouble:
+    fillNumeric<Double> (cur, itsTable, info.name, info.isArray, info.shape,
+                         startRow, nrow, length);
+    break;
+  case TpComplex:
+    fillNumeric<Complex> (cur, itsTable, info.name, info.isArray, info.shape,
+                          startRow, nrow, length);
+    break;
+  case TpDComplex:
+    fillNumeric<DComplex> (cur, itsTable, info.name, info.isArray, info.shape,
+                           startRow, nrow, length);
+    break;
+  case TpString:
+    fillString (cur, itsTable, info.name, info.isArray, info.shape,
+                startRow, nrow, length);
+    break;
+  default:
+    throw TableError ("TableArrowExporter: unsupported data type");
+  }
+}
+
+void TableArrowExporter::exportRows (rownr_t startRow, rownr_t nrow,
+                                     ArrowArray* out) const
+{
+  if (startRow + nrow > itsTable.nrow()) {
+    throw TableError ("TableArrowExporter: rows " +
+                      String::toString(startRow) + "+" +
+                      String::toString(nrow) + " exceed table size");
+  }
+  initArray (out, nrow, 1);
+  try {
+    for (const ColumnInfo& info : itsColumns) {
+      exportColumn (info, startRow, nrow, addChild(out));
+    }
+  } catch (...) {
+    out->release (out);
+    throw;
+  }
+}
+
+void TableArrowExporter::exportChunk (rownr_t chunkNr, ArrowArray* out) const
+{
+  if (chunkNr >= nchunk()) {
+    throw TableError ("TableArrowExporter: chunk " +
+                      String::toString(chunkNr) + " does not exist");
+  }
+  rownr_t startRow = chunkNr * itsChunkSize;
+  rownr_t nrow = std::min (itsChunkSize, itsTable.nrow() - startRow);
+  exportRows (startRow, nrow, out);
+}
+
+void TableArrowExporter::exportStream (ArrowArrayStream* out) const
+{
+  out->get_schema     = &streamGetSchema;
+  out->get_next       = &streamGetNext;
+  out->get_last_error = &streamGetLastError;
+  out->release        = &streamRelease;
+  out->private_data   = new StreamData (*this);
+}
+
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,243 @@
+//# TableArrowExporter.h: Export table columns in the Arrow columnar format
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_TABLEARROWEXPORTER_H
+#define TABLES_TABLEARROWEXPORTER_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+//# The structs of the Arrow C data and stream interface.
+//# They are defined by the Arrow specification as a stable ABI and are
+//# meant to be copied verbatim, so no Arrow library is needed.
+//# The guards make it possible to combine this header with Arrow's.
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+  int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+  const char* (*get_last_error)(struct ArrowArrayStream*);
+  void (*release)(struct ArrowArrayStream*);
+  void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+}  // extern "C"
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Export table columns in the Apache Arrow columnar memory layout.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tTableArrowExporter">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> Table
+//   <li> ArrayColumn
+// </prerequisite>
+
+// <synopsis>
+// TableArrowExporter exports the columns of a table (a PlainTable or a
+// selection like a RefTable) using the
+// <a href="https://arrow.apache.org/docs/format/CDataInterface.html">
+// Arrow C data interface</a>. It makes it possible to hand the data to
+// analysis tools (e.g., pyarrow, pandas, polars, DuckDB) in a columnar way
+// without converting row by row or column by column to Python objects.
+// No Arrow library is needed, because the C interface consists of a few
+// plain structs.
+// <p>
+// The table is exported as a series of record batches (Arrow struct
+// arrays), each containing a chunk of rows. In this way a table larger
+// than memory can be processed. The chunks can be obtained one by one
+// using <src>exportChunk</src> or as an Arrow stream using
+// <src>exportStream</src>. The schema is the same for all chunks.
+// <br>The column data types are mapped as follows:
+// <ul>
+//  <li> Bool, uChar, Short, uShort, Int, uInt, Int64, Float, Double and
+//       String map to the corresponding Arrow types (String to utf8).
+//  <li> Complex and DComplex map to a fixed-size list of 2 floats or
+//       doubles (real and imaginary part).
+//  <li> An array column whose cells have the same shape (i.e., a FixedShape
+//       column or a column where all cells have the shape of the first
+//       row) maps to nested fixed-size lists, one per axis. The outer list
+//       represents the last axis, the innermost list the first axis, so
+//       the values are in the same order as in a casacore Array.
+//       An exception is thrown when exporting a row with another shape.
+// </ul>
+// Other columns (e.g., records or array columns with an undefined first
+// row) cannot be exported. By default they are skipped, but an exception
+// is thrown if such a column is given explicitly.
+// <p>
+// The data of a chunk is obtained using <src>getColumnRange</src>.
+// For an array column it first tries to use
+// <src>ArrayColumn::getColumnRangeView</src>, so no copy is made if the
+// storage manager has the data available in memory (e.g., tiles mapped by
+// the TiledStMan and the chunk does not cross a tile boundary). A
+// chunk keeps its data alive until the consumer releases it.
+// <br>No null values are exported; all values are valid.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms");
+//   TableArrowExporter exporter (tab(tab.col("ANTENNA1") == 0),
+//                                stringToVector("TIME,DATA"), 100000);
+//   ArrowArrayStream stream;
+//   exporter.exportStream (&stream);
+//   // Pass &stream to, e.g., pyarrow.RecordBatchReader._import_from_c.
+// </srcblock>
+// </example>
+
+// <motivation>
+// Getting large tables into data analysis tools should be fast and not
+// require much memory.
+// </motivation>
+
+class TableArrowExporter
+{
+public:
+  // Set up the export of the given columns of the table in chunks
+  // of <src>chunkSize</src> rows.
+  // If no columns are given, all columns that can be exported are used.
+  // An exception is thrown if a given column cannot be exported.
+  explicit TableArrowExporter (const Table& table,
+                               const Vector<String>& columnNames =
+                                 Vector<String>(),
+                               rownr_t chunkSize = 65536);
+
+  // Get the table being exported.
+  const Table& table() const
+    { return itsTable; }
+
+  // Get the names of the exported columns.
+  Vector<String> columnNames() const;
+
+  // Get the number of rows per chunk.
+  rownr_t chunkSize() const
+    { return itsChunkSize; }
+
+  // Get the number of chunks.
+  rownr_t nchunk() const;
+
+  // Export the schema (an Arrow struct with a field per column).
+  // The caller has to release it using its release callback.
+  void exportSchema (ArrowSchema* out) const;
+
+  // Export the given rows as an Arrow struct array matching the schema.
+  // The caller has to release it using its release callback.
+  void exportRows (rownr_t startRow, rownr_t nrow, ArrowArray* out) const;
+
+  // Export the given chunk (thus rows starting at chunkNr*chunkSize).
+  void exportChunk (rownr_t chunkNr, ArrowArray* out) const;
+
+  // Export the chunks as an Arrow stream of record batches.
+  // The stream holds a copy of this exporter, so it can outlive it.
+  // The caller has to release it using its release callback.
+  void exportStream (ArrowArrayStream* out) const;
+
+  // Can the given column be exported?
+  static Bool canExport (const Table& table, const String& columnName);
+
+private:
+  // Description of an exported column.
+  struct ColumnInfo {
+    String    name;
+    DataType  dtype;
+    Bool      isArray;
+    IPosition shape;
+  };
+
+  // Get the info of a column. It returns False if it cannot be exported.
+  static Bool getColumnInfo (const Table& table, const String& columnName,
+                             ColumnInfo& info);
+
+  // Export the data of a column as an Arrow array.
+  void exportColumn (const ColumnInfo& info, rownr_t startRow, rownr_t nrow,
+                     ArrowArray* out) const;
+
+  //# Data members.
+  Table                   itsTable;
+  std::vector<ColumnInfo> itsColumns;
+  rownr_t                 itsChunkSize;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
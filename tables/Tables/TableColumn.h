@@ -383,6 +383,13 @@ public:
     void setMaximumCacheSize (uInt nbytes) const
         { baseColPtr_p->setMaximumCacheSize (nbytes); }
 
+    // Get the zone map of a scalar numeric column if its storage manager
+    // maintains one (see DataManagerColumn::getZoneMap).
+    // It returns False if not available.
+    Bool getZoneMap (Vector<rownr_t>& endRows, Vector<Double>& minValues,
+                     Vector<Double>& maxValues) const
+        { return baseColPtr_p->getZoneMap (endRows, minValues, maxValues); }
+
 protected:
     BaseTable*  baseTabPtr_p;
     BaseColumn* baseColPtr_p;                //# pointer to real column object
@@ -32,6 +32,8 @@
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/tables/DataMan/DataManager.h>
@@ -41,6 +43,12 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/OS/OMP.h>
+#include <algorithm>
+#include <exception>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -88,7 +96,8 @@ Table TableCopy::makeEmptyMemoryTable (const String& newName,
 }
 
 void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
-			  rownr_t startin, rownr_t nrrow, Bool flush)
+			  rownr_t startin, rownr_t nrrow, Bool flush,
+                          uInt nthreads)
 {
   // Check if startin and nrrow are correct for input.
   if (startin + nrrow > in.nrow()) {
@@ -99,25 +108,46 @@ void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
   TableRow outrow(out, out.tableDesc().ncolumn() > 1);
   Vector<String> columns = outrow.columnNames();
   const TableDesc& tdesc = in.tableDesc();
+  const TableDesc& outdesc = out.tableDesc();
   // Only copy the columns that exist in the input table.
+  // Columns with equal types are copied in chunks, others row by row.
   Vector<String> cols(columns.nelements());
+  Vector<String> chunkCols(columns.nelements());
   uInt nrcol = 0;
+  uInt nrchunk = 0;
   for (uInt i=0; i<columns.nelements(); i++) {
     if (tdesc.isColumn (columns(i))) {
-      cols(nrcol++) = columns(i);
+      const ColumnDesc& incd  = tdesc.columnDesc (columns(i));
+      const ColumnDesc& outcd = outdesc.columnDesc (columns(i));
+      if (incd.dataType() == outcd.dataType()  &&
+          incd.isScalar() == outcd.isScalar()  &&
+          incd.isArray()  == outcd.isArray()   &&
+          ((incd.dataType() != TpChar  &&  incd.dataType() <= TpString)  ||
+           incd.dataType() == TpInt64)) {
+        chunkCols(nrchunk++) = columns(i);
+      } else {
+        cols(nrcol++) = columns(i);
+      }
     }
   }
-  if (nrcol > 0) {
-    cols.resize (nrcol, True);
+  if (nrcol + nrchunk > 0) {
     // Add rows as needed.
     if (startout + nrrow > out.nrow()) {
       out.addRow (startout + nrrow - out.nrow());
     }
-    ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
-    for (rownr_t i=0; i<nrrow; i++) {
-      inrow.get (startin + i);
-      outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+    if (nrcol > 0) {
+      cols.resize (nrcol, True);
+      ROTableRow inrow(in, cols);
+      outrow = TableRow(out, cols);
+      for (rownr_t i=0; i<nrrow; i++) {
+        inrow.get (startin + i);
+        outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+      }
+    }
+    if (nrchunk > 0) {
+      chunkCols.resize (nrchunk, True);
+      copyColumnsChunked (out, in, chunkCols, startout, startin, nrrow,
+                          nthreads);
     }
     if (flush) {
       out.flush();
@@ -125,6 +155,212 @@ void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
   }
 }
 
+Bool TableCopy::canCopyParallel (const Table& tab)
+{
+  if (tab.tableType() == Table::Memory) {
+    return True;
+  }
+  TableLock::LockOption opt = tab.lockOptions().option();
+  return (tab.getPartNames(True).size() == 1  &&
+          opt != TableLock::AutoLocking  &&
+          opt != TableLock::AutoNoReadLocking);
+}
+
+void TableCopy::copyColumnsChunked (Table& out, const Table& in,
+                                    const Vector<String>& columns,
+                                    rownr_t startout, rownr_t startin,
+                                    rownr_t nrrow, uInt nthreads)
+{
+  // Create the column objects beforehand, because that is not thread-safe.
+  uInt nrcol = columns.size();
+  std::vector<TableColumn> incols;
+  std::vector<TableColumn> outcols;
+  incols.reserve (nrcol);
+  outcols.reserve (nrcol);
+  for (uInt i=0; i<nrcol; ++i) {
+    incols.push_back (TableColumn(in, columns[i]));
+    outcols.push_back (TableColumn(out, columns[i]));
+  }
+  // A data manager is not thread-safe, so columns sharing an input or
+  // output data manager are put in the same group. Groups can be copied
+  // in parallel. It is not done if a virtual column engine is used,
+  // because it can access the columns in other data managers.
+  uInt nthr = (nthreads == 0  ?  OMP::maxThreads() : nthreads);
+  std::vector<uInt> groupOf(nrcol);
+  for (uInt i=0; i<nrcol; ++i) {
+    groupOf[i] = i;
+  }
+  if (nthr > 1  &&  nrcol > 1  &&
+      canCopyParallel(in)  &&  canCopyParallel(out)) {
+    std::vector<const DataManager*> indm(nrcol);
+    std::vector<const DataManager*> outdm(nrcol);
+    for (uInt i=0; i<nrcol  &&  nthr > 1; ++i) {
+      indm[i]  = in.findDataManager (columns[i], True);
+      outdm[i] = out.findDataManager (columns[i], True);
+      if (!indm[i]->isStorageManager()  ||  !outdm[i]->isStorageManager()) {
+        nthr = 1;
+      }
+      for (uInt j=0; j<i; ++j) {
+        if (groupOf[j] != groupOf[i]  &&
+            (indm[j] == indm[i]  ||  outdm[j] == outdm[i])) {
+          // Merge the group of column i into the group of column j.
+          uInt oldGroup = groupOf[i];
+          for (uInt k=0; k<=i; ++k) {
+            if (groupOf[k] == oldGroup) {
+              groupOf[k] = groupOf[j];
+            }
+          }
+        }
+      }
+    }
+  } else {
+    nthr = 1;
+  }
+  std::vector<std::vector<uInt>> groups;
+  if (nthr == 1) {
+    groups.resize (1);
+    for (uInt i=0; i<nrcol; ++i) {
+      groups[0].push_back (i);
+    }
+  } else {
+    std::vector<Int> groupInx(nrcol, -1);
+    for (uInt i=0; i<nrcol; ++i) {
+      if (groupInx[groupOf[i]] < 0) {
+        groupInx[groupOf[i]] = groups.size();
+        groups.resize (groups.size() + 1);
+      }
+      groups[groupInx[groupOf[i]]].push_back (i);
+    }
+    nthr = std::min (nthr, uInt(groups.size()));
+  }
+  // Acquire the locks beforehand, because locking is not thread-safe.
+  Table inTab(in);
+  TableLocker outLocker(out, FileLocker::Write);
+  TableLocker inLocker(inTab, FileLocker::Read);
+  std::exception_ptr excp;
+#pragma omp parallel for num_threads(nthr) schedule(dynamic) if (nthr > 1)
+  for (Int g=0; g<Int(groups.size()); ++g) {
+    try {
+      for (uInt col : groups[g]) {
+        copyColumnChunked (outcols[col], incols[col],
+                           startout, startin, nrrow);
+      }
+    } catch (...) {
+#pragma omp critical(TableCopy_copyRows)
+      excp = std::current_exception();
+    }
+  }
+  if (excp) {
+    std::rethrow_exception (excp);
+  }
+}
+
+// Copy a chunk of rows of a column with data type T.
+// A range of array cells can only be copied at once if all cells are
+// defined and have the same shape; otherwise they are copied one by one.
+template<typename T>
+void TableCopyChunk (TableColumn& outcol, const TableColumn& incol,
+                     rownr_t startout, rownr_t startin, rownr_t nrrow)
+{
+  Slicer inRows  (IPosition(1,startin),  IPosition(1,nrrow));
+  Slicer outRows (IPosition(1,startout), IPosition(1,nrrow));
+  if (incol.columnDesc().isScalar()) {
+    ScalarColumn<T>(outcol).putColumnRange
+      (outRows, ScalarColumn<T>(incol).getColumnRange (inRows));
+    return;
+  }
+  Bool sameShape = incol.columnDesc().isFixedShape();
+  if (!sameShape  &&  incol.isDefined (startin)) {
+    sameShape = True;
+    IPosition shape = incol.shape (startin);
+    for (rownr_t i=1; i<nrrow  &&  sameShape; ++i) {
+      sameShape = (incol.isDefined (startin+i)  &&
+                   incol.shape(startin+i).isEqual (shape));
+    }
+  }
+  if (sameShape) {
+    ArrayColumn<T>(outcol).putColumnRange
+      (outRows, ArrayColumn<T>(incol).getColumnRange (inRows));
+  } else {
+    for (rownr_t i=0; i<nrrow; ++i) {
+      outcol.put (startout+i, incol, startin+i, False);
+    }
+  }
+}
+
+void TableCopy::copyColumnChunked (TableColumn& outcol,
+                                   const TableColumn& incol,
+                                   rownr_t startout, rownr_t startin,
+                                   rownr_t nrrow)
+{
+  if (nrrow == 0) {
+    return;
+  }
+  // Copy in chunks of about 32 MB.
+  // A tiled column is copied in chunks of entire tiles, so the data of
+  // a tile are read and written only once.
+  const ColumnDesc& cdesc = incol.columnDesc();
+  size_t rowSize = ValType::getTypeSize (cdesc.dataType());
+  rownr_t tileRows = 1;
+  if (cdesc.isArray()  &&  incol.isDefined (startin)) {
+    rowSize *= std::max (incol.shape(startin).product(), Int64(1));
+    IPosition tileShape = incol.tileShape (startin);
+    if (! tileShape.empty()) {
+      tileRows = tileShape[tileShape.size() - 1];
+    }
+  }
+  rownr_t chunkRows = std::max (rownr_t(32*1024*1024 / rowSize), rownr_t(1));
+  chunkRows = std::max (chunkRows / tileRows, rownr_t(1)) * tileRows;
+  rownr_t done = 0;
+  while (done < nrrow) {
+    // End a chunk at a multiple of the chunk size in the input.
+    rownr_t inrow = startin + done;
+    rownr_t nr = std::min (nrrow - done, chunkRows - inrow % chunkRows);
+    switch (cdesc.dataType()) {
+    case TpBool:
+      TableCopyChunk<Bool> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpUChar:
+      TableCopyChunk<uChar> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpShort:
+      TableCopyChunk<Short> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpUShort:
+      TableCopyChunk<uShort> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpInt:
+      TableCopyChunk<Int> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpUInt:
+      TableCopyChunk<uInt> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpInt64:
+      TableCopyChunk<Int64> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpFloat:
+      TableCopyChunk<Float> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpDouble:
+      TableCopyChunk<Double> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpComplex:
+      TableCopyChunk<Complex> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpDComplex:
+      TableCopyChunk<DComplex> (outcol, incol, startout+done, inrow, nr);
+      break;
+    case TpString:
+      TableCopyChunk<String> (outcol, incol, startout+done, inrow, nr);
+      break;
+    default:
+      throw TableError ("TableCopy::copyRows: unsupported data type of column "
+                        + cdesc.name());
+    }
+    done += nr;
+  }
+}
+
 void TableCopy::copyInfo (Table& out, const Table& in)
 {
   out.tableInfo() = in.tableInfo();
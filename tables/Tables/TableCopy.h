@@ -38,6 +38,9 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class TableColumn;
+
 // <summary>
 // Class with static functions for copying a table.
 // </summary>
@@ -114,12 +117,22 @@ public:
   // column with the same name in table <src>in</src>. In principle only
   // stored columns will be filled; however if the output table has only
   // one column, it can also be a virtual one.
+  // <br>Columns with the same data type in input and output are copied
+  // in chunks of rows using <src>getColumnRange</src> and
+  // <src>putColumnRange</src>. For tiled input columns a chunk holds
+  // entire tiles. Other columns are copied row by row.
+  // <br>Columns not sharing a data manager with other columns can be
+  // copied in parallel by <src>nthreads</src> threads (0 means the
+  // maximum number of OpenMP threads). It is only done if both tables
+  // are plain tables or references to a single plain table and do not
+  // use AutoLocking, because auto-releasing a lock is not thread-safe.
   // <group>
-  static void copyRows (Table& out, const Table& in, Bool flush=True)
-    { copyRows (out, in, 0, 0, in.nrow(), flush); }
+  static void copyRows (Table& out, const Table& in, Bool flush=True,
+                        uInt nthreads=0)
+    { copyRows (out, in, 0, 0, in.nrow(), flush, nthreads); }
   static void copyRows (Table& out, const Table& in,
 			rownr_t startout, rownr_t startin, rownr_t nrrow,
-                        Bool flush=True);
+                        Bool flush=True, uInt nthreads=0);
   // </group>
 
   // Copy the table info block from input to output table.
@@ -226,6 +239,21 @@ public:
                       preserveTileShape); }
 
 private:
+  // Copy the given columns (having the same data type in input and output)
+  // in chunks of rows. Columns can be copied in parallel.
+  static void copyColumnsChunked (Table& out, const Table& in,
+                                  const Vector<String>& columns,
+                                  rownr_t startout, rownr_t startin,
+                                  rownr_t nrrow, uInt nthreads);
+
+  // Copy a range of rows of a column in chunks.
+  static void copyColumnChunked (TableColumn& outcol, const TableColumn& incol,
+                                 rownr_t startout, rownr_t startin,
+                                 rownr_t nrrow);
+
+  // Can the columns of the table be copied in parallel?
+  static Bool canCopyParallel (const Table& tab);
+
   static void doCloneColumn (const Table& fromTable, const String& fromColumn,
                              Table& toTable, const ColumnDesc& newColumn,
                              const String& dataManagerName,
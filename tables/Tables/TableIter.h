@@ -76,6 +76,14 @@ template<class T> class Block;
 //
 // The table is sorted before doing the iteration unless TableIterator::NoSort
 // is given.
+// <br>If the order of the groups does not matter (e.g., when iterating per
+// baseline or per DATA_DESC_ID), the option TableIterator::HashGroup can be
+// given. Instead of sorting the table, the rows are grouped in a single pass
+// by hashing the key values. The groups are returned in order of first
+// appearance in the table, while the rows in a group keep their original
+// order. This can only be done if the key columns are scalars of a standard
+// data type (not complex) compared with the default compare objects.
+// Otherwise the table is sorted as with ParSort.
 // </synopsis> 
 
 // <example>
@@ -125,7 +133,9 @@ public:
                  HeapSort = Sort::HeapSort,
                  InsSort  = Sort::InsSort,
                  ParSort  = Sort::ParSort,
-                 NoSort   = 64};
+                 RadixSort= Sort::RadixSort,
+                 NoSort   = 64,
+                 HashGroup= 128};
 
     // Create a null TableIterator object (i.e. no iterator is attached yet).
     // The sole purpose of this constructor is to allow construction
@@ -151,9 +161,13 @@ public:
     // sorting algorithms. Usually ParSort is the fastest, but for
     // a single core machine QuickSort usually performs better.
     // InsSort (insertion sort) should only be used if the input
-    // is almost in order.
+    // is almost in order. RadixSort is faster for large tables if all
+    // columns are numeric and use the standard compare objects, but needs
+    // more memory (see <linkto class=Sort>Sort</linkto>).
     // If it is known that the table is already in order, the sort step can be
     // bypassed by giving the option TableIterator::NoSort.
+    // If the order of the groups does not matter, the option
+    // TableIterator::HashGroup groups the rows by hashing (see the synopsis).
     // The default option is ParSort.
     // <group>
     TableIterator (const Table&, const String& columnName,
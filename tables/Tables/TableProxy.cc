@@ -37,6 +37,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableCache.h>
 #include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableArrowExporter.h>
 #include <casacore/tables/Tables/PlainTable.h>
 #include <casacore/tables/Tables/TableLock.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
@@ -1163,6 +1164,18 @@ void TableProxy::getColumnVH (const String& columnName,
   return getValueFromTable (columnName, row, nrows, incr, False, vh);
 }
 
+void TableProxy::toArrowStream (const Vector<String>& columnNames,
+                                Int64 chunkSize,
+                                Int64 streamAddress)
+{
+  if (chunkSize <= 0  ||  streamAddress == 0) {
+    throw TableError ("TableProxy::toArrowStream: invalid chunk size "
+                      "or stream address");
+  }
+  TableArrowExporter exporter (table_p, columnNames, chunkSize);
+  exporter.exportStream (reinterpret_cast<ArrowArrayStream*>(streamAddress));
+}
+
 Record TableProxy::getVarColumn (const String& columnName,
 				 Int64 row,
 				 Int64 nrow,
@@ -327,6 +327,16 @@ public:
 		       Int64 incr);
   // </group>
 
+  // Export the given columns (all columns if empty) as an Arrow stream
+  // of record batches of <src>chunkSize</src> rows using the Arrow C
+  // stream interface (see class TableArrowExporter).
+  // <src>streamAddress</src> is the address of the ArrowArrayStream
+  // struct to fill (e.g., allocated by pyarrow). The caller has to
+  // release it.
+  void toArrowStream (const Vector<String>& columnNames,
+                      Int64 chunkSize,
+                      Int64 streamAddress);
+
   // Get some or all value slices from a column in the table.
   // If the inc vector is empty, it defaults to all 1.
   // <group>
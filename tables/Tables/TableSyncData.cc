@@ -31,6 +31,7 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Containers/BlockIO.h>
+#include <cstring>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -97,6 +98,7 @@ void TableSyncData::write (rownr_t nrrow, uInt nrcolumn, Bool tableChanged,
 	itsAipsIO << itsDataManChangeCounter;
     }
     itsAipsIO.putend();
+    keepData();
 }
 
 void TableSyncData::write (rownr_t nrrow)
@@ -118,11 +120,23 @@ void TableSyncData::write (rownr_t nrrow)
     itsAipsIO << itsNrcolumn;
     itsAipsIO << itsModifyCounter;
     itsAipsIO.putend();
+    // Without columns, the data are always interpreted.
+    itsLastData.resize (0);
 }
 
 Bool TableSyncData::read (rownr_t& nrrow, uInt& nrcolumn, Bool& tableChanged,
 			  Block<Bool>& dataManChanged)
 {
+    // Nothing has changed if the data are the same as last time.
+    if (sameData()) {
+        nrrow        = itsNrrow;
+        nrcolumn     = itsNrcolumn;
+        tableChanged = False;
+        dataManChanged.resize (itsDataManChangeCounter.nelements(),
+                               True, False);
+        dataManChanged.set (False);
+        return True;
+    }
     // Read the data into the memoryIO object.
     // When no columns, don't read the remaining part (then it is used
     // by an external filler).
@@ -144,6 +158,7 @@ Bool TableSyncData::read (rownr_t& nrrow, uInt& nrcolumn, Bool& tableChanged,
 	itsAipsIO >> itsModifyCounter;
     }
     if (nrcol < 0) {
+	itsLastData.resize (0);
 	tableChanged = True;
 	dataManChanged.set (True);
 	if (itsMemIO.length() > 0) {
@@ -182,9 +197,28 @@ Bool TableSyncData::read (rownr_t& nrrow, uInt& nrcolumn, Bool& tableChanged,
 	    itsDataManChangeCounter[i] = dataManChangeCounter[i];
 	}
     }
+    itsNrrow    = nrrow;
+    itsNrcolumn = nrcol;
+    keepData();
     return True;
 }
 
+void TableSyncData::keepData()
+{
+    uInt64 leng = itsMemIO.length();
+    itsLastData.resize (leng, True, False);
+    if (leng > 0) {
+	memcpy (itsLastData.storage(), itsMemIO.getBuffer(), leng);
+    }
+}
+
+Bool TableSyncData::sameData()
+{
+    uInt64 leng = itsMemIO.length();
+    return (leng > 0  &&  leng == itsLastData.nelements()  &&
+	    memcmp (itsLastData.storage(), itsMemIO.getBuffer(), leng) == 0);
+}
+
 
 } //# NAMESPACE CASACORE - END
 
@@ -67,6 +67,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <br>
 // When a lock on the table is released, it updates and writes the sync data
 // which tells if table data have changed.
+// <br>
+// A copy of the sync data last written or read is kept. If the sync data
+// read are the same, nothing has changed, so they do not need to be
+// interpreted. Usually that is the case when a lock is reacquired.
 // <p>
 // This class can also be used for the synchronization of tables and
 // external fillers (see class
@@ -97,6 +101,8 @@ public:
     // This function is called when a lock is acquired to see if
     // table data has to be reread.
     // <br>It returns False when the MemoryIO object is empty.
+    // <br>If the data are the same as the data last written or read,
+    // nothing has changed and the data are not interpreted.
     Bool read (rownr_t& nrrow, uInt& nrcolumn, Bool& tableChanged,
 	       Block<Bool>& dataManChanged);
 
@@ -116,6 +122,12 @@ private:
     // Assignment is forbidden.
     TableSyncData& operator= (const TableSyncData& that);
 
+    // Keep a copy of the data in the MemoryIO object.
+    void keepData();
+
+    // Are the data in the MemoryIO object the same as the data kept?
+    Bool sameData();
+
 
     //# Member variables.
     rownr_t     itsNrrow;
@@ -125,6 +137,7 @@ private:
     Block<uInt> itsDataManChangeCounter;
     MemoryIO    itsMemIO;
     AipsIO      itsAipsIO;
+    Block<uChar> itsLastData;      //# data last written or read
 };
 
 
@@ -0,0 +1,265 @@
+//# tColumnsIndexFile.cc: Test program for persistent column indices
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/ColumnsIndex.h>
+#include <casacore/tables/Tables/ColumnsIndexArray.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Containers/RecordField.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for the persistent indices of ColumnsIndex and
+// ColumnsIndexArray.
+// It checks that the index files are written, used, and invalidated
+// after the table has changed.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ANTENNA1"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  td.addColumn (ArrayColumnDesc<Int>     ("ARR"));
+  SetupNewTable newtab("tColumnsIndexFile_tmp.tab", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<String> name(tab, "NAME");
+  ArrayColumn<Int> arr(tab, "ARR");
+  for (rownr_t i=0; i<nrow; ++i) {
+    ant.put (i, (i*7)%13);
+    time.put (i, 1000. - i/10);
+    name.put (i, String::toString(i%5));
+    Vector<Int> vec(i%3);
+    indgen (vec, Int(i%11));
+    arr.put (i, vec);
+  }
+}
+
+// A compare function giving the same order as the default one.
+Int myCompare (const Block<void*>& fieldPtrs,
+               const Block<void*>& dataPtrs,
+               const Block<Int>& dataTypes,
+               rownr_t index)
+{
+  AlwaysAssert (dataTypes.nelements() == 2, AipsError);
+  const Int keyAnt = *(*(const RecordFieldPtr<Int>*)(fieldPtrs[0]));
+  const Double keyTime = *(*(const RecordFieldPtr<Double>*)(fieldPtrs[1]));
+  const Int ant = ((const Int*)(dataPtrs[0]))[index];
+  const Double time = ((const Double*)(dataPtrs[1]))[index];
+  if (keyAnt != ant) {
+    return (keyAnt < ant  ?  -1 : 1);
+  }
+  if (keyTime != time) {
+    return (keyTime < time  ?  -1 : 1);
+  }
+  return 0;
+}
+
+// Check the index lookups against the column data.
+void checkIndex (const Table& tab, ColumnsIndex& inx)
+{
+  ScalarColumn<Int> ant(tab, "ANTENNA1");
+  ScalarColumn<Double> time(tab, "TIME");
+  RecordFieldPtr<Int> antFld (inx.accessKey(), "ANTENNA1");
+  RecordFieldPtr<Double> timeFld (inx.accessKey(), "TIME");
+  for (rownr_t row=0; row<tab.nrow(); row+=17) {
+    *antFld = ant(row);
+    *timeFld = time(row);
+    RowNumbers rows = inx.getRowNumbers();
+    AlwaysAssertExit (rows.size() > 0);
+    for (rownr_t r : rows) {
+      AlwaysAssertExit (ant(r) == ant(row)  &&  time(r) == time(row));
+    }
+  }
+  // Look up a key range and check that all matching rows are found.
+  RecordFieldPtr<Int> antUpp (inx.accessUpperKey(), "ANTENNA1");
+  RecordFieldPtr<Double> timeUpp (inx.accessUpperKey(), "TIME");
+  *antFld = 3;
+  *timeFld = 0.;
+  *antUpp = 5;
+  *timeUpp = 0.;
+  RowNumbers rows = inx.getRowNumbers (True, False);
+  rownr_t nr = 0;
+  for (rownr_t row=0; row<tab.nrow(); ++row) {
+    if (ant(row) >= 3  &&  ant(row) < 5) {
+      nr++;
+    }
+  }
+  AlwaysAssertExit (nr == rows.size());
+  for (rownr_t r : rows) {
+    AlwaysAssertExit (ant(r) >= 3  &&  ant(r) < 5);
+  }
+}
+
+// Check the array index lookups against the column data.
+void checkArrayIndex (const Table& tab, ColumnsIndexArray& inx)
+{
+  ArrayColumn<Int> arr(tab, "ARR");
+  RecordFieldPtr<Int> fld (inx.accessKey(), "ARR");
+  for (Int v=0; v<14; ++v) {
+    *fld = v;
+    RowNumbers rows = inx.getRowNumbers (True);
+    rownr_t nr = 0;
+    for (rownr_t row=0; row<tab.nrow(); ++row) {
+      if (arr.isDefined(row)  &&  anyEQ (arr(row), v)) {
+        AlwaysAssertExit (nr < rows.size()  &&  rows[nr] == row);
+        nr++;
+      }
+    }
+    AlwaysAssertExit (nr == rows.size());
+  }
+}
+
+int main()
+{
+  try {
+    const String fileName = "tColumnsIndexFile_tmp.tab/table.colindex_";
+    Vector<String> keys(2);
+    keys[0] = "ANTENNA1";
+    keys[1] = "TIME";
+    createTable (5000);
+    {
+      Table tab("tColumnsIndexFile_tmp.tab");
+      AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys));
+      // A non-persistent index does not write a file.
+      ColumnsIndex inx0(tab, keys);
+      AlwaysAssertExit (! inx0.isPersistent());
+      AlwaysAssertExit (! File(fileName + "ANTENNA1_TIME").exists());
+      // Write the persistent indices.
+      ColumnsIndex inx(tab, keys, 0, False, True);
+      AlwaysAssertExit (inx.isPersistent());
+      AlwaysAssertExit (File(fileName + "ANTENNA1_TIME").exists());
+      checkIndex (tab, inx);
+      ColumnsIndexArray inxa(tab, "ARR", True);
+      AlwaysAssertExit (inxa.isPersistent());
+      AlwaysAssertExit (File(fileName + "ARR").exists());
+      checkArrayIndex (tab, inxa);
+      // An index with a user compare function cannot be persistent.
+      ColumnsIndex inxc(tab, keys, myCompare, False, True);
+      AlwaysAssertExit (! inxc.isPersistent());
+      checkIndex (tab, inxc);
+      // A String index cannot be persistent.
+      ColumnsIndex inxs(tab, "NAME", 0, False, True);
+      AlwaysAssertExit (! inxs.isPersistent());
+    }
+    {
+      // Reopen the table; the persistent indices are used.
+      Table tab("tColumnsIndexFile_tmp.tab");
+      AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, keys));
+      AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys, True));
+      AlwaysAssertExit (ColumnsIndexArray::hasPersistentIndex (tab, "ARR"));
+      ColumnsIndex inx(tab, keys, 0, False, True);
+      checkIndex (tab, inx);
+      // A copy uses the index file as well.
+      ColumnsIndex inx2(inx);
+      checkIndex (tab, inx2);
+      ColumnsIndexArray inxa(tab, "ARR", True);
+      checkArrayIndex (tab, inxa);
+    }
+    {
+      // Change the table, which invalidates the index files.
+      Table tab("tColumnsIndexFile_tmp.tab", Table::Update);
+      ColumnsIndex inx(tab, keys, 0, False, True);
+      ColumnsIndexArray inxa(tab, "ARR", True);
+      ScalarColumn<Int> ant(tab, "ANTENNA1");
+      ant.put (10, 100);
+      ArrayColumn<Int> arr(tab, "ARR");
+      arr.put (11, Vector<Int>(3, 13));
+      tab.flush();
+      AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys));
+      AlwaysAssertExit (! ColumnsIndexArray::hasPersistentIndex (tab, "ARR"));
+      inx.setChanged ("ANTENNA1");
+      checkIndex (tab, inx);
+      inxa.setChanged();
+      checkArrayIndex (tab, inxa);
+      // The indices have been rewritten.
+      AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, keys));
+      AlwaysAssertExit (ColumnsIndexArray::hasPersistentIndex (tab, "ARR"));
+      // Changes not flushed yet are taken into account by a new index.
+      ant.put (20, 200);
+      arr.put (21, Vector<Int>(2, 12));
+      ColumnsIndex inx3(tab, keys, 0, False, True);
+      checkIndex (tab, inx3);
+      *RecordFieldPtr<Int>(inx3.accessKey(), "ANTENNA1") = 200;
+      *RecordFieldPtr<Double>(inx3.accessKey(), "TIME") = 1000. - 2;
+      AlwaysAssertExit (inx3.getRowNumbers().size() == 1);
+      ColumnsIndexArray inxa3(tab, "ARR", True);
+      checkArrayIndex (tab, inxa3);
+      // Adding rows invalidates the index as well.
+      tab.addRow (10);
+      AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys));
+      checkIndex (tab, inx);
+      checkArrayIndex (tab, inxa);
+    }
+    {
+      Table tab("tColumnsIndexFile_tmp.tab");
+      AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, keys));
+      ColumnsIndex inx(tab, keys, 0, False, True);
+      checkIndex (tab, inx);
+      ColumnsIndexArray inxa(tab, "ARR", True);
+      checkArrayIndex (tab, inxa);
+    }
+    {
+      // The modify counter restarts if the lock file is recreated, which
+      // should not make a stale index file valid again.
+      RegularFile("tColumnsIndexFile_tmp.tab/table.lock").remove();
+      Table tab("tColumnsIndexFile_tmp.tab", Table::Update);
+      ScalarColumn<Int> ant(tab, "ANTENNA1");
+      for (Int i=0; i<20; ++i) {
+        ant.put (30, 300+i);
+        // Changes not flushed yet make the index invalid (without flushing).
+        AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys));
+        tab.flush();
+        AlwaysAssertExit (! ColumnsIndex::hasPersistentIndex (tab, keys));
+      }
+      ColumnsIndex inx(tab, keys, 0, False, True);
+      checkIndex (tab, inx);
+      AlwaysAssertExit (ColumnsIndex::hasPersistentIndex (tab, keys));
+    }
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,291 @@
+//# tTableArrowExporter.cc: Test program for class TableArrowExporter
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableArrowExporter.h>
+#include <casacore/tables/Tables/TableProxy.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <cstring>
+
+using namespace casacore;
+
+// <summary>
+// Test program for class TableArrowExporter.
+// It checks the Arrow schema and the contents of the exported buffers.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Bool>     ("ab"));
+  td.addColumn (ScalarColumnDesc<Int>      ("ai"));
+  td.addColumn (ScalarColumnDesc<Double>   ("ad"));
+  td.addColumn (ScalarColumnDesc<DComplex> ("adc"));
+  td.addColumn (ScalarColumnDesc<String>   ("as"));
+  td.addColumn (ArrayColumnDesc<Float>     ("arrf", IPosition(2,2,3),
+                                            ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex>   ("arrc", IPosition(1,4),
+                                            ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool>      ("arrb", 1));
+  td.addColumn (ArrayColumnDesc<Int>       ("arrvar", 1));
+  SetupNewTable newtab("tTableArrowExporter_tmp.data", td, Table::New);
+  TiledColumnStMan tsm("TSM", IPosition(3,2,3,8));
+  newtab.bindColumn ("arrf", tsm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Bool>     ab(tab, "ab");
+  ScalarColumn<Int>      ai(tab, "ai");
+  ScalarColumn<Double>   ad(tab, "ad");
+  ScalarColumn<DComplex> adc(tab, "adc");
+  ScalarColumn<String>   as(tab, "as");
+  ArrayColumn<Float>     arrf(tab, "arrf");
+  ArrayColumn<Complex>   arrc(tab, "arrc");
+  ArrayColumn<Bool>      arrb(tab, "arrb");
+  ArrayColumn<Int>       arrvar(tab, "arrvar");
+  for (rownr_t i=0; i<nrow; ++i) {
+    ab.put (i, i%3 == 0);
+    ai.put (i, i);
+    ad.put (i, i*0.5);
+    adc.put (i, DComplex(i, -Double(i)));
+    as.put (i, String(i%4, 'x') + String::toString(i));
+    Matrix<Float> mf(2,3);
+    indgen (mf, Float(i*10));
+    arrf.put (i, mf);
+    Vector<Complex> vc(4);
+    for (uInt j=0; j<4; ++j) vc[j] = Complex(i, j);
+    arrc.put (i, vc);
+    Vector<Bool> vb(5);
+    for (uInt j=0; j<5; ++j) vb[j] = (i+j)%2 == 0;
+    arrb.put (i, vb);
+    arrvar.put (i, Vector<Int>(1 + i%3, i));
+  }
+}
+
+void checkSchema (const TableArrowExporter& exporter)
+{
+  ArrowSchema schema;
+  exporter.exportSchema (&schema);
+  AlwaysAssertExit (String(schema.format) == "+s");
+  AlwaysAssertExit (schema.n_children == 8);
+  const char* formats[] = {"b", "i", "g", "+w:2", "u", "+w:3", "+w:4", "+w:5"};
+  for (uInt i=0; i<8; ++i) {
+    AlwaysAssertExit (String(schema.children[i]->format) == formats[i]);
+    AlwaysAssertExit (String(schema.children[i]->name) ==
+                      exporter.columnNames()[i]);
+  }
+  // The array column has a fixed-size list per axis.
+  ArrowSchema* arrf = schema.children[5];
+  AlwaysAssertExit (arrf->n_children == 1);
+  AlwaysAssertExit (String(arrf->children[0]->format) == "+w:2");
+  AlwaysAssertExit (String(arrf->children[0]->children[0]->format) == "f");
+  ArrowSchema* arrc = schema.children[6];
+  AlwaysAssertExit (String(arrc->children[0]->format) == "+w:2");
+  AlwaysAssertExit (String(arrc->children[0]->children[0]->format) == "f");
+  schema.release (&schema);
+  AlwaysAssertExit (schema.release == 0);
+}
+
+// Check the contents of a record batch against the table.
+void checkBatch (const Table& tab, rownr_t startRow, const ArrowArray& batch)
+{
+  rownr_t nrow = batch.length;
+  AlwaysAssertExit (batch.n_children == 8);
+  // Bool (bitmap).
+  const uChar* bits = static_cast<const uChar*>
+    (batch.children[0]->buffers[1]);
+  ScalarColumn<Bool> ab(tab, "ab");
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (Bool((bits[i/8] >> (i%8)) & 1) == ab(startRow+i));
+  }
+  // Int and Double.
+  const Int* ints = static_cast<const Int*>(batch.children[1]->buffers[1]);
+  const Double* dbls = static_cast<const Double*>
+    (batch.children[2]->buffers[1]);
+  ScalarColumn<Int> ai(tab, "ai");
+  ScalarColumn<Double> ad(tab, "ad");
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (ints[i] == ai(startRow+i));
+    AlwaysAssertExit (dbls[i] == ad(startRow+i));
+  }
+  // DComplex as pairs of doubles.
+  const ArrowArray* adcChild = batch.children[3]->children[0];
+  AlwaysAssertExit (adcChild->length == Int64(2*nrow));
+  const Double* dcs = static_cast<const Double*>(adcChild->buffers[1]);
+  ScalarColumn<DComplex> adc(tab, "adc");
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (dcs[2*i] == adc(startRow+i).real());
+    AlwaysAssertExit (dcs[2*i+1] == adc(startRow+i).imag());
+  }
+  // String with offsets.
+  const Int* offsets = static_cast<const Int*>(batch.children[4]->buffers[1]);
+  const char* chars = static_cast<const char*>(batch.children[4]->buffers[2]);
+  ScalarColumn<String> as(tab, "as");
+  AlwaysAssertExit (offsets[0] == 0);
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (String(chars+offsets[i], offsets[i+1]-offsets[i]) ==
+                      as(startRow+i));
+  }
+  // Float array of shape [2,3].
+  const ArrowArray* arrf = batch.children[5];
+  AlwaysAssertExit (arrf->length == Int64(nrow));
+  AlwaysAssertExit (arrf->children[0]->length == Int64(3*nrow));
+  AlwaysAssertExit (arrf->children[0]->children[0]->length == Int64(6*nrow));
+  const Float* flts = static_cast<const Float*>
+    (arrf->children[0]->children[0]->buffers[1]);
+  ArrayColumn<Float> arrfCol(tab, "arrf");
+  for (rownr_t i=0; i<nrow; ++i) {
+    Array<Float> arr = arrfCol(startRow+i);
+    AlwaysAssertExit (memcmp (flts + 6*i, arr.data(), 6*sizeof(Float)) == 0);
+  }
+  // Complex array of shape [4].
+  const ArrowArray* arrc = batch.children[6]->children[0]->children[0];
+  AlwaysAssertExit (arrc->length == Int64(8*nrow));
+  const Float* cflts = static_cast<const Float*>(arrc->buffers[1]);
+  ArrayColumn<Complex> arrcCol(tab, "arrc");
+  for (rownr_t i=0; i<nrow; ++i) {
+    Array<Complex> arr = arrcCol(startRow+i);
+    AlwaysAssertExit (memcmp (cflts + 8*i, arr.data(), 8*sizeof(Float)) == 0);
+  }
+  // Bool array.
+  const uChar* abits = static_cast<const uChar*>
+    (batch.children[7]->children[0]->buffers[1]);
+  ArrayColumn<Bool> arrbCol(tab, "arrb");
+  for (rownr_t i=0; i<nrow; ++i) {
+    Vector<Bool> vec(arrbCol(startRow+i));
+    for (uInt j=0; j<5; ++j) {
+      uInt inx = i*5 + j;
+      AlwaysAssertExit (Bool((abits[inx/8] >> (inx%8)) & 1) == vec[j]);
+    }
+  }
+}
+
+void checkStream (const Table& tab, ArrowArrayStream& stream,
+                  rownr_t chunkSize)
+{
+  ArrowSchema schema;
+  AlwaysAssertExit (stream.get_schema (&stream, &schema) == 0);
+  AlwaysAssertExit (schema.n_children == 8);
+  schema.release (&schema);
+  rownr_t nrow = 0;
+  while (True) {
+    ArrowArray batch;
+    AlwaysAssertExit (stream.get_next (&stream, &batch) == 0);
+    if (batch.release == 0) {
+      break;
+    }
+    AlwaysAssertExit (batch.length == Int64(std::min (chunkSize,
+                                                      tab.nrow() - nrow)));
+    checkBatch (tab, nrow, batch);
+    nrow += batch.length;
+    batch.release (&batch);
+  }
+  AlwaysAssertExit (nrow == tab.nrow());
+  AlwaysAssertExit (stream.get_last_error (&stream) == 0);
+  stream.release (&stream);
+}
+
+int main()
+{
+  try {
+    createTable (50);
+    Table tab("tTableArrowExporter_tmp.data");
+    Vector<String> names = stringToVector("ab,ai,ad,adc,as,arrf,arrc,arrb");
+    TableArrowExporter exporter (tab, names, 16);
+    AlwaysAssertExit (exporter.nchunk() == 4);
+    // A column not having a fixed shape uses the shape of the first row.
+    AlwaysAssertExit (TableArrowExporter::canExport (tab, "arrvar"));
+    AlwaysAssertExit (! TableArrowExporter::canExport (tab, "xx"));
+    checkSchema (exporter);
+    // Export a chunk and some rows.
+    ArrowArray batch;
+    exporter.exportChunk (3, &batch);
+    AlwaysAssertExit (batch.length == 2);
+    checkBatch (tab, 48, batch);
+    batch.release (&batch);
+    exporter.exportRows (5, 20, &batch);
+    checkBatch (tab, 5, batch);
+    batch.release (&batch);
+    // Export a selection as a stream.
+    Table sel = tab(tab.col("ai") % 3 != 1);
+    ArrowArrayStream stream;
+    TableArrowExporter (sel, names, 7).exportStream (&stream);
+    checkStream (sel, stream, 7);
+    // Export using TableProxy.
+    TableProxy proxy(tab);
+    proxy.toArrowStream (names, 10,
+                         reinterpret_cast<Int64>(&stream));
+    checkStream (tab, stream, 10);
+    // The data of a mapped table remain valid after the table is closed.
+    {
+      Table mtab("tTableArrowExporter_tmp.data", Table::Old, TSMOption::MMap);
+      TableArrowExporter (mtab, stringToVector("arrf,ai"), 8).exportChunk
+        (1, &batch);
+    }
+    const Float* flts = static_cast<const Float*>
+      (batch.children[0]->children[0]->children[0]->buffers[1]);
+    for (uInt i=0; i<6*8; ++i) {
+      AlwaysAssertExit (flts[i] == (8 + i/6) * 10 + i%6);
+    }
+    batch.release (&batch);
+    // Rows with a shape differing from the first row cannot be exported.
+    TableArrowExporter varExporter (tab, stringToVector("arrvar"));
+    varExporter.exportRows (3, 1, &batch);
+    batch.release (&batch);
+    Bool ok = False;
+    try {
+      varExporter.exportRows (0, 2, &batch);
+    } catch (const TableError&) {
+      ok = True;
+    }
+    AlwaysAssertExit (ok);
+    // The same for an unknown column.
+    ok = False;
+    try {
+      TableArrowExporter (tab, stringToVector("ai,xx"));
+    } catch (const TableError&) {
+      ok = True;
+    }
+    AlwaysAssertExit (ok);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
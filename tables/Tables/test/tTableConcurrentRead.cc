@@ -0,0 +1,187 @@
+//# tTableConcurrentRead.cc: Test program for reading a table by multiple threads
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace casacore;
+
+// <summary>
+// Test program for reading a table by multiple threads using the same
+// Table and column objects (see Table::setConcurrentRead).
+// The columns are stored in the StandardStMan, IncrementalStMan and
+// TiledShapeStMan, because they keep state shared by their columns.
+// </summary>
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("ID"));
+  td.addColumn (ScalarColumnDesc<String> ("NAME"));
+  td.addColumn (ScalarColumnDesc<Double> ("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>    ("SCAN"));
+  td.addColumn (ArrayColumnDesc<Float>   ("DATA", 2));
+  SetupNewTable newtab("tTableConcurrentRead_tmp.tab", td, Table::New);
+  // Use a small bucket size to have many buckets.
+  StandardStMan ssm("SSM", 512);
+  IncrementalStMan ism("ISM", 512);
+  TiledShapeStMan tsm("TSM", IPosition(3,4,8,16));
+  newtab.bindColumn ("ID", ssm);
+  newtab.bindColumn ("NAME", ssm);
+  newtab.bindColumn ("TIME", ism);
+  newtab.bindColumn ("SCAN", ism);
+  newtab.bindColumn ("DATA", tsm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> id(tab, "ID");
+  ScalarColumn<String> name(tab, "NAME");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> scan(tab, "SCAN");
+  ArrayColumn<Float> data(tab, "DATA");
+  for (rownr_t i=0; i<nrow; ++i) {
+    id.put (i, i);
+    name.put (i, "name" + String::toString(i));
+    time.put (i, Double(i/10));
+    scan.put (i, i/100);
+    data.put (i, Matrix<Float>(4, i<nrow/2 ? 8:6, Float(i)));
+  }
+}
+
+// Check the values in a row. It returns the number of errors.
+uInt checkRow (const ScalarColumn<Int>& id, const ScalarColumn<String>& name,
+               const ScalarColumn<Double>& time, const ScalarColumn<Int>& scan,
+               const ArrayColumn<Float>& data, rownr_t row, rownr_t origRow,
+               rownr_t nrow, Array<Float>& buf)
+{
+  uInt nerr = 0;
+  if (id(row) != Int(origRow)) nerr++;
+  if (name(row) != "name" + String::toString(origRow)) nerr++;
+  if (time(row) != Double(origRow/10)) nerr++;
+  if (scan(row) != Int(origRow/100)) nerr++;
+  data.get (row, buf, True);
+  if (buf.shape() != IPosition(2, 4, origRow<nrow/2 ? 8:6)) nerr++;
+  if (! allEQ (buf, Float(origRow))) nerr++;
+  return nerr;
+}
+
+// Read the table in a few threads, each starting at another row and
+// stepping through the table in a different order.
+void readTable (const Table& tab, rownr_t nrow, Bool isRef)
+{
+  ScalarColumn<Int> id(tab, "ID");
+  ScalarColumn<String> name(tab, "NAME");
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> scan(tab, "SCAN");
+  ArrayColumn<Float> data(tab, "DATA");
+  std::atomic<uInt> nerr(0);
+  std::vector<std::thread> threads;
+  for (uInt thr=0; thr<4; ++thr) {
+    threads.push_back (std::thread ([&, thr]() {
+      Array<Float> buf;
+      uInt n = 0;
+      rownr_t tabrow = tab.nrow();
+      for (rownr_t i=0; i<tabrow; ++i) {
+        rownr_t row = (thr*tabrow/4 + i*(2*thr+1)) % tabrow;
+        rownr_t origRow = (isRef  ?  tabrow-1-row : row);
+        n += checkRow (id, name, time, scan, data, row, origRow, nrow, buf);
+      }
+      // Also read entire columns.
+      Vector<Int> ids = id.getColumn();
+      for (rownr_t i=0; i<tabrow; ++i) {
+        if (ids[i] != Int(isRef  ?  tabrow-1-i : i)) n++;
+      }
+      nerr += n;
+    }));
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  AlwaysAssertExit (nerr == 0);
+}
+
+int main()
+{
+  try {
+    rownr_t nrow = 5000;
+    createTable (nrow);
+    // AutoLocking cannot be used.
+    {
+      Table tab("tTableConcurrentRead_tmp.tab");
+      Bool failed = False;
+      try {
+        tab.setConcurrentRead();
+      } catch (const TableInvOper&) {
+        failed = True;
+      }
+      AlwaysAssertExit (failed  &&  ! tab.isConcurrentRead());
+    }
+    Table tab("tTableConcurrentRead_tmp.tab",
+              TableLock(TableLock::PermanentLocking));
+    tab.setConcurrentRead();
+    AlwaysAssertExit (tab.isConcurrentRead());
+    readTable (tab, nrow, False);
+    // A view cannot be given in this mode.
+    Array<Float> view;
+    AlwaysAssertExit (! ArrayColumn<Float>(tab, "DATA").getColumnRangeView
+                      (Slicer(IPosition(1,0), IPosition(1,10)), view));
+    // A reference table (in reversed order) uses the root table.
+    Vector<rownr_t> rows(nrow);
+    for (rownr_t i=0; i<nrow; ++i) {
+      rows[i] = nrow-1-i;
+    }
+    Table reftab = tab(rows);
+    AlwaysAssertExit (reftab.isConcurrentRead());
+    readTable (reftab, nrow, True);
+    tab.setConcurrentRead (False);
+    AlwaysAssertExit (! reftab.isConcurrentRead());
+    // A memory table can be read concurrently as well.
+    Table memtab = tab.copyToMemoryTable ("tTableConcurrentRead_tmp.mem");
+    memtab.setConcurrentRead();
+    readTable (memtab, nrow, False);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
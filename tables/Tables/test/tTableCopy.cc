@@ -123,6 +123,71 @@ void testCloneColumns()
   testCloneColumn (tsm3, True);
 }
 
+// Copy rows using the chunked and parallel column copy.
+// It uses scalar, fixed and variable shaped array columns, an undefined
+// cell, cells with different shapes, and a column with a different type.
+void testCopyRows()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>    ("INT"));
+  td.addColumn (ScalarColumnDesc<Int64>  ("I64"));
+  td.addColumn (ScalarColumnDesc<String> ("STR"));
+  td.addColumn (ScalarColumnDesc<Int>    ("CONV"));
+  td.addColumn (ArrayColumnDesc<Float>   ("FIX", IPosition(1,4),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex> ("VAR", 1));
+  TableDesc tdout(td);
+  tdout.removeColumn ("CONV");
+  tdout.addColumn (ScalarColumnDesc<Double> ("CONV"));
+  TableLock lock(TableLock::PermanentLocking);
+  SetupNewTable newin("tTableCopy_tmp.in", td, Table::New);
+  TiledShapeStMan tsmin("VAR_stm", IPosition(2,4,16));
+  newin.bindColumn ("VAR", tsmin);
+  Table tin(newin, lock, 1000);
+  ScalarColumn<Int> intCol(tin, "INT");
+  ScalarColumn<Int64> i64Col(tin, "I64");
+  ScalarColumn<String> strCol(tin, "STR");
+  ScalarColumn<Int> convCol(tin, "CONV");
+  ArrayColumn<Float> fixCol(tin, "FIX");
+  ArrayColumn<Complex> varCol(tin, "VAR");
+  for (uInt row=0; row<tin.nrow(); ++row) {
+    intCol.put (row, row);
+    i64Col.put (row, Int64(row) << 33);
+    strCol.put (row, String::toString(row));
+    convCol.put (row, 2*row);
+    fixCol.put (row, Vector<Float>(4, row));
+    if (row != 500) {
+      varCol.put (row, Vector<Complex>(row<600 ? 3:2, Complex(row, -1)));
+    }
+  }
+  SetupNewTable newout("tTableCopy_tmp.out", tdout, Table::New);
+  TiledShapeStMan tsmout("VAR_stm", IPosition(2,4,8));
+  newout.bindColumn ("VAR", tsmout);
+  Table tout(newout, lock, 10);
+  TableCopy::copyRows (tout, tin, 5, 100, 800, True, 4);
+  AlwaysAssertExit (tout.nrow() == 805);
+  ScalarColumn<Int> intOut(tout, "INT");
+  ScalarColumn<Int64> i64Out(tout, "I64");
+  ScalarColumn<String> strOut(tout, "STR");
+  ScalarColumn<Double> convOut(tout, "CONV");
+  ArrayColumn<Float> fixOut(tout, "FIX");
+  ArrayColumn<Complex> varOut(tout, "VAR");
+  for (uInt i=0; i<800; ++i) {
+    uInt row = 100+i;
+    AlwaysAssertExit (intOut(5+i) == Int(row));
+    AlwaysAssertExit (i64Out(5+i) == Int64(row) << 33);
+    AlwaysAssertExit (strOut(5+i) == String::toString(row));
+    AlwaysAssertExit (convOut(5+i) == 2*row);
+    AlwaysAssertExit (allEQ (fixOut(5+i), Float(row)));
+    if (row == 500) {
+      AlwaysAssertExit (! varOut.isDefined(5+i));
+    } else {
+      AlwaysAssertExit (varOut.shape(5+i) == IPosition(1, row<600 ? 3:2));
+      AlwaysAssertExit (allEQ (varOut(5+i), Complex(row, -1)));
+    }
+  }
+}
+
 
 int main (int argc, const char* argv[])
 {
@@ -167,6 +232,7 @@ int main (int argc, const char* argv[])
 
     if (argc <= 1) {
       testCloneColumns();
+      testCopyRows();
     }
   } catch (const exception& x) {
     cout << x.what() << endl;
@@ -31,12 +31,16 @@
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/TableIter.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
+#include <map>
+#include <utility>
 
 
 #include <casacore/casa/namespace.h>
@@ -57,6 +61,7 @@ void doiter1();
 void doiter2();
 void doiter3();
 void test_cache_boundaries();
+void test_hash_groups();
 
 int main (int argc, const char* argv[])
 {
@@ -72,6 +77,7 @@ int main (int argc, const char* argv[])
     doiter2();               // do two column iteration
     doiter3();               // do interval iteration
     test_cache_boundaries(); // test option to cache group boundaries
+    test_hash_groups();      // test grouping by hashing
     return 0;                // successfully executed
 }
 
@@ -338,3 +344,63 @@ void test_cache_boundaries()
         iter2.next();
     }
 }
+
+// Check that grouping by hashing gives the same groups as the sorted
+// iteration, though maybe in another order.
+void check_hash_groups (const Table& tab)
+{
+    Block<String> cols(2);
+    cols[0] = "col2";
+    cols[1] = "col1";
+    std::map<std::pair<double,Int>, Vector<rownr_t> > groups;
+    for (TableIterator iter(tab, cols); !iter.pastEnd(); iter.next()) {
+        Table t = iter.table();
+        groups[std::make_pair (ScalarColumn<double>(t, "col2")(0),
+                               ScalarColumn<Int>(t, "col1")(0))] =
+          t.rowNumbers(tab);
+    }
+    uInt nr = 0;
+    rownr_t lastFirstRow = 0;
+    TableIterator iter(tab, cols, TableIterator::Ascending,
+                       TableIterator::HashGroup);
+    for (; !iter.pastEnd(); iter.next()) {
+        Table t = iter.table();
+        Vector<rownr_t> rows = t.rowNumbers(tab);
+        // The groups are in order of first appearance.
+        AlwaysAssertExit (nr == 0  ||  rows[0] > lastFirstRow);
+        lastFirstRow = rows[0];
+        const Vector<rownr_t>& expRows =
+          groups[std::make_pair (ScalarColumn<double>(t, "col2")(0),
+                                 ScalarColumn<Int>(t, "col1")(0))];
+        AlwaysAssertExit (rows.size() == expRows.size()  &&
+                          allEQ (rows, expRows));
+        nr++;
+    }
+    AlwaysAssertExit (nr == groups.size());
+    // Iterating again must give the same result.
+    iter.reset();
+    uInt nr2 = 0;
+    for (; !iter.pastEnd(); iter.next()) {
+        nr2++;
+    }
+    AlwaysAssertExit (nr2 == nr);
+}
+
+void test_hash_groups()
+{
+    Table tab ("tTableIter_tmp.data");
+    check_hash_groups (tab);
+    check_hash_groups (tab(tab.col("col3") > 20));
+    // An interval comparison cannot be hashed, so the table is sorted.
+    Block<String> cols(1, "col2");
+    Block<CountedPtr<BaseCompare> > cmp(1);
+    cmp[0] = new CompareIntervalReal<Double> (0., 10.);
+    Block<Int> orders(1, TableIterator::Ascending);
+    TableIterator iter1(tab, cols, cmp, orders, TableIterator::HashGroup);
+    TableIterator iter2(tab, cols, cmp, orders, TableIterator::ParSort);
+    for (; !iter1.pastEnd(); iter1.next(), iter2.next()) {
+        AlwaysAssertExit (allEQ (iter1.table().rowNumbers(tab),
+                                 iter2.table().rowNumbers(tab)));
+    }
+    AlwaysAssertExit (iter2.pastEnd());
+}
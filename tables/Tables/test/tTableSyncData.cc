@@ -0,0 +1,110 @@
+//# tTableSyncData.cc: Test program for class TableSyncData
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/Tables/TableSyncData.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// <summary>
+// Test program for class TableSyncData.
+// It mimics the sync data written by one process into the lock file and
+// read by another process when acquiring a lock.
+// </summary>
+
+// Copy the sync data as done via the lock file.
+void transfer (TableSyncData& from, TableSyncData& to)
+{
+  MemoryIO& fromIO = from.memoryIO();
+  MemoryIO& toIO = to.memoryIO();
+  toIO.clear();
+  toIO.write (fromIO.length(), fromIO.getBuffer());
+  toIO.seek (Int64(0));
+}
+
+int main()
+{
+  try {
+    TableSyncData writer;
+    TableSyncData reader;
+    Block<Bool> dmChanged(3, True);
+    rownr_t nrrow;
+    uInt ncolumn;
+    Bool tableChanged;
+    // Empty sync data.
+    AlwaysAssertExit (! reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    // Everything has changed the first time.
+    writer.write (10, 4, True, dmChanged);
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 10  &&  ncolumn == 4  &&  tableChanged);
+    AlwaysAssertExit (dmChanged.nelements() == 3);
+    // Reading the same data again tells nothing has changed.
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 10  &&  ncolumn == 4  &&  !tableChanged);
+    AlwaysAssertExit (dmChanged.nelements() == 3);
+    AlwaysAssertExit (!dmChanged[0]  &&  !dmChanged[1]  &&  !dmChanged[2]);
+    // Change a data manager and the number of rows.
+    dmChanged = False;
+    dmChanged[1] = True;
+    writer.write (12, 4, False, dmChanged);
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 12  &&  ncolumn == 4  &&  !tableChanged);
+    AlwaysAssertExit (!dmChanged[0]  &&  dmChanged[1]  &&  !dmChanged[2]);
+    // The data written by the reader itself are not changed.
+    dmChanged = False;
+    dmChanged[2] = True;
+    reader.write (13, 4, True, dmChanged);
+    AlwaysAssertExit (reader.getModifyCounter() == writer.getModifyCounter()+1);
+    transfer (reader, writer);
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 13  &&  ncolumn == 4  &&  !tableChanged);
+    AlwaysAssertExit (!dmChanged[0]  &&  !dmChanged[1]  &&  !dmChanged[2]);
+    // But the writer sees the changes.
+    AlwaysAssertExit (writer.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 13  &&  ncolumn == 4  &&  tableChanged);
+    AlwaysAssertExit (!dmChanged[0]  &&  !dmChanged[1]  &&  dmChanged[2]);
+    // Sync data of an external filler are always interpreted.
+    writer.write (20);
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 20  &&  tableChanged  &&  dmChanged[0]);
+    transfer (writer, reader);
+    AlwaysAssertExit (reader.read (nrrow, ncolumn, tableChanged, dmChanged));
+    AlwaysAssertExit (nrrow == 20  &&  tableChanged  &&  dmChanged[0]);
+  } catch (std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}